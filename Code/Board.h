@@ -39,6 +39,7 @@ extern "C" {
 
 #include "EK_TM4C1294XL.h"
 
+#define Board_initDMA               EK_TM4C1294XL_initDMA
 #define Board_initEMAC              EK_TM4C1294XL_initEMAC
 #define Board_initGeneral           EK_TM4C1294XL_initGeneral
 #define Board_initGPIO              EK_TM4C1294XL_initGPIO
@@ -59,6 +60,8 @@ extern "C" {
 #define Board_LED2                  EK_TM4C1294XL_D2
 #define Board_BUTTON0               EK_TM4C1294XL_USR_SW1
 #define Board_BUTTON1               EK_TM4C1294XL_USR_SW2
+#define Board_OPT3001_INT           EK_TM4C1294XL_OPT3001_INT
+#define Board_ESTOP                 EK_TM4C1294XL_USR_SW1
 
 #define Board_I2C0                  EK_TM4C1294XL_I2C7
 #define Board_I2C1                  EK_TM4C1294XL_I2C8
@@ -91,6 +94,7 @@ extern "C" {
 #define Board_TMP006_ADDR           (0x40)
 #define Board_RF430CL330_ADDR       (0x28)
 #define Board_TPL0401_ADDR          (0x40)
+#define Board_OPT3001_ADDR          (0x47)
 
 #ifdef __cplusplus
 }
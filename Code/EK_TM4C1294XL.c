@@ -287,10 +287,12 @@ void EK_TM4C1294XL_initEMAC(void)
  */
 GPIO_PinConfig gpioPinConfigs[] = {
     /* Input pins */
-    /* EK_TM4C1294XL_USR_SW1 */
-    GPIOTiva_PJ_0 | GPIO_CFG_IN_PU | GPIO_CFG_IN_INT_RISING,
+    /* EK_TM4C1294XL_USR_SW1, the e-stop, active low and taken on both edges */
+    GPIOTiva_PJ_0 | GPIO_CFG_IN_PU | GPIO_CFG_IN_INT_BOTH_EDGES,
     /* EK_TM4C1294XL_USR_SW2 */
     GPIOTiva_PJ_1 | GPIO_CFG_IN_PU | GPIO_CFG_IN_INT_RISING,
+    /* EK_TM4C1294XL_OPT3001_INT, open drain and active low */
+    GPIOTiva_PP_2 | GPIO_CFG_IN_PU | GPIO_CFG_IN_INT_FALLING,
 
     /* Output pins */
     /* EK_TM4C1294XL_USR_D1 */
@@ -308,7 +310,8 @@ GPIO_PinConfig gpioPinConfigs[] = {
  */
 GPIO_CallbackFxn gpioCallbackFunctions[] = {
     NULL,  /* EK_TM4C1294XL_USR_SW1 */
-    NULL   /* EK_TM4C1294XL_USR_SW2 */
+    NULL,  /* EK_TM4C1294XL_USR_SW2 */
+    NULL   /* EK_TM4C1294XL_OPT3001_INT */
 };
 
 /* The device-specific GPIO_config structure */
@@ -71,6 +71,7 @@ typedef enum EK_TM4C1294XL_EMACName {
 typedef enum EK_TM4C1294XL_GPIOName {
     EK_TM4C1294XL_USR_SW1 = 0,
     EK_TM4C1294XL_USR_SW2,
+    EK_TM4C1294XL_OPT3001_INT,
     EK_TM4C1294XL_D1,
     EK_TM4C1294XL_D2,
 
@@ -178,6 +179,14 @@ typedef enum EK_TM4C1294XL_WiFiName {
  */
 extern void EK_TM4C1294XL_initGeneral(void);
 
+/*!
+ *  @brief  Initialize the uDMA controller
+ *
+ *  This function enables the uDMA controller, sets the shared control table
+ *  and installs the uDMA error interrupt. It is safe to call more than once.
+ */
+extern void EK_TM4C1294XL_initDMA(void);
+
 /*!
  *  @brief Initialize board specific EMAC settings
  *
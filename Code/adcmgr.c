@@ -0,0 +1,327 @@
+#pragma region Includes
+#include "adcmgr.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* XDCtools header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Error.h>
+
+/* BIOS header files */
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_adc.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "driverlib/adc.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Register access can be overridden when built for host tests */
+#ifndef ADCMGR_HWREG
+#define ADCMGR_HWREG(x) HWREG(x)
+#endif
+
+/* Global constants */
+const uint8_t gc_ui8SequencerDepth[ADC_SEQUENCER_COUNT] = {8, 4, 4, 1};
+const uint32_t gc_ui32SequencerFIFO[ADC_SEQUENCER_COUNT] = {ADC_O_SSFIFO0, ADC_O_SSFIFO1, ADC_O_SSFIFO2, ADC_O_SSFIFO3};
+const uint32_t gc_ui32SequencerInt[ADC_SEQUENCER_COUNT] = {INT_ADC0SS0, INT_ADC0SS1, INT_ADC0SS2, INT_ADC0SS3};
+const uint32_t gc_ui32SequencerDMA[ADC_SEQUENCER_COUNT] = {UDMA_CH14_ADC0_0, UDMA_CH15_ADC0_1, UDMA_CH16_ADC0_2, UDMA_CH17_ADC0_3};
+
+/* Global variables */
+tADCClient *g_psADCClients[ADC_SEQUENCER_COUNT];
+Hwi_Struct g_sADCHwi[ADC_SEQUENCER_COUNT];
+
+/* Touch screen pseudo client, owns sequencer 3 and the timer trigger */
+tADCClient g_sADCTouchClient = {
+	.ui8NumSteps = 1,
+	.ui32Trigger = ADC_TRIGGER_TIMER,
+	.ui32RateHz = ADC_TOUCH_RATE,
+	.ui8Sequencer = ADC_TOUCH_SEQUENCER
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Assigns sequencer priorities so that the fastest sequence has the highest priority
+ *
+ * @note This function is not intended to be called by the user
+ */
+void ADCMgr_UpdatePriorities() {
+	uint32_t ui32Priorities = 0;
+
+	for (uint8_t i = 0; i < ADC_SEQUENCER_COUNT; i++) {
+		uint8_t ui8Priority = 0;
+
+		/* Count the sequences that run faster (ties broken by sequencer number) */
+		for (uint8_t j = 0; j < ADC_SEQUENCER_COUNT; j++) {
+			if (i == j)
+				continue;
+
+			uint32_t ui32RateI = g_psADCClients[i] ? g_psADCClients[i]->ui32RateHz : 0;
+			uint32_t ui32RateJ = g_psADCClients[j] ? g_psADCClients[j]->ui32RateHz : 0;
+			if (ui32RateJ > ui32RateI || (ui32RateJ == ui32RateI && j < i))
+				ui8Priority++;
+		}
+
+		if (g_psADCClients[i] != NULL)
+			g_psADCClients[i]->ui8Priority = ui8Priority;
+		ui32Priorities |= ui8Priority << (i * 4);
+	}
+
+	ADCMGR_HWREG(ADC0_BASE + ADC_O_SSPRI) = ui32Priorities;
+}
+
+/**
+ * @brief Checks the schedule of the registered clients plus a candidate client
+ *
+ * @param psCandidate The client to check alongside the registered clients
+ * @return True if the combined schedule is feasible
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool ADCMgr_CheckClients(const tADCClient *psCandidate) {
+	const tADCClient *psClients[ADC_SEQUENCER_COUNT + 1];
+	uint8_t ui8Steps[ADC_SEQUENCER_COUNT + 1];
+	uint32_t ui32Rates[ADC_SEQUENCER_COUNT + 1];
+	uint8_t ui8Count = 0;
+
+	for (uint8_t i = 0; i < ADC_SEQUENCER_COUNT; i++) {
+		if (g_psADCClients[i] != NULL)
+			psClients[ui8Count++] = g_psADCClients[i];
+	}
+	psClients[ui8Count++] = psCandidate;
+
+	/* Order by rate, fastest (highest priority) first */
+	for (uint8_t i = 1; i < ui8Count; i++) {
+		const tADCClient *psClient = psClients[i];
+		uint8_t j = i;
+		for (; j > 0 && psClients[j - 1]->ui32RateHz < psClient->ui32RateHz; j--)
+			psClients[j] = psClients[j - 1];
+		psClients[j] = psClient;
+	}
+
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		ui8Steps[i] = psClients[i]->ui8NumSteps;
+		ui32Rates[i] = psClients[i]->ui32RateHz;
+	}
+
+	return ADCMgr_CheckSchedule(ui8Steps, ui32Rates, ui8Count, NULL);
+}
+
+/**
+ * @brief Arms one half of a client's ping-pong buffer
+ *
+ * @param psClient The client to arm
+ * @param ui32Select UDMA_PRI_SELECT or UDMA_ALT_SELECT
+ *
+ * @note This function is not intended to be called by the user
+ */
+void ADCMgr_ArmTransfer(tADCClient *psClient, uint32_t ui32Select) {
+	uint8_t ui8Seq = psClient->ui8Sequencer;
+	uint16_t *pui16Dest = psClient->pui16Buffer;
+	if (ui32Select == UDMA_ALT_SELECT)
+		pui16Dest += psClient->ui16BlockLen;
+
+	uDMAChannelTransferSet((gc_ui32SequencerDMA[ui8Seq] & 0xff) | ui32Select, UDMA_MODE_PINGPONG,
+						   (void *)(ADC0_BASE + gc_ui32SequencerFIFO[ui8Seq]), pui16Dest, psClient->ui16BlockLen);
+}
+
+/**
+ * @brief Handles the DMA done interrupt of a sequencer
+ *
+ * @param arg The sequencer number
+ *
+ * @note This function is not intended to be called by the user
+ */
+void ADCMgr_SequencerHwi(UArg arg) {
+	uint8_t ui8Seq = arg;
+	tADCClient *psClient = g_psADCClients[ui8Seq];
+	uint32_t ui32Channel = gc_ui32SequencerDMA[ui8Seq] & 0xff;
+
+	ADCIntClearEx(ADC0_BASE, ADC_INT_DMA_SS0 << ui8Seq);
+	if (psClient == NULL)
+		return;
+
+	bool bPriDone = uDMAChannelModeGet(ui32Channel | UDMA_PRI_SELECT) == UDMA_MODE_STOP;
+	bool bAltDone = uDMAChannelModeGet(ui32Channel | UDMA_ALT_SELECT) == UDMA_MODE_STOP;
+
+	/* Both halves full means a block was lost */
+	if (bPriDone && bAltDone)
+		psClient->ui32Overruns++;
+
+	/* Re-arm the finished half before handing it out, the other half is filling */
+	if (bPriDone) {
+		ADCMgr_ArmTransfer(psClient, UDMA_PRI_SELECT);
+		psClient->ui32Blocks++;
+		if (psClient->pfnBlock != NULL)
+			psClient->pfnBlock(psClient->pui16Buffer, psClient->ui16BlockLen, psClient->pvArg);
+	}
+	if (bAltDone) {
+		ADCMgr_ArmTransfer(psClient, UDMA_ALT_SELECT);
+		psClient->ui32Blocks++;
+		if (psClient->pfnBlock != NULL)
+			psClient->pfnBlock(psClient->pui16Buffer + psClient->ui16BlockLen, psClient->ui16BlockLen, psClient->pvArg);
+	}
+
+	/* Channel is disabled once both halves stop */
+	if (!uDMAChannelIsEnabled(ui32Channel))
+		uDMAChannelEnable(ui32Channel);
+}
+#pragma endregion
+
+#pragma region ADC manager API functions
+/**
+ * @brief Initialize the ADC resource manager
+ *
+ * @note The touch screen driver is registered as the owner of sequencer 3 and the timer trigger
+ */
+void ADCMgr_Init() {
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
+	while (!SysCtlPeripheralReady(SYSCTL_PERIPH_ADC0))
+		;
+	Board_initDMA();
+
+	memset(g_psADCClients, 0, sizeof(g_psADCClients));
+	g_psADCClients[ADC_TOUCH_SEQUENCER] = &g_sADCTouchClient;
+	ADCMgr_UpdatePriorities();
+}
+
+/**
+ * @brief Registers a client and starts its conversions
+ *
+ * @param psClient The client to register
+ * @return True if a sequencer was assigned and the schedule is feasible
+ *
+ * @note Must be called after TouchScreenInit, which configures sequencer 3 with priority 0 and would undo the
+ *		 priorities set here
+ */
+bool ADCMgr_Register(tADCClient *psClient) {
+	/* Any enabled timer trigger fires every timer triggered sequence, the touch screen owns it */
+	if (psClient->ui32Trigger == ADC_TRIGGER_TIMER)
+		return false;
+	if (psClient->ui8NumSteps == 0 || psClient->ui16BlockLen % psClient->ui8NumSteps != 0)
+		return false;
+	if (psClient->ui16BlockLen > 1024)
+		return false;
+
+	/* Pick the shallowest free sequencer that fits */
+	uint8_t ui8Seq = ADC_SEQUENCER_COUNT;
+	for (uint8_t i = 0; i < ADC_SEQUENCER_COUNT; i++) {
+		if (g_psADCClients[i] != NULL || gc_ui8SequencerDepth[i] < psClient->ui8NumSteps)
+			continue;
+		if (ui8Seq == ADC_SEQUENCER_COUNT || gc_ui8SequencerDepth[i] < gc_ui8SequencerDepth[ui8Seq])
+			ui8Seq = i;
+	}
+	if (ui8Seq == ADC_SEQUENCER_COUNT)
+		return false;
+
+	if (!ADCMgr_CheckClients(psClient))
+		return false;
+
+	psClient->ui8Sequencer = ui8Seq;
+	psClient->ui32Blocks = 0;
+	psClient->ui32Overruns = 0;
+
+	/* Configure the sequence */
+	ADCSequenceDisable(ADC0_BASE, ui8Seq);
+	ADCSequenceConfigure(ADC0_BASE, ui8Seq, psClient->ui32Trigger, 0);
+	for (uint8_t i = 0; i < psClient->ui8NumSteps; i++) {
+		uint32_t ui32Config = psClient->pui32Channels[i];
+		if (i == psClient->ui8NumSteps - 1)
+			ui32Config |= ADC_CTL_END;
+		ADCSequenceStepConfigure(ADC0_BASE, ui8Seq, i, ui32Config);
+	}
+
+	/* Configure the ping-pong transfer */
+	uint32_t ui32Channel = gc_ui32SequencerDMA[ui8Seq] & 0xff;
+	uDMAChannelAssign(gc_ui32SequencerDMA[ui8Seq]);
+	uDMAChannelAttributeDisable(ui32Channel, UDMA_ATTR_ALTSELECT | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+	uDMAChannelControlSet(ui32Channel | UDMA_PRI_SELECT, UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+	uDMAChannelControlSet(ui32Channel | UDMA_ALT_SELECT, UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+	ADCMgr_ArmTransfer(psClient, UDMA_PRI_SELECT);
+	ADCMgr_ArmTransfer(psClient, UDMA_ALT_SELECT);
+	uDMAChannelEnable(ui32Channel);
+
+	/* Construct the block interrupt */
+	Hwi_Params hwiParams;
+	Hwi_Params_init(&hwiParams);
+	hwiParams.arg = ui8Seq;
+	Hwi_construct(&g_sADCHwi[ui8Seq], gc_ui32SequencerInt[ui8Seq], ADCMgr_SequencerHwi, &hwiParams, NULL);
+
+	/* Claim the sequencer and start converting */
+	g_psADCClients[ui8Seq] = psClient;
+	ADCMgr_UpdatePriorities();
+	ADCSequenceDMAEnable(ADC0_BASE, ui8Seq);
+	ADCIntEnableEx(ADC0_BASE, ADC_INT_DMA_SS0 << ui8Seq);
+	ADCSequenceEnable(ADC0_BASE, ui8Seq);
+	return true;
+}
+
+/**
+ * @brief Checks if a set of sequences can all be serviced at their trigger rate
+ *
+ * @param pui8Steps The number of steps in each sequence, ordered from highest to lowest priority
+ * @param pui32RateHz The trigger rate of each sequence (Hz)
+ * @param ui8Count The number of sequences
+ * @param pui32ResponseNs The worst case response time of each sequence (optional)
+ * @return True if every sequence completes before it is next triggered
+ *
+ * @note This function does not access the hardware and can be used on the host
+ */
+bool ADCMgr_CheckSchedule(const uint8_t *pui8Steps, const uint32_t *pui32RateHz, uint8_t ui8Count, uint32_t *pui32ResponseNs) {
+	/* Check total converter utilisation */
+	uint64_t ui64Busy = 0;
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		if (pui32RateHz[i] == 0)
+			return false;
+		ui64Busy += (uint64_t)pui8Steps[i] * ADC_CONVERSION_NS * pui32RateHz[i];
+	}
+	if (ui64Busy * 100 > (uint64_t)ADC_MAX_UTILISATION * 1000000000)
+		return false;
+
+	/* Response time analysis, sequences run to completion once started */
+	bool bFeasible = true;
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		uint32_t ui32Cost = pui8Steps[i] * ADC_CONVERSION_NS;
+		uint32_t ui32Period = 1000000000 / pui32RateHz[i];
+
+		/* Worst case blocking by a lower priority sequence already running */
+		uint32_t ui32Blocking = 0;
+		for (uint8_t j = i + 1; j < ui8Count; j++) {
+			if (pui8Steps[j] * ADC_CONVERSION_NS > ui32Blocking)
+				ui32Blocking = pui8Steps[j] * ADC_CONVERSION_NS;
+		}
+
+		/* Iterate until the response time settles or misses the deadline */
+		uint32_t ui32Response = ui32Cost + ui32Blocking;
+		while (ui32Response <= ui32Period) {
+			uint32_t ui32Next = ui32Cost + ui32Blocking;
+			for (uint8_t j = 0; j < i; j++) {
+				uint32_t ui32PeriodJ = 1000000000 / pui32RateHz[j];
+				ui32Next += ((ui32Response + ui32PeriodJ - 1) / ui32PeriodJ) * pui8Steps[j] * ADC_CONVERSION_NS;
+			}
+			if (ui32Next == ui32Response)
+				break;
+			ui32Response = ui32Next;
+		}
+
+		if (pui32ResponseNs != NULL)
+			pui32ResponseNs[i] = ui32Response;
+		if (ui32Response > ui32Period)
+			bFeasible = false;
+	}
+
+	return bFeasible;
+}
+#pragma endregion
@@ -0,0 +1,93 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define ADC_SEQUENCER_COUNT 4
+#define ADC_TOUCH_SEQUENCER 3
+#define ADC_TOUCH_RATE 1000
+#define ADC_CONVERSION_NS 1000
+#define ADC_MAX_UTILISATION 70
+
+/**
+ * @brief ADC block callback function type
+ *
+ * @note This function is called from the ADC interrupt and must not block
+ */
+typedef void (*tADCBlockFxn)(const uint16_t *pui16Block, uint16_t ui16Count, void *pvArg);
+
+/**
+ * @brief Describes a client of the ADC resource manager
+ *
+ */
+typedef struct tADCClient {
+	/**
+	 * @brief The ADC_CTL_CHx value for each step of the sequence
+	 */
+	const uint32_t *pui32Channels;
+	/**
+	 * @brief The number of steps in the sequence
+	 */
+	uint8_t ui8NumSteps;
+	/**
+	 * @brief The ADC_TRIGGER_x source that starts the sequence
+	 */
+	uint32_t ui32Trigger;
+	/**
+	 * @brief The rate at which the trigger fires (Hz)
+	 */
+	uint32_t ui32RateHz;
+	/**
+	 * @brief The ping-pong buffer, must hold 2 * ui16BlockLen samples
+	 */
+	uint16_t *pui16Buffer;
+	/**
+	 * @brief The number of samples per block, must be a multiple of ui8NumSteps
+	 */
+	uint16_t ui16BlockLen;
+	/**
+	 * @brief The function to call when a block has been filled
+	 */
+	tADCBlockFxn pfnBlock;
+	/**
+	 * @brief The argument to pass to the block function
+	 */
+	void *pvArg;
+
+	/* Private state, filled in by the manager */
+	uint8_t ui8Sequencer;
+	uint8_t ui8Priority;
+	uint32_t ui32Blocks;
+	uint32_t ui32Overruns;
+} tADCClient;
+
+/**
+ * @brief Initialize the ADC resource manager
+ *
+ * @note The touch screen driver is registered as the owner of sequencer 3 and the timer trigger
+ */
+void ADCMgr_Init();
+
+/**
+ * @brief Registers a client and starts its conversions
+ *
+ * @param psClient The client to register
+ * @return True if a sequencer was assigned and the schedule is feasible
+ *
+ * @note Must be called after TouchScreenInit, which configures sequencer 3 with priority 0 and would undo the
+ *		 priorities set here
+ */
+bool ADCMgr_Register(tADCClient *psClient);
+
+/**
+ * @brief Checks if a set of sequences can all be serviced at their trigger rate
+ *
+ * @param pui8Steps The number of steps in each sequence, ordered from highest to lowest priority
+ * @param pui32RateHz The trigger rate of each sequence (Hz)
+ * @param ui8Count The number of sequences
+ * @param pui32ResponseNs The worst case response time of each sequence (optional)
+ * @return True if every sequence completes before it is next triggered
+ *
+ * @note This function does not access the hardware and can be used on the host
+ */
+bool ADCMgr_CheckSchedule(const uint8_t *pui8Steps, const uint32_t *pui32RateHz, uint8_t ui8Count, uint32_t *pui32ResponseNs);
@@ -0,0 +1,155 @@
+#pragma region Includes
+#include "bar.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets the number of positions along the inside of the bar
+ *
+ * @param psBar The bar
+ * @return The length of the bar in pixels, without its outline
+ *
+ * @note This function is not intended to be called by the user
+ */
+int16_t Bar_Length(const tBarMeter *psBar) {
+	if (psBar->bVertical)
+		return psBar->sRect.i16YMax - psBar->sRect.i16YMin - 1;
+	return psBar->sRect.i16XMax - psBar->sRect.i16XMin - 1;
+}
+
+/**
+ * @brief Converts a value to a position along the bar
+ *
+ * @param psBar The bar
+ * @param i32Value The value to convert
+ * @return The number of positions filled by the value
+ *
+ * @note This function is not intended to be called by the user
+ */
+int16_t Bar_Position(const tBarMeter *psBar, int32_t i32Value) {
+	int16_t i16Length = Bar_Length(psBar);
+
+	if (i32Value <= 0 || psBar->i32Max <= 0)
+		return 0;
+	if (i32Value >= psBar->i32Max)
+		return i16Length;
+	return (i32Value * i16Length) / psBar->i32Max;
+}
+
+/**
+ * @brief Fills a range of positions along the inside of the bar
+ *
+ * @param psBar The bar
+ * @param psContext The graphics context
+ * @param i16From The first position to fill
+ * @param i16To The position after the last one to fill
+ * @param ui32Color The color to fill with
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Bar_Fill(const tBarMeter *psBar, tContext *psContext, int16_t i16From, int16_t i16To, uint32_t ui32Color) {
+	if (i16From >= i16To)
+		return;
+
+	tRectangle sStrip;
+	if (psBar->bVertical) {
+		sStrip = (tRectangle){psBar->sRect.i16XMin + 1, psBar->sRect.i16YMax - i16To, psBar->sRect.i16XMax - 1, psBar->sRect.i16YMax - 1 - i16From};
+	} else {
+		sStrip = (tRectangle){psBar->sRect.i16XMin + 1 + i16From, psBar->sRect.i16YMin + 1, psBar->sRect.i16XMin + i16To, psBar->sRect.i16YMax - 1};
+	}
+
+	GrContextForegroundSet(psContext, ui32Color);
+	GrRectFill(psContext, &sStrip);
+}
+
+/**
+ * @brief Converts a limit to the position of its marker
+ *
+ * @param psBar The bar
+ * @param i32Limit The limit to convert
+ * @return The position of the marker, always inside the bar
+ *
+ * @note This function is not intended to be called by the user
+ */
+int16_t Bar_MarkerPosition(const tBarMeter *psBar, int32_t i32Limit) {
+	int16_t i16Position = Bar_Position(psBar, i32Limit);
+	return i16Position < Bar_Length(psBar) ? i16Position : Bar_Length(psBar) - 1;
+}
+
+/**
+ * @brief Draws the limit marker or the bar behind it
+ *
+ * @param psBar The bar, with the level on screen
+ * @param psContext The graphics context
+ * @param i16Marker The position of the marker
+ * @param bShow True to draw the marker, false to draw the bar behind it
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Bar_Marker(const tBarMeter *psBar, tContext *psContext, int16_t i16Marker, bool bShow) {
+	uint32_t ui32Color = psBar->ui32Marker;
+	if (!bShow)
+		ui32Color = i16Marker < psBar->i16Level ? psBar->ui32Fill : psBar->ui32Empty;
+	Bar_Fill(psBar, psContext, i16Marker, i16Marker + 1, ui32Color);
+}
+#pragma endregion
+
+#pragma region Bar meter API functions
+/**
+ * @brief Draws a value and its limit, only the strip between the old and new level and a moved marker are redrawn
+ *
+ * @param psBar The bar to draw
+ * @param psContext The graphics context
+ * @param i32Value The value to show, clamped to the bar
+ * @param i32Limit The value to mark, clamped to the bar
+ *
+ * @note The first draw after a reset draws the whole bar
+ */
+void Bar_Draw(tBarMeter *psBar, tContext *psContext, int32_t i32Value, int32_t i32Limit) {
+	int16_t i16Level = Bar_Position(psBar, i32Value);
+	int16_t i16Marker = Bar_MarkerPosition(psBar, i32Limit);
+	bool bMarker = true;
+
+	if (!psBar->bValid) {
+		GrContextForegroundSet(psContext, psBar->ui32Outline);
+		GrRectDraw(psContext, &psBar->sRect);
+		Bar_Fill(psBar, psContext, 0, i16Level, psBar->ui32Fill);
+		Bar_Fill(psBar, psContext, i16Level, Bar_Length(psBar), psBar->ui32Empty);
+	} else {
+		/* Only the strip between the old and new level changes color */
+		int16_t i16Low = i16Level < psBar->i16Level ? i16Level : psBar->i16Level;
+		int16_t i16High = i16Level < psBar->i16Level ? psBar->i16Level : i16Level;
+		Bar_Fill(psBar, psContext, i16Low, i16High, i16Level > psBar->i16Level ? psBar->ui32Fill : psBar->ui32Empty);
+		psBar->i16Level = i16Level;
+
+		/* Put back what a moved marker covered, and redraw the marker if it moved or the strip painted over it */
+		if (i16Marker != psBar->i16Marker)
+			Bar_Marker(psBar, psContext, psBar->i16Marker, false);
+		else
+			bMarker = i16Marker >= i16Low && i16Marker < i16High;
+	}
+
+	if (bMarker)
+		Bar_Marker(psBar, psContext, i16Marker, true);
+
+	psBar->i16Level = i16Level;
+	psBar->i16Marker = i16Marker;
+	psBar->bValid = true;
+}
+
+/**
+ * @brief Forgets what is on screen so that the next draw redraws the whole bar
+ *
+ * @param psBar The bar to reset
+ */
+void Bar_Reset(tBarMeter *psBar) {
+	psBar->bValid = false;
+}
+#pragma endregion
@@ -0,0 +1,73 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+/**
+ * @brief A bar meter with a limit marker that only redraws the part of the bar that changed
+ *
+ */
+typedef struct tBarMeter {
+	/**
+	 * @brief The position of the bar, including its outline
+	 */
+	tRectangle sRect;
+	/**
+	 * @brief True to fill from the bottom up, false to fill from left to right
+	 */
+	bool bVertical;
+	/**
+	 * @brief The value of a full bar
+	 */
+	int32_t i32Max;
+	/**
+	 * @brief The colors of the filled part, the empty part, the limit marker and the outline
+	 */
+	uint32_t ui32Fill;
+	uint32_t ui32Empty;
+	uint32_t ui32Marker;
+	uint32_t ui32Outline;
+
+	/* Private state, filled in when drawn */
+	bool bValid;
+	int16_t i16Level;
+	int16_t i16Marker;
+} tBarMeter;
+
+/**
+ * @brief Statically initializes a bar meter
+ *
+ * @param x The x position of the bar
+ * @param y The y position of the bar
+ * @param width The width of the bar, including its outline
+ * @param height The height of the bar, including its outline
+ * @param vertical True to fill from the bottom up, false to fill from left to right
+ * @param max The value of a full bar
+ * @param fill The color of the filled part
+ * @param empty The color of the empty part
+ * @param marker The color of the limit marker
+ * @param outline The color of the outline
+ */
+#define BarMeter(x, y, width, height, vertical, max, fill, empty, marker, outline) \
+	{{(x), (y), (x) + (width)-1, (y) + (height)-1}, (vertical), (max), (fill), (empty), (marker), (outline), false, 0, 0}
+
+/**
+ * @brief Draws a value and its limit, only the strip between the old and new level and a moved marker are redrawn
+ *
+ * @param psBar The bar to draw
+ * @param psContext The graphics context
+ * @param i32Value The value to show, clamped to the bar
+ * @param i32Limit The value to mark, clamped to the bar
+ *
+ * @note The first draw after a reset draws the whole bar
+ */
+void Bar_Draw(tBarMeter *psBar, tContext *psContext, int32_t i32Value, int32_t i32Limit);
+
+/**
+ * @brief Forgets what is on screen so that the next draw redraws the whole bar
+ *
+ * @param psBar The bar to reset
+ *
+ * @note This should be called when the area behind the bar has been cleared
+ */
+void Bar_Reset(tBarMeter *psBar);
@@ -0,0 +1,223 @@
+#pragma region Includes
+#include "bus.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+
+#if defined(__TI_COMPILER_VERSION__)
+/* XDCtools header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+#else
+/* Host header files */
+#include <time.h>
+#endif
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#if defined(__TI_COMPILER_VERSION__)
+#define BUS_BARRIER() __asm(" dmb")
+#else
+#define BUS_BARRIER() __sync_synchronize()
+#endif
+
+/* The timestamp source can be overridden when built for host tests */
+#if !defined(BUS_TIMESTAMP) && defined(__TI_COMPILER_VERSION__)
+#define BUS_TIMESTAMP() Timestamp_get32()
+#elif !defined(BUS_TIMESTAMP)
+#define BUS_TIMESTAMP() Bus_HostTimestamp()
+#endif
+
+/**
+ * @brief Latest value of a topic, kept as two copies so a reader never waits on a preempted producer
+ *
+ */
+typedef struct tBusSlot {
+	volatile uint32_t ui32Seq;
+	volatile tBusSample sCopy[2];
+} tBusSlot;
+
+/**
+ * @brief Ring entry, the sequence is 2 * (n + 1) once sample n is complete
+ *
+ */
+typedef struct tBusEntry {
+	volatile uint32_t ui32Seq;
+	volatile tBusSample sSample;
+} tBusEntry;
+
+/**
+ * @brief History of a topic for consumers that need every sample
+ *
+ */
+typedef struct tBusRing {
+	volatile uint32_t ui32Head;
+	tBusEntry sEntries[BUS_RING_LENGTH];
+} tBusRing;
+
+/* Global constants */
+const bool gc_bBusRingEnabled[BUS_TOPIC_COUNT] = {true, true, false, true, false, false};
+
+/* Global variables */
+tBusSlot g_sBusSlots[BUS_TOPIC_COUNT];
+tBusRing g_sBusRings[BUS_TOPIC_COUNT];
+#pragma endregion
+
+#pragma region Internal functions
+#if !defined(__TI_COMPILER_VERSION__)
+/**
+ * @brief Gets a microsecond timestamp when built for the host
+ *
+ * @return The timestamp
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint32_t Bus_HostTimestamp() {
+	struct timespec sNow;
+	clock_gettime(CLOCK_MONOTONIC, &sNow);
+	return sNow.tv_sec * 1000000u + sNow.tv_nsec / 1000;
+}
+#endif
+
+/**
+ * @brief Appends a sample to the ring of a topic
+ *
+ * @param psRing The ring to append to
+ * @param psSample The sample to append
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Bus_RingAppend(tBusRing *psRing, const tBusSample *psSample) {
+	uint32_t ui32Head = psRing->ui32Head;
+	tBusEntry *psEntry = &psRing->sEntries[ui32Head % BUS_RING_LENGTH];
+
+	/* Odd while the entry is being rewritten */
+	psEntry->ui32Seq = 2 * ui32Head + 1;
+	BUS_BARRIER();
+	psEntry->sSample.ui32Timestamp = psSample->ui32Timestamp;
+	psEntry->sSample.i32Value = psSample->i32Value;
+	BUS_BARRIER();
+	psEntry->ui32Seq = 2 * (ui32Head + 1);
+	BUS_BARRIER();
+	psRing->ui32Head = ui32Head + 1;
+}
+#pragma endregion
+
+#pragma region Bus API functions
+/**
+ * @brief Publishes a sample on a topic
+ *
+ * @param eTopic The topic to publish on
+ * @param i32Value The value to publish
+ *
+ * @note Each topic must have a single producer, which may be a task, Swi or Hwi
+ */
+void Bus_Publish(tBusTopic eTopic, int32_t i32Value) {
+	if (eTopic >= BUS_TOPIC_COUNT)
+		return;
+
+	tBusSample sSample = {BUS_TIMESTAMP(), i32Value};
+	tBusSlot *psSlot = &g_sBusSlots[eTopic];
+
+	/* Readers use copy 1 while copy 0 is written, then copy 0 while copy 1 is written */
+	uint32_t ui32Seq = psSlot->ui32Seq;
+	psSlot->ui32Seq = ui32Seq + 1;
+	BUS_BARRIER();
+	psSlot->sCopy[0].ui32Timestamp = sSample.ui32Timestamp;
+	psSlot->sCopy[0].i32Value = sSample.i32Value;
+	BUS_BARRIER();
+	psSlot->ui32Seq = ui32Seq + 2;
+	BUS_BARRIER();
+	psSlot->sCopy[1].ui32Timestamp = sSample.ui32Timestamp;
+	psSlot->sCopy[1].i32Value = sSample.i32Value;
+
+	if (gc_bBusRingEnabled[eTopic])
+		Bus_RingAppend(&g_sBusRings[eTopic], &sSample);
+}
+
+/**
+ * @brief Reads the latest sample of a topic
+ *
+ * @param eTopic The topic to read
+ * @param psSample The latest sample
+ * @return True if the topic has been published at least once
+ *
+ * @note This function never waits on the producer and is safe to call from any context
+ */
+bool Bus_Read(tBusTopic eTopic, tBusSample *psSample) {
+	if (eTopic >= BUS_TOPIC_COUNT)
+		return false;
+
+	tBusSlot *psSlot = &g_sBusSlots[eTopic];
+	uint32_t ui32Seq;
+
+	/* Only retries if the producer ran during the copy, never while it is preempted */
+	do {
+		ui32Seq = psSlot->ui32Seq;
+		BUS_BARRIER();
+		psSample->ui32Timestamp = psSlot->sCopy[ui32Seq & 1].ui32Timestamp;
+		psSample->i32Value = psSlot->sCopy[ui32Seq & 1].i32Value;
+		BUS_BARRIER();
+	} while (ui32Seq != psSlot->ui32Seq);
+
+	return ui32Seq >= 2;
+}
+
+/**
+ * @brief Reads the samples of a topic published since the last call
+ *
+ * @param eTopic The topic to read, must have its ring enabled
+ * @param pui32Cursor The sequence number of the next sample to read, start at 0
+ * @param psSamples The samples read, oldest first
+ * @param ui32Max The maximum number of samples to read
+ * @param pui32Lost The number of samples that were overwritten before they could be read (optional)
+ * @return The number of samples read
+ *
+ * @note This function never waits on the producer and is safe to call from any context
+ */
+uint32_t Bus_ReadRing(tBusTopic eTopic, uint32_t *pui32Cursor, tBusSample *psSamples, uint32_t ui32Max, uint32_t *pui32Lost) {
+	uint32_t ui32Count = 0;
+	uint32_t ui32Lost = 0;
+
+	if (eTopic >= BUS_TOPIC_COUNT || !gc_bBusRingEnabled[eTopic]) {
+		if (pui32Lost != NULL)
+			*pui32Lost = 0;
+		return 0;
+	}
+
+	tBusRing *psRing = &g_sBusRings[eTopic];
+	uint32_t ui32Head = psRing->ui32Head;
+	BUS_BARRIER();
+
+	/* Skip the samples that have already been overwritten */
+	if (ui32Head - *pui32Cursor > BUS_RING_LENGTH) {
+		ui32Lost += ui32Head - *pui32Cursor - BUS_RING_LENGTH;
+		*pui32Cursor = ui32Head - BUS_RING_LENGTH;
+	}
+
+	while (*pui32Cursor != ui32Head && ui32Count < ui32Max) {
+		tBusEntry *psEntry = &psRing->sEntries[*pui32Cursor % BUS_RING_LENGTH];
+		uint32_t ui32Expected = 2 * (*pui32Cursor + 1);
+
+		uint32_t ui32Seq = psEntry->ui32Seq;
+		BUS_BARRIER();
+		psSamples[ui32Count].ui32Timestamp = psEntry->sSample.ui32Timestamp;
+		psSamples[ui32Count].i32Value = psEntry->sSample.i32Value;
+		BUS_BARRIER();
+
+		/* The producer lapped the reader during the copy */
+		if (ui32Seq != ui32Expected || psEntry->ui32Seq != ui32Expected)
+			ui32Lost++;
+		else
+			ui32Count++;
+
+		(*pui32Cursor)++;
+	}
+
+	if (pui32Lost != NULL)
+		*pui32Lost = ui32Lost;
+	return ui32Count;
+}
+#pragma endregion
@@ -0,0 +1,89 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define BUS_RING_LENGTH 32
+
+/**
+ * @brief Data bus topics
+ *
+ */
+typedef enum tBusTopic {
+	/**
+	 * @brief The current motor speed (RPM)
+	 */
+	BUS_TOPIC_SPEED = 0,
+	/**
+	 * @brief The current motor power (W)
+	 */
+	BUS_TOPIC_POWER,
+	/**
+	 * @brief The current light level (lux)
+	 */
+	BUS_TOPIC_LIGHT,
+	/**
+	 * @brief The current acceleration (m/s^2)
+	 */
+	BUS_TOPIC_ACCEL,
+	/**
+	 * @brief The current time (ticks)
+	 */
+	BUS_TOPIC_TIME,
+	/**
+	 * @brief The current e-stop state
+	 */
+	BUS_TOPIC_ESTOP,
+
+	BUS_TOPIC_COUNT
+} tBusTopic;
+
+/**
+ * @brief A timestamped sample published on the bus
+ *
+ */
+typedef struct tBusSample {
+	/**
+	 * @brief The time the sample was published (timestamp counts)
+	 */
+	uint32_t ui32Timestamp;
+	/**
+	 * @brief The value of the sample
+	 */
+	int32_t i32Value;
+} tBusSample;
+
+/**
+ * @brief Publishes a sample on a topic
+ *
+ * @param eTopic The topic to publish on
+ * @param i32Value The value to publish
+ *
+ * @note Each topic must have a single producer, which may be a task, Swi or Hwi
+ */
+void Bus_Publish(tBusTopic eTopic, int32_t i32Value);
+
+/**
+ * @brief Reads the latest sample of a topic
+ *
+ * @param eTopic The topic to read
+ * @param psSample The latest sample
+ * @return True if the topic has been published at least once
+ *
+ * @note This function never waits on the producer and is safe to call from any context
+ */
+bool Bus_Read(tBusTopic eTopic, tBusSample *psSample);
+
+/**
+ * @brief Reads the samples of a topic published since the last call
+ *
+ * @param eTopic The topic to read, must have its ring enabled
+ * @param pui32Cursor The sequence number of the next sample to read, start at 0
+ * @param psSamples The samples read, oldest first
+ * @param ui32Max The maximum number of samples to read
+ * @param pui32Lost The number of samples that were overwritten before they could be read (optional)
+ * @return The number of samples read
+ *
+ * @note This function never waits on the producer and is safe to call from any context
+ */
+uint32_t Bus_ReadRing(tBusTopic eTopic, uint32_t *pui32Cursor, tBusSample *psSamples, uint32_t ui32Max, uint32_t *pui32Lost);
@@ -0,0 +1,221 @@
+#pragma region Includes
+#include "commutation.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* XDCtools header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+
+/* BIOS header files */
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_gpio.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_pwm.h"
+#include "inc/hw_types.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define COMMUTATION_HALL_BASE GPIO_PORTD_BASE
+#define COMMUTATION_HALL_PINS (GPIO_PIN_4 | GPIO_PIN_5 | GPIO_PIN_6)
+#define COMMUTATION_HALL_SHIFT 4
+#define COMMUTATION_A_HIGH PWM_OUT_2_BIT
+#define COMMUTATION_A_LOW PWM_OUT_3_BIT
+#define COMMUTATION_B_HIGH PWM_OUT_0_BIT
+#define COMMUTATION_B_LOW PWM_OUT_1_BIT
+#define COMMUTATION_C_HIGH PWM_OUT_6_BIT
+#define COMMUTATION_C_LOW PWM_OUT_7_BIT
+
+/* Register access can be overridden when built for host tests */
+#ifndef COMMUTATION_HWREG
+#define COMMUTATION_HWREG(x) HWREG(x)
+#endif
+
+/* The Hall state is read straight from the pins, A in bit 0, B in bit 1 and C in bit 2. The pattern is written to the
+   output enables of PWM0 in one store, the outputs of generator 2 are not used */
+#define COMMUTATION_READ_HALL() \
+	((COMMUTATION_HWREG(COMMUTATION_HALL_BASE + GPIO_O_DATA + (COMMUTATION_HALL_PINS << 2)) >> COMMUTATION_HALL_SHIFT) & 0x7)
+#define COMMUTATION_WRITE_OUTPUTS(pattern) (COMMUTATION_HWREG(PWM0_BASE + PWM_O_ENABLE) = (pattern))
+
+/**
+ * @brief A PWM generator driving one phase of the bridge
+ *
+ */
+typedef struct tCommutationPhase {
+	uint32_t ui32Gen;
+	uint32_t ui32HighOut;
+	uint32_t ui32Port;
+	uint8_t ui8Pins;
+	uint32_t ui32HighPinConfig;
+	uint32_t ui32LowPinConfig;
+} tCommutationPhase;
+
+/* Global constants */
+const tCommutationPhase gc_sCommutationPhases[3] = {
+	{PWM_GEN_1, PWM_OUT_2, GPIO_PORTF_BASE, GPIO_PIN_2 | GPIO_PIN_3, GPIO_PF2_M0PWM2, GPIO_PF3_M0PWM3},
+	{PWM_GEN_0, PWM_OUT_0, GPIO_PORTF_BASE, GPIO_PIN_0 | GPIO_PIN_1, GPIO_PF0_M0PWM0, GPIO_PF1_M0PWM1},
+	{PWM_GEN_3, PWM_OUT_6, GPIO_PORTK_BASE, GPIO_PIN_4 | GPIO_PIN_5, GPIO_PK4_M0PWM6, GPIO_PK5_M0PWM7},
+};
+
+/**
+ * @brief Output enables of the bridge for each Hall state, one row per mode
+ *
+ * @note Turning forward, the Hall states follow 5, 1, 3, 2, 6, 4. Reverse swaps the high and the low side of each
+ *		 step. All low or all high is not a valid Hall state and opens every switch
+ */
+const uint8_t gc_ui8CommutationTable[COMMUTATION_MODE_COUNT][8] = {
+	[COMMUTATION_OFF] = {0},
+	[COMMUTATION_FORWARD] =
+		{
+			0,
+			COMMUTATION_A_HIGH | COMMUTATION_C_LOW, // 1
+			COMMUTATION_B_HIGH | COMMUTATION_A_LOW, // 2
+			COMMUTATION_B_HIGH | COMMUTATION_C_LOW, // 3
+			COMMUTATION_C_HIGH | COMMUTATION_B_LOW, // 4
+			COMMUTATION_A_HIGH | COMMUTATION_B_LOW, // 5
+			COMMUTATION_C_HIGH | COMMUTATION_A_LOW, // 6
+			0,
+		},
+	[COMMUTATION_REVERSE] =
+		{
+			0,
+			COMMUTATION_C_HIGH | COMMUTATION_A_LOW, // 1
+			COMMUTATION_A_HIGH | COMMUTATION_B_LOW, // 2
+			COMMUTATION_C_HIGH | COMMUTATION_B_LOW, // 3
+			COMMUTATION_B_HIGH | COMMUTATION_C_LOW, // 4
+			COMMUTATION_B_HIGH | COMMUTATION_A_LOW, // 5
+			COMMUTATION_A_HIGH | COMMUTATION_C_LOW, // 6
+			0,
+		},
+};
+
+/* Global variables */
+const uint8_t *volatile g_pui8CommutationRow = gc_ui8CommutationTable[COMMUTATION_OFF];
+tCommutationStats g_sCommutationStats;
+#pragma endregion
+
+#pragma region Commutation API functions
+/**
+ * @brief Initialize the PWM generators driving the bridge, with every switch open
+ *
+ * @param ui32SysClock The frequency of the system clock
+ *
+ * @note Phase A is driven by M0PWM2/3 (PF2/PF3), B by M0PWM0/1 (PF0/PF1) and C by M0PWM6/7 (PK4/PK5), high side
+ *		 first. M0PWM4/5 would come out on PG0/PG1, but PG1 is the backlight of the display. Must be called after
+ *		 Hall_Init, which owns the Hall sensor pins
+ */
+void Commutation_Init(uint32_t ui32SysClock) {
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_PWM0);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOF);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOK);
+
+	/* Every switch stays open until the first pattern is written */
+	PWMOutputState(PWM0_BASE, COMMUTATION_A_HIGH | COMMUTATION_A_LOW | COMMUTATION_B_HIGH | COMMUTATION_B_LOW |
+								  COMMUTATION_C_HIGH | COMMUTATION_C_LOW, false);
+	PWMClockSet(PWM0_BASE, PWM_SYSCLK_DIV_1);
+
+	for (uint8_t i = 0; i < 3; i++) {
+		const tCommutationPhase *psPhase = &gc_sCommutationPhases[i];
+		GPIOPinConfigure(psPhase->ui32HighPinConfig);
+		GPIOPinConfigure(psPhase->ui32LowPinConfig);
+		GPIOPinTypePWM(psPhase->ui32Port, psPhase->ui8Pins);
+
+		/* The high side chops at the duty cycle, the low side is held on for the whole step */
+		PWMGenConfigure(PWM0_BASE, psPhase->ui32Gen, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC);
+		PWMGenPeriodSet(PWM0_BASE, psPhase->ui32Gen, ui32SysClock / COMMUTATION_PWM_FREQ);
+		COMMUTATION_HWREG(PWM0_BASE + psPhase->ui32Gen + PWM_O_X_GENB) = PWM_X_GENB_ACTLOAD_ONE | PWM_X_GENB_ACTZERO_ONE;
+		PWMGenEnable(PWM0_BASE, psPhase->ui32Gen);
+	}
+	Commutation_SetDuty(0);
+
+	/* The phases switch together */
+	PWMSyncTimeBase(PWM0_BASE, PWM_GEN_0_BIT | PWM_GEN_1_BIT | PWM_GEN_3_BIT);
+}
+
+/**
+ * @brief Commutates the bridge to the state of the Hall sensors
+ *
+ * @param ui32Entry The time the calling interrupt was entered
+ *
+ * @note Called first thing by the Hall capture interrupt. Runs in constant time, the direction and the stop are
+ *		 part of the table it reads
+ */
+void Commutation_Edge(uint32_t ui32Entry) {
+	uint8_t ui8State = COMMUTATION_READ_HALL();
+	COMMUTATION_WRITE_OUTPUTS(g_pui8CommutationRow[ui8State]);
+	uint32_t ui32Latency = Timestamp_get32() - ui32Entry;
+
+	/* The bridge is switched, the rest only keeps count */
+	tCommutationStats *psStats = &g_sCommutationStats;
+	uint32_t ui32Bin = ui32Latency >> COMMUTATION_HISTOGRAM_SHIFT;
+	psStats->pui32Latency[ui32Bin < COMMUTATION_HISTOGRAM_BINS ? ui32Bin : COMMUTATION_HISTOGRAM_BINS - 1]++;
+	if (ui32Latency > psStats->ui32WorstLatency)
+		psStats->ui32WorstLatency = ui32Latency;
+	if (ui8State == 0 || ui8State == 7)
+		psStats->ui32Faults++;
+	psStats->ui32Commutations++;
+}
+
+/**
+ * @brief Sets the duty cycle of the high side switches
+ *
+ * @param i32Duty The duty cycle (0 to COMMUTATION_DUTY_MAX)
+ *
+ * @note The compare registers are loaded when the generators count through 0, a new duty starts with the next
+ *		 PWM period. A duty of 0 leaves a pulse of one PWM clock, too short for the gate drivers to follow
+ */
+void Commutation_SetDuty(int32_t i32Duty) {
+	if (i32Duty < 0)
+		i32Duty = 0;
+	else if (i32Duty > COMMUTATION_DUTY_MAX)
+		i32Duty = COMMUTATION_DUTY_MAX;
+
+	uint32_t ui32Period = PWMGenPeriodGet(PWM0_BASE, PWM_GEN_1);
+	uint32_t ui32Width = (uint32_t)i32Duty * ui32Period / (COMMUTATION_DUTY_MAX + 1);
+	if (ui32Width == 0)
+		ui32Width = 1;
+
+	for (uint8_t i = 0; i < 3; i++)
+		PWMPulseWidthSet(PWM0_BASE, gc_sCommutationPhases[i].ui32HighOut, ui32Width);
+}
+
+/**
+ * @brief Sets the direction of the commutation, or stops it
+ *
+ * @param eMode The direction, or COMMUTATION_OFF to open every switch
+ *
+ * @note Takes effect at once rather than on the next Hall edge, which never comes for a motor at rest
+ */
+void Commutation_SetMode(tCommutationMode eMode) {
+	if (eMode >= COMMUTATION_MODE_COUNT)
+		eMode = COMMUTATION_OFF;
+
+	/* The Hall interrupt must not write the old row after the new one */
+	UInt uiKey = Hwi_disable();
+	g_pui8CommutationRow = gc_ui8CommutationTable[eMode];
+	COMMUTATION_WRITE_OUTPUTS(g_pui8CommutationRow[COMMUTATION_READ_HALL()]);
+	Hwi_restore(uiKey);
+}
+
+/**
+ * @brief Gets the statistics of the commutation interrupt
+ *
+ * @param psStats The statistics to copy into
+ */
+void Commutation_GetStats(tCommutationStats *psStats) {
+	UInt uiKey = Hwi_disable();
+	*psStats = g_sCommutationStats;
+	Hwi_restore(uiKey);
+}
+#pragma endregion
@@ -0,0 +1,97 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define COMMUTATION_DUTY_MAX 32767
+#define COMMUTATION_HISTOGRAM_BINS 16
+
+/**
+ * @brief Directions the bridge can be commutated in
+ *
+ */
+typedef enum tCommutationMode {
+	/**
+	 * @brief Every switch open, the motor coasts
+	 */
+	COMMUTATION_OFF = 0,
+	/**
+	 * @brief Six-step commutation in the forward direction
+	 */
+	COMMUTATION_FORWARD,
+	/**
+	 * @brief Six-step commutation in the reverse direction
+	 */
+	COMMUTATION_REVERSE,
+
+	COMMUTATION_MODE_COUNT
+} tCommutationMode;
+
+/**
+ * @brief Statistics of the commutation interrupt
+ *
+ * @note Latencies are in timestamp counts, see Timestamp_getFreq
+ */
+typedef struct tCommutationStats {
+	/**
+	 * @brief The number of patterns written by the Hall interrupt
+	 */
+	uint32_t ui32Commutations;
+	/**
+	 * @brief The number of times the Hall sensors read all low or all high, which opens every switch
+	 */
+	uint32_t ui32Faults;
+	/**
+	 * @brief The longest time from the entry of the Hall interrupt to the pattern reaching the bridge
+	 */
+	uint32_t ui32WorstLatency;
+	/**
+	 * @brief The number of commutations by latency, 1 << COMMUTATION_HISTOGRAM_SHIFT counts per bin. The last bin
+	 *		  also holds every longer latency
+	 */
+	uint32_t pui32Latency[COMMUTATION_HISTOGRAM_BINS];
+} tCommutationStats;
+
+/**
+ * @brief Initialize the PWM generators driving the bridge, with every switch open
+ *
+ * @param ui32SysClock The frequency of the system clock
+ *
+ * @note Phase A is driven by M0PWM2/3 (PF2/PF3), B by M0PWM0/1 (PF0/PF1) and C by M0PWM6/7 (PK4/PK5), high side
+ *		 first. M0PWM4/5 would come out on PG0/PG1, but PG1 is the backlight of the display. Must be called after
+ *		 Hall_Init, which owns the Hall sensor pins
+ */
+void Commutation_Init(uint32_t ui32SysClock);
+
+/**
+ * @brief Commutates the bridge to the state of the Hall sensors
+ *
+ * @param ui32Entry The time the calling interrupt was entered
+ *
+ * @note Called first thing by the Hall capture interrupt. Runs in constant time, the direction and the stop are
+ *		 part of the table it reads
+ */
+void Commutation_Edge(uint32_t ui32Entry);
+
+/**
+ * @brief Sets the duty cycle of the high side switches
+ *
+ * @param i32Duty The duty cycle (0 to COMMUTATION_DUTY_MAX)
+ */
+void Commutation_SetDuty(int32_t i32Duty);
+
+/**
+ * @brief Sets the direction of the commutation, or stops it
+ *
+ * @param eMode The direction, or COMMUTATION_OFF to open every switch
+ *
+ * @note Takes effect at once rather than on the next Hall edge, which never comes for a motor at rest
+ */
+void Commutation_SetMode(tCommutationMode eMode);
+
+/**
+ * @brief Gets the statistics of the commutation interrupt
+ *
+ * @param psStats The statistics to copy into
+ */
+void Commutation_GetStats(tCommutationStats *psStats);
@@ -1,8 +1,36 @@
 #pragma once
 
 #define NIGHT_LIGHT_THRESHOLD 5
-#define GUI_PULSE_PERIOD 100
+#define NIGHT_LIGHT_HYSTERESIS 2 // The light must rise this far above the threshold to end the night (lux)
+#define GUI_PULSE_PERIOD 50
+#define GUI_GRAPH_PERIOD 100
+#define GUI_FRAME_PERIOD 40
+#define GUI_FRAME_BUDGET 8000 // us
+#define GUI_OVERLAY_HOLD 1000
+#define GUI_OVERLAY_PERIOD 1000
+#define GUI_OVERLAY_TASK_COUNT 4
+#define MOTOR_CONTROL_RATE 1000
+#define MOTOR_JERK_TIME 100 // The speed reference reaches the max acceleration in this long (ms)
+#define HALL_POLE_PAIRS 4
+#define HALL_WINDOW 6 // Edge periods averaged, a whole electrical turn cancels the placement error of the sensors
+#define HALL_LATE_GAP 125 // The longest edge gap at a steady speed, with the placement error of the sensors (% of the mean)
+#define HALL_TIMEOUT 500 // No edge for this long reads as stopped, the slowest speed is 60000 / (6 * HALL_POLE_PAIRS * HALL_TIMEOUT) RPM
+#define HALL_PUBLISH_PERIOD 1
+#define HALL_HWI_PRIORITY 0x20 // The highest priority BIOS still masks, above every other interrupt
+#define COMMUTATION_PWM_FREQ 20000 // Hz
+#define COMMUTATION_HISTOGRAM_SHIFT 4 // Latency bins of 16 timestamp counts
+#define POWER_SAMPLE_RATE 8192 // Hz per channel, not a divisor of COMMUTATION_PWM_FREQ so the samples walk across the PWM period
+#define POWER_BLOCK 64 // Samples of each channel per block, a multiple of DECIMATOR_RATIO
+#define POWER_CURRENT_ZERO 2048 // ADC code of the current sensor at no current
+#define POWER_CURRENT_FULL 20000 // Current that moves the reading 2048 codes from the zero (mA)
+#define POWER_VOLTAGE_FULL 33000 // Supply voltage at a full scale reading, behind the divider (mV)
+#define LIGHT_AVERAGE 8 // Conversions in the moving average of the light, one every 100 ms
+#define LIGHT_WATCHDOG 500 // The light sensor is read if its interrupt has not fired for this long (ms)
 #define MAX_SPEED 255
 #define MAX_POWER 255
 #define MAX_LIGHT 255
 #define MAX_ACCEL 255
+
+/* RAM set aside for the graph history, each channel takes the depth of its graph channel entry on every level (bytes).
+   Eight channels keep a full plot of 240 buckets */
+#define HISTORY_RAM_BUDGET 24576
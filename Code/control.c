@@ -0,0 +1,318 @@
+#pragma region Includes
+#include "control.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define CONTROL_INTEGRAL_SHIFT 8
+#define CONTROL_SCURVE_SHIFT 24
+#define CONTROL_SCURVE_SEARCH 4 // Steps the ramps of a plan may be lengthened by to land on whole steps
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Limits a value to a range
+ *
+ * @param i32Value The value
+ * @param i32Min The lowest value
+ * @param i32Max The highest value
+ * @return The limited value
+ *
+ * @note This function is not intended to be called by the user
+ */
+int32_t Control_Clamp(int32_t i32Value, int32_t i32Min, int32_t i32Max) {
+	if (i32Value < i32Min)
+		return i32Min;
+	if (i32Value > i32Max)
+		return i32Max;
+	return i32Value;
+}
+
+/**
+ * @brief Multiplies by a Q16 gain and drops fractional bits
+ *
+ * @param i32Gain The gain (Q16)
+ * @param i32Value The value
+ * @param ui8Shift The number of fractional bits to drop, 16 for an integer result
+ * @return The product, saturated to 32 bits
+ *
+ * @note This function is not intended to be called by the user
+ */
+int32_t Control_Multiply(int32_t i32Gain, int32_t i32Value, uint8_t ui8Shift) {
+	int64_t i64Product = ((int64_t)i32Gain * i32Value) >> ui8Shift;
+	if (i64Product > INT32_MAX)
+		return INT32_MAX;
+	if (i64Product < INT32_MIN)
+		return INT32_MIN;
+	return (int32_t)i64Product;
+}
+
+/**
+ * @brief Finds the integer square root
+ *
+ * @param ui64Value The value
+ * @return The square root, rounded down
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint32_t Control_Sqrt(uint64_t ui64Value) {
+	uint64_t ui64Root = 0;
+	uint64_t ui64Bit = (uint64_t)1 << 62;
+	while (ui64Bit > ui64Value)
+		ui64Bit >>= 2;
+
+	while (ui64Bit != 0) {
+		if (ui64Value >= ui64Root + ui64Bit) {
+			ui64Value -= ui64Root + ui64Bit;
+			ui64Root = (ui64Root >> 1) + ui64Bit;
+		} else {
+			ui64Root >>= 1;
+		}
+		ui64Bit >>= 2;
+	}
+	return (uint32_t)ui64Root;
+}
+
+/**
+ * @brief Divides and rounds up
+ *
+ * @param i64Numerator The numerator
+ * @param i64Denominator The denominator, above 0
+ * @return The quotient rounded up, 0 for a numerator of 0 or below
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint32_t Control_DivideUp(int64_t i64Numerator, int64_t i64Denominator) {
+	return i64Numerator > 0 ? (uint32_t)((i64Numerator + i64Denominator - 1) / i64Denominator) : 0;
+}
+
+/**
+ * @brief Appends a segment to an S-curve
+ *
+ * @param psCurve The planner
+ * @param ui32Steps The length of the segment, nothing is appended for 0
+ * @param i32Delta The change of acceleration over the segment (Q24)
+ *
+ * @note The jerk is rounded down and the remainder spread over the steps, so the segment ends exactly on its
+ *		 acceleration and no step changes it by more than the rounded-up jerk
+ * @note This function is not intended to be called by the user
+ */
+void Control_SCurveAppend(tControlSCurve *psCurve, uint32_t ui32Steps, int32_t i32Delta) {
+	if (ui32Steps == 0)
+		return;
+
+	tControlSegment *psSegment = &psCurve->psSegments[psCurve->ui8Segments++];
+	int32_t i32Jerk = i32Delta / (int32_t)ui32Steps;
+	if (i32Jerk * (int32_t)ui32Steps > i32Delta)
+		i32Jerk--;
+	psSegment->ui32Steps = ui32Steps;
+	psSegment->i32Jerk = i32Jerk;
+	psSegment->ui32Remainder = (uint32_t)(i32Delta - i32Jerk * (int32_t)ui32Steps);
+}
+#pragma endregion
+
+#pragma region Control API functions
+/**
+ * @brief Runs one step of a PI controller
+ *
+ * @param psPI The controller
+ * @param i32Error The setpoint minus the measurement
+ * @return The output, within the output limits
+ *
+ * @note The integral stops growing while the output is saturated in the direction of the error
+ */
+int32_t Control_PIStep(tControlPI *psPI, int32_t i32Error) {
+	int32_t i32Proportional = Control_Multiply(psPI->i32Kp, i32Error, 16);
+	int32_t i32Increment = Control_Multiply(psPI->i32Ki, i32Error, 16 - CONTROL_INTEGRAL_SHIFT);
+
+	/* Only integrate while it can bring the output back inside the limits */
+	if (psPI->i8Saturated == 0 || (psPI->i8Saturated > 0) != (i32Increment > 0)) {
+		psPI->i32Integral = Control_Clamp(psPI->i32Integral + Control_Clamp(i32Increment, -(1 << 30), 1 << 30),
+										  psPI->i32OutMin << CONTROL_INTEGRAL_SHIFT, psPI->i32OutMax << CONTROL_INTEGRAL_SHIFT);
+	}
+
+	int64_t i64Output = (int64_t)i32Proportional + (psPI->i32Integral >> CONTROL_INTEGRAL_SHIFT);
+	if (i64Output > psPI->i32OutMax) {
+		psPI->i8Saturated = 1;
+		return psPI->i32OutMax;
+	}
+	if (i64Output < psPI->i32OutMin) {
+		psPI->i8Saturated = -1;
+		return psPI->i32OutMin;
+	}
+
+	psPI->i8Saturated = 0;
+	return (int32_t)i64Output;
+}
+
+/**
+ * @brief Changes the output limits of a PI controller
+ *
+ * @param psPI The controller
+ * @param i32OutMin The lowest output
+ * @param i32OutMax The highest output
+ *
+ * @note The integral is clamped to the new limits, so a lower limit takes effect without delay
+ */
+void Control_PISetLimits(tControlPI *psPI, int32_t i32OutMin, int32_t i32OutMax) {
+	psPI->i32OutMin = i32OutMin;
+	psPI->i32OutMax = i32OutMax;
+	psPI->i32Integral = Control_Clamp(psPI->i32Integral, i32OutMin << CONTROL_INTEGRAL_SHIFT, i32OutMax << CONTROL_INTEGRAL_SHIFT);
+}
+
+/**
+ * @brief Clears the integral of a PI controller
+ *
+ * @param psPI The controller
+ * @param i32Output The output the integral starts from, for a bumpless start
+ */
+void Control_PIReset(tControlPI *psPI, int32_t i32Output) {
+	psPI->i32Integral = Control_Clamp(i32Output, psPI->i32OutMin, psPI->i32OutMax) << CONTROL_INTEGRAL_SHIFT;
+	psPI->i8Saturated = 0;
+}
+
+/**
+ * @brief Plans the S-curve from the current value and change per step to a new target
+ *
+ * @param psCurve The planner
+ * @param i32Target The target, within +/-32767
+ * @param i32MaxAccel The largest change per step (Q24, within 2^27)
+ * @param i32MaxJerk The largest change of the change per step (Q24, within i32MaxAccel)
+ *
+ * @note The segments are rounded up to whole steps and the peak acceleration lowered to land on the target,
+ *		 so the limits hold at every step. A target just past where the value can stop may not land on whole
+ *		 steps, the value then stops as soon as it can and the last step takes up the rest, less than half a
+ *		 step at the current acceleration
+ * @note Planning runs an integer square root and a short search, call it when the target or the limits change
+ *		 rather than every step
+ */
+void Control_SCurvePlan(tControlSCurve *psCurve, int32_t i32Target, int32_t i32MaxAccel, int32_t i32MaxJerk) {
+	psCurve->i32Target = i32Target;
+	psCurve->ui8Segments = 0;
+	psCurve->ui8Segment = 0;
+	psCurve->ui32Step = 0;
+	psCurve->ui32Fraction = 0;
+	if (i32MaxAccel <= 0 || i32MaxJerk <= 0) {
+		psCurve->i32Accel = 0;
+		return;
+	}
+
+	/* Head for the target from where the value stops if the acceleration is brought to 0 right away, then work
+	   in the direction of travel */
+	int64_t i64Jerk = i32MaxJerk;
+	int64_t i64Start = psCurve->i32Accel;
+	uint32_t ui32Stop = Control_DivideUp(i64Start < 0 ? -i64Start : i64Start, i64Jerk);
+	int64_t i64Stop = psCurve->i64Value + i64Start * ui32Stop / 2;
+	int64_t i64Target = (int64_t)i32Target << CONTROL_SCURVE_SHIFT;
+	int8_t i8Sign = i64Target >= i64Stop ? 1 : -1;
+	i64Start *= i8Sign;
+	int64_t i64Distance = i8Sign * (i64Target - psCurve->i64Value);
+
+	/* The peak of a profile without a hold at the max acceleration satisfies peak^2 = J D + a0^2 / 2 (Q40) */
+	int64_t i64Square = i64Jerk * (i64Distance >> 8) + ((i64Start * i64Start) >> 9);
+	int64_t i64Peak = i64Square > 0 ? (int64_t)Control_Sqrt(i64Square) << 4 : 0;
+	if (i64Peak > i32MaxAccel)
+		i64Peak = i32MaxAccel;
+
+	uint32_t ui32Rise = Control_DivideUp(i64Peak > i64Start ? i64Peak - i64Start : i64Start - i64Peak, i64Jerk);
+	uint32_t ui32Hold = 0;
+	uint32_t ui32Fall = Control_DivideUp(i64Peak, i64Jerk);
+
+	/* Round the ramps up to whole steps, lengthening them a step at a time until some whole number of steps at
+	   a lower peak lands on the target within the limits */
+	bool bFound = false;
+	for (uint8_t i = 0; i <= CONTROL_SCURVE_SEARCH && !bFound; i++) {
+		for (uint8_t j = 0; j <= i && !bFound; j++) {
+			int64_t i64Up = ui32Rise + j;
+			int64_t i64Down = ui32Fall + i - j;
+			int64_t i64Low = i64Start - i64Jerk * i64Up > 0 ? i64Start - i64Jerk * i64Up : 0;
+			int64_t i64High = i64Start + i64Jerk * i64Up;
+			if (i64High > i64Jerk * i64Down)
+				i64High = i64Jerk * i64Down;
+			if (i64High > i32MaxAccel)
+				i64High = i32MaxAccel;
+			int64_t i64Area = 2 * i64Distance - i64Start * i64Up;
+			if (i64High <= 0 || i64High < i64Low || i64Area <= 0)
+				continue;
+
+			/* The shortest hold that keeps the peak under the limits */
+			int64_t i64Steps = i64Up + i64Down + 2 * (int64_t)Control_DivideUp(i64Area - i64High * (i64Up + i64Down), 2 * i64High);
+			int64_t i64Fit = i64Area / i64Steps;
+			if (i64Fit >= i64Low) {
+				ui32Rise = (uint32_t)i64Up;
+				ui32Hold = (uint32_t)((i64Steps - i64Up - i64Down) / 2);
+				ui32Fall = (uint32_t)i64Down;
+				i64Peak = i64Fit;
+				bFound = true;
+			}
+		}
+	}
+
+	if (!bFound) {
+		/* Just short of one more step of the stop, bring the acceleration down now and let the end of the plan take
+		   up the rest, less than half a step at the current acceleration */
+		ui32Rise = 0;
+		ui32Hold = 0;
+		ui32Fall = ui32Stop;
+		i64Peak = i64Start;
+	}
+
+	Control_SCurveAppend(psCurve, ui32Rise, (int32_t)(i8Sign * (i64Peak - i64Start)));
+	Control_SCurveAppend(psCurve, ui32Hold, 0);
+	Control_SCurveAppend(psCurve, ui32Fall, (int32_t)(-i8Sign * i64Peak));
+	if (psCurve->ui8Segments == 0) {
+		/* Closer than the smallest step */
+		psCurve->i64Value = i64Target;
+		psCurve->i32Accel = 0;
+	}
+}
+
+/**
+ * @brief Moves an S-curve one step along its plan
+ *
+ * @param psCurve The planner
+ * @return The new value
+ */
+int32_t Control_SCurveStep(tControlSCurve *psCurve) {
+	if (psCurve->ui8Segment < psCurve->ui8Segments) {
+		const tControlSegment *psSegment = &psCurve->psSegments[psCurve->ui8Segment];
+		int32_t i32Last = psCurve->i32Accel;
+		psCurve->i32Accel += psSegment->i32Jerk;
+		psCurve->ui32Fraction += psSegment->ui32Remainder;
+		if (psCurve->ui32Fraction >= psSegment->ui32Steps) {
+			psCurve->ui32Fraction -= psSegment->ui32Steps;
+			psCurve->i32Accel++;
+		}
+		psCurve->i64Value += ((int64_t)i32Last + psCurve->i32Accel) >> 1;
+
+		if (++psCurve->ui32Step == psSegment->ui32Steps) {
+			psCurve->ui32Step = 0;
+			psCurve->ui32Fraction = 0;
+			if (++psCurve->ui8Segment == psCurve->ui8Segments) {
+				/* Drop the rounding of the steps */
+				psCurve->i64Value = (int64_t)psCurve->i32Target << CONTROL_SCURVE_SHIFT;
+				psCurve->i32Accel = 0;
+			}
+		}
+	}
+	return (int32_t)(psCurve->i64Value >> CONTROL_SCURVE_SHIFT);
+}
+
+/**
+ * @brief Sets the value of an S-curve at rest, dropping its plan
+ *
+ * @param psCurve The planner
+ * @param i32Value The value
+ */
+void Control_SCurveReset(tControlSCurve *psCurve, int32_t i32Value) {
+	psCurve->i64Value = (int64_t)i32Value << CONTROL_SCURVE_SHIFT;
+	psCurve->i32Accel = 0;
+	psCurve->i32Target = i32Value;
+	psCurve->ui8Segments = 0;
+	psCurve->ui8Segment = 0;
+}
+#pragma endregion
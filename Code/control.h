@@ -0,0 +1,137 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief A fixed-point PI controller with conditional integration against windup
+ *
+ */
+typedef struct tControlPI {
+	/**
+	 * @brief The proportional gain, output counts per unit of error (Q16)
+	 */
+	int32_t i32Kp;
+	/**
+	 * @brief The integral gain, output counts per unit of error per step (Q16)
+	 */
+	int32_t i32Ki;
+	/**
+	 * @brief The lowest output (counts, within +/-2^22)
+	 */
+	int32_t i32OutMin;
+	/**
+	 * @brief The highest output (counts, within +/-2^22)
+	 */
+	int32_t i32OutMax;
+
+	/* Private state, filled in by the controller */
+	int32_t i32Integral; // Q8 output counts
+	int8_t i8Saturated;	 // 1 at the highest output, -1 at the lowest
+} tControlPI;
+
+/**
+ * @brief One segment of an S-curve, a constant jerk for a whole number of steps
+ *
+ */
+typedef struct tControlSegment {
+	uint32_t ui32Steps;
+	int32_t i32Jerk;		 // Q24 per step per step, rounded down
+	uint32_t ui32Remainder; // What the rounding left out over the segment, spread across its steps
+} tControlSegment;
+
+/**
+ * @brief A setpoint planner that moves a value to a target along a jerk-limited S-curve
+ *
+ */
+typedef struct tControlSCurve {
+	/**
+	 * @brief The current value (Q24)
+	 */
+	int64_t i64Value;
+	/**
+	 * @brief The current change per step (Q24)
+	 */
+	int32_t i32Accel;
+
+	/* Private state, filled in by the planner */
+	int32_t i32Target;
+	tControlSegment psSegments[3]; // Jerk towards the peak acceleration, hold it, jerk back to 0
+	uint8_t ui8Segments;
+	uint8_t ui8Segment;
+	uint32_t ui32Step;
+	uint32_t ui32Fraction;
+} tControlSCurve;
+
+/**
+ * @brief Statically initializes a PI controller
+ *
+ * @param kp The proportional gain (Q16)
+ * @param ki The integral gain (Q16)
+ * @param min The lowest output
+ * @param max The highest output
+ */
+#define ControlPI(kp, ki, min, max) \
+	{(kp), (ki), (min), (max), 0, 0}
+
+/**
+ * @brief Runs one step of a PI controller
+ *
+ * @param psPI The controller
+ * @param i32Error The setpoint minus the measurement
+ * @return The output, within the output limits
+ *
+ * @note The integral stops growing while the output is saturated in the direction of the error
+ */
+int32_t Control_PIStep(tControlPI *psPI, int32_t i32Error);
+
+/**
+ * @brief Changes the output limits of a PI controller
+ *
+ * @param psPI The controller
+ * @param i32OutMin The lowest output
+ * @param i32OutMax The highest output
+ *
+ * @note The integral is clamped to the new limits, so a lower limit takes effect without delay
+ */
+void Control_PISetLimits(tControlPI *psPI, int32_t i32OutMin, int32_t i32OutMax);
+
+/**
+ * @brief Clears the integral of a PI controller
+ *
+ * @param psPI The controller
+ * @param i32Output The output the integral starts from, for a bumpless start
+ */
+void Control_PIReset(tControlPI *psPI, int32_t i32Output);
+
+/**
+ * @brief Plans the S-curve from the current value and change per step to a new target
+ *
+ * @param psCurve The planner
+ * @param i32Target The target, within +/-32767
+ * @param i32MaxAccel The largest change per step (Q24, within 2^27)
+ * @param i32MaxJerk The largest change of the change per step (Q24, within i32MaxAccel)
+ *
+ * @note The segments are rounded up to whole steps and the peak acceleration lowered to land on the target,
+ *		 so the limits hold at every step. A target just past where the value can stop may not land on whole
+ *		 steps, the value then stops as soon as it can and the last step takes up the rest, less than half a
+ *		 step at the current acceleration
+ * @note Planning runs an integer square root and a short search, call it when the target or the limits change
+ *		 rather than every step
+ */
+void Control_SCurvePlan(tControlSCurve *psCurve, int32_t i32Target, int32_t i32MaxAccel, int32_t i32MaxJerk);
+
+/**
+ * @brief Moves an S-curve one step along its plan
+ *
+ * @param psCurve The planner
+ * @return The new value
+ */
+int32_t Control_SCurveStep(tControlSCurve *psCurve);
+
+/**
+ * @brief Sets the value of an S-curve at rest, dropping its plan
+ *
+ * @param psCurve The planner
+ * @param i32Value The value
+ */
+void Control_SCurveReset(tControlSCurve *psCurve, int32_t i32Value);
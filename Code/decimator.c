@@ -0,0 +1,101 @@
+#pragma region Includes
+#include "decimator.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define DECIMATOR_CIC_SHIFT 15 // log2 of the CIC gain
+#define DECIMATOR_FIR_SHIFT 15
+#define DECIMATOR_OUTPUT_SHIFT (DECIMATOR_CIC_SHIFT + DECIMATOR_FIR_SHIFT - DECIMATOR_SHIFT)
+#define DECIMATOR_CENTRE (DECIMATOR_TAPS / 2)
+
+#if (1 << DECIMATOR_CIC_SHIFT) != DECIMATOR_CIC_RATIO * DECIMATOR_CIC_RATIO * DECIMATOR_CIC_RATIO
+#error "DECIMATOR_CIC_SHIFT must match the gain of the CIC filter"
+#endif
+
+/* Global constants */
+/* Least squares fit to the inverse of the CIC response in the passband and to 0 in the stopband, Q15 and summing to
+   exactly 1. The taps are symmetric, only the first half and the centre are stored */
+const int32_t gc_i32DecimatorTaps[DECIMATOR_CENTRE + 1] = {-96, -438, -870, -652, 1128, 4496, 7987, 9658};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Runs the FIR filter over the latest CIC outputs
+ *
+ * @param psDecimator The decimator
+ * @return The filtered value (Q DECIMATOR_SHIFT)
+ *
+ * @note This function is not intended to be called by the user
+ */
+int32_t Decimator_Filter(const tDecimator *psDecimator) {
+	const int32_t *pi32Window = &psDecimator->pi32History[psDecimator->ui8Head];
+	int64_t i64Sum = (int64_t)gc_i32DecimatorTaps[DECIMATOR_CENTRE] * pi32Window[DECIMATOR_CENTRE];
+
+	/* Fold the symmetric taps, half the multiplies */
+	for (uint8_t i = 0; i < DECIMATOR_CENTRE; i++)
+		i64Sum += gc_i32DecimatorTaps[i] * ((int64_t)pi32Window[i] + pi32Window[DECIMATOR_TAPS - 1 - i]);
+
+	return (int32_t)((i64Sum + (1 << (DECIMATOR_OUTPUT_SHIFT - 1))) >> DECIMATOR_OUTPUT_SHIFT);
+}
+#pragma endregion
+
+#pragma region Decimator API functions
+/**
+ * @brief Clears the state of a decimator
+ *
+ * @param psDecimator The decimator
+ */
+void Decimator_Reset(tDecimator *psDecimator) {
+	memset(psDecimator, 0, sizeof(*psDecimator));
+}
+
+/**
+ * @brief Feeds one sample to a decimator
+ *
+ * @param psDecimator The decimator
+ * @param i32Sample The sample (within +/-DECIMATOR_INPUT_MAX)
+ * @param pi32Output The filtered value, written every DECIMATOR_RATIO samples (Q DECIMATOR_SHIFT)
+ * @return True if an output was written
+ *
+ * @note This function does not access the hardware and can be used on the host
+ */
+bool Decimator_Push(tDecimator *psDecimator, int32_t i32Sample, int32_t *pi32Output) {
+	/* The integrators run at the input rate, modulo 2^32 */
+	uint32_t *pui32Integrators = psDecimator->pui32Integrators;
+	uint32_t ui32Value = (uint32_t)i32Sample;
+	for (uint8_t i = 0; i < DECIMATOR_ORDER; i++) {
+		pui32Integrators[i] += ui32Value;
+		ui32Value = pui32Integrators[i];
+	}
+
+	psDecimator->ui8Phase++;
+	if (psDecimator->ui8Phase % DECIMATOR_CIC_RATIO != 0)
+		return false;
+
+	/* The combs run at the CIC output rate, the differences undo the wrap around */
+	for (uint8_t i = 0; i < DECIMATOR_ORDER; i++) {
+		uint32_t ui32Previous = psDecimator->pui32Combs[i];
+		psDecimator->pui32Combs[i] = ui32Value;
+		ui32Value -= ui32Previous;
+	}
+
+	uint8_t ui8Head = psDecimator->ui8Head > 0 ? psDecimator->ui8Head - 1 : DECIMATOR_TAPS - 1;
+	psDecimator->pi32History[ui8Head] = (int32_t)ui32Value;
+	psDecimator->pi32History[ui8Head + DECIMATOR_TAPS] = (int32_t)ui32Value;
+	psDecimator->ui8Head = ui8Head;
+
+	/* The FIR filter only runs for the outputs it keeps */
+	if (psDecimator->ui8Phase < DECIMATOR_RATIO)
+		return false;
+
+	psDecimator->ui8Phase = 0;
+	*pi32Output = Decimator_Filter(psDecimator);
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define DECIMATOR_ORDER 3
+#define DECIMATOR_CIC_RATIO 32
+#define DECIMATOR_FIR_RATIO 2
+#define DECIMATOR_RATIO (DECIMATOR_CIC_RATIO * DECIMATOR_FIR_RATIO)
+#define DECIMATOR_TAPS 15
+#define DECIMATOR_SHIFT 8 // Fractional bits of the output
+#define DECIMATOR_INPUT_MAX 65535 // The CIC gain is DECIMATOR_CIC_RATIO^DECIMATOR_ORDER, inputs beyond this overflow it
+
+/**
+ * @brief A fixed-point decimator, a CIC filter followed by an FIR filter that compensates its droop
+ *
+ * @note Relative to the input rate fs the response is flat within 0.1 dB up to fs / 512 and down at least 45 dB
+ *		 from fs / 128, the output rate is fs / DECIMATOR_RATIO. The gain at DC is exactly 1
+ */
+typedef struct tDecimator {
+	/* Private state, filled in by the decimator */
+	uint32_t pui32Integrators[DECIMATOR_ORDER]; // Wrap around, the combs take the difference
+	uint32_t pui32Combs[DECIMATOR_ORDER];		 // The previous input of each comb
+	int32_t pi32History[2 * DECIMATOR_TAPS];	 // CIC outputs, written twice so the taps read them in one run
+	uint8_t ui8Head;
+	uint8_t ui8Phase;
+} tDecimator;
+
+/**
+ * @brief Clears the state of a decimator
+ *
+ * @param psDecimator The decimator
+ */
+void Decimator_Reset(tDecimator *psDecimator);
+
+/**
+ * @brief Feeds one sample to a decimator
+ *
+ * @param psDecimator The decimator
+ * @param i32Sample The sample (within +/-DECIMATOR_INPUT_MAX)
+ * @param pi32Output The filtered value, written every DECIMATOR_RATIO samples (Q DECIMATOR_SHIFT)
+ * @return True if an output was written
+ *
+ * @note This function does not access the hardware and can be used on the host
+ */
+bool Decimator_Push(tDecimator *psDecimator, int32_t i32Sample, int32_t *pi32Output);
@@ -0,0 +1,23 @@
+#pragma once
+#include <stdint.h>
+#include "grlib/grlib.h"
+
+/**
+ * @brief The number of bytes sent to the display controller
+ */
+extern uint32_t g_ui32SSD2119SPIBytes;
+
+/**
+ * @brief The number of chip select transactions sent to the display controller
+ */
+extern uint32_t g_ui32SSD2119SPITransactions;
+
+/**
+ * @brief Writes a block of pixel columns with a single data burst
+ *
+ * @param psRect The rectangle to write, inclusive of the maximum coordinates
+ * @param pui16Data The pixel data in display colors, column by column from left to right and each column from top to bottom
+ *
+ * @note This bypasses the graphics context, the caller is responsible for clipping
+ */
+void Kentec320x240x16_SSD2119ColumnsWrite(const tRectangle *psRect, const uint16_t *pui16Data);
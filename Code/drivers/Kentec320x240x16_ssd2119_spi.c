@@ -40,6 +40,7 @@
 #include "driverlib/timer.h"
 #include "grlib/grlib.h"
 #include "drivers/Kentec320x240x16_ssd2119_spi.h"
+#include "drivers/Kentec320x240x16_ssd2119_ext.h"
 
 //*****************************************************************************
 //
@@ -221,6 +222,15 @@
                                  (((c) & 0x0000fc00) >> 5) |               \
                                  (((c) & 0x000000f8) >> 3))
 
+//*****************************************************************************
+//
+// The number of bytes and chip select transactions sent to the SSD2119, used
+// to measure the bus cost of drawing operations.
+//
+//*****************************************************************************
+uint32_t g_ui32SSD2119SPIBytes;
+uint32_t g_ui32SSD2119SPITransactions;
+
 //*****************************************************************************
 //
 // Switches Backlight ON for the LCD Panel
@@ -275,6 +285,9 @@ WriteDataSPI(uint16_t ui16Data)
     while(SSIBusy(LCD_SSI_BASE)){ }
 
     GPIOPinWrite(LCD_CS_BASE, LCD_CS_PIN, LCD_CS_PIN);
+
+    g_ui32SSD2119SPIBytes += 2;
+    g_ui32SSD2119SPITransactions++;
 }
 
 //*****************************************************************************
@@ -309,6 +322,9 @@ WriteCommandSPI(uint16_t ui16Data)
     while(SSIBusy(LCD_SSI_BASE)){ }
 
     GPIOPinWrite(LCD_CS_BASE, LCD_CS_PIN, LCD_CS_PIN);
+
+    g_ui32SSD2119SPIBytes += 2;
+    g_ui32SSD2119SPITransactions++;
 }
 
 //*****************************************************************************
@@ -1061,6 +1077,118 @@ Kentec320x240x16_SSD2119RectFill(void *pvDisplayData, const tRectangle *pRect,
     WriteDataSPI(0xEF00);
 }
 
+//*****************************************************************************
+//
+//! Writes a block of pixel columns with a single data burst.
+//!
+//! \param psRect is a pointer to the rectangle to write; both sXMin and sXMax
+//! are written, along with sYMin and sYMax.
+//! \param pui16Data is a pointer to the pixel data, in display driver-specific
+//! colors.  The data is stored column by column from left to right, and each
+//! column from top to bottom.
+//!
+//! This function limits the controller RAM window to the rectangle and then
+//! streams all of the pixel data with the chip select held low, instead of
+//! one chip select transaction per pixel.  This makes it well suited to
+//! drawing narrow strips that have been composed in RAM.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+Kentec320x240x16_SSD2119ColumnsWrite(const tRectangle *psRect,
+                                     const uint16_t *pui16Data)
+{
+    int32_t i32Count;
+    uint16_t ui16XStart, ui16XEnd, ui16YStart, ui16YEnd;
+
+    //
+    // Find the extents of the rectangle in controller coordinates.
+    //
+    ui16XStart = MAPPED_X(psRect->i16XMin, psRect->i16YMin);
+    ui16XEnd = MAPPED_X(psRect->i16XMax, psRect->i16YMax);
+    if(ui16XStart > ui16XEnd)
+    {
+        ui16XStart = ui16XEnd;
+        ui16XEnd = MAPPED_X(psRect->i16XMin, psRect->i16YMin);
+    }
+    ui16YStart = MAPPED_Y(psRect->i16XMin, psRect->i16YMin);
+    ui16YEnd = MAPPED_Y(psRect->i16XMax, psRect->i16YMax);
+    if(ui16YStart > ui16YEnd)
+    {
+        ui16YStart = ui16YEnd;
+        ui16YEnd = MAPPED_Y(psRect->i16XMin, psRect->i16YMin);
+    }
+
+    //
+    // Set the cursor increment to top to bottom, followed by left to right.
+    //
+    WriteCommandSPI(SSD2119_ENTRY_MODE_REG);
+    WriteDataSPI(MAKE_ENTRY_MODE(VERT_DIRECTION));
+
+    //
+    // Limit the RAM window to the rectangle.
+    //
+    WriteCommandSPI(SSD2119_H_RAM_START_REG);
+    WriteDataSPI(ui16XStart);
+    WriteCommandSPI(SSD2119_H_RAM_END_REG);
+    WriteDataSPI(ui16XEnd);
+    WriteCommandSPI(SSD2119_V_RAM_POS_REG);
+    WriteDataSPI(ui16YStart | (ui16YEnd << 8));
+
+    //
+    // Set the display cursor to the upper left of the rectangle (in
+    // application coordinate space).
+    //
+    WriteCommandSPI(SSD2119_X_RAM_ADDR_REG);
+    WriteDataSPI(MAPPED_X(psRect->i16XMin, psRect->i16YMin));
+    WriteCommandSPI(SSD2119_Y_RAM_ADDR_REG);
+    WriteDataSPI(MAPPED_Y(psRect->i16XMin, psRect->i16YMin));
+
+    //
+    // Tell the controller we are about to write data into its RAM.
+    //
+    WriteCommandSPI(SSD2119_RAM_DATA_REG);
+
+    //
+    // Stream the pixel data with a single chip select transaction.  The SSI
+    // transmit FIFO provides the flow control, so there is only one wait for
+    // the bus to go idle at the end.
+    //
+    i32Count = ((psRect->i16XMax - psRect->i16XMin + 1) *
+                (psRect->i16YMax - psRect->i16YMin + 1));
+
+    GPIOPinWrite(LCD_DC_BASE, LCD_DC_PIN, LCD_DC_PIN);
+    GPIOPinWrite(LCD_CS_BASE, LCD_CS_PIN, 0);
+
+    g_ui32SSD2119SPIBytes += i32Count * 2;
+    g_ui32SSD2119SPITransactions++;
+
+    while(i32Count--)
+    {
+        SSIDataPut(LCD_SSI_BASE, *pui16Data >> 8);
+        SSIDataPut(LCD_SSI_BASE, *pui16Data++);
+    }
+
+    while(SSIBusy(LCD_SSI_BASE)){ }
+
+    GPIOPinWrite(LCD_CS_BASE, LCD_CS_PIN, LCD_CS_PIN);
+
+    //
+    // Reset the X extents to the entire screen.
+    //
+    WriteCommandSPI(SSD2119_H_RAM_START_REG);
+    WriteDataSPI(0x0000);
+    WriteCommandSPI(SSD2119_H_RAM_END_REG);
+    WriteDataSPI(0x013F);
+
+    //
+    // Reset the Y extent to the full screen
+    //
+    WriteCommandSPI(SSD2119_V_RAM_POS_REG);
+    WriteDataSPI(0xEF00);
+}
+
 //*****************************************************************************
 //
 //! Translates a 24-bit RGB color to a display driver-specific color.
@@ -0,0 +1,371 @@
+#pragma region Includes
+#include "gauge.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define GAUGE_COLOR_BACKGROUND 0
+#define GAUGE_COLOR_FACE 1
+#define GAUGE_COLOR_SCALE 2
+#define GAUGE_COLOR_NEEDLE 3
+#define GAUGE_START_ANGLE 225.0f // Degrees counter-clockwise from 3 o'clock
+#define GAUGE_SWEEP_ANGLE 270.0f // Degrees clockwise from the start
+#define GAUGE_RIM_WIDTH 2
+#define GAUGE_TICK_LENGTH 5
+#define GAUGE_TICK_HALF_WIDTH 0.71f // Keeps diagonal ticks connected
+#define GAUGE_HUB_RADIUS 3
+#define GAUGE_PI 3.14159265f
+
+/**
+ * @brief A horizontal span of needle pixels waiting to be drawn
+ *
+ */
+typedef struct tGaugeSpan {
+	int16_t i16XMin;
+	int16_t i16XMax;
+	int16_t i16Y;
+	uint8_t ui8Color;
+} tGaugeSpan;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets the direction of a point on the scale
+ *
+ * @param fFraction The position on the scale, 0 to 1
+ * @param pfCos The x component of the direction
+ * @param pfSin The y component of the direction, positive is up
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Gauge_Direction(float fFraction, float *pfCos, float *pfSin) {
+	float fAngle = (GAUGE_START_ANGLE - fFraction * GAUGE_SWEEP_ANGLE) * GAUGE_PI / 180.0f;
+	*pfCos = cosf(fAngle);
+	*pfSin = sinf(fAngle);
+}
+
+/**
+ * @brief Computes the color of the dial face at an offset from its center
+ *
+ * @param psGauge The gauge
+ * @param i16DX The x offset
+ * @param i16DY The y offset, positive is down
+ * @return The GAUGE_COLOR_x of the pixel
+ *
+ * @note This function is only used to build the face, not when drawing
+ * @note This function is not intended to be called by the user
+ */
+uint8_t Gauge_FaceAt(const tGauge *psGauge, int16_t i16DX, int16_t i16DY) {
+	int32_t i32Radius = psGauge->ui8Radius;
+	int32_t i32Inner = i32Radius - GAUGE_RIM_WIDTH;
+	int32_t i32Distance = i16DX * i16DX + i16DY * i16DY;
+
+	/* Radii are widened by half a pixel so the circles look round */
+	if (i32Distance > i32Radius * i32Radius + i32Radius)
+		return GAUGE_COLOR_BACKGROUND;
+	if (i32Distance > i32Inner * i32Inner + i32Inner)
+		return GAUGE_COLOR_SCALE;
+	if (i32Distance <= GAUGE_HUB_RADIUS * GAUGE_HUB_RADIUS + GAUGE_HUB_RADIUS)
+		return GAUGE_COLOR_NEEDLE;
+
+	/* Ticks run inwards from the rim at each end of every division */
+	for (uint8_t i = 0; i <= psGauge->ui8Divisions; i++) {
+		float fCos, fSin;
+		Gauge_Direction((float)i / psGauge->ui8Divisions, &fCos, &fSin);
+
+		float fAlong = i16DX * fCos - i16DY * fSin;
+		float fAcross = i16DX * fSin + i16DY * fCos;
+		if (fAcross >= -GAUGE_TICK_HALF_WIDTH && fAcross <= GAUGE_TICK_HALF_WIDTH && fAlong >= i32Inner - GAUGE_TICK_LENGTH && fAlong <= i32Inner)
+			return GAUGE_COLOR_SCALE;
+	}
+
+	return GAUGE_COLOR_FACE;
+}
+
+/**
+ * @brief Run length encodes the dial face, one row of runs per pixel row of the dial
+ *
+ * @param psGauge The gauge to build the face of
+ * @return True if the face fits in GAUGE_MAX_RUNS runs
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool Gauge_Build(tGauge *psGauge) {
+	int16_t i16Radius = psGauge->ui8Radius;
+	uint16_t ui16Runs = 0;
+
+	if (i16Radius > GAUGE_MAX_RADIUS || psGauge->ui8Divisions == 0)
+		return false;
+
+	for (int16_t i16DY = -i16Radius; i16DY <= i16Radius; i16DY++) {
+		psGauge->pui16RowStart[i16DY + i16Radius] = ui16Runs;
+
+		for (int16_t i16DX = -i16Radius; i16DX <= i16Radius; i16DX++) {
+			uint8_t ui8Color = Gauge_FaceAt(psGauge, i16DX, i16DY);
+
+			/* Extend the last run of the row or start a new one */
+			if (ui16Runs > psGauge->pui16RowStart[i16DY + i16Radius] && psGauge->psRuns[ui16Runs - 1].ui8Color == ui8Color) {
+				psGauge->psRuns[ui16Runs - 1].ui8Length++;
+				continue;
+			}
+			if (ui16Runs == GAUGE_MAX_RUNS)
+				return false;
+			psGauge->psRuns[ui16Runs++] = (tGaugeRun){1, ui8Color};
+		}
+	}
+
+	psGauge->pui16RowStart[2 * i16Radius + 1] = ui16Runs;
+	psGauge->ui16Runs = ui16Runs;
+	return true;
+}
+
+/**
+ * @brief Looks up the color of the dial face under a pixel
+ *
+ * @param psGauge The gauge
+ * @param i16X The x position of the pixel
+ * @param i16Y The y position of the pixel
+ * @return The GAUGE_COLOR_x of the pixel
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint8_t Gauge_FaceColor(const tGauge *psGauge, int16_t i16X, int16_t i16Y) {
+	int16_t i16Column = i16X - psGauge->i16X + psGauge->ui8Radius;
+	int16_t i16Row = i16Y - psGauge->i16Y + psGauge->ui8Radius;
+
+	if (i16Column < 0 || i16Row < 0 || i16Column > 2 * psGauge->ui8Radius || i16Row > 2 * psGauge->ui8Radius)
+		return GAUGE_COLOR_BACKGROUND;
+
+	for (uint16_t i = psGauge->pui16RowStart[i16Row]; i < psGauge->pui16RowStart[i16Row + 1]; i++) {
+		if (i16Column < psGauge->psRuns[i].ui8Length)
+			return psGauge->psRuns[i].ui8Color;
+		i16Column -= psGauge->psRuns[i].ui8Length;
+	}
+
+	return GAUGE_COLOR_BACKGROUND;
+}
+
+/**
+ * @brief Appends the pixels of a line to a needle
+ *
+ * @param psPoints The needle pixels
+ * @param pui8Count The number of needle pixels, updated
+ * @param i16X0 The x position of the start
+ * @param i16Y0 The y position of the start
+ * @param i16X1 The x position of the end
+ * @param i16Y1 The y position of the end
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Gauge_Line(tGaugePoint *psPoints, uint8_t *pui8Count, int16_t i16X0, int16_t i16Y0, int16_t i16X1, int16_t i16Y1) {
+	int16_t i16DX = i16X1 > i16X0 ? i16X1 - i16X0 : i16X0 - i16X1;
+	int16_t i16DY = i16Y1 > i16Y0 ? i16Y0 - i16Y1 : i16Y1 - i16Y0;
+	int16_t i16StepX = i16X1 > i16X0 ? 1 : -1;
+	int16_t i16StepY = i16Y1 > i16Y0 ? 1 : -1;
+	int16_t i16Error = i16DX + i16DY;
+
+	while (*pui8Count < GAUGE_MAX_NEEDLE) {
+		psPoints[(*pui8Count)++] = (tGaugePoint){i16X0, i16Y0};
+		if (i16X0 == i16X1 && i16Y0 == i16Y1)
+			break;
+
+		int16_t i16Error2 = 2 * i16Error;
+		if (i16Error2 >= i16DY) {
+			i16Error += i16DY;
+			i16X0 += i16StepX;
+		}
+		if (i16Error2 <= i16DX) {
+			i16Error += i16DX;
+			i16Y0 += i16StepY;
+		}
+	}
+}
+
+/**
+ * @brief Computes the pixels of the needle for a value
+ *
+ * @param psGauge The gauge
+ * @param i32Value The value to point at
+ * @param psPoints The needle pixels, GAUGE_MAX_NEEDLE entries
+ * @return The number of needle pixels
+ *
+ * @note The needle is two pixels wide and runs from the hub to just inside the rim
+ * @note This function is not intended to be called by the user
+ */
+uint8_t Gauge_Needle(const tGauge *psGauge, int32_t i32Value, tGaugePoint *psPoints) {
+	float fFraction = 0.0f;
+	if (psGauge->i32Max != psGauge->i32Min)
+		fFraction = (float)(i32Value - psGauge->i32Min) / (psGauge->i32Max - psGauge->i32Min);
+	if (fFraction < 0.0f)
+		fFraction = 0.0f;
+	if (fFraction > 1.0f)
+		fFraction = 1.0f;
+
+	float fCos, fSin;
+	Gauge_Direction(fFraction, &fCos, &fSin);
+
+	int16_t i16Length = psGauge->ui8Radius - GAUGE_RIM_WIDTH - 1;
+	int16_t i16X0 = psGauge->i16X + lroundf(fCos * GAUGE_HUB_RADIUS);
+	int16_t i16Y0 = psGauge->i16Y - lroundf(fSin * GAUGE_HUB_RADIUS);
+	int16_t i16X1 = psGauge->i16X + lroundf(fCos * i16Length);
+	int16_t i16Y1 = psGauge->i16Y - lroundf(fSin * i16Length);
+
+	/* Second line next to the first across the major axis */
+	uint8_t ui8Count = 0;
+	int16_t i16OffsetX = 0, i16OffsetY = 0;
+	if (fabsf(fCos) > fabsf(fSin))
+		i16OffsetY = 1;
+	else
+		i16OffsetX = 1;
+
+	Gauge_Line(psPoints, &ui8Count, i16X0, i16Y0, i16X1, i16Y1);
+	Gauge_Line(psPoints, &ui8Count, i16X0 + i16OffsetX, i16Y0 + i16OffsetY, i16X1 + i16OffsetX, i16Y1 + i16OffsetY);
+	return ui8Count;
+}
+
+/**
+ * @brief Checks if a needle contains a pixel
+ *
+ * @param psPoints The needle pixels
+ * @param ui8Count The number of needle pixels
+ * @param sPoint The pixel to look for
+ * @return True if the pixel is part of the needle
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool Gauge_Contains(const tGaugePoint *psPoints, uint8_t ui8Count, tGaugePoint sPoint) {
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		if (psPoints[i].i16X == sPoint.i16X && psPoints[i].i16Y == sPoint.i16Y)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Draws a pending span if there is one
+ *
+ * @param psGauge The gauge
+ * @param psContext The graphics context
+ * @param psSpan The span to draw, emptied
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Gauge_FlushSpan(const tGauge *psGauge, tContext *psContext, tGaugeSpan *psSpan) {
+	if (psSpan->i16XMin > psSpan->i16XMax)
+		return;
+
+	GrContextForegroundSet(psContext, psGauge->pui32Colors[psSpan->ui8Color]);
+	GrLineDrawH(psContext, psSpan->i16XMin, psSpan->i16XMax, psSpan->i16Y);
+	psSpan->i16XMin = 1;
+	psSpan->i16XMax = 0;
+}
+
+/**
+ * @brief Paints the pixels of one needle that are not part of another
+ *
+ * @param psGauge The gauge
+ * @param psContext The graphics context
+ * @param psPoints The pixels to paint
+ * @param ui8Count The number of pixels to paint
+ * @param psKeep The pixels to leave alone
+ * @param ui8Keep The number of pixels to leave alone
+ * @param bFace True to restore the dial face, false to paint the needle
+ *
+ * @note Neighbouring pixels of the same color in a row are drawn as one span
+ * @note This function is not intended to be called by the user
+ */
+void Gauge_PaintPoints(const tGauge *psGauge, tContext *psContext, const tGaugePoint *psPoints, uint8_t ui8Count, const tGaugePoint *psKeep, uint8_t ui8Keep, bool bFace) {
+	tGaugeSpan sSpan = {1, 0, 0, 0};
+
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		tGaugePoint sPoint = psPoints[i];
+		if (Gauge_Contains(psKeep, ui8Keep, sPoint))
+			continue;
+
+		uint8_t ui8Color = bFace ? Gauge_FaceColor(psGauge, sPoint.i16X, sPoint.i16Y) : GAUGE_COLOR_NEEDLE;
+		if (sSpan.i16XMin <= sSpan.i16XMax && sSpan.i16Y == sPoint.i16Y && sSpan.ui8Color == ui8Color) {
+			if (sPoint.i16X == sSpan.i16XMax + 1) {
+				sSpan.i16XMax = sPoint.i16X;
+				continue;
+			}
+			if (sPoint.i16X == sSpan.i16XMin - 1) {
+				sSpan.i16XMin = sPoint.i16X;
+				continue;
+			}
+		}
+
+		Gauge_FlushSpan(psGauge, psContext, &sSpan);
+		sSpan = (tGaugeSpan){sPoint.i16X, sPoint.i16X, sPoint.i16Y, ui8Color};
+	}
+
+	Gauge_FlushSpan(psGauge, psContext, &sSpan);
+}
+#pragma endregion
+
+#pragma region Gauge API functions
+/**
+ * @brief Draws a value, only the needle pixels that differ from what is on screen are redrawn
+ *
+ * @param psGauge The gauge to draw
+ * @param psContext The graphics context
+ * @param i32Value The value to show, clamped to the scale
+ *
+ * @note The first draw after a reset draws the whole dial
+ */
+void Gauge_Draw(tGauge *psGauge, tContext *psContext, int32_t i32Value) {
+	tGaugePoint psNeedle[GAUGE_MAX_NEEDLE];
+
+	if (psGauge->ui16Runs == 0 && !Gauge_Build(psGauge))
+		return;
+
+	uint8_t ui8Needle = Gauge_Needle(psGauge, i32Value, psNeedle);
+
+	if (!psGauge->bValid) {
+		/* Whole face, the background around the dial is left as is */
+		int16_t i16Left = psGauge->i16X - psGauge->ui8Radius;
+		for (uint8_t ui8Row = 0; ui8Row <= 2 * psGauge->ui8Radius; ui8Row++) {
+			int16_t i16X = i16Left;
+			for (uint16_t i = psGauge->pui16RowStart[ui8Row]; i < psGauge->pui16RowStart[ui8Row + 1]; i++) {
+				const tGaugeRun *psRun = &psGauge->psRuns[i];
+				if (psRun->ui8Color != GAUGE_COLOR_BACKGROUND) {
+					GrContextForegroundSet(psContext, psGauge->pui32Colors[psRun->ui8Color]);
+					GrLineDrawH(psContext, i16X, i16X + psRun->ui8Length - 1, psGauge->i16Y - psGauge->ui8Radius + ui8Row);
+				}
+				i16X += psRun->ui8Length;
+			}
+		}
+
+		psGauge->ui8Needle = 0;
+	}
+
+	/* Restore the face under the old needle, then draw what is new of the new needle */
+	Gauge_PaintPoints(psGauge, psContext, psGauge->psNeedle, psGauge->ui8Needle, psNeedle, ui8Needle, true);
+	Gauge_PaintPoints(psGauge, psContext, psNeedle, ui8Needle, psGauge->psNeedle, psGauge->ui8Needle, false);
+
+	for (uint8_t i = 0; i < ui8Needle; i++) {
+		psGauge->psNeedle[i] = psNeedle[i];
+	}
+	psGauge->ui8Needle = ui8Needle;
+	psGauge->bValid = true;
+}
+
+/**
+ * @brief Forgets what is on screen so that the next draw redraws the whole dial
+ *
+ * @param psGauge The gauge to reset
+ *
+ * @note This should be called when the area behind the gauge has been cleared
+ */
+void Gauge_Reset(tGauge *psGauge) {
+	psGauge->bValid = false;
+}
+#pragma endregion
@@ -0,0 +1,107 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+/* Global defines */
+#define GAUGE_MAX_RADIUS 40
+#define GAUGE_MAX_RUNS 1024
+#define GAUGE_MAX_NEEDLE (4 * GAUGE_MAX_RADIUS)
+
+/**
+ * @brief A pixel of a gauge needle
+ *
+ */
+typedef struct tGaugePoint {
+	int16_t i16X;
+	int16_t i16Y;
+} tGaugePoint;
+
+/**
+ * @brief A run of pixels of the same color in the dial face
+ *
+ */
+typedef struct tGaugeRun {
+	uint8_t ui8Length;
+	uint8_t ui8Color;
+} tGaugeRun;
+
+/**
+ * @brief A round analog gauge that only redraws the pixels of the needle that moved
+ *
+ */
+typedef struct tGauge {
+	/**
+	 * @brief The x position of the center of the dial
+	 */
+	int16_t i16X;
+	/**
+	 * @brief The y position of the center of the dial
+	 */
+	int16_t i16Y;
+	/**
+	 * @brief The radius of the dial, at most GAUGE_MAX_RADIUS
+	 */
+	uint8_t ui8Radius;
+	/**
+	 * @brief The number of scale divisions, a tick is drawn at each end of every division
+	 */
+	uint8_t ui8Divisions;
+	/**
+	 * @brief The value at the start of the scale
+	 */
+	int32_t i32Min;
+	/**
+	 * @brief The value at the end of the scale
+	 */
+	int32_t i32Max;
+	/**
+	 * @brief The colors of the background, dial face, scale and needle
+	 */
+	uint32_t pui32Colors[4];
+
+	/* Private state, filled in when drawn */
+	bool bValid;
+	uint16_t ui16Runs;
+	uint16_t pui16RowStart[2 * GAUGE_MAX_RADIUS + 2];
+	tGaugeRun psRuns[GAUGE_MAX_RUNS];
+	uint8_t ui8Needle;
+	tGaugePoint psNeedle[GAUGE_MAX_NEEDLE];
+} tGauge;
+
+/**
+ * @brief Statically initializes a gauge
+ *
+ * @param x The x position of the center of the dial
+ * @param y The y position of the center of the dial
+ * @param radius The radius of the dial
+ * @param divisions The number of scale divisions
+ * @param min The value at the start of the scale
+ * @param max The value at the end of the scale
+ * @param background The color around the dial
+ * @param face The color of the dial face
+ * @param scale The color of the rim and ticks
+ * @param needle The color of the needle and hub
+ */
+#define Gauge(x, y, radius, divisions, min, max, background, face, scale, needle) \
+	{(x), (y), (radius), (divisions), (min), (max), {(background), (face), (scale), (needle)}, false, 0, {0}, {{0}}, 0, {{0}}}
+
+/**
+ * @brief Draws a value, only the needle pixels that differ from what is on screen are redrawn
+ *
+ * @param psGauge The gauge to draw
+ * @param psContext The graphics context
+ * @param i32Value The value to show, clamped to the scale
+ *
+ * @note The first draw after a reset draws the whole dial
+ */
+void Gauge_Draw(tGauge *psGauge, tContext *psContext, int32_t i32Value);
+
+/**
+ * @brief Forgets what is on screen so that the next draw redraws the whole dial
+ *
+ * @param psGauge The gauge to reset
+ *
+ * @note This should be called when the area behind the gauge has been cleared
+ */
+void Gauge_Reset(tGauge *psGauge);
@@ -2,6 +2,11 @@
 #include "gui.h"
 #include "util.h"
 #include "config.h"
+#include "history.h"
+#include "numeric.h"
+#include "gauge.h"
+#include "bar.h"
+#include "bus.h"
 
 /* Standard header files */
 #include <stdio.h>
@@ -10,6 +15,16 @@
 #include <string.h>
 #include <math.h>
 
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+#include <xdc/runtime/Types.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Event.h>
+#include <ti/sysbios/gates/GateMutexPri.h>
+#include <ti/sysbios/utils/Load.h>
+
 /* GPIO header files */
 #include <ti/drivers/GPIO.h>
 #include "Board.h"
@@ -25,6 +40,7 @@
 /* Driver header files */
 #include "drivers/Kentec320x240x16_ssd2119_spi.h"
 #include "drivers/touch.h"
+#include "drivers/Kentec320x240x16_ssd2119_ext.h"
 
 /* Font header files */
 #include "fonts/fontnf10.h"
@@ -39,24 +55,146 @@
 #define DISPLAY &g_sKentec320x240x16_SSD2119
 #define AUTO_REPEAT_DELAY 250
 #define AUTO_REPEAT_RATE 20
-#define DEFULT_GRAPH_INDEX 6
 #define GRAPH_GRID_SIZE_X 28
 #define GRAPH_GRID_SIZE_Y 28
-#define GRAPH_UNIT_SPEED "dY:45RPM"	  // MAX_POWER / (GRAPH_HEIGHT / GRAPH_GRID_SIZE_Y)
-#define GRAPH_UNIT_POWER "dY:45W"	  // MAX_POWER / (GRAPH_HEIGHT / GRAPH_GRID_SIZE_Y)
-#define GRAPH_UNIT_LIGHT "dY:45lux"	  // MAX_LIGHT / (GRAPH_HEIGHT / GRAPH_GRID_SIZE_Y)
-#define GRAPH_UNIT_ACCEL "dY:45m/s^2" // MAX_ACCEL / (GRAPH_HEIGHT / GRAPH_GRID_SIZE_Y)
-#define GRAPH_UNIT_TIME "dX:2.8s"	  // GUI_PULSE_PERIOD * GRAPH_GRID_SIZE_X / 1000
+#define GRAPH_CHANNEL_COUNT (sizeof(gc_sGraphChannels) / sizeof(gc_sGraphChannels[0]))
+#define GRAPH_CHECKBOX_X 82
+#define GRAPH_CHECKBOX_Y 182
+#define GRAPH_CHECKBOX_WIDTH 232 // Shared by the columns of checkboxes
+#define GRAPH_CHECKBOX_HEIGHT 23
+#define GRAPH_CHECKBOX_ROWS 2
+#define GRAPH_CHECKBOX_SPACING 29
+#define GRAPH_UNIT_X 6
+#define GRAPH_UNIT_Y 6
+#define GRAPH_UNIT_WIDTH 248 // Shared by the columns of unit labels, the time unit follows the first row
+#define GRAPH_UNIT_HEIGHT 13
+#define GRAPH_UNIT_COLUMNS 4	// Labels per row, more channels add a row and the plot shrinks by it
+#define GRAPH_UNIT_TEXT 16
+#define GRAPH_COLUMN_MAX 240
+#define GRAPH_CHUNK_COLUMNS 32
+#define GUI_FILL_CHUNK_PIXELS 4800 // Filled at once, about as many pixels as GRAPH_CHUNK_COLUMNS columns of the plot
 #define MOTOR_STATE_LED Board_LED0
 #define LIGHT_STATE_LED Board_LED1
+#define GUI_EVENT_PULSE Event_Id_00
+#define GUI_EVENT_INPUT Event_Id_01
+#define GUI_EVENT_RENDER Event_Id_00
+#define GUI_REGION_ROOT 0
+#define GUI_REGION_DESIRED_SPEED 1
+#define GUI_REGION_CURRENT_SPEED 2
+#define GUI_REGION_MAIN_TIME 3
+#define GUI_REGION_OPTION1 4
+#define GUI_REGION_OPTION2 5
+#define GUI_REGION_OPTION3 6
+#define GUI_REGION_OPTION4 7
+#define GUI_REGION_GRAPH_CONTENT 8
+#define GUI_REGION_GRAPH_UNITS 9
+#define GUI_REGION_GRAPH_TIME 10
+#define GUI_REGION_PANEL 11
+#define GUI_REGION_MAIN_START 12
+#define GUI_REGION_SPEED_GAUGE 13
+#define GUI_REGION_POWER_BAR 14
+#define GUI_REGION_ACCEL_BAR 15
+#define GUI_REGION_COUNT 16
+#define GUI_PRIORITY_COUNT 4
+#define GUI_TRANSITION_ERASE_MAX 24
+#define GUI_REGION_RESTART ((1 << GUI_REGION_ROOT) | (1 << GUI_REGION_PANEL))
+#define GUI_OVERLAY_LINE1_Y 12
+#define GUI_OVERLAY_LINE2_Y 23
+#define GUI_OVERLAY_TASK_X 70
+#define GUI_OVERLAY_TASK_SPACING 60
 
 /* Global constants */
-const tRectangle gc_sDesiredSpeedRect = {61, 54, 156, 79};
-const tRectangle gc_sCurrentSpeedRect = {61, 132, 156, 157};
-const tRectangle gc_sOption1Rect = {180, 34, 216, 51};
-const tRectangle gc_sOption2Rect = {180, 90, 216, 107};
-const tRectangle gc_sOption3Rect = {180, 146, 216, 163};
-const tRectangle gc_sOption4Rect = {180, 202, 216, 219};
+const tRectangle gc_sDesiredSpeedRect = {12, 44, 201, 94};
+const tRectangle gc_sCurrentSpeedRect = {12, 121, 201, 171};
+const tRectangle gc_sOption1Rect = {134, 22, 261, 57};
+const tRectangle gc_sOption2Rect = {134, 78, 261, 113};
+const tRectangle gc_sOption3Rect = {134, 134, 261, 169};
+const tRectangle gc_sOption4Rect = {134, 190, 261, 225};
+const tRectangle gc_sSpeedGaugeRect = {229, 107, 295, 173};
+
+/**
+ * @brief Snapshot of the values displayed by the GUI
+ *
+ */
+typedef struct tGUISnapshot {
+	/**
+	 * @brief The current motor speed (RPM)
+	 */
+	int16_t i16Speed;
+	/**
+	 * @brief The current motor power (W)
+	 */
+	int16_t i16Power;
+	/**
+	 * @brief The current light level (lux)
+	 */
+	int16_t i16Light;
+	/**
+	 * @brief The current acceleration (m/s^2)
+	 */
+	int16_t i16Accel;
+	/**
+	 * @brief The current time (ticks)
+	 */
+	uint32_t ui32Time;
+	/**
+	 * @brief The current e-stop state
+	 */
+	bool bEStop;
+} tGUISnapshot;
+
+/**
+ * @brief Values shown by the performance overlay, measured over the last GUI_OVERLAY_PERIOD
+ *
+ */
+typedef struct tGUIOverlay {
+	/**
+	 * @brief The frames painted per second
+	 */
+	uint16_t ui16FrameRate;
+	/**
+	 * @brief The display bus traffic (kB/s)
+	 */
+	uint16_t ui16SPIRate;
+	/**
+	 * @brief The most touch messages waiting in the widget queue when the input task ran
+	 */
+	uint8_t ui8QueueDepth;
+	/**
+	 * @brief The longest time from a pulse to the end of the frame that painted it (ms)
+	 */
+	uint16_t ui16PulseLatency;
+	/**
+	 * @brief The CPU load (%)
+	 */
+	uint8_t ui8CPULoad;
+	/**
+	 * @brief The load of each task added with GUI_AddOverlayTask (%)
+	 */
+	uint8_t ui8TaskLoad[GUI_OVERLAY_TASK_COUNT];
+} tGUIOverlay;
+
+/**
+ * @brief A static label of the performance overlay
+ *
+ */
+typedef struct tGUIOverlayLabel {
+	const char *pcText;
+	int16_t i16X;
+	int16_t i16Y;
+} tGUIOverlayLabel;
+
+/* Labels of the performance overlay, the task labels are added by GUI_AddOverlayTask */
+const tGUIOverlayLabel gc_sOverlayLabels[] = {
+	{"fps", 10, GUI_OVERLAY_LINE1_Y},
+	{"SPI", 58, GUI_OVERLAY_LINE1_Y},
+	{"kB/s", 106, GUI_OVERLAY_LINE1_Y},
+	{"q", 142, GUI_OVERLAY_LINE1_Y},
+	{"p2p", 178, GUI_OVERLAY_LINE1_Y},
+	{"ms", 226, GUI_OVERLAY_LINE1_Y},
+	{"cpu", 10, GUI_OVERLAY_LINE2_Y},
+	{"%", 52, GUI_OVERLAY_LINE2_Y},
+};
 
 /* Global variables */
 tContext g_sContext;
@@ -68,21 +206,91 @@ uint8_t g_ui8MaxAccel = 10;
 uint8_t g_ui8TimeHours = 0;
 uint8_t g_ui8TimeMinutes = 0;
 bool g_bIsRunning = false;
-bool g_bGraphSpeed = true;
-bool g_bGraphPower = true;
-bool g_bGraphLight = false;
-bool g_bGraphAccel = false;
-volatile bool g_bDoUpdate = false;
+Event_Struct g_sGUIEvent;
+Event_Handle g_hGUIEvent;
+Event_Struct g_sGUIRenderEvent;
+Event_Handle g_hGUIRenderEvent;
+GateMutexPri_Struct g_sGUIGate;
+GateMutexPri_Handle g_hGUIGate;
+IArg g_iGUIGateKey;
+uint32_t g_ui32TapStamp = 0;
+bool g_bFullRepaint = false;
+tGUISnapshot g_sSnapshot;
 uint32_t g_ui32PrevTime = UINT32_MAX;
 bool g_bPrevIsNight = false;
 int16_t g_i16PrevRPM = INT16_MAX;
+int16_t g_i16PrevPower = INT16_MAX;
+int16_t g_i16PrevAccel = INT16_MAX;
 char ga_cTimeText[33];
-uint16_t g_ui16GraphIndex = DEFULT_GRAPH_INDEX;
-uint8_t g_ui8PrevSpeed = UINT8_MAX;
-uint8_t g_ui8PrevPower = UINT8_MAX;
-uint8_t g_ui8PrevLight = UINT8_MAX;
-uint8_t g_ui8PrevAccel = UINT8_MAX;
-bool g_bGraphFirstPaint = true;
+bool g_bOverlay = false;
+bool g_bOverlayLabels = false;
+bool g_bOverlayHeld = false;
+uint32_t g_ui32OverlayPress = 0;
+uint32_t g_ui32OverlayWindow = 0;
+uint32_t g_ui32OverlayFrames = 0;
+uint32_t g_ui32OverlayBytes = 0;
+uint32_t g_ui32OverlayPulseLatency = 0;
+tGUIOverlay g_sOverlay;
+Task_Handle ga_hOverlayTasks[GUI_OVERLAY_TASK_COUNT];
+const char *ga_pcOverlayTaskLabels[GUI_OVERLAY_TASK_COUNT];
+uint8_t g_ui8OverlayTasks = 0;
+uint32_t g_ui32PulseStamp = 0;
+uint32_t g_ui32PaintPulse = 0;
+volatile uint32_t g_ui32InputQueued = 0;
+uint32_t g_ui32InputProcessed = 0;
+uint8_t g_ui8InputPeak = 0;
+uint32_t g_ui32TimestampPerMs = 0;
+uint32_t g_ui32DirtyRegions = 0;
+tWidget *g_psTransitionFrom = NULL;
+uint32_t g_ui32LastFrame = 0;
+uint32_t g_ui32FrameBudget = 0;
+tGUIFrameStats g_sFrameStats;
+int32_t g_i32GraphPainted = -1;
+bool g_bGraphRedraw = true;
+uint8_t g_ui8GraphZoom = 0;
+uint16_t ga_ui16GraphColumn[2 * GRAPH_COLUMN_MAX];
+uint32_t g_ui32GraphColumnBytes = 0;
+uint32_t g_ui32GraphColumnTransactions = 0;
+uint32_t g_ui32GraphChannels = 0; // Bit per enabled channel
+
+/* Time per grid division of each history level, GUI_GRAPH_PERIOD * GRAPH_GRID_SIZE_X * History_Samples(level) */
+const char *gc_pcGraphUnitTime[HISTORY_LEVEL_COUNT] = {"dX:2.8s", "dX:28s", "dX:4.7m", "dX:28m"};
+
+/* Numeric readouts */
+tNumericDisplay g_sDesiredSpeedNumeric = NumericDisplay(&g_sFontNf36, ClrRed, ClrBlack, 107, 64, 4, ' ');
+tNumericDisplay g_sCurrentSpeedNumeric = NumericDisplay(&g_sFontNf36, ClrRed, ClrBlack, 107, 142, 4, ' ');
+tNumericDisplay g_sOption1Numeric = NumericDisplay(&g_sFontNf24, ClrRed, ClrBlack, 198, 41, 3, ' ');
+tNumericDisplay g_sOption2Numeric = NumericDisplay(&g_sFontNf24, ClrRed, ClrBlack, 198, 97, 3, ' ');
+tNumericDisplay g_sOption3Numeric = NumericDisplay(&g_sFontNf24, ClrRed, ClrBlack, 198, 153, 2, '0');
+tNumericDisplay g_sOption4Numeric = NumericDisplay(&g_sFontNf24, ClrRed, ClrBlack, 198, 209, 2, '0');
+tNumericDisplay *const gc_psNumerics[] = {
+	&g_sDesiredSpeedNumeric,
+	&g_sCurrentSpeedNumeric,
+	&g_sOption1Numeric,
+	&g_sOption2Numeric,
+	&g_sOption3Numeric,
+	&g_sOption4Numeric
+};
+
+/* Speed gauge, next to the current speed readout */
+tGauge g_sSpeedGauge = Gauge(262, 140, 33, 10, 0, MAX_SPEED, ClrBlack, ClrBlack, ClrWhite, ClrRed);
+
+/* Power and acceleration bars either side of the gauge, marked at their limits */
+tBarMeter g_sPowerBar = BarMeter(215, 107, 12, 67, true, MAX_POWER, ClrBlue, ClrBlack, ClrWhite, ClrGray);
+tBarMeter g_sAccelBar = BarMeter(298, 107, 12, 67, true, MAX_ACCEL, ClrYellow, ClrBlack, ClrWhite, ClrGray);
+
+/* Performance overlay readouts, in the time bar */
+tNumericDisplay g_sOverlayFrameNumeric = NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, 41, GUI_OVERLAY_LINE1_Y, 3, ' ');
+tNumericDisplay g_sOverlaySPINumeric = NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, 92, GUI_OVERLAY_LINE1_Y, 4, ' ');
+tNumericDisplay g_sOverlayQueueNumeric = NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, 158, GUI_OVERLAY_LINE1_Y, 2, ' ');
+tNumericDisplay g_sOverlayPulseNumeric = NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, 212, GUI_OVERLAY_LINE1_Y, 4, ' ');
+tNumericDisplay g_sOverlayCPUNumeric = NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, 41, GUI_OVERLAY_LINE2_Y, 3, ' ');
+tNumericDisplay ga_sOverlayTaskNumeric[GUI_OVERLAY_TASK_COUNT] = {
+	NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, GUI_OVERLAY_TASK_X + 25, GUI_OVERLAY_LINE2_Y, 3, ' '),
+	NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, GUI_OVERLAY_TASK_X + GUI_OVERLAY_TASK_SPACING + 25, GUI_OVERLAY_LINE2_Y, 3, ' '),
+	NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, GUI_OVERLAY_TASK_X + 2 * GUI_OVERLAY_TASK_SPACING + 25, GUI_OVERLAY_LINE2_Y, 3, ' '),
+	NumericDisplay(&g_sFontNf10, ClrYellow, ClrBlack, GUI_OVERLAY_TASK_X + 3 * GUI_OVERLAY_TASK_SPACING + 25, GUI_OVERLAY_LINE2_Y, 3, ' '),
+};
 
 /* Callback function array */
 tGUICallbackFxn g_pfnCallbacks[GUI_CALLBACK_COUNT];
@@ -100,6 +308,9 @@ tCanvasWidget g_sMainDesiredSpeed;
 tCanvasWidget g_sMainCurrentSpeed;
 tPushButtonWidget g_sMainDesiredSpeedUpBtn;
 tPushButtonWidget g_sMainDesiredSpeedDownBtn;
+tCanvasWidget g_sMainSpeedGauge;
+tCanvasWidget g_sMainPowerBar;
+tCanvasWidget g_sMainAccelBar;
 
 /* Settings panel widgets */
 tCanvasWidget g_sSettingsPanel;
@@ -121,17 +332,9 @@ tPushButtonWidget g_sSettingsOption4UpBtn;
 /* Graph panel widgets */
 tCanvasWidget g_sGraphPanel;
 tPushButtonWidget g_sGraphBackBtn;
-tCheckBoxWidget g_sGraphSpeedChk;
-tCheckBoxWidget g_sGraphPowerChk;
-tCheckBoxWidget g_sGraphLightChk;
-tCheckBoxWidget g_sGraphAccelChk;
 tCanvasWidget g_sGraphContent;
 tCanvasWidget g_sGraphUnits;
-tCanvasWidget g_sGraphUnitSpeed;
-tCanvasWidget g_sGraphUnitPower;
-tCanvasWidget g_sGraphUnitLight;
-tCanvasWidget g_sGraphUnitAccel;
-tCanvasWidget g_sGraphUnitTime;
+tPushButtonWidget g_sGraphUnitTime;
 
 /* Forward button click function declerations */
 void OnMainStartBtnClick(tWidget *psWidget);
@@ -149,19 +352,704 @@ void OnSettingsOption3UpBtnClick(tWidget *psWidget);
 void OnSettingsOption4DownBtnClick(tWidget *psWidget);
 void OnSettingsOption4UpBtnClick(tWidget *psWidget);
 void OnGraphBackBtnClick(tWidget *psWidget);
-void OnGraphSpeedChkClick(tWidget *psWidget, uint32_t bSelected);
-void OnGraphPowerChkClick(tWidget *psWidget, uint32_t bSelected);
-void OnGraphLightChkClick(tWidget *psWidget, uint32_t bSelected);
-void OnGraphAccelChkClick(tWidget *psWidget, uint32_t bSelected);
+void OnGraphChannelChkClick(tWidget *psWidget, uint32_t bSelected);
+void OnGraphUnitTimeClick(tWidget *psWidget);
 
 /* Forward widget pain function declerations */
 void OnMainDesiredSpeedPaint(tWidget *psWidget, tContext *psContext);
 void OnMainCurrentSpeedPaint(tWidget *psWidget, tContext *psContext);
+void OnMainSpeedGaugePaint(tWidget *psWidget, tContext *psContext);
+void OnMainPowerBarPaint(tWidget *psWidget, tContext *psContext);
+void OnMainAccelBarPaint(tWidget *psWidget, tContext *psContext);
+void OnMainTimePaint(tWidget *psWidget, tContext *psContext);
 void OnSettingsOption1Paint(tWidget *psWidget, tContext *psContext);
 void OnSettingsOption2Paint(tWidget *psWidget, tContext *psContext);
 void OnSettingsOption3Paint(tWidget *psWidget, tContext *psContext);
 void OnSettingsOption4Paint(tWidget *psWidget, tContext *psContext);
 void OnGraphContentPaint(tWidget *psWidget, tContext *psContext);
+
+/* Forward graph history function declerations */
+uint8_t GUI_GraphQuantise(int16_t i16Value, int16_t i16Max);
+int16_t GUI_GraphColumn(tContext *psContext, int32_t i32Bucket);
+void GUI_GraphDrawColumn(tContext *psContext, int32_t i32Bucket, bool bLead);
+void GUI_GraphInit();
+
+/* Forward dirty region function declerations */
+void GUI_Invalidate(uint8_t ui8Region);
+
+/* Forward panel transition function declerations */
+tWidget *GUI_WidgetNext(tWidget *psWidget, tWidget *psRoot);
+bool GUI_PaintTransition();
+
+/* Forward refresh schedule function declerations */
+void GUI_UpdateEStop();
+void GUI_UpdateSpeed();
+void GUI_UpdateGraph();
+void GUI_UpdateLight();
+void GUI_UpdateClock();
+void GUI_UpdateMeters();
+void GUI_UpdateOverlay();
+#pragma endregion
+
+#pragma region Dirty region table
+/**
+ * @brief Describes a region of the screen that can be invalidated and repainted on its own
+ *
+ */
+typedef struct tGUIRegion {
+	/**
+	 * @brief The panel the region is shown on
+	 */
+	tCurrentPanel ePanel;
+	/**
+	 * @brief The widget that owns the region
+	 */
+	tWidget *psWidget;
+	/**
+	 * @brief The part of the widget to repaint, or NULL for the whole widget
+	 */
+	const tRectangle *psRect;
+	/**
+	 * @brief The function that paints the part, or NULL to repaint the widget and its children
+	 */
+	void (*pfnPaint)(tWidget *psWidget, tContext *psContext);
+	/**
+	 * @brief The paint priority, 0 is never deferred and higher values are deferred first
+	 */
+	uint8_t ui8Priority;
+} tGUIRegion;
+
+/* Regions indexed by GUI_REGION_x, the root and panel regions are handled by GUI_Commit */
+const tGUIRegion gc_sRegions[GUI_REGION_COUNT] = {
+	{MAIN_PANEL, WIDGET_ROOT, NULL, NULL, 0},
+	{MAIN_PANEL, (tWidget *)&g_sMainDesiredSpeed, &gc_sDesiredSpeedRect, OnMainDesiredSpeedPaint, 0},
+	{MAIN_PANEL, (tWidget *)&g_sMainCurrentSpeed, &gc_sCurrentSpeedRect, OnMainCurrentSpeedPaint, 1},
+	{MAIN_PANEL, (tWidget *)&g_sMainTime, &g_sMainTime.sBase.sPosition, OnMainTimePaint, 3},
+	{SETTINGS_PANEL, (tWidget *)&g_sSettingsOption1Panel, &gc_sOption1Rect, OnSettingsOption1Paint, 0},
+	{SETTINGS_PANEL, (tWidget *)&g_sSettingsOption2Panel, &gc_sOption2Rect, OnSettingsOption2Paint, 0},
+	{SETTINGS_PANEL, (tWidget *)&g_sSettingsOption3Panel, &gc_sOption3Rect, OnSettingsOption3Paint, 0},
+	{SETTINGS_PANEL, (tWidget *)&g_sSettingsOption4Panel, &gc_sOption4Rect, OnSettingsOption4Paint, 0},
+	{GRAPH_PANEL, (tWidget *)&g_sGraphContent, &g_sGraphContent.sBase.sPosition, OnGraphContentPaint, 2},
+	{GRAPH_PANEL, (tWidget *)&g_sGraphUnits, NULL, NULL, 0},
+	{GRAPH_PANEL, (tWidget *)&g_sGraphUnitTime, NULL, NULL, 0},
+	{MAIN_PANEL, NULL, NULL, NULL, 0},
+	{MAIN_PANEL, (tWidget *)&g_sMainStartBtn, NULL, NULL, 0},
+	{MAIN_PANEL, (tWidget *)&g_sMainSpeedGauge, &gc_sSpeedGaugeRect, OnMainSpeedGaugePaint, 1},
+	{MAIN_PANEL, (tWidget *)&g_sMainPowerBar, &g_sPowerBar.sRect, OnMainPowerBarPaint, 3},
+	{MAIN_PANEL, (tWidget *)&g_sMainAccelBar, &g_sAccelBar.sRect, OnMainAccelBarPaint, 3},
+};
+#pragma endregion
+
+#pragma region Graph channel table
+/**
+ * @brief Describes a channel of the graph
+ *
+ */
+typedef struct tGUIGraphChannel {
+	/**
+	 * @brief The value to sample every GUI_GRAPH_PERIOD
+	 */
+	const int16_t *pi16Source;
+	/**
+	 * @brief The value drawn at the top of the graph
+	 */
+	int16_t i16Max;
+	/**
+	 * @brief The color of the trace, checkbox text and unit label
+	 */
+	uint32_t ui32Color;
+	/**
+	 * @brief The checkbox text
+	 */
+	const char *pcLabel;
+	/**
+	 * @brief The unit of the label showing the value of one horizontal grid division
+	 */
+	const char *pcUnit;
+	/**
+	 * @brief True if the channel is drawn when the GUI starts
+	 */
+	bool bEnabled;
+	/**
+	 * @brief The buckets kept on each history level, at least GRAPH_COLUMN_MAX so the widest plot fills
+	 */
+	uint16_t ui16Depth;
+} tGUIGraphChannel;
+
+/* Channels in history order, a new channel only needs an entry */
+const tGUIGraphChannel gc_sGraphChannels[] = {
+	{&g_sSnapshot.i16Speed, MAX_SPEED, ClrRed, " Speed (RPM)", "RPM", true, GRAPH_COLUMN_MAX},
+	{&g_sSnapshot.i16Power, MAX_POWER, ClrBlue, " Power (W)", "W", true, GRAPH_COLUMN_MAX},
+	{&g_sSnapshot.i16Light, MAX_LIGHT, ClrLime, " Light (lux)", "lux", false, GRAPH_COLUMN_MAX},
+	{&g_sSnapshot.i16Accel, MAX_ACCEL, ClrYellow, " Accel (m/s^2)", "m/s^2", false, GRAPH_COLUMN_MAX},
+};
+
+_Static_assert(GRAPH_CHANNEL_COUNT <= HISTORY_CHANNEL_MAX, "More graph channels than the history holds");
+_Static_assert(GRAPH_CHANNEL_COUNT * HISTORY_LEVEL_COUNT * GRAPH_COLUMN_MAX * sizeof(tHistoryBucket) <= HISTORY_RAM_BUDGET,
+			   "HISTORY_RAM_BUDGET cannot fill the plot for every graph channel");
+
+/* Widgets and display colors of each channel */
+uint16_t ga_ui16GraphChannelColor[GRAPH_CHANNEL_COUNT];
+tCheckBoxWidget ga_sGraphChannelChk[GRAPH_CHANNEL_COUNT];
+tCanvasWidget ga_sGraphChannelUnit[GRAPH_CHANNEL_COUNT];
+char ga_cGraphChannelUnit[GRAPH_CHANNEL_COUNT][GRAPH_UNIT_TEXT];
+#pragma endregion
+
+#pragma region Refresh schedule table
+/**
+ * @brief Describes a dynamic element of the GUI that is refreshed at its own rate
+ *
+ */
+typedef struct tGUIUpdate {
+	/**
+	 * @brief The function that refreshes the element, it invalidates the regions that changed
+	 */
+	void (*pfnUpdate)();
+	/**
+	 * @brief The refresh period (ms), rounded up to a multiple of GUI_PULSE_PERIOD
+	 */
+	uint16_t ui16Period;
+} tGUIUpdate;
+
+/* Updates in priority order, the regions they invalidate carry the matching paint priority */
+const tGUIUpdate gc_sUpdates[] = {
+	{GUI_UpdateEStop, GUI_PULSE_PERIOD},
+	{GUI_UpdateSpeed, 50},
+	{GUI_UpdateGraph, GUI_GRAPH_PERIOD},
+	{GUI_UpdateLight, 200},
+	{GUI_UpdateClock, 1000},
+	{GUI_UpdateMeters, 100},
+	{GUI_UpdateOverlay, GUI_OVERLAY_PERIOD},
+};
+#define GUI_UPDATE_COUNT (sizeof(gc_sUpdates) / sizeof(gc_sUpdates[0]))
+
+/* Clock tick at which each update is next due */
+uint32_t ga_ui32UpdateDue[GUI_UPDATE_COUNT];
+#pragma endregion
+
+#pragma region Dirty region functions
+/**
+ * @brief Internal function to mark a region as needing a repaint in the next frame
+ *
+ * @param ui8Region The GUI_REGION_x to repaint
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_Invalidate(uint8_t ui8Region) {
+	if (ui8Region >= GUI_REGION_COUNT)
+		return;
+
+	/* Wake the render task to schedule the frame */
+	if (g_ui32DirtyRegions == 0)
+		Event_post(g_hGUIRenderEvent, GUI_EVENT_RENDER);
+	g_ui32DirtyRegions |= 1 << ui8Region;
+}
+
+/**
+ * @brief Internal function to get the time until the next frame may be painted
+ *
+ * @return The number of clock ticks to wait, or BIOS_WAIT_FOREVER if nothing is dirty
+ *
+ * @note This function is not intended to be called by the user
+ */
+UInt32 GUI_FrameTimeout() {
+	if (g_ui32DirtyRegions == 0)
+		return BIOS_WAIT_FOREVER;
+
+	UInt32 ui32Elapsed = Clock_getTicks() - g_ui32LastFrame;
+	if (ui32Elapsed >= GUI_FRAME_PERIOD)
+		return 0;
+	return GUI_FRAME_PERIOD - ui32Elapsed;
+}
+
+/**
+ * @brief Internal function to let the input task run between two chunks of painting
+ *
+ * @return False if a root or panel repaint was requested meanwhile, making the paint in progress stale
+ *
+ * @note This function must only be called by the render task while it holds the GUI gate
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_Yield() {
+	GateMutexPri_leave(g_hGUIGate, g_iGUIGateKey);
+	g_iGUIGateKey = GateMutexPri_enter(g_hGUIGate);
+
+	return !(g_ui32DirtyRegions & GUI_REGION_RESTART);
+}
+
+/**
+ * @brief Internal function to fill a rectangle a chunk at a time, yielding to the input task after each chunk
+ *
+ * @param psRect The rectangle to fill
+ * @param ui32Color The color to fill it with
+ * @return False if the fill was cancelled by GUI_Yield
+ *
+ * @note Each chunk is a band of rows of at most GUI_FILL_CHUNK_PIXELS pixels
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_FillChunked(const tRectangle *psRect, uint32_t ui32Color) {
+	int32_t i32Rows = GUI_FILL_CHUNK_PIXELS / (psRect->i16XMax - psRect->i16XMin + 1);
+	if (i32Rows < 1)
+		i32Rows = 1;
+
+	tRectangle sBand = *psRect;
+	for (int32_t i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y += i32Rows) {
+		sBand.i16YMin = i32Y;
+		sBand.i16YMax = i32Y + i32Rows - 1 < psRect->i16YMax ? i32Y + i32Rows - 1 : psRect->i16YMax;
+
+		/* The context is set again for every chunk, as the input task may paint while yielding */
+		GrContextClipRegionSet(&g_sContext, &sBand);
+		GrContextForegroundSet(&g_sContext, ui32Color);
+		GrRectFill(&g_sContext, &sBand);
+		if (!GUI_Yield())
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Internal function to get the style and fill color of a widget that fills its background
+ *
+ * @param psWidget The widget
+ * @param pui32Fill Set to the style bit that turns the fill on
+ * @param pui32Color Set to the color the widget fills with
+ * @return The style of the widget, or NULL if it is neither a canvas nor a push button
+ *
+ * @note The time bar is a canvas while the performance overlay is hidden
+ * @note This function is not intended to be called by the user
+ */
+uint32_t *GUI_WidgetFill(tWidget *psWidget, uint32_t *pui32Fill, uint32_t *pui32Color) {
+	if (psWidget->pfnMsgProc == CanvasMsgProc || (psWidget == (tWidget *)&g_sMainTime && !g_bOverlay)) {
+		tCanvasWidget *psCanvas = (tCanvasWidget *)psWidget;
+		*pui32Fill = CANVAS_STYLE_FILL;
+		*pui32Color = psCanvas->ui32FillColor;
+		return &psCanvas->ui32Style;
+	}
+
+	if (psWidget->pfnMsgProc == RectangularButtonMsgProc) {
+		tPushButtonWidget *psButton = (tPushButtonWidget *)psWidget;
+		*pui32Fill = PB_STYLE_FILL;
+		*pui32Color = psButton->ui32Style & PB_STYLE_PRESSED ? psButton->ui32PressFillColor : psButton->ui32FillColor;
+		return &psButton->ui32Style;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Internal function to paint a widget without its children, so that no step takes longer than a chunk
+ *
+ * @param psWidget The widget to paint
+ * @return False if the paint was cancelled by GUI_Yield
+ *
+ * @note A fill of more than GUI_FILL_CHUNK_PIXELS is painted by GUI_FillChunked, then the widget is painted
+ *		 over it with its fill turned off
+ * @note This function must only be called by the render task while it holds the GUI gate
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_PaintWidget(tWidget *psWidget) {
+	const tRectangle *psRect = &psWidget->sPosition;
+	uint32_t ui32Fill, ui32Color;
+	uint32_t *pui32Style = GUI_WidgetFill(psWidget, &ui32Fill, &ui32Color);
+	if (pui32Style == NULL || !(*pui32Style & ui32Fill) ||
+		(psRect->i16XMax - psRect->i16XMin + 1) * (psRect->i16YMax - psRect->i16YMin + 1) <= GUI_FILL_CHUNK_PIXELS) {
+		psWidget->pfnMsgProc(psWidget, WIDGET_MSG_PAINT, 0, 0);
+		return true;
+	}
+
+	if (!GUI_FillChunked(psRect, ui32Color))
+		return false;
+
+	/* A press while yielding changes the fill and has painted the widget already */
+	uint32_t ui32Now;
+	pui32Style = GUI_WidgetFill(psWidget, &ui32Fill, &ui32Now);
+	if (pui32Style == NULL || ui32Now != ui32Color)
+		return true;
+
+	/* Plain containers have nothing else to paint */
+	if (*pui32Style == ui32Fill)
+		return true;
+
+	*pui32Style &= ~ui32Fill;
+	psWidget->pfnMsgProc(psWidget, WIDGET_MSG_PAINT, 0, 0);
+	*pui32Style |= ui32Fill;
+	return true;
+}
+
+/**
+ * @brief Internal function to paint a widget and its children, parents before children
+ *
+ * @param psTree The widget to paint
+ * @param bChunked True to paint every widget with GUI_PaintWidget and yield to the input task after it
+ * @return False if the paint was cancelled by GUI_Yield
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_PaintTree(tWidget *psTree, bool bChunked) {
+	for (tWidget *psWidget = psTree; psWidget != NULL; psWidget = GUI_WidgetNext(psWidget, psTree)) {
+		if (!bChunked) {
+			psWidget->pfnMsgProc(psWidget, WIDGET_MSG_PAINT, 0, 0);
+			continue;
+		}
+
+		/* The tree may have changed while yielding, so stop before walking it any further */
+		if (!GUI_PaintWidget(psWidget) || !GUI_Yield())
+			return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Internal function to repaint one region
+ *
+ * @param ui8Region The GUI_REGION_x to repaint
+ * @return False if the paint was cancelled
+ *
+ * @note Widget trees are painted in chunks, the paint functions of regions yield by themselves if they need to
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_PaintRegion(uint8_t ui8Region) {
+	const tGUIRegion *psRegion = &gc_sRegions[ui8Region];
+
+	if (psRegion->pfnPaint == NULL)
+		return GUI_PaintTree(psRegion->psWidget, true);
+
+	/* Paint only the part of the widget that changed */
+	tRectangle sClip = *psRegion->psRect;
+	GrContextClipRegionSet(&g_sContext, &sClip);
+	psRegion->pfnPaint(psRegion->psWidget, &g_sContext);
+	return true;
+}
+
+/**
+ * @brief Internal function to make every readout and the graph plot draw themselves in full on their next paint
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_ResetReadouts() {
+	for (uint8_t i = 0; i < sizeof(gc_psNumerics) / sizeof(gc_psNumerics[0]); i++) {
+		Numeric_Reset(gc_psNumerics[i]);
+	}
+	Gauge_Reset(&g_sSpeedGauge);
+	Bar_Reset(&g_sPowerBar);
+	Bar_Reset(&g_sAccelBar);
+	g_bOverlayLabels = false;
+	g_bGraphRedraw = true;
+}
+
+/**
+ * @brief Internal function to repaint every dirty region in a single pass
+ *
+ * @note A dirty root supersedes all other regions, a panel transition is painted before the other regions
+ * @note Once the frame budget is used up, regions with a priority above 0 stay dirty until the next frame
+ * @note The input task runs between regions and between the chunks of long paints, a root or panel repaint
+ *		 requested meanwhile cancels the frame, which is then restarted at once
+ * @note This function must only be called by the render task while it holds the GUI gate
+ * @note This function is not intended to be called by the user
+ */
+void GUI_Commit() {
+	uint32_t ui32Start = Timestamp_get32();
+	uint32_t ui32Dirty = g_ui32DirtyRegions;
+	uint32_t ui32Pulse = g_ui32PaintPulse;
+	g_ui32DirtyRegions = 0;
+	g_ui32PaintPulse = 0;
+	g_ui32LastFrame = Clock_getTicks();
+
+	if (ui32Dirty & (1 << GUI_REGION_ROOT)) {
+		ui32Dirty = 1 << GUI_REGION_ROOT;
+		g_psTransitionFrom = NULL;
+
+		/* The panel background is cleared, so every readout has to be drawn again */
+		GUI_ResetReadouts();
+	}
+
+	bool bCancelled = false;
+	bool bDeferred = false;
+	if (ui32Dirty & (1 << GUI_REGION_PANEL)) {
+		ui32Dirty &= ~(1 << GUI_REGION_PANEL);
+
+		g_bFullRepaint = true;
+		if (!GUI_PaintTransition()) {
+			/* A half painted transition leaves a mix of both panels on screen */
+			ui32Dirty = 1 << GUI_REGION_ROOT;
+			bCancelled = true;
+		}
+	}
+
+	g_bFullRepaint = ui32Dirty & (1 << GUI_REGION_ROOT);
+	for (uint8_t ui8Priority = 0; ui8Priority < GUI_PRIORITY_COUNT && !bCancelled; ui8Priority++) {
+		for (uint8_t i = 0; i < GUI_REGION_COUNT && !bCancelled; i++) {
+			if (!(ui32Dirty & (1 << i)) || gc_sRegions[i].ui8Priority != ui8Priority)
+				continue;
+			ui32Dirty &= ~(1 << i);
+			if (i != GUI_REGION_ROOT && gc_sRegions[i].ePanel != g_eCurrentPanel)
+				continue;
+
+			/* Defer to the next frame when out of budget */
+			if (ui8Priority > 0 && Timestamp_get32() - ui32Start >= g_ui32FrameBudget) {
+				g_ui32DirtyRegions |= 1 << i;
+				g_sFrameStats.ui32Deferred++;
+				bDeferred = true;
+				continue;
+			}
+
+			/* A region that invalidates itself again has more chunks to paint, keep going while in budget */
+			do {
+				g_ui32DirtyRegions &= ~(1 << i);
+				if (!GUI_PaintRegion(i) || !GUI_Yield()) {
+					ui32Dirty |= 1 << i;
+					bCancelled = true;
+				}
+			} while (!bCancelled && (g_ui32DirtyRegions & (1 << i)) &&
+					 Timestamp_get32() - ui32Start < g_ui32FrameBudget);
+		}
+	}
+	g_bFullRepaint = false;
+
+	if (bCancelled) {
+		/* Put back what was not painted and start over without waiting for the frame period */
+		g_ui32DirtyRegions |= ui32Dirty;
+		g_ui32LastFrame = Clock_getTicks() - GUI_FRAME_PERIOD;
+		g_sFrameStats.ui32Cancelled++;
+		if (ui32Pulse != 0)
+			g_ui32PaintPulse = ui32Pulse;
+		return;
+	}
+
+	/* Account for the frame */
+	uint32_t ui32Elapsed = Timestamp_get32() - ui32Start;
+	g_sFrameStats.ui32Frames++;
+	if (ui32Elapsed > g_ui32FrameBudget)
+		g_sFrameStats.ui32Overruns++;
+	if (ui32Elapsed > g_sFrameStats.ui32WorstTime)
+		g_sFrameStats.ui32WorstTime = ui32Elapsed;
+
+	/* A pulse is only painted once nothing it changed is deferred, the oldest waiting pulse is kept */
+	if (ui32Pulse != 0 && bDeferred) {
+		g_ui32PaintPulse = ui32Pulse;
+	} else if (ui32Pulse != 0) {
+		uint32_t ui32Latency = (Timestamp_get32() | 1) - ui32Pulse;
+		if (ui32Latency > g_sFrameStats.ui32WorstPulseLatency)
+			g_sFrameStats.ui32WorstPulseLatency = ui32Latency;
+		if (ui32Latency > g_ui32OverlayPulseLatency)
+			g_ui32OverlayPulseLatency = ui32Latency;
+	}
+}
+#pragma endregion
+
+#pragma region Panel transition functions
+/* Panel widget of each tCurrentPanel */
+tWidget *const gc_psPanels[] = {
+	(tWidget *)&g_sMainPanel,
+	(tWidget *)&g_sSettingsPanel,
+	(tWidget *)&g_sGraphPanel,
+};
+
+/**
+ * @brief Internal function to walk a widget tree in pre-order
+ *
+ * @param psWidget The current widget
+ * @param psRoot The root of the tree, which is not visited
+ * @return The next widget, or NULL once the tree is exhausted
+ *
+ * @note This function is not intended to be called by the user
+ */
+tWidget *GUI_WidgetNext(tWidget *psWidget, tWidget *psRoot) {
+	if (psWidget->psChild != NULL)
+		return psWidget->psChild;
+
+	while (psWidget != psRoot && psWidget->psNext == NULL) {
+		psWidget = psWidget->psParent;
+	}
+
+	return psWidget == psRoot ? NULL : psWidget->psNext;
+}
+
+/**
+ * @brief Internal function to check if a widget draws nothing over a background
+ *
+ * @param psWidget The widget to check
+ * @param ui32Background The background color
+ * @return True if painting the widget leaves the background unchanged
+ *
+ * @note Only plain canvases are transparent, such as the containers that group the widgets of a panel
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_WidgetTransparent(tWidget *psWidget, uint32_t ui32Background) {
+	if (psWidget->pfnMsgProc != CanvasMsgProc)
+		return false;
+
+	tCanvasWidget *psCanvas = (tCanvasWidget *)psWidget;
+	if (psCanvas->ui32Style & (CANVAS_STYLE_OUTLINE | CANVAS_STYLE_TEXT | CANVAS_STYLE_IMG | CANVAS_STYLE_APP_DRAWN))
+		return false;
+
+	return !(psCanvas->ui32Style & CANVAS_STYLE_FILL) || psCanvas->ui32FillColor == ui32Background;
+}
+
+/**
+ * @brief Internal function to check if two widgets look the same on screen
+ *
+ * @param psA The first widget
+ * @param psB The second widget
+ * @return True if painting either widget produces the same pixels
+ *
+ * @note Widgets that are drawn by the application are only the same as themselves
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_WidgetSame(tWidget *psA, tWidget *psB) {
+	if (psA == psB)
+		return true;
+	if (psA->pfnMsgProc != psB->pfnMsgProc || memcmp(&psA->sPosition, &psB->sPosition, sizeof(tRectangle)) != 0)
+		return false;
+
+	if (psA->pfnMsgProc == RectangularButtonMsgProc) {
+		tPushButtonWidget *psButtonA = (tPushButtonWidget *)psA;
+		tPushButtonWidget *psButtonB = (tPushButtonWidget *)psB;
+
+		return psButtonA->ui32Style == psButtonB->ui32Style && psButtonA->ui32FillColor == psButtonB->ui32FillColor &&
+			   psButtonA->ui32OutlineColor == psButtonB->ui32OutlineColor && psButtonA->ui32TextColor == psButtonB->ui32TextColor &&
+			   psButtonA->psFont == psButtonB->psFont && psButtonA->pui8Image == psButtonB->pui8Image &&
+			   (psButtonA->pcText == psButtonB->pcText || (psButtonA->pcText != NULL && psButtonB->pcText != NULL && strcmp(psButtonA->pcText, psButtonB->pcText) == 0));
+	}
+
+	if (psA->pfnMsgProc == CanvasMsgProc) {
+		tCanvasWidget *psCanvasA = (tCanvasWidget *)psA;
+		tCanvasWidget *psCanvasB = (tCanvasWidget *)psB;
+
+		if ((psCanvasA->ui32Style | psCanvasB->ui32Style) & CANVAS_STYLE_APP_DRAWN)
+			return false;
+
+		return psCanvasA->ui32Style == psCanvasB->ui32Style && psCanvasA->ui32FillColor == psCanvasB->ui32FillColor &&
+			   psCanvasA->ui32OutlineColor == psCanvasB->ui32OutlineColor && psCanvasA->ui32TextColor == psCanvasB->ui32TextColor &&
+			   psCanvasA->psFont == psCanvasB->psFont && psCanvasA->pui8Image == psCanvasB->pui8Image &&
+			   (psCanvasA->pcText == psCanvasB->pcText || (psCanvasA->pcText != NULL && psCanvasB->pcText != NULL && strcmp(psCanvasA->pcText, psCanvasB->pcText) == 0));
+	}
+
+	/* Other widget types carry state that is not compared */
+	return false;
+}
+
+/**
+ * @brief Internal function to find a widget that looks the same in another panel
+ *
+ * @param psWidget The widget to look for
+ * @param psPanel The panel to search
+ * @return True if the panel contains a widget that looks the same
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_PanelContains(tWidget *psWidget, tWidget *psPanel) {
+	for (tWidget *psOther = psPanel->psChild; psOther != NULL; psOther = GUI_WidgetNext(psOther, psPanel)) {
+		if (GUI_WidgetSame(psWidget, psOther))
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Internal function to check if two rectangles overlap
+ *
+ * @param psA The first rectangle
+ * @param psB The second rectangle
+ * @return True if the rectangles share at least one pixel
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_RectOverlaps(const tRectangle *psA, const tRectangle *psB) {
+	return psA->i16XMin <= psB->i16XMax && psB->i16XMin <= psA->i16XMax && psA->i16YMin <= psB->i16YMax && psB->i16YMin <= psA->i16YMax;
+}
+
+/**
+ * @brief Internal function to switch the panel shown on screen
+ *
+ * @param eNext The panel to show
+ *
+ * @note The screen is updated in the next frame, only the widgets that differ between the panels are repainted
+ * @note This function is not intended to be called by the user
+ */
+void GUI_SwitchPanel(tCurrentPanel eNext) {
+	if (eNext == g_eCurrentPanel)
+		return;
+
+	/* Several switches within one frame transition from the panel that is still on screen */
+	if (g_psTransitionFrom == NULL)
+		g_psTransitionFrom = gc_psPanels[g_eCurrentPanel];
+
+	WidgetRemove(gc_psPanels[g_eCurrentPanel]);
+	WidgetAdd(WIDGET_ROOT, gc_psPanels[eNext]);
+	g_eCurrentPanel = eNext;
+	GUI_Invalidate(GUI_REGION_PANEL);
+}
+
+/**
+ * @brief Internal function to repaint the difference between the outgoing and incoming panel
+ *
+ * @return False if the transition was cancelled by GUI_Yield before it was fully painted
+ *
+ * @note Outgoing widgets without a twin are erased to the background, then incoming widgets without a twin
+ *		 and twins that overlap an erased area are painted, yielding to the input task after each widget
+ * @note This function is not intended to be called by the user
+ */
+bool GUI_PaintTransition() {
+	tWidget *psFrom = g_psTransitionFrom;
+	tWidget *psTo = gc_psPanels[g_eCurrentPanel];
+	g_psTransitionFrom = NULL;
+	if (psFrom == NULL || psFrom == psTo)
+		return true;
+
+	uint32_t ui32Start = Timestamp_get32();
+	uint32_t ui32Background = ((tCanvasWidget *)psTo)->ui32FillColor;
+	tRectangle sErased[GUI_TRANSITION_ERASE_MAX];
+	uint8_t ui8Erased = 0;
+
+	/* Find what only the outgoing panel drew */
+	for (tWidget *psWidget = psFrom->psChild; psWidget != NULL; psWidget = GUI_WidgetNext(psWidget, psFrom)) {
+		if (GUI_WidgetTransparent(psWidget, ui32Background) || GUI_PanelContains(psWidget, psTo))
+			continue;
+
+		if (ui8Erased == GUI_TRANSITION_ERASE_MAX) {
+			/* Too many differences to track, fall back to a full repaint */
+			GUI_ResetReadouts();
+			return GUI_PaintTree(WIDGET_ROOT, true);
+		}
+		sErased[ui8Erased++] = psWidget->sPosition;
+	}
+
+	/* Erase it */
+	for (uint8_t i = 0; i < ui8Erased; i++) {
+		if (!GUI_FillChunked(&sErased[i], ui32Background))
+			return false;
+	}
+
+	/* The readouts of the incoming panel are drawn from scratch */
+	GUI_ResetReadouts();
+
+	/* Paint what differs or was erased, parents before children */
+	for (tWidget *psWidget = psTo->psChild; psWidget != NULL; psWidget = GUI_WidgetNext(psWidget, psTo)) {
+		if (GUI_WidgetTransparent(psWidget, ui32Background))
+			continue;
+
+		bool bPaint = !GUI_PanelContains(psWidget, psFrom);
+		for (uint8_t i = 0; i < ui8Erased && !bPaint; i++) {
+			bPaint = GUI_RectOverlaps(&psWidget->sPosition, &sErased[i]);
+		}
+
+		if (!bPaint)
+			continue;
+
+		if (!GUI_PaintWidget(psWidget) || !GUI_Yield())
+			return false;
+	}
+
+	uint32_t ui32Elapsed = Timestamp_get32() - ui32Start;
+	g_sFrameStats.ui32Transitions++;
+	if (ui32Elapsed > g_sFrameStats.ui32WorstTransition)
+		g_sFrameStats.ui32WorstTransition = ui32Elapsed;
+	return true;
+}
 #pragma endregion
 
 #pragma region Main panel widget constructors
@@ -356,7 +1244,7 @@ RectangularButton(
 RectangularButton(
 	g_sMainDesiredSpeedDownBtn,												 // struct name
 	&g_sMainContent,														 // parent widget pointer
-	NULL,																	 // sibling widget pointer
+	&g_sMainSpeedGauge,														 // sibling widget pointer
 	NULL,																	 // child widget pointer
 	DISPLAY,																 // display device pointer
 	214,																	 // x position
@@ -376,6 +1264,63 @@ RectangularButton(
 	AUTO_REPEAT_RATE,														 // auto repeat rate
 	OnMainSpeedDownBtnClick													 // on-click function pointer
 );
+Canvas(
+	g_sMainSpeedGauge,		// struct name
+	&g_sMainContent,		// parent widget pointer
+	&g_sMainPowerBar,		// sibling widget pointer
+	NULL,					// child widget pointer
+	DISPLAY,				// display device pointer
+	229,					// x position
+	107,					// y position
+	67,						// width
+	67,						// height
+	CANVAS_STYLE_APP_DRAWN, // style
+	NULL,					// fill color
+	NULL,					// outline color
+	NULL,					// text color
+	NULL,					// font pointer
+	NULL,					// text
+	NULL,					// image pointer
+	OnMainSpeedGaugePaint	// on-paint function pointer
+);
+Canvas(
+	g_sMainPowerBar,		// struct name
+	&g_sMainContent,		// parent widget pointer
+	&g_sMainAccelBar,		// sibling widget pointer
+	NULL,					// child widget pointer
+	DISPLAY,				// display device pointer
+	215,					// x position
+	107,					// y position
+	12,						// width
+	67,						// height
+	CANVAS_STYLE_APP_DRAWN, // style
+	NULL,					// fill color
+	NULL,					// outline color
+	NULL,					// text color
+	NULL,					// font pointer
+	NULL,					// text
+	NULL,					// image pointer
+	OnMainPowerBarPaint		// on-paint function pointer
+);
+Canvas(
+	g_sMainAccelBar,		// struct name
+	&g_sMainContent,		// parent widget pointer
+	NULL,					// sibling widget pointer
+	NULL,					// child widget pointer
+	DISPLAY,				// display device pointer
+	298,					// x position
+	107,					// y position
+	12,						// width
+	67,						// height
+	CANVAS_STYLE_APP_DRAWN, // style
+	NULL,					// fill color
+	NULL,					// outline color
+	NULL,					// text color
+	NULL,					// font pointer
+	NULL,					// text
+	NULL,					// image pointer
+	OnMainAccelBarPaint		// on-paint function pointer
+);
 #pragma endregion
 
 #pragma region Settings panel widget constructors
@@ -727,7 +1672,7 @@ Canvas(
 RectangularButton(
 	g_sGraphBackBtn,								  // struct name
 	&g_sGraphPanel,									  // parent widget pointer
-	&g_sGraphSpeedChk,								  // sibling widget pointer
+	&g_sGraphContent,								  // sibling widget pointer
 	NULL,											  // child widget pointer
 	DISPLAY,										  // display device pointer
 	6,												  // x position
@@ -747,86 +1692,6 @@ RectangularButton(
 	0,												  // auto repeat rate
 	OnGraphBackBtnClick								  // on-click function pointer
 );
-CheckBox(
-	g_sGraphSpeedChk,				   // struct name
-	&g_sGraphPanel,					   // parent widget pointer
-	&g_sGraphPowerChk,				   // sibling widget pointer
-	NULL,							   // child widget pointer
-	DISPLAY,						   // display device pointer
-	82,								   // x position
-	182,							   // y position
-	108,							   // width
-	23,								   // height
-	CB_STYLE_TEXT | CB_STYLE_SELECTED, // style
-	23,								   // box size
-	NULL,							   // fill color
-	ClrWhite,						   // outline color
-	ClrRed,							   // text color
-	&g_sFontNf10,					   // font pointer
-	" Speed (RPM)",					   // text
-	NULL,							   // image pointer
-	OnGraphSpeedChkClick			   // on-change function pointer
-);
-CheckBox(
-	g_sGraphPowerChk,				   // struct name
-	&g_sGraphPanel,					   // parent widget pointer
-	&g_sGraphLightChk,				   // sibling widget pointer
-	NULL,							   // child widget pointer
-	DISPLAY,						   // display device pointer
-	82,								   // x position
-	211,							   // y position
-	108,							   // width
-	23,								   // height
-	CB_STYLE_TEXT | CB_STYLE_SELECTED, // style
-	23,								   // box size
-	NULL,							   // fill color
-	ClrWhite,						   // outline color
-	ClrBlue,						   // text color
-	&g_sFontNf10,					   // font pointer
-	" Power (W)",					   // text
-	NULL,							   // image pointer
-	OnGraphPowerChkClick			   // on-change function pointer
-);
-CheckBox(
-	g_sGraphLightChk,	 // struct name
-	&g_sGraphPanel,		 // parent widget pointer
-	&g_sGraphAccelChk,	 // sibling widget pointer
-	NULL,				 // child widget pointer
-	DISPLAY,			 // display device pointer
-	196,				 // x position
-	182,				 // y position
-	128,				 // width
-	23,					 // height
-	CB_STYLE_TEXT,		 // style
-	23,					 // box size
-	NULL,				 // fill color
-	ClrWhite,			 // outline color
-	ClrLime,			 // text color
-	&g_sFontNf10,		 // font pointer
-	" Light (lux)",		 // text
-	NULL,				 // image pointer
-	OnGraphLightChkClick // on-change function pointer
-);
-CheckBox(
-	g_sGraphAccelChk,	 // struct name
-	&g_sGraphPanel,		 // parent widget pointer
-	&g_sGraphContent,	 // sibling widget pointer
-	NULL,				 // child widget pointer
-	DISPLAY,			 // display device pointer
-	196,				 // x position
-	211,				 // y position
-	128,				 // width
-	23,					 // height
-	CB_STYLE_TEXT,		 // style
-	23,					 // box size
-	NULL,				 // fill color
-	ClrWhite,			 // outline color
-	ClrYellow,			 // text color
-	&g_sFontNf10,		 // font pointer
-	" Accel (m/s^2)",	 // text
-	NULL,				 // image pointer
-	OnGraphAccelChkClick // on-change function pointer
-);
 Canvas(
 	g_sGraphContent,							   // struct name
 	&g_sGraphPanel,								   // parent widget pointer
@@ -850,7 +1715,7 @@ Canvas(
 	g_sGraphUnits,		// struct name
 	&g_sGraphPanel,		// parent widget pointer
 	NULL,				// sibling widget pointer
-	&g_sGraphUnitSpeed, // child widget pointer
+	&g_sGraphUnitTime,	// child widget pointer
 	DISPLAY,			// display device pointer
 	6,					// x position
 	6,					// y position
@@ -865,100 +1730,28 @@ Canvas(
 	NULL,				// image pointer
 	NULL				// on-paint function pointer
 );
-Canvas(
-	g_sGraphUnitSpeed,																								  // struct name
-	&g_sGraphUnits,																									  // parent widget pointer
-	&g_sGraphUnitPower,																								  // sibling widget pointer
-	NULL,																											  // child widget pointer
-	DISPLAY,																										  // display device pointer
-	6,																												  // x position
-	6,																												  // y position
-	62,																												  // width
-	13,																												  // height
-	CANVAS_STYLE_FILL | CANVAS_STYLE_OUTLINE | CANVAS_STYLE_TEXT | CANVAS_STYLE_TEXT_HCENTER | CANVAS_STYLE_TEXT_TOP, // style
-	ClrBlack,																										  // fill color
-	ClrRed,																											  // outline color
-	ClrRed,																											  // text color
-	&g_sFontNf10,																									  // font pointer
-	GRAPH_UNIT_SPEED,																								  // text
-	NULL,																											  // image pointer
-	NULL																											  // on-paint function pointer
-);
-Canvas(
-	g_sGraphUnitPower,																								  // struct name
-	&g_sGraphUnits,																									  // parent widget pointer
-	&g_sGraphUnitLight,																								  // sibling widget pointer
-	NULL,																											  // child widget pointer
-	DISPLAY,																										  // display device pointer
-	68,																												  // x position
-	6,																												  // y position
-	62,																												  // width
-	13,																												  // height
-	CANVAS_STYLE_FILL | CANVAS_STYLE_OUTLINE | CANVAS_STYLE_TEXT | CANVAS_STYLE_TEXT_HCENTER | CANVAS_STYLE_TEXT_TOP, // style
-	ClrBlack,																										  // fill color
-	ClrBlue,																										  // outline color
-	ClrBlue,																										  // text color
-	&g_sFontNf10,																									  // font pointer
-	GRAPH_UNIT_POWER,																								  // text
-	NULL,																											  // image pointer
-	NULL																											  // on-paint function pointer
-);
-Canvas(
-	g_sGraphUnitLight,													   // struct name
-	&g_sGraphUnits,														   // parent widget pointer
-	&g_sGraphUnitAccel,													   // sibling widget pointer
-	NULL,																   // child widget pointer
-	DISPLAY,															   // display device pointer
-	130,																   // x position
-	6,																	   // y position
-	62,																	   // width
-	13,																	   // height
-	CANVAS_STYLE_FILL | CANVAS_STYLE_TEXT_HCENTER | CANVAS_STYLE_TEXT_TOP, // style
-	ClrBlack,															   // fill color
-	ClrLime,															   // outline color
-	ClrLime,															   // text color
-	&g_sFontNf10,														   // font pointer
-	GRAPH_UNIT_LIGHT,													   // text
-	NULL,																   // image pointer
-	NULL																   // on-paint function pointer
-);
-Canvas(
-	g_sGraphUnitAccel,													   // struct name
-	&g_sGraphUnits,														   // parent widget pointer
-	&g_sGraphUnitTime,													   // sibling widget pointer
-	NULL,																   // child widget pointer
-	DISPLAY,															   // display device pointer
-	192,																   // x position
-	6,																	   // y position
-	62,																	   // width
-	13,																	   // height
-	CANVAS_STYLE_FILL | CANVAS_STYLE_TEXT_HCENTER | CANVAS_STYLE_TEXT_TOP, // style
-	ClrBlack,															   // fill color
-	ClrYellow,															   // outline color
-	ClrYellow,															   // text color
-	&g_sFontNf10,														   // font pointer
-	GRAPH_UNIT_ACCEL,													   // text
-	NULL,																   // image pointer
-	NULL																   // on-paint function pointer
-);
-Canvas(
-	g_sGraphUnitTime,																								  // struct name
-	&g_sGraphUnits,																									  // parent widget pointer
-	NULL,																											  // sibling widget pointer
-	NULL,																											  // child widget pointer
-	DISPLAY,																										  // display device pointer
-	254,																											  // x position
-	6,																												  // y position
-	60,																												  // width
-	13,																												  // height
-	CANVAS_STYLE_FILL | CANVAS_STYLE_OUTLINE | CANVAS_STYLE_TEXT | CANVAS_STYLE_TEXT_HCENTER | CANVAS_STYLE_TEXT_TOP, // style
-	ClrBlack,																										  // fill color
-	ClrWhite,																										  // outline color
-	ClrWhite,																										  // text color
-	&g_sFontNf10,																									  // font pointer
-	GRAPH_UNIT_TIME,																								  // text
-	NULL,																											  // image pointer
-	NULL																											  // on-paint function pointer
+RectangularButton(
+	g_sGraphUnitTime,								  // struct name
+	&g_sGraphUnits,									  // parent widget pointer
+	NULL,											  // sibling widget pointer
+	NULL,											  // child widget pointer
+	DISPLAY,										  // display device pointer
+	254,											  // x position
+	6,												  // y position
+	60,												  // width
+	13,												  // height
+	PB_STYLE_OUTLINE | PB_STYLE_TEXT | PB_STYLE_FILL, // style
+	ClrBlack,										  // fill color
+	ClrDimGray,										  // press fill color
+	ClrWhite,										  // outline color
+	ClrWhite,										  // text color
+	&g_sFontNf10,									  // font pointer
+	"dX:2.8s",										  // text
+	NULL,											  // image pointer
+	NULL,											  // press image pointer
+	0,												  // auto repeat delay
+	0,												  // auto repeat rate
+	OnGraphUnitTimeClick							  // on-click function pointer
 );
 #pragma endregion
 
@@ -992,7 +1785,7 @@ void OnMainStartBtnClick(tWidget *pWidget) {
  */
 void OnMainSpeedUpBtnClick(tWidget *pWidget) {
 	g_i16DesiredSpeed++;
-	WidgetPaint((tWidget *)&g_sMainDesiredSpeed);
+	GUI_Invalidate(GUI_REGION_DESIRED_SPEED);
 
 	GUI_InvokeCallback(GUI_MOTOR_SPEED_CHANGE, g_i16DesiredSpeed, NULL);
 }
@@ -1004,7 +1797,7 @@ void OnMainSpeedUpBtnClick(tWidget *pWidget) {
  */
 void OnMainSpeedDownBtnClick(tWidget *pWidget) {
 	g_i16DesiredSpeed--;
-	WidgetPaint((tWidget *)&g_sMainDesiredSpeed);
+	GUI_Invalidate(GUI_REGION_DESIRED_SPEED);
 
 	GUI_InvokeCallback(GUI_MOTOR_SPEED_CHANGE, g_i16DesiredSpeed, NULL);
 }
@@ -1015,10 +1808,7 @@ void OnMainSpeedDownBtnClick(tWidget *pWidget) {
  * @param pWidget The widget that triggered the event
  */
 void OnMainSettingsBtnClick(tWidget *pWidget) {
-	WidgetRemove((tWidget *)&g_sMainPanel);
-	WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sSettingsPanel);
-	WidgetPaint(WIDGET_ROOT);
-	g_eCurrentPanel = SETTINGS_PANEL;
+	GUI_SwitchPanel(SETTINGS_PANEL);
 }
 
 /**
@@ -1027,12 +1817,8 @@ void OnMainSettingsBtnClick(tWidget *pWidget) {
  * @param pWidget The widget that triggered the event
  */
 void OnMainGraphBtnClick(tWidget *pWidget) {
-	WidgetRemove((tWidget *)&g_sMainPanel);
-	WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sGraphPanel);
-	WidgetPaint(WIDGET_ROOT);
-	g_eCurrentPanel = GRAPH_PANEL;
-	g_ui16GraphIndex = DEFULT_GRAPH_INDEX;
-	g_bGraphFirstPaint = true;
+	GUI_SwitchPanel(GRAPH_PANEL);
+	g_bGraphRedraw = true;
 }
 
 /**
@@ -1041,10 +1827,7 @@ void OnMainGraphBtnClick(tWidget *pWidget) {
  * @param pWidget The widget that triggered the event
  */
 void OnSettingsBackBtnClick(tWidget *pWidget) {
-	WidgetRemove((tWidget *)&g_sSettingsPanel);
-	WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sMainPanel);
-	WidgetPaint(WIDGET_ROOT);
-	g_eCurrentPanel = MAIN_PANEL;
+	GUI_SwitchPanel(MAIN_PANEL);
 }
 
 /**
@@ -1054,7 +1837,7 @@ void OnSettingsBackBtnClick(tWidget *pWidget) {
  */
 void OnSettingsOption1UpBtnClick(tWidget *psWidget) {
 	g_ui8MaxPower++;
-	WidgetPaint((tWidget *)&g_sSettingsOption1Panel);
+	GUI_Invalidate(GUI_REGION_OPTION1);
 
 	GUI_InvokeCallback(GUI_MAX_POWER_CHANGE, g_ui8MaxPower, NULL);
 }
@@ -1066,7 +1849,7 @@ void OnSettingsOption1UpBtnClick(tWidget *psWidget) {
  */
 void OnSettingsOption1DownBtnClick(tWidget *psWidget) {
 	g_ui8MaxPower--;
-	WidgetPaint((tWidget *)&g_sSettingsOption1Panel);
+	GUI_Invalidate(GUI_REGION_OPTION1);
 
 	GUI_InvokeCallback(GUI_MAX_POWER_CHANGE, g_ui8MaxPower, NULL);
 }
@@ -1078,7 +1861,7 @@ void OnSettingsOption1DownBtnClick(tWidget *psWidget) {
  */
 void OnSettingsOption2UpBtnClick(tWidget *psWidget) {
 	g_ui8MaxAccel++;
-	WidgetPaint((tWidget *)&g_sSettingsOption2Panel);
+	GUI_Invalidate(GUI_REGION_OPTION2);
 
 	GUI_InvokeCallback(GUI_MAX_ACCEL_CHANGE, g_ui8MaxAccel, NULL);
 }
@@ -1090,7 +1873,7 @@ void OnSettingsOption2UpBtnClick(tWidget *psWidget) {
  */
 void OnSettingsOption2DownBtnClick(tWidget *psWidget) {
 	g_ui8MaxAccel--;
-	WidgetPaint((tWidget *)&g_sSettingsOption2Panel);
+	GUI_Invalidate(GUI_REGION_OPTION2);
 
 	GUI_InvokeCallback(GUI_MAX_ACCEL_CHANGE, g_ui8MaxAccel, NULL);
 }
@@ -1105,7 +1888,7 @@ void OnSettingsOption3UpBtnClick(tWidget *psWidget) {
 	if (g_ui8TimeHours > 23)
 		g_ui8TimeHours = 0;
 
-	WidgetPaint((tWidget *)&g_sSettingsOption3Panel);
+	GUI_Invalidate(GUI_REGION_OPTION3);
 
 	GUI_InvokeCallback(GUI_SET_TIME_CHANGE, TimeToTicks(g_ui8TimeHours, g_ui8TimeMinutes, 0), NULL);
 }
@@ -1121,7 +1904,7 @@ void OnSettingsOption3DownBtnClick(tWidget *psWidget) {
 		g_ui8TimeHours = 23;
 
 	g_ui8TimeHours = g_ui8TimeHours % 24;
-	WidgetPaint((tWidget *)&g_sSettingsOption3Panel);
+	GUI_Invalidate(GUI_REGION_OPTION3);
 
 	GUI_InvokeCallback(GUI_SET_TIME_CHANGE, TimeToTicks(g_ui8TimeHours, g_ui8TimeMinutes, 0), NULL);
 }
@@ -1135,7 +1918,7 @@ void OnSettingsOption4UpBtnClick(tWidget *psWidget) {
 	g_ui8TimeMinutes++;
 	if (g_ui8TimeMinutes > 59)
 		g_ui8TimeMinutes = 0;
-	WidgetPaint((tWidget *)&g_sSettingsOption4Panel);
+	GUI_Invalidate(GUI_REGION_OPTION4);
 
 	GUI_InvokeCallback(GUI_SET_TIME_CHANGE, TimeToTicks(g_ui8TimeHours, g_ui8TimeMinutes, 0), NULL);
 }
@@ -1150,7 +1933,7 @@ void OnSettingsOption4DownBtnClick(tWidget *psWidget) {
 	if (g_ui8TimeMinutes > 60)
 		g_ui8TimeMinutes = 59;
 
-	WidgetPaint((tWidget *)&g_sSettingsOption4Panel);
+	GUI_Invalidate(GUI_REGION_OPTION4);
 
 	GUI_InvokeCallback(GUI_SET_TIME_CHANGE, TimeToTicks(g_ui8TimeHours, g_ui8TimeMinutes, 0), NULL);
 }
@@ -1161,94 +1944,393 @@ void OnSettingsOption4DownBtnClick(tWidget *psWidget) {
  * @param pWidget The widget that triggered the event
  */
 void OnGraphBackBtnClick(tWidget *pWidget) {
-	WidgetRemove((tWidget *)&g_sGraphPanel);
-	WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sMainPanel);
-	WidgetPaint(WIDGET_ROOT);
-	g_eCurrentPanel = MAIN_PANEL;
+	GUI_SwitchPanel(MAIN_PANEL);
 }
 
 /**
- * @brief Function to handle the speed checkbox click event on the graph panel
+ * @brief Function to handle the channel checkbox click events on the graph panel
  *
  * @param psWidget The widget that triggered the event
  * @param bSelected The state of the checkbox
  */
-void OnGraphSpeedChkClick(tWidget *psWidget, uint32_t bSelected) {
-	g_bGraphSpeed = bSelected;
-	g_ui8PrevSpeed = UINT8_MAX;
+void OnGraphChannelChkClick(tWidget *psWidget, uint32_t bSelected) {
+	uint8_t ui8Channel = (tCheckBoxWidget *)psWidget - ga_sGraphChannelChk;
+	tCanvasWidget *psUnit = &ga_sGraphChannelUnit[ui8Channel];
+	g_bGraphRedraw = true;
 
 	if (bSelected) {
-		CanvasOutlineOn((tCanvasWidget *)&g_sGraphUnitSpeed);
-		CanvasTextOn((tCanvasWidget *)&g_sGraphUnitSpeed);
+		g_ui32GraphChannels |= 1 << ui8Channel;
+		CanvasOutlineOn(psUnit);
+		CanvasTextOn(psUnit);
 	} else {
-		CanvasOutlineOff((tCanvasWidget *)&g_sGraphUnitSpeed);
-		CanvasTextOff((tCanvasWidget *)&g_sGraphUnitSpeed);
+		g_ui32GraphChannels &= ~(1 << ui8Channel);
+		CanvasOutlineOff(psUnit);
+		CanvasTextOff(psUnit);
 	}
 
-	WidgetPaint((tWidget *)&g_sGraphUnitSpeed);
+	GUI_Invalidate(GUI_REGION_GRAPH_UNITS);
+	GUI_Invalidate(GUI_REGION_GRAPH_CONTENT);
 }
 
 /**
- * @brief Function to handle the power checkbox click event on the graph panel
+ * @brief Function to handle the time unit click event on the graph panel, cycles the zoom level
  *
  * @param psWidget The widget that triggered the event
- * @param bSelected The state of the checkbox
  */
-void OnGraphPowerChkClick(tWidget *psWidget, uint32_t bSelected) {
-	g_bGraphPower = bSelected;
-	g_ui8PrevPower = UINT8_MAX;
-
-	if (bSelected) {
-		CanvasOutlineOn((tCanvasWidget *)&g_sGraphUnitPower);
-		CanvasTextOn((tCanvasWidget *)&g_sGraphUnitPower);
-	} else {
-		CanvasOutlineOff((tCanvasWidget *)&g_sGraphUnitPower);
-		CanvasTextOff((tCanvasWidget *)&g_sGraphUnitPower);
-	}
+void OnGraphUnitTimeClick(tWidget *psWidget) {
+	g_ui8GraphZoom = (g_ui8GraphZoom + 1) % HISTORY_LEVEL_COUNT;
+	g_bGraphRedraw = true;
 
-	WidgetPaint((tWidget *)&g_sGraphUnitPower);
+	PushButtonTextSet((tPushButtonWidget *)&g_sGraphUnitTime, gc_pcGraphUnitTime[g_ui8GraphZoom]);
+	GUI_Invalidate(GUI_REGION_GRAPH_TIME);
+	GUI_Invalidate(GUI_REGION_GRAPH_CONTENT);
 }
+#pragma endregion
 
+#pragma region Graph history functions
 /**
- * @brief Function to handle the light checkbox click event on the graph panel
+ * @brief Internal function to record the current snapshot into the graph history
  *
- * @param psWidget The widget that triggered the event
- * @param bSelected The state of the checkbox
+ * @note This function is not intended to be called by the user
  */
-void OnGraphLightChkClick(tWidget *psWidget, uint32_t bSelected) {
-	g_bGraphLight = bSelected;
-	g_ui8PrevLight = UINT8_MAX;
+void GUI_GraphSample() {
+	uint8_t ui8Values[GRAPH_CHANNEL_COUNT];
 
-	if (bSelected) {
-		CanvasOutlineOn((tCanvasWidget *)&g_sGraphUnitLight);
-		CanvasTextOn((tCanvasWidget *)&g_sGraphUnitLight);
-	} else {
-		CanvasOutlineOff((tCanvasWidget *)&g_sGraphUnitLight);
-		CanvasTextOff((tCanvasWidget *)&g_sGraphUnitLight);
+	for (uint8_t i = 0; i < GRAPH_CHANNEL_COUNT; i++) {
+		ui8Values[i] = GUI_GraphQuantise(*gc_sGraphChannels[i].pi16Source, gc_sGraphChannels[i].i16Max);
 	}
+	History_Add(ui8Values);
+}
 
-	WidgetPaint((tWidget *)&g_sGraphUnitLight);
+/**
+ * @brief Internal function to scale a value into the range stored by the graph history
+ *
+ * @param i16Value The value to scale
+ * @param i16Max The maximum value of the channel
+ * @return The scaled value
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint8_t GUI_GraphQuantise(int16_t i16Value, int16_t i16Max) {
+	if (i16Value <= 0)
+		return 0;
+	if (i16Value >= i16Max)
+		return UINT8_MAX;
+	return (i16Value * UINT8_MAX) / i16Max;
 }
 
 /**
- * @brief Function to handle the accel checkbox click event on the graph panel
+ * @brief Internal function to write the unit label of a graph channel
  *
- * @param psWidget The widget that triggered the event
- * @param bSelected The state of the checkbox
+ * @param pcText The label to write, GRAPH_UNIT_TEXT characters
+ * @param psChannel The channel
+ * @param i16Height The height of the plot
+ *
+ * @note The label shows the value of one horizontal grid division, which grows as the plot shrinks
+ * @note This function is not intended to be called by the user
  */
-void OnGraphAccelChkClick(tWidget *psWidget, uint32_t bSelected) {
-	g_bGraphAccel = bSelected;
-	g_ui8PrevAccel = UINT8_MAX;
+void GUI_GraphUnitText(char *pcText, const tGUIGraphChannel *psChannel, int16_t i16Height) {
+	int32_t i32Step = (int32_t)psChannel->i16Max * GRAPH_GRID_SIZE_Y / i16Height;
+	uint8_t ui8Digits = 1;
+	for (int32_t i = i32Step; i >= 10; i /= 10) {
+		ui8Digits++;
+	}
 
-	if (bSelected) {
-		CanvasOutlineOn((tCanvasWidget *)&g_sGraphUnitAccel);
-		CanvasTextOn((tCanvasWidget *)&g_sGraphUnitAccel);
-	} else {
-		CanvasOutlineOff((tCanvasWidget *)&g_sGraphUnitAccel);
-		CanvasTextOff((tCanvasWidget *)&g_sGraphUnitAccel);
+	memcpy(pcText, "dY:", 3);
+	FormatInt(i32Step, pcText + 3, ui8Digits, ' ');
+	strncpy(pcText + 3 + ui8Digits, psChannel->pcUnit, GRAPH_UNIT_TEXT - 4 - ui8Digits);
+	pcText[GRAPH_UNIT_TEXT - 1] = '\0';
+}
+
+/**
+ * @brief Internal function to build the checkbox and unit label of every graph channel
+ *
+ * @note The checkboxes fill GRAPH_CHECKBOX_ROWS rows and the unit labels rows of up to GRAPH_UNIT_COLUMNS, both sized
+ *		 by the channel count. Each row of unit labels past the first moves the top of the plot down
+ * @note This function is not intended to be called by the user
+ */
+void GUI_GraphInit() {
+	uint8_t ui8Columns = (GRAPH_CHANNEL_COUNT + GRAPH_CHECKBOX_ROWS - 1) / GRAPH_CHECKBOX_ROWS;
+	int16_t i16CheckBoxWidth = GRAPH_CHECKBOX_WIDTH / ui8Columns;
+	uint8_t ui8UnitRows = (GRAPH_CHANNEL_COUNT + GRAPH_UNIT_COLUMNS - 1) / GRAPH_UNIT_COLUMNS;
+	uint8_t ui8UnitColumns = (GRAPH_CHANNEL_COUNT + ui8UnitRows - 1) / ui8UnitRows;
+	int16_t i16UnitWidth = GRAPH_UNIT_WIDTH / ui8UnitColumns;
+
+	/* Make room for the rows of unit labels */
+	int16_t i16Rows = (ui8UnitRows - 1) * GRAPH_UNIT_HEIGHT;
+	g_sGraphUnits.sBase.sPosition.i16YMax += i16Rows;
+	g_sGraphContent.sBase.sPosition.i16YMin += i16Rows;
+	int16_t i16Height = g_sGraphContent.sBase.sPosition.i16YMax - g_sGraphContent.sBase.sPosition.i16YMin + 1;
+
+	for (uint8_t i = 0; i < GRAPH_CHANNEL_COUNT; i++) {
+		const tGUIGraphChannel *psChannel = &gc_sGraphChannels[i];
+		tCheckBoxWidget *psCheckBox = &ga_sGraphChannelChk[i];
+		tCanvasWidget *psUnit = &ga_sGraphChannelUnit[i];
+
+		/* A channel the history budget cannot hold keeps no buckets and draws nothing */
+		History_AddChannel(psChannel->ui16Depth > GRAPH_COLUMN_MAX ? psChannel->ui16Depth : GRAPH_COLUMN_MAX);
+		if (psChannel->bEnabled)
+			g_ui32GraphChannels |= 1 << i;
+		ga_ui16GraphChannelColor[i] = DpyColorTranslate(g_sContext.psDisplay, psChannel->ui32Color);
+
+		/* Checkboxes fill each column from top to bottom */
+		CheckBoxInit(psCheckBox, DISPLAY, GRAPH_CHECKBOX_X + (i / GRAPH_CHECKBOX_ROWS) * i16CheckBoxWidth,
+					 GRAPH_CHECKBOX_Y + (i % GRAPH_CHECKBOX_ROWS) * GRAPH_CHECKBOX_SPACING, i16CheckBoxWidth, GRAPH_CHECKBOX_HEIGHT);
+		psCheckBox->ui16Style = CB_STYLE_TEXT | (psChannel->bEnabled ? CB_STYLE_SELECTED : 0);
+		psCheckBox->ui16BoxSize = GRAPH_CHECKBOX_HEIGHT;
+		psCheckBox->ui32OutlineColor = ClrWhite;
+		psCheckBox->ui32TextColor = psChannel->ui32Color;
+		psCheckBox->psFont = &g_sFontNf10;
+		psCheckBox->pcText = psChannel->pcLabel;
+		psCheckBox->pfnOnChange = OnGraphChannelChkClick;
+		WidgetAdd((tWidget *)&g_sGraphPanel, (tWidget *)psCheckBox);
+
+		/* Unit labels fill each row from left to right, and are only outlined and labelled while the channel is drawn */
+		GUI_GraphUnitText(ga_cGraphChannelUnit[i], psChannel, i16Height);
+		CanvasInit(psUnit, DISPLAY, GRAPH_UNIT_X + (i % ui8UnitColumns) * i16UnitWidth,
+				   GRAPH_UNIT_Y + (i / ui8UnitColumns) * GRAPH_UNIT_HEIGHT, i16UnitWidth, GRAPH_UNIT_HEIGHT);
+		psUnit->ui32Style = CANVAS_STYLE_FILL | CANVAS_STYLE_TEXT_HCENTER | CANVAS_STYLE_TEXT_TOP;
+		if (psChannel->bEnabled)
+			psUnit->ui32Style |= CANVAS_STYLE_OUTLINE | CANVAS_STYLE_TEXT;
+		psUnit->ui32FillColor = ClrBlack;
+		psUnit->ui32OutlineColor = psChannel->ui32Color;
+		psUnit->ui32TextColor = psChannel->ui32Color;
+		psUnit->psFont = &g_sFontNf10;
+		psUnit->pcText = ga_cGraphChannelUnit[i];
+		WidgetAdd((tWidget *)&g_sGraphUnits, (tWidget *)psUnit);
 	}
+}
 
-	WidgetPaint((tWidget *)&g_sGraphUnitAccel);
+/**
+ * @brief Internal function to get the screen column of a bucket
+ *
+ * @param psContext The graphics context
+ * @param i32Bucket The bucket number in the current zoom level
+ * @return The x position of the column
+ *
+ * @note This function is not intended to be called by the user
+ */
+int16_t GUI_GraphColumn(tContext *psContext, int32_t i32Bucket) {
+	int32_t i32Width = psContext->sClipRegion.i16XMax - psContext->sClipRegion.i16XMin;
+	return psContext->sClipRegion.i16XMin + ((i32Bucket % i32Width) + i32Width) % i32Width;
+}
+
+/**
+ * @brief Internal function to get the row of a history value in the graph
+ *
+ * @param psContext The graphics context
+ * @param ui8Value The history value
+ * @return The offset of the row from the top of the graph
+ *
+ * @note This function is not intended to be called by the user
+ */
+int16_t GUI_GraphRow(tContext *psContext, uint8_t ui8Value) {
+	return Map(ui8Value, 0, UINT8_MAX, psContext->sClipRegion.i16YMax, psContext->sClipRegion.i16YMin) - psContext->sClipRegion.i16YMin;
+}
+
+/**
+ * @brief Internal function to raster the traces of the enabled channels into a column buffer
+ *
+ * @param psContext The graphics context
+ * @param pui16Column The column buffer, one display color per row
+ * @param i32Bucket The bucket number of the column
+ *
+ * @note All channels of a bucket are fetched at once, the cost per channel is a span fill
+ * @note This function is not intended to be called by the user
+ */
+void GUI_GraphRasterTraces(tContext *psContext, uint16_t *pui16Column, int32_t i32Bucket) {
+	tHistoryBucket sBuckets[GRAPH_CHANNEL_COUNT];
+	uint32_t ui32Drawn = History_GetAll(g_ui8GraphZoom, i32Bucket, sBuckets) & g_ui32GraphChannels;
+	if (ui32Drawn == 0)
+		return;
+
+	/* Join to the previous means, but not across the wrap */
+	tHistoryBucket sPrev[GRAPH_CHANNEL_COUNT];
+	uint32_t ui32Joined = 0;
+	if (GUI_GraphColumn(psContext, i32Bucket) != psContext->sClipRegion.i16XMin)
+		ui32Joined = History_GetAll(g_ui8GraphZoom, i32Bucket - 1, sPrev);
+
+	for (uint8_t ui8Channel = 0; ui8Channel < GRAPH_CHANNEL_COUNT; ui8Channel++) {
+		if (!(ui32Drawn & (1 << ui8Channel)))
+			continue;
+
+		/* Envelope of the bucket, a single pixel at the finest level */
+		const tHistoryBucket *psBucket = &sBuckets[ui8Channel];
+		int16_t i16Top = GUI_GraphRow(psContext, psBucket->ui8Max);
+		int16_t i16Bottom = GUI_GraphRow(psContext, psBucket->ui8Min);
+
+		/* Extend the span to join the previous mean */
+		if (ui32Joined & (1 << ui8Channel)) {
+			int16_t i16Prev = GUI_GraphRow(psContext, sPrev[ui8Channel].ui8Mean);
+			int16_t i16Mean = GUI_GraphRow(psContext, psBucket->ui8Mean);
+			int16_t i16Join = i16Prev < i16Mean ? i16Prev : i16Mean;
+			if (i16Join < i16Top)
+				i16Top = i16Join;
+			i16Join = i16Prev > i16Mean ? i16Prev : i16Mean;
+			if (i16Join > i16Bottom)
+				i16Bottom = i16Join;
+		}
+
+		uint16_t ui16Color = ga_ui16GraphChannelColor[ui8Channel];
+		for (int16_t i = i16Top; i <= i16Bottom; i++) {
+			pui16Column[i] = ui16Color;
+		}
+	}
+}
+
+/**
+ * @brief Internal function to draw one column of the graph from history
+ *
+ * @param psContext The graphics context
+ * @param i32Bucket The bucket number of the column
+ * @param bLead True to also draw the lead line in the column to the right
+ *
+ * @note The column is composed in RAM and written to the display with a single burst
+ * @note This function is not intended to be called by the user
+ */
+void GUI_GraphDrawColumn(tContext *psContext, int32_t i32Bucket, bool bLead) {
+	int16_t i16X = GUI_GraphColumn(psContext, i32Bucket);
+	int16_t i16Height = psContext->sClipRegion.i16YMax - psContext->sClipRegion.i16YMin + 1;
+	uint16_t ui16Grid = DpyColorTranslate(psContext->psDisplay, ClrDimGray);
+
+	/* Background, vertical grid line or clear */
+	uint16_t ui16Background = ui16Grid;
+	if ((i16X - psContext->sClipRegion.i16XMin) % GRAPH_GRID_SIZE_X != 0)
+		ui16Background = DpyColorTranslate(psContext->psDisplay, ClrBlack);
+	for (int16_t i = 0; i < i16Height; i++) {
+		ga_ui16GraphColumn[i] = ui16Background;
+	}
+
+	/* Horizontal grid lines */
+	for (int16_t i = i16Height - 1; i > 0; i -= GRAPH_GRID_SIZE_Y) {
+		ga_ui16GraphColumn[i] = ui16Grid;
+	}
+
+	/* Enabled channels */
+	GUI_GraphRasterTraces(psContext, ga_ui16GraphColumn, i32Bucket);
+
+	/* Lead line */
+	tRectangle sRect = {i16X, psContext->sClipRegion.i16YMin, i16X, psContext->sClipRegion.i16YMax};
+	if (bLead) {
+		uint16_t ui16Lead = DpyColorTranslate(psContext->psDisplay, ClrCyan);
+		for (int16_t i = i16Height; i < 2 * i16Height; i++) {
+			ga_ui16GraphColumn[i] = ui16Lead;
+		}
+		sRect.i16XMax++;
+	}
+
+	uint32_t ui32Bytes = g_ui32SSD2119SPIBytes;
+	uint32_t ui32Transactions = g_ui32SSD2119SPITransactions;
+	Kentec320x240x16_SSD2119ColumnsWrite(&sRect, ga_ui16GraphColumn);
+	g_ui32GraphColumnBytes = g_ui32SSD2119SPIBytes - ui32Bytes;
+	g_ui32GraphColumnTransactions = g_ui32SSD2119SPITransactions - ui32Transactions;
+}
+#pragma endregion
+
+#pragma region Performance overlay functions
+/**
+ * @brief Internal function to paint the performance overlay over the time bar
+ *
+ * @param psContext The graphics context
+ *
+ * @note The labels are only drawn after the bar was cleared, then only the digits that changed are sent
+ * @note This function is not intended to be called by the user
+ */
+void GUI_PaintOverlay(tContext *psContext) {
+	if (!g_bOverlayLabels) {
+		if (!GUI_FillChunked(&g_sMainTime.sBase.sPosition, ClrBlack))
+			return;
+		GrContextClipRegionSet(psContext, &g_sMainTime.sBase.sPosition);
+
+		GrContextFontSet(psContext, &g_sFontNf10);
+		GrContextForegroundSet(psContext, ClrWhite);
+		int16_t i16Baseline = GrFontBaselineGet(&g_sFontNf10) / 2;
+		for (uint8_t i = 0; i < sizeof(gc_sOverlayLabels) / sizeof(gc_sOverlayLabels[0]); i++) {
+			GrStringDraw(psContext, gc_sOverlayLabels[i].pcText, -1, gc_sOverlayLabels[i].i16X, gc_sOverlayLabels[i].i16Y - i16Baseline, false);
+		}
+		for (uint8_t i = 0; i < g_ui8OverlayTasks; i++) {
+			int16_t i16X = GUI_OVERLAY_TASK_X + i * GUI_OVERLAY_TASK_SPACING;
+			GrStringDraw(psContext, ga_pcOverlayTaskLabels[i], -1, i16X, GUI_OVERLAY_LINE2_Y - i16Baseline, false);
+			GrStringDraw(psContext, "%", -1, i16X + 36, GUI_OVERLAY_LINE2_Y - i16Baseline, false);
+		}
+
+		Numeric_Reset(&g_sOverlayFrameNumeric);
+		Numeric_Reset(&g_sOverlaySPINumeric);
+		Numeric_Reset(&g_sOverlayQueueNumeric);
+		Numeric_Reset(&g_sOverlayPulseNumeric);
+		Numeric_Reset(&g_sOverlayCPUNumeric);
+		for (uint8_t i = 0; i < GUI_OVERLAY_TASK_COUNT; i++) {
+			Numeric_Reset(&ga_sOverlayTaskNumeric[i]);
+		}
+		g_bOverlayLabels = true;
+	}
+
+	Numeric_Draw(&g_sOverlayFrameNumeric, psContext, g_sOverlay.ui16FrameRate);
+	Numeric_Draw(&g_sOverlaySPINumeric, psContext, g_sOverlay.ui16SPIRate);
+	Numeric_Draw(&g_sOverlayQueueNumeric, psContext, g_sOverlay.ui8QueueDepth);
+	Numeric_Draw(&g_sOverlayPulseNumeric, psContext, g_sOverlay.ui16PulseLatency);
+	Numeric_Draw(&g_sOverlayCPUNumeric, psContext, g_sOverlay.ui8CPULoad);
+	for (uint8_t i = 0; i < g_ui8OverlayTasks; i++) {
+		Numeric_Draw(&ga_sOverlayTaskNumeric[i], psContext, g_sOverlay.ui8TaskLoad[i]);
+	}
+}
+
+/**
+ * @brief Internal function to show or hide the performance overlay
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_ToggleOverlay() {
+	g_bOverlay = !g_bOverlay;
+	g_bOverlayLabels = false;
+
+	/* Put the time text back straight away when hiding the overlay */
+	g_ui32PrevTime = UINT32_MAX;
+	GUI_UpdateClock();
+	GUI_Invalidate(GUI_REGION_MAIN_TIME);
+}
+
+/**
+ * @brief Function to handle the messages of the time bar on the main panel, holding it toggles the overlay
+ *
+ * @param psWidget The widget that received the message
+ * @param ui32Msg The message
+ * @param ui32Param1 The first parameter of the message
+ * @param ui32Param2 The second parameter of the message
+ * @return Non-zero if the message was handled
+ *
+ * @note Every other message is handled by the canvas
+ */
+int32_t OnMainTimeMsg(tWidget *psWidget, uint32_t ui32Msg, uint32_t ui32Param1, uint32_t ui32Param2) {
+	switch (ui32Msg) {
+	case WIDGET_MSG_PTR_DOWN:
+		if (!GrRectContainsPoint(&psWidget->sPosition, (int32_t)ui32Param1, (int32_t)ui32Param2))
+			return 0;
+		g_bOverlayHeld = true;
+		g_ui32OverlayPress = Clock_getTicks();
+		return 1;
+	case WIDGET_MSG_PTR_MOVE:
+		/* Moves keep arriving while the bar is held, toggle once per press */
+		if (g_bOverlayHeld && Clock_getTicks() - g_ui32OverlayPress >= GUI_OVERLAY_HOLD) {
+			g_bOverlayHeld = false;
+			GUI_ToggleOverlay();
+		}
+		return 1;
+	case WIDGET_MSG_PTR_UP:
+		g_bOverlayHeld = false;
+		return 1;
+	case WIDGET_MSG_PAINT:
+		if (!g_bOverlay)
+			break;
+		g_bOverlayLabels = false;
+		GrContextClipRegionSet(&g_sContext, &psWidget->sPosition);
+		GUI_PaintOverlay(&g_sContext);
+		return 1;
+	default:
+		break;
+	}
+
+	return CanvasMsgProc(psWidget, ui32Msg, ui32Param1, ui32Param2);
 }
 #pragma endregion
 
@@ -1260,16 +2342,7 @@ void OnGraphAccelChkClick(tWidget *psWidget, uint32_t bSelected) {
  * @param psContext The graphics context
  */
 void OnMainDesiredSpeedPaint(tWidget *psWidget, tContext *psContext) {
-	/* Clear the previous speed */
-	GrContextForegroundSet(psContext, ClrBlack);
-	GrRectFill(psContext, &gc_sDesiredSpeedRect);
-
-	/* Draw the new speed */
-	GrContextForegroundSet(psContext, ClrRed);
-	GrContextFontSet(psContext, &g_sFontNf36);
-	char text[8];
-	snprintf(text, 8, "%d\0", g_i16DesiredSpeed);
-	GrStringDrawCentered(psContext, text, -1, 107, 64, false);
+	Numeric_Draw(&g_sDesiredSpeedNumeric, psContext, g_i16DesiredSpeed);
 }
 
 /**
@@ -1279,22 +2352,51 @@ void OnMainDesiredSpeedPaint(tWidget *psWidget, tContext *psContext) {
  * @param psContext The graphics context
  */
 void OnMainCurrentSpeedPaint(tWidget *psWidget, tContext *psContext) {
-	/* Check if speed has updated */
-	int16_t i16CurrentRPM = GUI_InvokeCallback(GUI_RETURN_SPEED, NULL, NULL);
-	if (i16CurrentRPM == g_i16PrevRPM)
-		return;
-	g_i16PrevRPM = i16CurrentRPM;
+	Numeric_Draw(&g_sCurrentSpeedNumeric, psContext, g_sSnapshot.i16Speed);
+}
+
+/**
+ * @brief Function to handle painting the speed gauge on the main panel
+ *
+ * @param psWidget The widget that is being painted
+ * @param psContext The graphics context
+ */
+void OnMainSpeedGaugePaint(tWidget *psWidget, tContext *psContext) {
+	Gauge_Draw(&g_sSpeedGauge, psContext, g_sSnapshot.i16Speed);
+}
 
-	/* Clear the previous speed */
-	GrContextForegroundSet(psContext, ClrBlack);
-	GrRectFill(psContext, &gc_sCurrentSpeedRect);
+/**
+ * @brief Function to handle painting the time bar on the main panel, or the performance overlay over it
+ *
+ * @param psWidget The widget that is being painted
+ * @param psContext The graphics context
+ */
+void OnMainTimePaint(tWidget *psWidget, tContext *psContext) {
+	/* A frame cancelled while the bar is filled is stopped by the yield that follows the region */
+	if (g_bOverlay)
+		GUI_PaintOverlay(psContext);
+	else
+		GUI_PaintWidget(psWidget);
+}
+
+/**
+ * @brief Function to handle painting the power bar on the main panel
+ *
+ * @param psWidget The widget that is being painted
+ * @param psContext The graphics context
+ */
+void OnMainPowerBarPaint(tWidget *psWidget, tContext *psContext) {
+	Bar_Draw(&g_sPowerBar, psContext, g_sSnapshot.i16Power, g_ui8MaxPower);
+}
 
-	/* Draw the new speed */
-	GrContextForegroundSet(psContext, ClrRed);
-	GrContextFontSet(psContext, &g_sFontNf36);
-	char text[8];
-	snprintf(text, 8, "%d\0", i16CurrentRPM);
-	GrStringDrawCentered(psContext, text, -1, 107, 142, false);
+/**
+ * @brief Function to handle painting the acceleration bar on the main panel
+ *
+ * @param psWidget The widget that is being painted
+ * @param psContext The graphics context
+ */
+void OnMainAccelBarPaint(tWidget *psWidget, tContext *psContext) {
+	Bar_Draw(&g_sAccelBar, psContext, g_sSnapshot.i16Accel, g_ui8MaxAccel);
 }
 
 /**
@@ -1304,16 +2406,7 @@ void OnMainCurrentSpeedPaint(tWidget *psWidget, tContext *psContext) {
  * @param psContext The graphics context
  */
 void OnSettingsOption1Paint(tWidget *psWidget, tContext *psContext) {
-	/* Clear the previous text */
-	GrContextForegroundSet(psContext, ClrBlack);
-	GrRectFill(psContext, &gc_sOption1Rect);
-
-	/* Draw the new text */
-	GrContextForegroundSet(psContext, ClrRed);
-	GrContextFontSet(psContext, &g_sFontNf24);
-	char text[4];
-	snprintf(text, 4, "%d\0", g_ui8MaxPower);
-	GrStringDrawCentered(psContext, text, -1, 198, 41, false);
+	Numeric_Draw(&g_sOption1Numeric, psContext, g_ui8MaxPower);
 }
 
 /**
@@ -1323,16 +2416,7 @@ void OnSettingsOption1Paint(tWidget *psWidget, tContext *psContext) {
  * @param psContext The graphics context
  */
 void OnSettingsOption2Paint(tWidget *psWidget, tContext *psContext) {
-	/* Clear the previous text */
-	GrContextForegroundSet(psContext, ClrBlack);
-	GrRectFill(psContext, &gc_sOption2Rect);
-
-	/* Draw the new text */
-	GrContextForegroundSet(psContext, ClrRed);
-	GrContextFontSet(psContext, &g_sFontNf24);
-	char text[4];
-	snprintf(text, 4, "%d\0", g_ui8MaxAccel);
-	GrStringDrawCentered(psContext, text, -1, 198, 97, false);
+	Numeric_Draw(&g_sOption2Numeric, psContext, g_ui8MaxAccel);
 }
 
 /**
@@ -1342,16 +2426,7 @@ void OnSettingsOption2Paint(tWidget *psWidget, tContext *psContext) {
  * @param psContext The graphics context
  */
 void OnSettingsOption3Paint(tWidget *psWidget, tContext *psContext) {
-	/* Clear the previous text */
-	GrContextForegroundSet(psContext, ClrBlack);
-	GrRectFill(psContext, &gc_sOption3Rect);
-
-	/* Draw the new text */
-	GrContextForegroundSet(psContext, ClrRed);
-	GrContextFontSet(psContext, &g_sFontNf24);
-	char text[4];
-	snprintf(text, 4, "%02d\0", g_ui8TimeHours);
-	GrStringDrawCentered(psContext, text, -1, 198, 153, false);
+	Numeric_Draw(&g_sOption3Numeric, psContext, g_ui8TimeHours);
 }
 
 /**
@@ -1361,16 +2436,7 @@ void OnSettingsOption3Paint(tWidget *psWidget, tContext *psContext) {
  * @param psContext The graphics context
  */
 void OnSettingsOption4Paint(tWidget *psWidget, tContext *psContext) {
-	/* Clear the previous text */
-	GrContextForegroundSet(psContext, ClrBlack);
-	GrRectFill(psContext, &gc_sOption4Rect);
-
-	/* Draw the new text */
-	GrContextForegroundSet(psContext, ClrRed);
-	GrContextFontSet(psContext, &g_sFontNf24);
-	char text[4];
-	snprintf(text, 4, "%02d\0", g_ui8TimeMinutes);
-	GrStringDrawCentered(psContext, text, -1, 198, 209, false);
+	Numeric_Draw(&g_sOption4Numeric, psContext, g_ui8TimeMinutes);
 }
 
 /**
@@ -1378,121 +2444,124 @@ void OnSettingsOption4Paint(tWidget *psWidget, tContext *psContext) {
  *
  * @param psWidget The widget that is being painted
  * @param psContext The graphics context
+ *
+ * @note At most GRAPH_CHUNK_COLUMNS columns are drawn per call, the region is invalidated again until caught up
  */
 void OnGraphContentPaint(tWidget *psWidget, tContext *psContext) {
-	/* Draw entire graph background if first paint */
-	if (g_bGraphFirstPaint) {
-		g_bGraphFirstPaint = false;
-		GrContextForegroundSet(psContext, ClrDimGray);
-
-		/* Draw vertical lines */
-		int16_t i16X = psContext->sClipRegion.i16XMin;
-		for (i16X; i16X < psContext->sClipRegion.i16XMax; i16X += GRAPH_GRID_SIZE_X) {
-			GrLineDrawV(psContext, i16X, psContext->sClipRegion.i16YMin, psContext->sClipRegion.i16YMax);
-		}
-
-		/* Draw horizontal lines */
-		int16_t i16Y = psContext->sClipRegion.i16YMax;
-		for (i16Y; i16Y > psContext->sClipRegion.i16YMin; i16Y -= GRAPH_GRID_SIZE_Y) {
-			GrLineDrawH(psContext, psContext->sClipRegion.i16XMin, psContext->sClipRegion.i16XMax, i16Y);
-		}
-	}
-
-	/* Draw lead line */
-	GrContextForegroundSet(psContext, ClrCyan);
-	GrLineDrawV(psContext, g_ui16GraphIndex + 1, psContext->sClipRegion.i16YMin, psContext->sClipRegion.i16YMax);
-
-	/* Draw vertical grid line or clear */
-	if ((g_ui16GraphIndex - psContext->sClipRegion.i16XMin) % GRAPH_GRID_SIZE_X == 0)
-		GrContextForegroundSet(psContext, ClrDimGray);
-	else
-		GrContextForegroundSet(psContext, ClrBlack);
-	GrLineDrawV(psContext, g_ui16GraphIndex, psContext->sClipRegion.i16YMin, psContext->sClipRegion.i16YMax);
-
-	/* Draw horizontal grid lines */
-	GrContextForegroundSet(psContext, ClrDimGray);
-	int16_t i16Y = psContext->sClipRegion.i16YMax;
-	for (i16Y; i16Y > psContext->sClipRegion.i16YMin; i16Y -= GRAPH_GRID_SIZE_Y) {
-		GrPixelDraw(psContext, g_ui16GraphIndex, i16Y);
-	}
-
-	/* Draw speed */
-	if (g_bGraphSpeed) {
-		int16_t i16Speed = GUI_InvokeCallback(GUI_RETURN_SPEED, NULL, NULL);
-		int16_t i16SpeedVal = Map(i16Speed, 0, MAX_SPEED, psContext->sClipRegion.i16YMax, psContext->sClipRegion.i16YMin);
-		if (g_ui8PrevSpeed != UINT8_MAX) {
-			GrContextForegroundSet(psContext, ClrRed);
-			GrLineDraw(psContext, g_ui16GraphIndex - 1, g_ui8PrevSpeed, g_ui16GraphIndex, i16SpeedVal);
-		}
-		g_ui8PrevSpeed = i16SpeedVal;
-	}
-
-	/* Draw power */
-	if (g_bGraphPower) {
-		int16_t i16Power = GUI_InvokeCallback(GUI_RETURN_POWER, NULL, NULL);
-		int16_t i16PowerVal = Map(i16Power, 0, MAX_POWER, psContext->sClipRegion.i16YMax, psContext->sClipRegion.i16YMin);
-		if (g_ui8PrevPower != UINT8_MAX) {
-			GrContextForegroundSet(psContext, ClrBlue);
-			GrLineDraw(psContext, g_ui16GraphIndex - 1, g_ui8PrevPower, g_ui16GraphIndex, i16PowerVal);
-		}
-		g_ui8PrevPower = i16PowerVal;
+	int32_t i32Width = psContext->sClipRegion.i16XMax - psContext->sClipRegion.i16XMin;
+
+	/* Redraw the whole window from history if required or if too far behind */
+	int32_t i32Latest = History_Latest(g_ui8GraphZoom);
+	int32_t i32First = g_i32GraphPainted + 1;
+	if (g_bGraphRedraw || i32Latest - g_i32GraphPainted >= i32Width) {
+		g_bGraphRedraw = false;
+		i32First = i32Latest - i32Width + 1;
 	}
 
-	/* Draw light */
-	if (g_bGraphLight) {
-		int16_t i16Light = GUI_InvokeCallback(GUI_RETURN_LIGHT, NULL, NULL);
-		int16_t i16LightVal = Map(i16Light, 0, MAX_LIGHT, psContext->sClipRegion.i16YMax, psContext->sClipRegion.i16YMin);
-		if (g_ui8PrevLight != UINT8_MAX) {
-			GrContextForegroundSet(psContext, ClrLime);
-			GrLineDraw(psContext, g_ui16GraphIndex - 1, g_ui8PrevLight, g_ui16GraphIndex, i16LightVal);
-		}
-		g_ui8PrevLight = i16LightVal;
+	/* Draw the columns not yet on screen a chunk at a time, with the lead line after the last one drawn */
+	int32_t i32Last = i32Latest;
+	if (i32Last - i32First >= GRAPH_CHUNK_COLUMNS) {
+		i32Last = i32First + GRAPH_CHUNK_COLUMNS - 1;
+		GUI_Invalidate(GUI_REGION_GRAPH_CONTENT);
 	}
-
-	/* Draw accel */
-	if (g_bGraphAccel) {
-		int16_t i16Accel = GUI_InvokeCallback(GUI_RETURN_ACCEL, NULL, NULL);
-		int16_t i16AccelVal = Map(i16Accel, 0, MAX_ACCEL, psContext->sClipRegion.i16YMax, psContext->sClipRegion.i16YMin);
-		if (g_ui8PrevAccel != UINT8_MAX) {
-			GrContextForegroundSet(psContext, ClrYellow);
-			GrLineDraw(psContext, g_ui16GraphIndex - 1, g_ui8PrevAccel, g_ui16GraphIndex, i16AccelVal);
-		}
-		g_ui8PrevAccel = i16AccelVal;
-	}
-
-	/* Increment the graph */
-	g_ui16GraphIndex++;
-	if (g_ui16GraphIndex >= psContext->sClipRegion.i16XMax) {
-		g_ui16GraphIndex = psContext->sClipRegion.i16XMin;
+	for (int32_t i32Bucket = i32First; i32Bucket <= i32Last; i32Bucket++) {
+		GUI_GraphDrawColumn(psContext, i32Bucket, i32Bucket == i32Last);
 	}
+	g_i32GraphPainted = i32Last;
 }
 #pragma endregion
 
 #pragma region GUI API functions
+/**
+ * @brief Internal function to forward touch screen messages to the widget message queue
+ *
+ * @param ui32Message The pointer message
+ * @param i32X The x position of the pointer
+ * @param i32Y The y position of the pointer
+ * @return The result of queueing the message
+ *
+ * @note The time of a tap is recorded to measure how long it waits for the input task
+ * @note This function is called from the touch screen interrupt and is not intended to be called by the user
+ */
+int32_t GUI_TouchCallback(uint32_t ui32Message, int32_t i32X, int32_t i32Y) {
+	if (ui32Message == WIDGET_MSG_PTR_DOWN && g_ui32TapStamp == 0)
+		g_ui32TapStamp = Timestamp_get32() | 1;
+
+	int32_t i32Result = WidgetPointerMessage(ui32Message, i32X, i32Y);
+	if (i32Result)
+		g_ui32InputQueued++;
+	Event_post(g_hGUIEvent, GUI_EVENT_INPUT);
+	return i32Result;
+}
+
 /**
  * @brief Initialize the GUI
  *
  * @param ui32SysClock The frequency of the system clock
  */
 void GUI_Init(uint32_t ui32SysClock) {
+	/* Construct the events the GUI tasks pend on and the gate they share the widgets and display with */
+	Event_construct(&g_sGUIEvent, NULL);
+	g_hGUIEvent = Event_handle(&g_sGUIEvent);
+	Event_construct(&g_sGUIRenderEvent, NULL);
+	g_hGUIRenderEvent = Event_handle(&g_sGUIRenderEvent);
+	GateMutexPri_construct(&g_sGUIGate, NULL);
+	g_hGUIGate = GateMutexPri_handle(&g_sGUIGate);
+
 	/* Initialize touch screen */
 	Kentec320x240x16_SSD2119Init(ui32SysClock);
 	GrContextInit(&g_sContext, &g_sKentec320x240x16_SSD2119);
 	TouchScreenInit(ui32SysClock);
-	TouchScreenCallbackSet(WidgetPointerMessage);
+	TouchScreenCallbackSet(GUI_TouchCallback);
+
+	/* Build the graph channel widgets */
+	GUI_GraphInit();
+
+	/* Convert the frame budget to timestamp counts */
+	Types_FreqHz sFreq;
+	Timestamp_getFreq(&sFreq);
+	g_ui32FrameBudget = (sFreq.lo / 1000000) * GUI_FRAME_BUDGET;
+	g_ui32TimestampPerMs = sFreq.lo / 1000;
+
+	/* The time bar toggles the performance overlay when held */
+	g_sMainTime.sBase.pfnMsgProc = OnMainTimeMsg;
 
 	/* Erase the function callbacks array */
 	memset(g_pfnCallbacks, NULL, sizeof(g_pfnCallbacks));
 }
 
 /**
- * @brief Internal function to handle updating the GUI
+ * @brief Internal function to read the latest samples from the data bus
+ *
+ * @param psSnapshot The snapshot to update, topics never published keep their value
  *
+ * @note This function never blocks on the producers
  * @note This function is not intended to be called by the user
  */
-void GUI_PulseInternal() {
-	/* Update e-stop status */
-	bool bEStop = GUI_InvokeCallback(GUI_RETURN_ESTOP, NULL, NULL);
+void GUI_ReadSnapshot(tGUISnapshot *psSnapshot) {
+	tBusSample sSample;
+
+	if (Bus_Read(BUS_TOPIC_SPEED, &sSample))
+		psSnapshot->i16Speed = sSample.i32Value;
+	if (Bus_Read(BUS_TOPIC_POWER, &sSample))
+		psSnapshot->i16Power = sSample.i32Value;
+	if (Bus_Read(BUS_TOPIC_LIGHT, &sSample))
+		psSnapshot->i16Light = sSample.i32Value;
+	if (Bus_Read(BUS_TOPIC_ACCEL, &sSample))
+		psSnapshot->i16Accel = sSample.i32Value;
+	if (Bus_Read(BUS_TOPIC_TIME, &sSample))
+		psSnapshot->ui32Time = sSample.i32Value;
+	if (Bus_Read(BUS_TOPIC_ESTOP, &sSample))
+		psSnapshot->bEStop = sSample.i32Value != 0;
+}
+
+/**
+ * @brief Internal function to refresh the e-stop state
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateEStop() {
+	bool bEStop = g_sSnapshot.bEStop;
 	if (bEStop && !g_bPrevEStop) {
 		g_bPrevEStop = true;
 
@@ -1504,17 +2573,11 @@ void GUI_PulseInternal() {
 		GPIO_write(MOTOR_STATE_LED, false);
 		g_bIsRunning = false;
 
-		/* Go to main panel */
-		if (g_eCurrentPanel == SETTINGS_PANEL) {
-			WidgetRemove((tWidget *)&g_sSettingsPanel);
-			WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sMainPanel);
-		}
-		if (g_eCurrentPanel == GRAPH_PANEL) {
-			WidgetRemove((tWidget *)&g_sGraphPanel);
-			WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sMainPanel);
-		}
-		g_eCurrentPanel = MAIN_PANEL;
-		WidgetPaint(WIDGET_ROOT);
+		/* Go to main panel, the transition paints the start button */
+		if (g_eCurrentPanel == MAIN_PANEL)
+			GUI_Invalidate(GUI_REGION_MAIN_START);
+		else
+			GUI_SwitchPanel(MAIN_PANEL);
 	}
 	if (!bEStop && g_bPrevEStop) {
 		g_bPrevEStop = false;
@@ -1525,39 +2588,161 @@ void GUI_PulseInternal() {
 		PushButtonCallbackSet((tPushButtonWidget *)&g_sMainStartBtn, OnMainStartBtnClick);
 		PushButtonTextSet((tPushButtonWidget *)&g_sMainStartBtn, "START");
 
-		/* Repaint GUI */
+		/* Repaint start button */
 		if (g_eCurrentPanel == MAIN_PANEL)
-			WidgetPaint(WIDGET_ROOT);
+			GUI_Invalidate(GUI_REGION_MAIN_START);
 	}
+}
+
+/**
+ * @brief Internal function to refresh the current speed readout
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateSpeed() {
+	if (g_eCurrentPanel != MAIN_PANEL)
+		return;
+
+	if (g_sSnapshot.i16Speed != g_i16PrevRPM) {
+		g_i16PrevRPM = g_sSnapshot.i16Speed;
+		GUI_Invalidate(GUI_REGION_CURRENT_SPEED);
+		GUI_Invalidate(GUI_REGION_SPEED_GAUGE);
+	}
+}
+
+/**
+ * @brief Internal function to sample the graph history and refresh the graph
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateGraph() {
+	/* Record graph history regardless of the visible panel */
+	GUI_GraphSample();
+
+	if (g_eCurrentPanel == GRAPH_PANEL)
+		GUI_Invalidate(GUI_REGION_GRAPH_CONTENT);
+}
 
-	/* Update light status */
-	bool bIsNight = GUI_InvokeCallback(GUI_RETURN_LIGHT, NULL, NULL) < NIGHT_LIGHT_THRESHOLD;
+/**
+ * @brief Internal function to refresh the light status LED
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateLight() {
+	/* The night only ends well above the threshold, so a light level sitting on it does not flicker the LED */
+	int16_t i16Threshold = NIGHT_LIGHT_THRESHOLD + (g_bPrevIsNight ? NIGHT_LIGHT_HYSTERESIS : 0);
+	bool bIsNight = g_sSnapshot.i16Light < i16Threshold;
 	GPIO_write(LIGHT_STATE_LED, bIsNight);
 
-	if (g_eCurrentPanel == MAIN_PANEL) {
-		/* Update current speed */
-		WidgetPaint((tWidget *)&g_sMainCurrentSpeed);
+	/* The time text shows day or night, refresh it straight away */
+	if (bIsNight != g_bPrevIsNight) {
+		g_bPrevIsNight = bIsNight;
+		g_ui32PrevTime = UINT32_MAX;
+		GUI_UpdateClock();
+	}
+}
 
-		/* Update time and light status */
-		uint32_t ui32Time = GUI_InvokeCallback(GUI_RETURN_TIME, NULL, NULL);
-		if (ui32Time / 60 != g_ui32PrevTime || bIsNight != g_bPrevIsNight) {
-			g_ui32PrevTime = ui32Time / 60;
-			g_bPrevIsNight = bIsNight;
+/**
+ * @brief Internal function to refresh the time text
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateClock() {
+	if (g_eCurrentPanel != MAIN_PANEL)
+		return;
 
-			TicksToTime(ui32Time, &g_ui8TimeHours, &g_ui8TimeMinutes, NULL);
+	uint32_t ui32Time = g_sSnapshot.ui32Time;
+	if (ui32Time / 60 == g_ui32PrevTime)
+		return;
+	g_ui32PrevTime = ui32Time / 60;
 
-			if (bIsNight)
-				snprintf(ga_cTimeText, 33, __DATE__ " - %02d:%02d (night)\0", g_ui8TimeHours, g_ui8TimeMinutes);
-			else
-				snprintf(ga_cTimeText, 33, __DATE__ " - %02d:%02d (day)\0", g_ui8TimeHours, g_ui8TimeMinutes);
+	TicksToTime(ui32Time, &g_ui8TimeHours, &g_ui8TimeMinutes, NULL);
 
-			CanvasTextSet(&g_sMainTime, ga_cTimeText);
-			WidgetPaint((tWidget *)&g_sMainTime);
-		}
+	if (g_bPrevIsNight)
+		snprintf(ga_cTimeText, 33, __DATE__ " - %02d:%02d (night)\0", g_ui8TimeHours, g_ui8TimeMinutes);
+	else
+		snprintf(ga_cTimeText, 33, __DATE__ " - %02d:%02d (day)\0", g_ui8TimeHours, g_ui8TimeMinutes);
+
+	CanvasTextSet(&g_sMainTime, ga_cTimeText);
+	GUI_Invalidate(GUI_REGION_MAIN_TIME);
+}
+
+/**
+ * @brief Internal function to refresh the power and acceleration bars
+ *
+ * @note The bars repaint at the lowest priority, so they only use what is left of the frame budget
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateMeters() {
+	if (g_eCurrentPanel != MAIN_PANEL)
+		return;
+
+	if (g_sSnapshot.i16Power != g_i16PrevPower) {
+		g_i16PrevPower = g_sSnapshot.i16Power;
+		GUI_Invalidate(GUI_REGION_POWER_BAR);
+	}
+	if (g_sSnapshot.i16Accel != g_i16PrevAccel) {
+		g_i16PrevAccel = g_sSnapshot.i16Accel;
+		GUI_Invalidate(GUI_REGION_ACCEL_BAR);
 	}
-	if (g_eCurrentPanel == GRAPH_PANEL) {
-		/* Update graph content */
-		WidgetPaint((tWidget *)&g_sGraphContent);
+}
+
+/**
+ * @brief Internal function to measure the values shown by the performance overlay and refresh it
+ *
+ * @note The measurements roll over every GUI_OVERLAY_PERIOD even while the overlay is hidden
+ * @note This function is not intended to be called by the user
+ */
+void GUI_UpdateOverlay() {
+	uint32_t ui32Now = Clock_getTicks();
+	uint32_t ui32Elapsed = ui32Now - g_ui32OverlayWindow;
+	if (ui32Elapsed == 0)
+		return;
+
+	/* Bytes per millisecond are kB/s */
+	g_sOverlay.ui16FrameRate = (g_sFrameStats.ui32Frames - g_ui32OverlayFrames) * 1000 / ui32Elapsed;
+	g_sOverlay.ui16SPIRate = (g_ui32SSD2119SPIBytes - g_ui32OverlayBytes) / ui32Elapsed;
+	g_sOverlay.ui8QueueDepth = g_ui8InputPeak > 99 ? 99 : g_ui8InputPeak;
+	g_sOverlay.ui16PulseLatency = g_ui32OverlayPulseLatency / g_ui32TimestampPerMs;
+	if (g_sOverlay.ui16PulseLatency > 9999)
+		g_sOverlay.ui16PulseLatency = 9999;
+	g_sOverlay.ui8CPULoad = Load_getCPULoad();
+	for (uint8_t i = 0; i < g_ui8OverlayTasks; i++) {
+		Load_Stat sStat;
+		if (Load_getTaskLoad(ga_hOverlayTasks[i], &sStat))
+			g_sOverlay.ui8TaskLoad[i] = Load_calculateLoad(&sStat);
+	}
+
+	g_ui32OverlayWindow = ui32Now;
+	g_ui32OverlayFrames = g_sFrameStats.ui32Frames;
+	g_ui32OverlayBytes = g_ui32SSD2119SPIBytes;
+	g_ui32OverlayPulseLatency = 0;
+	g_ui8InputPeak = 0;
+
+	if (g_bOverlay && g_eCurrentPanel == MAIN_PANEL)
+		GUI_Invalidate(GUI_REGION_MAIN_TIME);
+}
+
+/**
+ * @brief Internal function to handle updating the GUI, runs the updates that are due
+ *
+ * @note This function is not intended to be called by the user
+ */
+void GUI_PulseInternal() {
+	/* Take a consistent copy of the published values for this pulse */
+	GUI_ReadSnapshot(&g_sSnapshot);
+
+	uint32_t ui32Now = Clock_getTicks();
+	for (uint8_t i = 0; i < GUI_UPDATE_COUNT; i++) {
+		if ((int32_t)(ui32Now - ga_ui32UpdateDue[i]) < 0)
+			continue;
+
+		gc_sUpdates[i].pfnUpdate();
+
+		/* Keep the cadence, but do not try to catch up after a stall */
+		ga_ui32UpdateDue[i] += gc_sUpdates[i].ui16Period;
+		if ((int32_t)(ui32Now - ga_ui32UpdateDue[i]) >= 0)
+			ga_ui32UpdateDue[i] = ui32Now + gc_sUpdates[i].ui16Period;
 	}
 }
 
@@ -1568,23 +2753,98 @@ void GUI_PulseInternal() {
  *
  */
 void GUI_Pulse() {
-	g_bDoUpdate = true; // VERIFY: Is this sufficient? Does it need to be atomic?
+	if (g_ui32PulseStamp == 0)
+		g_ui32PulseStamp = Timestamp_get32() | 1;
+
+	Event_post(g_hGUIEvent, GUI_EVENT_PULSE);
+}
+
+/**
+ * @brief Internal function to account for the latency of a tap, from the touch interrupt to the input task taking the gate
+ *
+ * @param ui32Tap The time the tap was queued, or 0 if there was none
+ *
+ * @note The dispatch that follows is the same whether or not a repaint is running, so it is not counted
+ * @note This function is not intended to be called by the user
+ */
+void GUI_AccountTap(uint32_t ui32Tap) {
+	if (ui32Tap == 0)
+		return;
+
+	/* The stamp is odd so it is never 0, a tap handled within the same tick takes no time */
+	uint32_t ui32Latency = (Timestamp_get32() | 1) - ui32Tap;
+	g_ui32TapStamp = 0;
+	g_sFrameStats.ui32Taps++;
+	if (ui32Latency > g_sFrameStats.ui32WorstTapLatency)
+		g_sFrameStats.ui32WorstTapLatency = ui32Latency;
+	if (g_bFullRepaint && ui32Latency > g_sFrameStats.ui32WorstRepaintTapLatency)
+		g_sFrameStats.ui32WorstRepaintTapLatency = ui32Latency;
+}
+
+/**
+ * @brief Internal function to account for the touch messages waiting in the widget queue
+ *
+ * @note Every queued message is processed by the following dispatch
+ * @note This function is not intended to be called by the user
+ */
+void GUI_AccountQueue() {
+	uint32_t ui32Queued = g_ui32InputQueued;
+	uint32_t ui32Depth = ui32Queued - g_ui32InputProcessed;
+	g_ui32InputProcessed = ui32Queued;
+
+	if (ui32Depth > g_ui8InputPeak)
+		g_ui8InputPeak = ui32Depth > UINT8_MAX ? UINT8_MAX : ui32Depth;
 }
 
 /**
  * @brief Handles processing the messages for the widget message queue
  *
- * @note This function does not return and should be called in its own task
+ * @note This function does not return and should be called in its own task, at a higher priority than GUI_Render
  *
  */
 void GUI_Handle() {
 	while (1) {
-		if (g_bDoUpdate) {
-			g_bDoUpdate = false;
+		/* Sleep until the pulse clock fires or touch input is queued */
+		UInt uiEvents = Event_pend(g_hGUIEvent, Event_Id_NONE, GUI_EVENT_PULSE | GUI_EVENT_INPUT, BIOS_WAIT_FOREVER);
+
+		/* Waits at most one chunk of painting for the render task to yield */
+		IArg iKey = GateMutexPri_enter(g_hGUIGate);
+		GUI_AccountTap(g_ui32TapStamp);
+
+		if (uiEvents & GUI_EVENT_PULSE) {
+			uint32_t ui32Pulse = g_ui32PulseStamp;
+			uint32_t ui32Dirty = g_ui32DirtyRegions;
+			g_ui32PulseStamp = 0;
 			GUI_PulseInternal();
+
+			/* Time the pulse to the end of the frame that paints what it changed */
+			if (g_ui32DirtyRegions != ui32Dirty && g_ui32PaintPulse == 0)
+				g_ui32PaintPulse = ui32Pulse;
 		}
 
+		GUI_AccountQueue();
 		WidgetMessageQueueProcess();
+		GateMutexPri_leave(g_hGUIGate, iKey);
+	}
+}
+
+/**
+ * @brief Paints the regions invalidated by the input task
+ *
+ * @note This function does not return and should be called in its own task, at a lower priority than GUI_Handle
+ *
+ */
+void GUI_Render() {
+	while (1) {
+		/* Sleep until a dirty frame is due */
+		Event_pend(g_hGUIRenderEvent, Event_Id_NONE, GUI_EVENT_RENDER, GUI_FrameTimeout());
+		if (GUI_FrameTimeout() != 0)
+			continue;
+
+		/* Repaint everything invalidated since the last frame, yielding the gate between chunks */
+		g_iGUIGateKey = GateMutexPri_enter(g_hGUIGate);
+		GUI_Commit();
+		GateMutexPri_leave(g_hGUIGate, g_iGUIGateKey);
 	}
 }
 
@@ -1620,12 +2880,42 @@ int32_t GUI_InvokeCallback(tGUICallbackOption tCallbackOpt, uint32_t arg1, uint3
 	return g_pfnCallbacks[tCallbackOpt](arg1, arg2);
 }
 
+/**
+ * @brief Gets the frame timing statistics of the GUI
+ *
+ * @param psStats The statistics to copy into
+ *
+ * @note Times are in timestamp counts, see Timestamp_getFreq
+ */
+void GUI_GetFrameStats(tGUIFrameStats *psStats) {
+	*psStats = g_sFrameStats;
+}
+
+/**
+ * @brief Adds a task to the CPU load line of the performance overlay
+ *
+ * @param hTask The task
+ * @param pcLabel The label shown before its load, at most 2 characters
+ * @return False if the overlay already shows GUI_OVERLAY_TASK_COUNT tasks
+ *
+ * @note The overlay is toggled by holding the time bar on the main panel for GUI_OVERLAY_HOLD
+ */
+bool GUI_AddOverlayTask(Task_Handle hTask, const char *pcLabel) {
+	if (g_ui8OverlayTasks >= GUI_OVERLAY_TASK_COUNT)
+		return false;
+
+	ga_hOverlayTasks[g_ui8OverlayTasks] = hTask;
+	ga_pcOverlayTaskLabels[g_ui8OverlayTasks] = pcLabel;
+	g_ui8OverlayTasks++;
+	return true;
+}
+
 /**
  * @brief Starts the GUI
  *
  */
 void GUI_Start() {
 	WidgetAdd(WIDGET_ROOT, (tWidget *)&g_sMainPanel);
-	WidgetPaint(WIDGET_ROOT);
+	GUI_Invalidate(GUI_REGION_ROOT);
 }
 #pragma endregion
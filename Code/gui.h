@@ -1,5 +1,10 @@
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Task.h>
 
 /**
  * @brief GUI callback options
@@ -26,30 +31,6 @@ typedef enum GUICallbackOption {
 	 * @brief Callback for when the set time is changed
 	 */
 	GUI_SET_TIME_CHANGE,
-	/**
-	 * @brief Callback for when the current speed is requested
-	 */
-	GUI_RETURN_SPEED,
-	/**
-	 * @brief Callback for when the current power is requested
-	 */
-	GUI_RETURN_POWER,
-	/**
-	 * @brief Callback for when the current light level is requested
-	 */
-	GUI_RETURN_LIGHT,
-	/**
-	 * @brief Callback for when the current acceleration is requested
-	 */
-	GUI_RETURN_ACCEL,
-	/**
-	 * @brief Callback for when the current time is requested
-	 */
-	GUI_RETURN_TIME,
-	/**
-	 * @brief Callback for when the current e-stop state is requested
-	 */
-	GUI_RETURN_ESTOP,
 
 	GUI_CALLBACK_COUNT
 } tGUICallbackOption;
@@ -64,6 +45,59 @@ typedef enum tCurrentPanel {
 	GRAPH_PANEL
 } tCurrentPanel;
 
+/**
+ * @brief Frame timing statistics of the GUI, used to size the GUI task
+ *
+ */
+typedef struct tGUIFrameStats {
+	/**
+	 * @brief The number of frames painted
+	 */
+	uint32_t ui32Frames;
+	/**
+	 * @brief The number of frames that took longer than GUI_FRAME_BUDGET
+	 */
+	uint32_t ui32Overruns;
+	/**
+	 * @brief The number of region repaints deferred to a later frame
+	 */
+	uint32_t ui32Deferred;
+	/**
+	 * @brief The longest frame (timestamp counts)
+	 */
+	uint32_t ui32WorstTime;
+	/**
+	 * @brief The number of panel transitions painted
+	 */
+	uint32_t ui32Transitions;
+	/**
+	 * @brief The longest panel transition (timestamp counts)
+	 */
+	uint32_t ui32WorstTransition;
+	/**
+	 * @brief The number of frames cancelled and restarted because a root or panel repaint was requested
+	 */
+	uint32_t ui32Cancelled;
+	/**
+	 * @brief The number of taps dispatched
+	 */
+	uint32_t ui32Taps;
+	/**
+	 * @brief The longest time from a tap to the input task dispatching it (timestamp counts)
+	 */
+	uint32_t ui32WorstTapLatency;
+	/**
+	 * @brief The longest time from a tap to the input task dispatching it while a root or panel repaint was in
+	 *		  progress (timestamp counts)
+	 */
+	uint32_t ui32WorstRepaintTapLatency;
+	/**
+	 * @brief The longest time from a pulse to the end of the frame that painted everything it changed
+	 *		  (timestamp counts)
+	 */
+	uint32_t ui32WorstPulseLatency;
+} tGUIFrameStats;
+
 /**
  * @brief GUI callback function type
  *
@@ -88,11 +122,19 @@ void GUI_Pulse();
 /**
  * @brief Handles processing the messages for the widget message queue
  *
- * @note This function does not return and should be called in its own task
+ * @note This function does not return and should be called in its own task, at a higher priority than GUI_Render
  *
  */
 void GUI_Handle();
 
+/**
+ * @brief Paints the regions invalidated by the input task
+ *
+ * @note This function does not return and should be called in its own task, at a lower priority than GUI_Handle
+ *
+ */
+void GUI_Render();
+
 /**
  * @brief Sets the callback function for a specific callback
  *
@@ -113,6 +155,26 @@ void GUI_SetCallback(tGUICallbackOption tCallbackOpt, tGUICallbackFxn pfnCallbac
  */
 int32_t GUI_InvokeCallback(tGUICallbackOption tCallbackOpt, uint32_t arg1, uint32_t arg2);
 
+/**
+ * @brief Gets the frame timing statistics of the GUI
+ *
+ * @param psStats The statistics to copy into
+ *
+ * @note Times are in timestamp counts, see Timestamp_getFreq
+ */
+void GUI_GetFrameStats(tGUIFrameStats *psStats);
+
+/**
+ * @brief Adds a task to the CPU load line of the performance overlay
+ *
+ * @param hTask The task
+ * @param pcLabel The label shown before its load, at most 2 characters
+ * @return False if the overlay already shows GUI_OVERLAY_TASK_COUNT tasks
+ *
+ * @note The overlay is toggled by holding the time bar on the main panel for GUI_OVERLAY_HOLD
+ */
+bool GUI_AddOverlayTask(Task_Handle hTask, const char *pcLabel);
+
 /**
  * @brief Starts the GUI
  *
@@ -0,0 +1,223 @@
+#pragma region Includes
+#include "hall.h"
+#include "config.h"
+#include "bus.h"
+#include "commutation.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* XDCtools header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+
+/* BIOS header files */
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pin_map.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define HALL_EDGES_PER_TURN (6 * HALL_POLE_PAIRS)
+#define HALL_RPM_FACTOR (60ULL * HALL_CLOCK_FREQ / HALL_EDGES_PER_TURN) // RPM times capture counts per edge
+
+#if HALL_TIMEOUT * (HALL_CLOCK_FREQ / 1000) >= HALL_CAPTURE_MASK
+#error "HALL_TIMEOUT must be shorter than a wrap of the capture timers"
+#endif
+
+/**
+ * @brief A capture input wired to a Hall sensor
+ *
+ */
+typedef struct tHallChannel {
+	uint32_t ui32Base;
+	uint32_t ui32Timer;
+	uint32_t ui32Event;
+	uint32_t ui32Interrupt;
+	uint32_t ui32PinConfig;
+	uint8_t ui8Pin;
+} tHallChannel;
+
+/**
+ * @brief Sliding window over the last edge periods, only written by the capture interrupt
+ *
+ */
+typedef struct tHallWindow {
+	uint32_t pui32Periods[HALL_WINDOW];
+	uint32_t ui32Sum;
+	uint8_t ui8Count;
+	uint8_t ui8Next;
+	bool bPrimed;
+	uint32_t ui32LastCapture;
+	uint32_t ui32LastTick;
+} tHallWindow;
+
+/* Global constants */
+const tHallChannel gc_sHallChannels[HALL_CHANNEL_COUNT] = {
+	{TIMER3_BASE, TIMER_A, TIMER_CAPA_EVENT, INT_TIMER3A, GPIO_PD4_T3CCP0, GPIO_PIN_4},
+	{TIMER3_BASE, TIMER_B, TIMER_CAPB_EVENT, INT_TIMER3B, GPIO_PD5_T3CCP1, GPIO_PIN_5},
+	{TIMER4_BASE, TIMER_A, TIMER_CAPA_EVENT, INT_TIMER4A, GPIO_PD6_T4CCP0, GPIO_PIN_6},
+};
+
+/* Global variables */
+Hwi_Struct g_sHallHwi[HALL_CHANNEL_COUNT];
+tHallWindow g_sHallWindow;
+tHallStats g_sHallStats;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Adds a Hall edge to the speed window
+ *
+ * @param arg The index of the channel that captured the edge
+ *
+ * @note Commutates the bridge before anything else. Runs in constant time and does not divide, the speed is
+ *		 worked out by the reader
+ * @note This function is not intended to be called by the user
+ */
+void Hall_CaptureHwi(UArg arg) {
+	uint32_t ui32Start = Timestamp_get32();
+	Commutation_Edge(ui32Start);
+
+	const tHallChannel *psChannel = &gc_sHallChannels[arg];
+	tHallWindow *psWindow = &g_sHallWindow;
+
+	TimerIntClear(psChannel->ui32Base, psChannel->ui32Event);
+	uint32_t ui32Capture = TimerValueGet(psChannel->ui32Base, psChannel->ui32Timer);
+	uint32_t ui32Tick = Clock_getTicks();
+
+	if (!psWindow->bPrimed || ui32Tick - psWindow->ui32LastTick > HALL_TIMEOUT) {
+		/* The first edge after a stop, the time since the previous one is unknown */
+		if (psWindow->bPrimed)
+			g_sHallStats.ui32Restarts++;
+		psWindow->bPrimed = true;
+		psWindow->ui32Sum = 0;
+		psWindow->ui8Count = 0;
+		psWindow->ui8Next = 0;
+	} else {
+		uint32_t ui32Period = (ui32Capture - psWindow->ui32LastCapture) & HALL_CAPTURE_MASK;
+		if (psWindow->ui8Count == HALL_WINDOW)
+			psWindow->ui32Sum -= psWindow->pui32Periods[psWindow->ui8Next];
+		else
+			psWindow->ui8Count++;
+		psWindow->ui32Sum += ui32Period;
+		psWindow->pui32Periods[psWindow->ui8Next] = ui32Period;
+		if (++psWindow->ui8Next == HALL_WINDOW)
+			psWindow->ui8Next = 0;
+	}
+	psWindow->ui32LastCapture = ui32Capture;
+	psWindow->ui32LastTick = ui32Tick;
+
+	g_sHallStats.ui32Edges++;
+	uint32_t ui32Time = Timestamp_get32() - ui32Start;
+	if (ui32Time > g_sHallStats.ui32WorstISR)
+		g_sHallStats.ui32WorstISR = ui32Time;
+}
+#pragma endregion
+
+#pragma region Hall API functions
+/**
+ * @brief Initialize the Hall sensor capture
+ *
+ * @note The three Hall sensors are captured on both edges by T3CCP0 (PD4), T3CCP1 (PD5) and T4CCP0 (PD6)
+ * @note Timer 0 is enabled as well, for its GPTMSYNC register
+ */
+void Hall_Init() {
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_GPIOD);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER3);
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER4);
+
+	/* Free running 24 bit counters, stamping both edges of each sensor */
+	TimerClockSourceSet(TIMER3_BASE, TIMER_CLOCK_PIOSC);
+	TimerClockSourceSet(TIMER4_BASE, TIMER_CLOCK_PIOSC);
+	TimerConfigure(TIMER3_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_CAP_TIME_UP | TIMER_CFG_B_CAP_TIME_UP);
+	TimerConfigure(TIMER4_BASE, TIMER_CFG_SPLIT_PAIR | TIMER_CFG_A_CAP_TIME_UP);
+
+	Hwi_Params hwiParams;
+	Hwi_Params_init(&hwiParams);
+	hwiParams.priority = HALL_HWI_PRIORITY;
+	for (uint8_t i = 0; i < HALL_CHANNEL_COUNT; i++) {
+		const tHallChannel *psChannel = &gc_sHallChannels[i];
+		GPIOPinConfigure(psChannel->ui32PinConfig);
+		GPIOPinTypeTimer(GPIO_PORTD_BASE, psChannel->ui8Pin);
+
+		TimerControlEvent(psChannel->ui32Base, psChannel->ui32Timer, TIMER_EVENT_BOTH_EDGES);
+		TimerLoadSet(psChannel->ui32Base, psChannel->ui32Timer, HALL_CAPTURE_MASK & 0xFFFF);
+		TimerPrescaleSet(psChannel->ui32Base, psChannel->ui32Timer, HALL_CAPTURE_MASK >> 16);
+
+		hwiParams.arg = i;
+		Hwi_construct(&g_sHallHwi[i], psChannel->ui32Interrupt, Hall_CaptureHwi, &hwiParams, NULL);
+		TimerIntEnable(psChannel->ui32Base, psChannel->ui32Event);
+		TimerEnable(psChannel->ui32Base, psChannel->ui32Timer);
+	}
+
+	/* Edges on different sensors are only comparable when the counters start together, the synchronization
+	   register is in Timer 0, which has to be clocked whether or not the kernel uses it */
+	SysCtlPeripheralEnable(SYSCTL_PERIPH_TIMER0);
+	while (!SysCtlPeripheralReady(SYSCTL_PERIPH_TIMER0))
+		;
+	TimerSynchronize(TIMER0_BASE, TIMER_3A_SYNC | TIMER_3B_SYNC | TIMER_4A_SYNC);
+}
+
+/**
+ * @brief Gets the motor speed from the latest Hall edges
+ *
+ * @return The speed (RPM)
+ *
+ * @note Averages the last HALL_WINDOW edge periods. While no edge comes for longer than the average, the speed
+ *		 decays as if the next edge were about to come, and it drops to 0 after HALL_TIMEOUT
+ */
+int32_t Hall_GetSpeed() {
+	UInt uiKey = Hwi_disable();
+	uint32_t ui32Sum = g_sHallWindow.ui32Sum;
+	uint8_t ui8Count = g_sHallWindow.ui8Count;
+	uint32_t ui32LastTick = g_sHallWindow.ui32LastTick;
+	Hwi_restore(uiKey);
+
+	uint32_t ui32Elapsed = Clock_getTicks() - ui32LastTick;
+	if (ui8Count == 0 || ui32Sum == 0 || ui32Elapsed > HALL_TIMEOUT)
+		return 0;
+
+	uint32_t ui32Speed = (HALL_RPM_FACTOR * ui8Count + ui32Sum / 2) / ui32Sum;
+
+	/* The motor cannot be faster than the longest edge gap in the time that has surely passed since the last
+	   edge, a tick less than counted. Once the next edge is late the speed decays with that bound */
+	if (ui32Elapsed > 1) {
+		uint32_t ui32Bound = 60 * 1000 * HALL_LATE_GAP / (100 * HALL_EDGES_PER_TURN * (ui32Elapsed - 1));
+		if (ui32Bound < ui32Speed)
+			ui32Speed = ui32Bound;
+	}
+	return ui32Speed;
+}
+
+/**
+ * @brief Publishes the motor speed on the data bus
+ *
+ * @note This function should be called periodically from a clock task, every HALL_PUBLISH_PERIOD
+ */
+void Hall_Publish() {
+	Bus_Publish(BUS_TOPIC_SPEED, Hall_GetSpeed());
+}
+
+/**
+ * @brief Gets the statistics of the Hall sensor capture
+ *
+ * @param psStats The statistics to copy into
+ */
+void Hall_GetStats(tHallStats *psStats) {
+	UInt uiKey = Hwi_disable();
+	*psStats = g_sHallStats;
+	Hwi_restore(uiKey);
+}
+#pragma endregion
@@ -0,0 +1,58 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define HALL_CHANNEL_COUNT 3
+#define HALL_CLOCK_FREQ 16000000 // The capture timers count the precision internal oscillator (Hz)
+#define HALL_CAPTURE_MASK 0xFFFFFF // The capture timers are 24 bits wide with the prescaler
+
+/**
+ * @brief Statistics of the Hall sensor capture
+ *
+ */
+typedef struct tHallStats {
+	/**
+	 * @brief The number of Hall edges captured
+	 */
+	uint32_t ui32Edges;
+	/**
+	 * @brief The number of times the speed window restarted after no edge for HALL_TIMEOUT
+	 */
+	uint32_t ui32Restarts;
+	/**
+	 * @brief The longest time spent in the capture interrupt (timestamp counts, see Timestamp_getFreq)
+	 */
+	uint32_t ui32WorstISR;
+} tHallStats;
+
+/**
+ * @brief Initialize the Hall sensor capture
+ *
+ * @note The three Hall sensors are captured on both edges by T3CCP0 (PD4), T3CCP1 (PD5) and T4CCP0 (PD6)
+ */
+void Hall_Init();
+
+/**
+ * @brief Gets the motor speed from the latest Hall edges
+ *
+ * @return The speed (RPM)
+ *
+ * @note Averages the last HALL_WINDOW edge periods. While no edge comes for longer than the average, the speed
+ *		 decays as if the next edge were about to come, and it drops to 0 after HALL_TIMEOUT
+ */
+int32_t Hall_GetSpeed();
+
+/**
+ * @brief Publishes the motor speed on the data bus
+ *
+ * @note This function should be called periodically from a clock task, every HALL_PUBLISH_PERIOD
+ */
+void Hall_Publish();
+
+/**
+ * @brief Gets the statistics of the Hall sensor capture
+ *
+ * @param psStats The statistics to copy into
+ */
+void Hall_GetStats(tHallStats *psStats);
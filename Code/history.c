@@ -0,0 +1,229 @@
+#pragma region Includes
+#include "history.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define HISTORY_POOL_BUCKETS (HISTORY_RAM_BUDGET / sizeof(tHistoryBucket))
+
+/* Global constants */
+const uint8_t gc_ui8HistoryFactor[HISTORY_LEVEL_COUNT] = {1, 10, 10, 6}; // Buckets of the level below per bucket
+
+/**
+ * @brief Partially filled bucket of a level
+ *
+ */
+typedef struct tHistoryAccumulator {
+	uint8_t ui8Min;
+	uint8_t ui8Max;
+	uint16_t ui16Sum;
+} tHistoryAccumulator;
+
+/**
+ * @brief The rings of one channel, carved from the pool
+ *
+ */
+typedef struct tHistoryChannel {
+	tHistoryBucket *psBuckets; // HISTORY_LEVEL_COUNT rings of ui16Length buckets
+	uint16_t ui16Length;
+} tHistoryChannel;
+
+/* Global variables */
+tHistoryBucket g_sHistoryPool[HISTORY_POOL_BUCKETS];
+uint32_t g_ui32HistoryPoolUsed = 0;
+tHistoryChannel g_sHistoryChannels[HISTORY_CHANNEL_MAX];
+uint8_t g_ui8HistoryChannelCount = 0;
+tHistoryAccumulator g_sHistoryAccumulator[HISTORY_LEVEL_COUNT][HISTORY_CHANNEL_MAX];
+uint8_t g_ui8HistoryCount[HISTORY_LEVEL_COUNT];
+int32_t g_i32HistoryBuckets[HISTORY_LEVEL_COUNT]; // Complete buckets of each level, the newest is one less
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Stores the accumulated buckets of a level and feeds them to the next level
+ *
+ * @param ui8Level The level that completed a bucket
+ *
+ * @note This function is not intended to be called by the user
+ */
+void History_Commit(uint8_t ui8Level) {
+	int32_t i32Bucket = g_i32HistoryBuckets[ui8Level]++;
+	uint8_t ui8Next = ui8Level + 1;
+
+	if (ui8Next < HISTORY_LEVEL_COUNT && g_ui8HistoryCount[ui8Next] == 0) {
+		/* First bucket of the next level starts empty */
+		for (uint8_t i = 0; i < g_ui8HistoryChannelCount; i++) {
+			g_sHistoryAccumulator[ui8Next][i] = (tHistoryAccumulator){UINT8_MAX, 0, 0};
+		}
+	}
+
+	for (uint8_t i = 0; i < g_ui8HistoryChannelCount; i++) {
+		const tHistoryChannel *psChannel = &g_sHistoryChannels[i];
+		if (psChannel->ui16Length == 0)
+			continue;
+
+		tHistoryAccumulator *psAcc = &g_sHistoryAccumulator[ui8Level][i];
+		tHistoryBucket *psBucket = &psChannel->psBuckets[ui8Level * psChannel->ui16Length + i32Bucket % psChannel->ui16Length];
+
+		psBucket->ui8Min = psAcc->ui8Min;
+		psBucket->ui8Max = psAcc->ui8Max;
+		psBucket->ui8Mean = psAcc->ui16Sum / gc_ui8HistoryFactor[ui8Level];
+
+		if (ui8Next < HISTORY_LEVEL_COUNT) {
+			/* Every bucket of a level holds the same number of samples, so the means can be averaged */
+			tHistoryAccumulator *psNext = &g_sHistoryAccumulator[ui8Next][i];
+			if (psBucket->ui8Min < psNext->ui8Min)
+				psNext->ui8Min = psBucket->ui8Min;
+			if (psBucket->ui8Max > psNext->ui8Max)
+				psNext->ui8Max = psBucket->ui8Max;
+			psNext->ui16Sum += psBucket->ui8Mean;
+		}
+	}
+
+	if (ui8Next < HISTORY_LEVEL_COUNT && ++g_ui8HistoryCount[ui8Next] == gc_ui8HistoryFactor[ui8Next]) {
+		g_ui8HistoryCount[ui8Next] = 0;
+		History_Commit(ui8Next);
+	}
+}
+#pragma endregion
+
+#pragma region History API functions
+/**
+ * @brief Adds a channel to the history, numbered in the order the channels are added
+ *
+ * @param ui16Length The number of buckets the channel keeps on each level
+ * @return True if the buckets fit in what is left of HISTORY_RAM_BUDGET
+ *
+ * @note A channel that does not fit is still numbered, it keeps no buckets. Channels must be added before the
+ *		 first sample
+ */
+bool History_AddChannel(uint16_t ui16Length) {
+	if (g_ui8HistoryChannelCount >= HISTORY_CHANNEL_MAX)
+		return false;
+
+	tHistoryChannel *psChannel = &g_sHistoryChannels[g_ui8HistoryChannelCount++];
+	uint32_t ui32Buckets = (uint32_t)ui16Length * HISTORY_LEVEL_COUNT;
+	if (ui32Buckets > HISTORY_POOL_BUCKETS - g_ui32HistoryPoolUsed) {
+		*psChannel = (tHistoryChannel){NULL, 0};
+		return false;
+	}
+
+	*psChannel = (tHistoryChannel){&g_sHistoryPool[g_ui32HistoryPoolUsed], ui16Length};
+	g_ui32HistoryPoolUsed += ui32Buckets;
+	return ui16Length > 0;
+}
+
+/**
+ * @brief Adds one sample for every channel to the history
+ *
+ * @param pui8Values The sample of each channel, one value per channel added
+ *
+ * @note The sample is folded into every level, the cost does not depend on the history length
+ */
+void History_Add(const uint8_t *pui8Values) {
+	for (uint8_t i = 0; i < g_ui8HistoryChannelCount; i++) {
+		g_sHistoryAccumulator[0][i] = (tHistoryAccumulator){pui8Values[i], pui8Values[i], pui8Values[i]};
+	}
+
+	History_Commit(0);
+}
+
+/**
+ * @brief Gets the number of the newest complete bucket of a level
+ *
+ * @param ui8Level The level to query
+ * @return The bucket number, or -1 if the level has no complete buckets yet
+ */
+int32_t History_Latest(uint8_t ui8Level) {
+	if (ui8Level >= HISTORY_LEVEL_COUNT)
+		return -1;
+
+	return g_i32HistoryBuckets[ui8Level] - 1;
+}
+
+/**
+ * @brief Gets the number of bucket slots a channel holds on each level
+ *
+ * @param ui8Channel The channel to query
+ * @return The number of buckets held per level
+ */
+uint16_t History_Length(uint8_t ui8Channel) {
+	if (ui8Channel >= g_ui8HistoryChannelCount)
+		return 0;
+
+	return g_sHistoryChannels[ui8Channel].ui16Length;
+}
+
+/**
+ * @brief Gets the number of samples that make up one bucket of a level
+ *
+ * @param ui8Level The level to query
+ * @return The number of samples per bucket
+ */
+uint32_t History_Samples(uint8_t ui8Level) {
+	uint32_t ui32Samples = 1;
+
+	for (uint8_t i = 0; i <= ui8Level && i < HISTORY_LEVEL_COUNT; i++) {
+		ui32Samples *= gc_ui8HistoryFactor[i];
+	}
+
+	return ui32Samples;
+}
+
+/**
+ * @brief Gets a bucket of a channel from a level
+ *
+ * @param ui8Channel The channel to read
+ * @param ui8Level The level to read
+ * @param i32Bucket The bucket number to read
+ * @param psBucket The bucket contents
+ * @return True if the bucket is still held by the level
+ */
+bool History_Get(uint8_t ui8Channel, uint8_t ui8Level, int32_t i32Bucket, tHistoryBucket *psBucket) {
+	if (ui8Channel >= g_ui8HistoryChannelCount || ui8Level >= HISTORY_LEVEL_COUNT)
+		return false;
+
+	const tHistoryChannel *psChannel = &g_sHistoryChannels[ui8Channel];
+	int32_t i32Latest = g_i32HistoryBuckets[ui8Level] - 1;
+	if (i32Bucket < 0 || i32Bucket > i32Latest || i32Bucket <= i32Latest - (int32_t)psChannel->ui16Length)
+		return false;
+
+	*psBucket = psChannel->psBuckets[ui8Level * psChannel->ui16Length + i32Bucket % psChannel->ui16Length];
+	return true;
+}
+
+/**
+ * @brief Gets a bucket of every channel from a level
+ *
+ * @param ui8Level The level to read
+ * @param i32Bucket The bucket number to read
+ * @param psBuckets The bucket of each channel, one per channel added
+ * @return A bit per channel that still holds the bucket, the others are left untouched
+ */
+uint32_t History_GetAll(uint8_t ui8Level, int32_t i32Bucket, tHistoryBucket *psBuckets) {
+	if (ui8Level >= HISTORY_LEVEL_COUNT)
+		return 0;
+
+	int32_t i32Latest = g_i32HistoryBuckets[ui8Level] - 1;
+	if (i32Bucket < 0 || i32Bucket > i32Latest)
+		return 0;
+
+	/* Channels keep their own number of buckets, the shorter ones drop a bucket first */
+	uint32_t ui32Held = 0;
+	for (uint8_t i = 0; i < g_ui8HistoryChannelCount; i++) {
+		const tHistoryChannel *psChannel = &g_sHistoryChannels[i];
+		if (i32Bucket <= i32Latest - (int32_t)psChannel->ui16Length)
+			continue;
+
+		psBuckets[i] = psChannel->psBuckets[ui8Level * psChannel->ui16Length + i32Bucket % psChannel->ui16Length];
+		ui32Held |= 1 << i;
+	}
+	return ui32Held;
+}
+#pragma endregion
@@ -0,0 +1,91 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define HISTORY_CHANNEL_MAX 8
+#define HISTORY_LEVEL_COUNT 4
+
+/**
+ * @brief Summary of the samples that fell into one bucket of a history level
+ *
+ */
+typedef struct tHistoryBucket {
+	/**
+	 * @brief The smallest sample in the bucket
+	 */
+	uint8_t ui8Min;
+	/**
+	 * @brief The largest sample in the bucket
+	 */
+	uint8_t ui8Max;
+	/**
+	 * @brief The mean of the samples in the bucket
+	 */
+	uint8_t ui8Mean;
+} tHistoryBucket;
+
+/**
+ * @brief Adds a channel to the history, numbered in the order the channels are added
+ *
+ * @param ui16Length The number of buckets the channel keeps on each level
+ * @return True if the buckets fit in what is left of HISTORY_RAM_BUDGET
+ *
+ * @note A channel that does not fit is still numbered, it keeps no buckets. Channels must be added before the
+ *		 first sample
+ */
+bool History_AddChannel(uint16_t ui16Length);
+
+/**
+ * @brief Adds one sample for every channel to the history
+ *
+ * @param pui8Values The sample of each channel, one value per channel added
+ *
+ * @note The sample is folded into every level, the cost does not depend on the history length
+ */
+void History_Add(const uint8_t *pui8Values);
+
+/**
+ * @brief Gets the number of the newest complete bucket of a level
+ *
+ * @param ui8Level The level to query
+ * @return The bucket number, or -1 if the level has no complete buckets yet
+ */
+int32_t History_Latest(uint8_t ui8Level);
+
+/**
+ * @brief Gets the number of bucket slots a channel holds on each level
+ *
+ * @param ui8Channel The channel to query
+ * @return The number of buckets held per level
+ */
+uint16_t History_Length(uint8_t ui8Channel);
+
+/**
+ * @brief Gets the number of samples that make up one bucket of a level
+ *
+ * @param ui8Level The level to query
+ * @return The number of samples per bucket
+ */
+uint32_t History_Samples(uint8_t ui8Level);
+
+/**
+ * @brief Gets a bucket of a channel from a level
+ *
+ * @param ui8Channel The channel to read
+ * @param ui8Level The level to read
+ * @param i32Bucket The bucket number to read
+ * @param psBucket The bucket contents
+ * @return True if the bucket is still held by the level
+ */
+bool History_Get(uint8_t ui8Channel, uint8_t ui8Level, int32_t i32Bucket, tHistoryBucket *psBucket);
+
+/**
+ * @brief Gets a bucket of every channel from a level
+ *
+ * @param ui8Level The level to read
+ * @param i32Bucket The bucket number to read
+ * @param psBuckets The bucket of each channel, one per channel added
+ * @return A bit per channel that still holds the bucket, the others are left untouched
+ */
+uint32_t History_GetAll(uint8_t ui8Level, int32_t i32Bucket, tHistoryBucket *psBuckets);
@@ -3,7 +3,6 @@
 #include <stdlib.h> // rand()
 #include <stdint.h>
 #include <stdbool.h>
-#include <math.h>
 
 /* XDCtools header files */
 #include <xdc/std.h>
@@ -25,13 +24,28 @@
 #include "gui.h"
 #include "util.h"
 #include "config.h"
+#include "adcmgr.h"
+#include "bus.h"
+#include "motor.h"
+#include "hall.h"
+#include "commutation.h"
+#include "sensors.h"
+#include "power.h"
+#include "opt3001.h"
 
 /* Global defines */
 #define TASK_STACK_SIZE 1024
+#define TASK_PRIORITY_MOTOR 3
+#define TASK_PRIORITY_GUI_INPUT 2
+#define TASK_PRIORITY_GUI_RENDER 1
 
 /* Global variables */
 Task_Struct g_sHandleGUITask;
+Task_Struct g_sRenderGUITask;
+Task_Struct g_sMotorTask;
 char ga_cHandleGUIStack[TASK_STACK_SIZE];
+char ga_cRenderGUIStack[TASK_STACK_SIZE];
+char ga_cMotorStack[TASK_STACK_SIZE];
 uint32_t g_ui32ClockCounter = 0;
 
 /**
@@ -40,7 +54,34 @@ uint32_t g_ui32ClockCounter = 0;
  * @param bMotorState The new state of the motor
  */
 void MotorStateChanged(bool bMotorState) {
-	// TODO: Implement this
+	Motor_Post(MOTOR_COMMAND_STATE, bMotorState);
+}
+
+/**
+ * @brief Callback function for when the desired motor speed changes
+ *
+ * @param i16Speed The new desired speed
+ */
+void MotorSpeedChanged(int16_t i16Speed) {
+	Motor_Post(MOTOR_COMMAND_SPEED, i16Speed);
+}
+
+/**
+ * @brief Callback function for when the max allowed power changes
+ *
+ * @param ui8MaxPower The new max power
+ */
+void MaxPowerChanged(uint8_t ui8MaxPower) {
+	Motor_Post(MOTOR_COMMAND_MAX_POWER, ui8MaxPower);
+}
+
+/**
+ * @brief Callback function for when the max allowed acceleration changes
+ *
+ * @param ui8MaxAccel The new max acceleration
+ */
+void MaxAccelChanged(uint8_t ui8MaxAccel) {
+	Motor_Post(MOTOR_COMMAND_MAX_ACCEL, ui8MaxAccel);
 }
 
 /**
@@ -74,34 +115,27 @@ void SetClock(uint32_t ui32Time) {
 	g_ui32ClockCounter = ui32Time;
 }
 
-float rpmCounter = 0;
-int16_t GetCurrentSpeed() {
-	rpmCounter++;
-	return ((sin(rpmCounter / 5) * 80) + (255 / 2));
-}
-
-float powerCounter = 0;
-int16_t GetCurrentPower() {
-	powerCounter++;
-	return ((sin(powerCounter / 10) * 80) + (255 / 2));
-}
-
-float lightCounter = 0;
-int16_t GetCurrentLight() {
-	lightCounter++;
-	return ((sin(lightCounter / (38.5 / M_PI)) * 40) + 35);
-}
-
-float accelCounter = 0;
-int16_t GetCurrentAccel() {
-	accelCounter++;
-	return (((sin(accelCounter / 2) * 40) + (255 / 2)) + ((sin(accelCounter / 10) * 80) + (255 / 2))) / 2;
+/**
+ * @brief Callback function for when the e-stop input changes
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ *
+ * @note Called from the GPIO interrupt on both edges, so the bridge opens without waiting for a control period
+ */
+void EStopChanged(unsigned int uiIndex) {
+	Motor_EStop(Sensors_GetEStop());
 }
 
-bool GetEStop() {
-	// uint32_t ticks = Clock_getTicks();		// Enables e-stop after 10 seconds
-	// return ticks < 20000 && ticks > 10000;	// Disables e-stop after 20 seconds
-	return false;
+/**
+ * @brief Sample the sensors and publish them on the data bus
+ *
+ * @note This function should be called periodically from a clock task, before the GUI pulse
+ */
+void PublishSensors() {
+	Bus_Publish(BUS_TOPIC_POWER, Sensors_GetPower());
+	Bus_Publish(BUS_TOPIC_LIGHT, Sensors_GetLight());
+	Bus_Publish(BUS_TOPIC_ACCEL, Sensors_GetAccel());
+	Bus_Publish(BUS_TOPIC_TIME, GetClock());
 }
 
 /**
@@ -113,35 +147,72 @@ int main(void) {
 	/* Call board init functions */
 	Board_initGeneral();
 	Board_initGPIO();
+	Board_initI2C();
+
+	/* Initialize the ADC before any of its clients */
+	ADCMgr_Init();
 
 	/* Get CPU frequency */
 	Types_FreqHz cpuFreq;
 	BIOS_getCpuFreq(&cpuFreq);
 
-	/* Initialize the GUI */
+	/* Initialize the speed sensor, the bridge and the motor controller before the GUI can post to it */
+	Hall_Init();
+	Commutation_Init(cpuFreq.lo);
+	Motor_Init(cpuFreq.lo);
+
+	/* Take the e-stop from its input interrupt, starting from the level it is at */
+	Motor_EStop(Sensors_GetEStop());
+	GPIO_setCallback(Board_ESTOP, EStopChanged);
+	GPIO_enableInt(Board_ESTOP);
+
+	/* Initialize the GUI. Its touch screen configures ADC sequencer 3 with priority 0, before the ADC clients below
+	   are registered and the manager ranks the sequencers */
 	GUI_Init(cpuFreq.lo);
 	GUI_SetCallback(GUI_MOTOR_STATE_CHANGE, (tGUICallbackFxn)MotorStateChanged);
+	GUI_SetCallback(GUI_MOTOR_SPEED_CHANGE, (tGUICallbackFxn)MotorSpeedChanged);
+	GUI_SetCallback(GUI_MAX_POWER_CHANGE, (tGUICallbackFxn)MaxPowerChanged);
+	GUI_SetCallback(GUI_MAX_ACCEL_CHANGE, (tGUICallbackFxn)MaxAccelChanged);
 	GUI_SetCallback(GUI_SET_TIME_CHANGE, (tGUICallbackFxn)SetClock);
-	GUI_SetCallback(GUI_RETURN_TIME, (tGUICallbackFxn)GetClock);
-	GUI_SetCallback(GUI_RETURN_SPEED, (tGUICallbackFxn)GetCurrentSpeed);
-	GUI_SetCallback(GUI_RETURN_POWER, (tGUICallbackFxn)GetCurrentPower);
-	GUI_SetCallback(GUI_RETURN_LIGHT, (tGUICallbackFxn)GetCurrentLight);
-	GUI_SetCallback(GUI_RETURN_ACCEL, (tGUICallbackFxn)GetCurrentAccel);
-	GUI_SetCallback(GUI_RETURN_ESTOP, (tGUICallbackFxn)GetEStop);
+
+	/* Start sampling the supply on the PWM module the bridge set up */
+	if (!Power_Init(cpuFreq.lo))
+		System_printf("Power sampling could not be scheduled\n");
+
+	/* Start the light sensor, its transfers run once BIOS is started */
+	if (!OPT3001_Init())
+		System_printf("Light sensor bus could not be opened\n");
 
 	/* Construct task threads */
 	Task_Params taskParams;
 	Task_Params_init(&taskParams);
 	taskParams.stackSize = TASK_STACK_SIZE;
 	taskParams.stack = &ga_cHandleGUIStack;
+	taskParams.priority = TASK_PRIORITY_GUI_INPUT;
 	Task_construct(&g_sHandleGUITask, (Task_FuncPtr)GUI_Handle, &taskParams, NULL);
+	taskParams.stack = &ga_cRenderGUIStack;
+	taskParams.priority = TASK_PRIORITY_GUI_RENDER;
+	Task_construct(&g_sRenderGUITask, (Task_FuncPtr)GUI_Render, &taskParams, NULL);
+	taskParams.stack = &ga_cMotorStack;
+	taskParams.priority = TASK_PRIORITY_MOTOR;
+	Task_construct(&g_sMotorTask, (Task_FuncPtr)Motor_Control, &taskParams, NULL);
+
+	/* Show the load of each task on the performance overlay */
+	GUI_AddOverlayTask(Task_handle(&g_sHandleGUITask), "in");
+	GUI_AddOverlayTask(Task_handle(&g_sRenderGUITask), "rn");
+	GUI_AddOverlayTask(Task_handle(&g_sMotorTask), "mo");
 
 	/* Construct clock threads */
 	Clock_Params clockParams;
 	Clock_Params_init(&clockParams);
 	clockParams.startFlag = true;
 	clockParams.period = GUI_PULSE_PERIOD;
+	Clock_create((Clock_FuncPtr)PublishSensors, GUI_PULSE_PERIOD, &clockParams, NULL);
 	Clock_create((Clock_FuncPtr)GUI_Pulse, GUI_PULSE_PERIOD, &clockParams, NULL);
+	clockParams.period = HALL_PUBLISH_PERIOD;
+	Clock_create((Clock_FuncPtr)Hall_Publish, HALL_PUBLISH_PERIOD, &clockParams, NULL);
+	clockParams.period = LIGHT_WATCHDOG;
+	Clock_create((Clock_FuncPtr)OPT3001_Poll, LIGHT_WATCHDOG, &clockParams, NULL);
 	clockParams.period = 1000;
 	Clock_create((Clock_FuncPtr)PulseClock, 1000, &clockParams, NULL);
 
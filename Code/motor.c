@@ -0,0 +1,410 @@
+#pragma region Includes
+#include "motor.h"
+#include "control.h"
+#include "commutation.h"
+#include "config.h"
+#include "bus.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* XDCtools header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+#include <xdc/runtime/Types.h>
+
+/* BIOS header files */
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Event.h>
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#if defined(__TI_COMPILER_VERSION__)
+#define MOTOR_BARRIER() __asm(" dmb")
+#else
+#define MOTOR_BARRIER() __sync_synchronize()
+#endif
+
+#define MOTOR_EVENT_PERIOD Event_Id_00
+#define MOTOR_TIMER_BASE TIMER2_BASE
+#define MOTOR_TIMER_PERIPH SYSCTL_PERIPH_TIMER2
+#define MOTOR_TIMER_INT INT_TIMER2A
+#define MOTOR_DUTY_MAX COMMUTATION_DUTY_MAX
+#define MOTOR_KP (491 * 65536) // Duty counts per RPM, a 45 rad/s loop on a 300 RPM motor with a 100 ms time constant
+#define MOTOR_KI 644100		   // Duty counts per RPM per period (Q16), the integral takes over below 20 rad/s
+#define MOTOR_FULL_SPEED 300   // Speed at full duty without load, the reference stays within what the max power reaches (RPM)
+
+/**
+ * @brief Mailbox slot holding the latest command of one kind
+ *
+ * @note The producer only writes the value and the posted count, the controller only the taken count
+ */
+typedef struct tMotorSlot {
+	volatile int32_t i32Value;
+	volatile uint32_t ui32Posted;
+	uint32_t ui32Taken;
+} tMotorSlot;
+
+/**
+ * @brief Setpoints the controller works towards
+ *
+ */
+typedef struct tMotorSetpoints {
+	bool bRunning;
+	int32_t i32Speed;
+	int32_t i32MaxPower;
+	int32_t i32MaxAccel;
+} tMotorSetpoints;
+
+/* Global variables */
+Event_Struct g_sMotorEvent;
+Event_Handle g_hMotorEvent;
+Hwi_Struct g_sMotorHwi;
+volatile uint32_t g_ui32MotorTick = 0;
+uint32_t g_ui32MotorPeriod = 0;
+uint32_t g_ui32MotorLastStart = 0;
+tMotorTimingStats g_sMotorTimingStats;
+tMotorStatus g_sMotorStatus;
+tControlPI g_sMotorPI = ControlPI(MOTOR_KP, MOTOR_KI, 0, MOTOR_DUTY_MAX);
+tControlSCurve g_sMotorCurve;
+bool g_bMotorPlan = true;
+volatile bool g_bMotorEStop = false;
+volatile bool g_bMotorEStopTaken = false; // Set by every engage, so one shorter than a control period still stops the run
+tMotorSlot g_sMotorSlots[MOTOR_COMMAND_COUNT];
+tMotorSetpoints g_sMotorSetpoints = {false, 0, MAX_POWER, MAX_ACCEL};
+tMotorMailboxStats g_sMotorMailboxStats;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Applies a command to the setpoints of the controller
+ *
+ * @param eCommand The command to apply
+ * @param i32Value The value of the command
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Motor_Apply(tMotorCommand eCommand, int32_t i32Value) {
+	switch (eCommand) {
+	case MOTOR_COMMAND_STATE:
+		g_sMotorSetpoints.bRunning = i32Value != 0;
+		break;
+	case MOTOR_COMMAND_SPEED:
+		g_sMotorSetpoints.i32Speed = i32Value;
+		break;
+	case MOTOR_COMMAND_MAX_POWER:
+		g_sMotorSetpoints.i32MaxPower = i32Value;
+		break;
+	case MOTOR_COMMAND_MAX_ACCEL:
+		g_sMotorSetpoints.i32MaxAccel = i32Value;
+		break;
+	default:
+		return;
+	}
+
+	g_bMotorPlan = true;
+}
+
+/**
+ * @brief Applies the latest command of each kind posted since the last control period
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Motor_ReceiveCommands() {
+	uint8_t ui8Depth = 0;
+
+	/* State first, so a start and a new speed posted together take effect in the same period */
+	for (uint8_t i = 0; i < MOTOR_COMMAND_COUNT; i++) {
+		tMotorSlot *psSlot = &g_sMotorSlots[i];
+		uint32_t ui32Posted = psSlot->ui32Posted;
+		if (ui32Posted == psSlot->ui32Taken)
+			continue;
+
+		/* The value is at least as new as the count, a newer one is applied again next period */
+		MOTOR_BARRIER();
+		int32_t i32Value = psSlot->i32Value;
+
+		g_sMotorMailboxStats.ui32Coalesced += ui32Posted - psSlot->ui32Taken - 1;
+		g_sMotorMailboxStats.ui32Applied++;
+		psSlot->ui32Taken = ui32Posted;
+		ui8Depth++;
+
+		Motor_Apply((tMotorCommand)i, i32Value);
+	}
+
+	if (ui8Depth > g_sMotorMailboxStats.ui8PeakDepth)
+		g_sMotorMailboxStats.ui8PeakDepth = ui8Depth;
+}
+
+/**
+ * @brief Reads the latest speed measurement
+ *
+ * @return The speed (RPM)
+ *
+ * @note This function is not intended to be called by the user
+ */
+int32_t Motor_MeasureSpeed() {
+	tBusSample sSample;
+	return Bus_Read(BUS_TOPIC_SPEED, &sSample) ? sSample.i32Value : 0;
+}
+
+/**
+ * @brief Applies a duty cycle to the motor
+ *
+ * @param i32Duty The duty cycle (0 to MOTOR_DUTY_MAX)
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Motor_Drive(int32_t i32Duty) {
+	g_sMotorStatus.i32Duty = i32Duty;
+	Commutation_SetDuty(i32Duty);
+}
+
+/**
+ * @brief Plans the speed reference towards the setpoints
+ *
+ * @note The target is limited to the speed the max power reaches without load, and the acceleration rises to
+ *		 the max acceleration over MOTOR_JERK_TIME
+ * @note This function is not intended to be called by the user
+ */
+void Motor_Plan() {
+	int32_t i32Target = g_sMotorSetpoints.i32Speed;
+	int32_t i32Reach = g_sMotorSetpoints.i32MaxPower * MOTOR_FULL_SPEED / MAX_POWER;
+	if (i32Target > i32Reach)
+		i32Target = i32Reach;
+
+	int32_t i32MaxAccel = ((int64_t)g_sMotorSetpoints.i32MaxAccel * MOTOR_ACCEL_SCALE << 24) / MOTOR_CONTROL_RATE;
+	int32_t i32MaxJerk = i32MaxAccel / (MOTOR_JERK_TIME * MOTOR_CONTROL_RATE / 1000);
+	Control_SCurvePlan(&g_sMotorCurve, i32Target, i32MaxAccel, i32MaxJerk > 0 ? i32MaxJerk : 1);
+	g_bMotorPlan = false;
+}
+
+/**
+ * @brief Runs one period of the speed loop
+ *
+ * @note The speed reference follows an S-curve planned when the setpoints change, see Motor_Plan, and the duty
+ *		 is clamped to the max power, the PI controller stops integrating while the clamp holds. Stopping opens the bridge at once, the Hall
+ *		 interrupt then writes nothing but open patterns. An e-stop has already opened it, see Motor_EStop, the loop
+ *		 follows up by clearing the run setpoint, a start posted after the release runs the motor again
+ * @note This function is not intended to be called by the user
+ */
+void Motor_Step() {
+	int32_t i32Speed = Motor_MeasureSpeed();
+
+	/* An e-stop cancels the run, also one engaged and released since the last period */
+	UInt uiKey = Hwi_disable();
+	bool bEStop = g_bMotorEStop || g_bMotorEStopTaken;
+	g_bMotorEStopTaken = false;
+	Hwi_restore(uiKey);
+	if (bEStop)
+		g_sMotorSetpoints.bRunning = false;
+
+	g_sMotorStatus.i32Speed = i32Speed;
+	if (!g_sMotorSetpoints.bRunning) {
+		/* Start again from the speed the motor is coasting at */
+		Control_SCurveReset(&g_sMotorCurve, i32Speed);
+		Control_PIReset(&g_sMotorPI, 0);
+		g_bMotorPlan = true;
+		if (g_sMotorStatus.bRunning)
+			Commutation_SetMode(COMMUTATION_OFF);
+		g_sMotorStatus.bRunning = false;
+		g_sMotorStatus.i32Reference = i32Speed;
+		Motor_Drive(0);
+		return;
+	}
+
+	if (g_bMotorPlan)
+		Motor_Plan();
+	int32_t i32Reference = Control_SCurveStep(&g_sMotorCurve);
+	Control_PISetLimits(&g_sMotorPI, 0, g_sMotorSetpoints.i32MaxPower * MOTOR_DUTY_MAX / MAX_POWER);
+
+	if (!g_sMotorStatus.bRunning) {
+		/* An e-stop taken since the check above must not be undone */
+		uiKey = Hwi_disable();
+		if (!g_bMotorEStop)
+			Commutation_SetMode(COMMUTATION_FORWARD);
+		Hwi_restore(uiKey);
+	}
+	g_sMotorStatus.bRunning = true;
+	g_sMotorStatus.i32Reference = i32Reference;
+	Motor_Drive(Control_PIStep(&g_sMotorPI, i32Reference - i32Speed));
+}
+
+/**
+ * @brief Accounts for the timing of one control period
+ *
+ * @param ui32Tick The time the timer interrupt fired
+ * @param ui32Start The time the period started running
+ * @param ui32End The time the period finished
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Motor_AccountTiming(uint32_t ui32Tick, uint32_t ui32Start, uint32_t ui32End) {
+	tMotorTimingStats *psStats = &g_sMotorTimingStats;
+
+	if (psStats->ui32Periods > 0) {
+		/* A gap of two or more periods means timer interrupts were coalesced */
+		uint32_t ui32Interval = ui32Start - g_ui32MotorLastStart;
+		uint32_t ui32Jitter = ui32Interval > g_ui32MotorPeriod ? ui32Interval - g_ui32MotorPeriod : g_ui32MotorPeriod - ui32Interval;
+		if (ui32Interval >= g_ui32MotorPeriod * 3 / 2)
+			psStats->ui32Missed += (ui32Interval + g_ui32MotorPeriod / 2) / g_ui32MotorPeriod - 1;
+		else if (ui32Jitter > psStats->ui32WorstJitter)
+			psStats->ui32WorstJitter = ui32Jitter;
+	}
+
+	g_ui32MotorLastStart = ui32Start;
+	psStats->ui32Periods++;
+	if (ui32Start - ui32Tick > psStats->ui32WorstLatency)
+		psStats->ui32WorstLatency = ui32Start - ui32Tick;
+	if (ui32End - ui32Start > psStats->ui32WorstExecution)
+		psStats->ui32WorstExecution = ui32End - ui32Start;
+}
+
+/**
+ * @brief Triggers a control period from the timer interrupt
+ *
+ * @param arg Unused
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Motor_TimerHwi(UArg arg) {
+	TimerIntClear(MOTOR_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+	g_ui32MotorTick = Timestamp_get32();
+	Event_post(g_hMotorEvent, MOTOR_EVENT_PERIOD);
+}
+#pragma endregion
+
+#pragma region Motor API functions
+/**
+ * @brief Initialize the motor controller
+ *
+ * @param ui32SysClock The frequency of the system clock
+ *
+ * @note The control timer starts at once, its interrupt is taken once BIOS is started
+ */
+void Motor_Init(uint32_t ui32SysClock) {
+	Event_construct(&g_sMotorEvent, NULL);
+	g_hMotorEvent = Event_handle(&g_sMotorEvent);
+
+	/* Convert the control period to timestamp counts */
+	Types_FreqHz sFreq;
+	Timestamp_getFreq(&sFreq);
+	g_ui32MotorPeriod = sFreq.lo / MOTOR_CONTROL_RATE;
+
+	/* Run the control period from a hardware timer, so it does not drift with the clock tick */
+	Hwi_Params hwiParams;
+	Hwi_Params_init(&hwiParams);
+	Hwi_construct(&g_sMotorHwi, MOTOR_TIMER_INT, Motor_TimerHwi, &hwiParams, NULL);
+
+	SysCtlPeripheralEnable(MOTOR_TIMER_PERIPH);
+	TimerConfigure(MOTOR_TIMER_BASE, TIMER_CFG_PERIODIC);
+	TimerLoadSet(MOTOR_TIMER_BASE, TIMER_A, ui32SysClock / MOTOR_CONTROL_RATE - 1);
+	TimerIntEnable(MOTOR_TIMER_BASE, TIMER_TIMA_TIMEOUT);
+	TimerEnable(MOTOR_TIMER_BASE, TIMER_A);
+}
+
+/**
+ * @brief Posts a command to the motor controller
+ *
+ * @param eCommand The command to post
+ * @param i32Value The value of the command
+ *
+ * @note This function never blocks. A command not yet applied is replaced by the next one of the same
+ *		 kind, so the controller only sees the latest value. Each command must have a single producer
+ */
+void Motor_Post(tMotorCommand eCommand, int32_t i32Value) {
+	if (eCommand >= MOTOR_COMMAND_COUNT)
+		return;
+
+	tMotorSlot *psSlot = &g_sMotorSlots[eCommand];
+	psSlot->i32Value = i32Value;
+	MOTOR_BARRIER();
+	psSlot->ui32Posted++;
+}
+
+/**
+ * @brief Runs the motor controller, applying the posted commands and the speed loop once per control period
+ *
+ * @note This function does not return and should be called in its own task, at a higher priority than the GUI.
+ *		 Control periods are triggered by TIMER2A, every 1/MOTOR_CONTROL_RATE s
+ */
+void Motor_Control() {
+	while (1) {
+		Event_pend(g_hMotorEvent, Event_Id_NONE, MOTOR_EVENT_PERIOD, BIOS_WAIT_FOREVER);
+		uint32_t ui32Start = Timestamp_get32();
+
+		Motor_ReceiveCommands();
+		Motor_Step();
+
+		Motor_AccountTiming(g_ui32MotorTick, ui32Start, Timestamp_get32());
+	}
+}
+
+/**
+ * @brief Engages or releases the e-stop
+ *
+ * @param bEngaged Whether the e-stop is engaged
+ *
+ * @note Called from the interrupt of the e-stop input. Engaging opens the bridge at once, before the Hall interrupt
+ *		 can drive another row, the speed loop clears the run setpoint on its next period. Releasing does not start the
+ *		 motor, that takes a new MOTOR_COMMAND_STATE. The e-stop is published on the data bus from here, this function
+ *		 is its only producer
+ */
+void Motor_EStop(bool bEngaged) {
+	g_bMotorEStop = bEngaged;
+	if (bEngaged) {
+		g_bMotorEStopTaken = true;
+		Commutation_SetMode(COMMUTATION_OFF);
+	}
+	Bus_Publish(BUS_TOPIC_ESTOP, bEngaged);
+}
+
+/**
+ * @brief Gets the statistics of the command mailbox
+ *
+ * @param psStats The statistics to copy into
+ */
+void Motor_GetMailboxStats(tMotorMailboxStats *psStats) {
+	*psStats = g_sMotorMailboxStats;
+
+	/* The producer side is read live, so the counts may be one command apart */
+	psStats->ui32Posted = 0;
+	psStats->ui8Depth = 0;
+	for (uint8_t i = 0; i < MOTOR_COMMAND_COUNT; i++) {
+		uint32_t ui32Posted = g_sMotorSlots[i].ui32Posted;
+		psStats->ui32Posted += ui32Posted;
+		if (ui32Posted != g_sMotorSlots[i].ui32Taken)
+			psStats->ui8Depth++;
+	}
+}
+
+/**
+ * @brief Gets the timing statistics of the control period
+ *
+ * @param psStats The statistics to copy into
+ *
+ * @note Times are in timestamp counts, see Timestamp_getFreq
+ */
+void Motor_GetTimingStats(tMotorTimingStats *psStats) {
+	*psStats = g_sMotorTimingStats;
+}
+
+/**
+ * @brief Gets the state of the speed loop
+ *
+ * @param psStatus The state to copy into
+ */
+void Motor_GetStatus(tMotorStatus *psStatus) {
+	*psStatus = g_sMotorStatus;
+}
+#pragma endregion
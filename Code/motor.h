@@ -0,0 +1,170 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define MOTOR_ACCEL_SCALE 10 // RPM/s per unit of acceleration, on the bus and in the max acceleration setting
+
+/**
+ * @brief Commands accepted by the motor controller
+ *
+ */
+typedef enum tMotorCommand {
+	/**
+	 * @brief Start (1) or stop (0) the motor
+	 */
+	MOTOR_COMMAND_STATE = 0,
+	/**
+	 * @brief The desired motor speed (RPM)
+	 */
+	MOTOR_COMMAND_SPEED,
+	/**
+	 * @brief The max allowed power (W)
+	 */
+	MOTOR_COMMAND_MAX_POWER,
+	/**
+	 * @brief The max allowed acceleration (m/s^2)
+	 */
+	MOTOR_COMMAND_MAX_ACCEL,
+
+	MOTOR_COMMAND_COUNT
+} tMotorCommand;
+
+/**
+ * @brief Statistics of the command mailbox
+ *
+ */
+typedef struct tMotorMailboxStats {
+	/**
+	 * @brief The number of commands posted
+	 */
+	uint32_t ui32Posted;
+	/**
+	 * @brief The number of commands applied by the controller
+	 */
+	uint32_t ui32Applied;
+	/**
+	 * @brief The number of commands replaced by a later one of the same kind before they were applied
+	 */
+	uint32_t ui32Coalesced;
+	/**
+	 * @brief The number of kinds of command waiting to be applied
+	 */
+	uint8_t ui8Depth;
+	/**
+	 * @brief The most kinds of command the controller has found waiting in one control period
+	 */
+	uint8_t ui8PeakDepth;
+} tMotorMailboxStats;
+
+/**
+ * @brief Timing statistics of the control period
+ *
+ * @note Times are in timestamp counts, see Timestamp_getFreq
+ */
+typedef struct tMotorTimingStats {
+	/**
+	 * @brief The number of control periods run
+	 */
+	uint32_t ui32Periods;
+	/**
+	 * @brief The number of timer periods passed without a control period
+	 */
+	uint32_t ui32Missed;
+	/**
+	 * @brief The largest deviation of the time between two control periods from the timer period
+	 */
+	uint32_t ui32WorstJitter;
+	/**
+	 * @brief The longest time from the timer interrupt to the start of the control period
+	 */
+	uint32_t ui32WorstLatency;
+	/**
+	 * @brief The longest time taken by one control period
+	 */
+	uint32_t ui32WorstExecution;
+} tMotorTimingStats;
+
+/**
+ * @brief The state of the speed loop
+ *
+ */
+typedef struct tMotorStatus {
+	/**
+	 * @brief Whether the speed loop is driving the motor
+	 */
+	bool bRunning;
+	/**
+	 * @brief The measured speed (RPM)
+	 */
+	int32_t i32Speed;
+	/**
+	 * @brief The speed reference after acceleration limiting (RPM)
+	 */
+	int32_t i32Reference;
+	/**
+	 * @brief The duty cycle applied to the motor (0 to 32767)
+	 */
+	int32_t i32Duty;
+} tMotorStatus;
+
+/**
+ * @brief Initialize the motor controller
+ *
+ * @param ui32SysClock The frequency of the system clock
+ *
+ * @note The control timer starts at once, its interrupt is taken once BIOS is started
+ */
+void Motor_Init(uint32_t ui32SysClock);
+
+/**
+ * @brief Posts a command to the motor controller
+ *
+ * @param eCommand The command to post
+ * @param i32Value The value of the command
+ *
+ * @note This function never blocks. A command not yet applied is replaced by the next one of the same
+ *		 kind, so the controller only sees the latest value. Each command must have a single producer
+ */
+void Motor_Post(tMotorCommand eCommand, int32_t i32Value);
+
+/**
+ * @brief Runs the motor controller, applying the posted commands and the speed loop once per control period
+ *
+ * @note This function does not return and should be called in its own task, at a higher priority than the GUI.
+ *		 Control periods are triggered by TIMER2A, every 1/MOTOR_CONTROL_RATE s
+ */
+void Motor_Control();
+
+/**
+ * @brief Engages or releases the e-stop
+ *
+ * @param bEngaged Whether the e-stop is engaged
+ *
+ * @note Safe to call from a Hwi, engaging opens the bridge at once and cancels the run. Releasing does not start
+ *		 the motor, that takes a new MOTOR_COMMAND_STATE after the release
+ */
+void Motor_EStop(bool bEngaged);
+
+/**
+ * @brief Gets the statistics of the command mailbox
+ *
+ * @param psStats The statistics to copy into
+ */
+void Motor_GetMailboxStats(tMotorMailboxStats *psStats);
+
+/**
+ * @brief Gets the timing statistics of the control period
+ *
+ * @param psStats The statistics to copy into
+ *
+ * @note Times are in timestamp counts, see Timestamp_getFreq
+ */
+void Motor_GetTimingStats(tMotorTimingStats *psStats);
+
+/**
+ * @brief Gets the state of the speed loop
+ *
+ * @param psStatus The state to copy into
+ */
+void Motor_GetStatus(tMotorStatus *psStatus);
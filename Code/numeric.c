@@ -0,0 +1,95 @@
+#pragma region Includes
+#include "numeric.h"
+#include "util.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Measures the widest character that can be shown in a cell
+ *
+ * @param psContext The graphics context, with the readout font selected
+ * @return The width of a cell
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint8_t Numeric_CellWidth(tContext *psContext) {
+	const char pcChars[] = "0123456789-";
+	int32_t i32Widest = 0;
+
+	for (uint8_t i = 0; i < sizeof(pcChars) - 1; i++) {
+		int32_t i32Width = GrStringWidthGet(psContext, &pcChars[i], 1);
+		if (i32Width > i32Widest)
+			i32Widest = i32Width;
+	}
+
+	return i32Widest;
+}
+#pragma endregion
+
+#pragma region Numeric API functions
+/**
+ * @brief Draws a value, only the cells that differ from what is on screen are redrawn
+ *
+ * @param psNumeric The readout to draw
+ * @param psContext The graphics context
+ * @param i32Value The value to show
+ */
+void Numeric_Draw(tNumericDisplay *psNumeric, tContext *psContext, int32_t i32Value) {
+	char pcText[NUMERIC_MAX_WIDTH + 1];
+	uint8_t ui8Width = psNumeric->ui8Width > NUMERIC_MAX_WIDTH ? NUMERIC_MAX_WIDTH : psNumeric->ui8Width;
+
+	FormatInt(i32Value, pcText, ui8Width, psNumeric->cPad);
+	GrContextFontSet(psContext, psNumeric->psFont);
+
+	if (psNumeric->ui8CellWidth == 0)
+		psNumeric->ui8CellWidth = Numeric_CellWidth(psContext);
+
+	/* Cells are laid out the same way GrStringDrawCentered would place the full width string */
+	int16_t i16Left = psNumeric->i16X - (psNumeric->ui8CellWidth * ui8Width) / 2;
+	int16_t i16Top = psNumeric->i16Y - GrFontBaselineGet(psNumeric->psFont) / 2;
+
+	for (uint8_t i = 0; i < ui8Width; i++) {
+		if (psNumeric->bValid && pcText[i] == psNumeric->pcShown[i])
+			continue;
+
+		/* Clear the cell */
+		tRectangle sCell = {
+			i16Left + i * psNumeric->ui8CellWidth,
+			i16Top,
+			i16Left + (i + 1) * psNumeric->ui8CellWidth - 1,
+			i16Top + GrFontHeightGet(psNumeric->psFont) - 1
+		};
+		GrContextForegroundSet(psContext, psNumeric->ui32Background);
+		GrRectFill(psContext, &sCell);
+
+		/* Draw the character centered in the cell */
+		if (pcText[i] != ' ') {
+			int32_t i32CharWidth = GrStringWidthGet(psContext, &pcText[i], 1);
+			GrContextForegroundSet(psContext, psNumeric->ui32Color);
+			GrStringDraw(psContext, &pcText[i], 1, sCell.i16XMin + (psNumeric->ui8CellWidth - i32CharWidth) / 2, i16Top, false);
+		}
+
+		psNumeric->pcShown[i] = pcText[i];
+	}
+
+	psNumeric->bValid = true;
+}
+
+/**
+ * @brief Forgets what is on screen so that the next draw redraws every cell
+ *
+ * @param psNumeric The readout to reset
+ *
+ * @note This should be called when the area behind the readout has been cleared
+ */
+void Numeric_Reset(tNumericDisplay *psNumeric) {
+	psNumeric->bValid = false;
+}
+#pragma endregion
@@ -0,0 +1,79 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+/* Global defines */
+#define NUMERIC_MAX_WIDTH 6
+
+/**
+ * @brief A fixed width numeric readout that only redraws the digits that changed
+ *
+ */
+typedef struct tNumericDisplay {
+	/**
+	 * @brief The font used to draw the digits
+	 */
+	const tFont *psFont;
+	/**
+	 * @brief The color of the digits
+	 */
+	uint32_t ui32Color;
+	/**
+	 * @brief The color behind the digits
+	 */
+	uint32_t ui32Background;
+	/**
+	 * @brief The x position of the center of the readout
+	 */
+	int16_t i16X;
+	/**
+	 * @brief The y position of the center of the readout
+	 */
+	int16_t i16Y;
+	/**
+	 * @brief The number of character cells, at most NUMERIC_MAX_WIDTH
+	 */
+	uint8_t ui8Width;
+	/**
+	 * @brief The character used to fill the cells before the number (' ' or '0')
+	 */
+	char cPad;
+
+	/* Private state, filled in when drawn */
+	uint8_t ui8CellWidth;
+	bool bValid;
+	char pcShown[NUMERIC_MAX_WIDTH + 1];
+} tNumericDisplay;
+
+/**
+ * @brief Statically initializes a numeric readout
+ *
+ * @param font The font used to draw the digits
+ * @param color The color of the digits
+ * @param background The color behind the digits
+ * @param x The x position of the center of the readout
+ * @param y The y position of the center of the readout
+ * @param width The number of character cells
+ * @param pad The character used to fill the cells before the number
+ */
+#define NumericDisplay(font, color, background, x, y, width, pad) \
+	{(font), (color), (background), (x), (y), (width), (pad), 0, false, {0}}
+
+/**
+ * @brief Draws a value, only the cells that differ from what is on screen are redrawn
+ *
+ * @param psNumeric The readout to draw
+ * @param psContext The graphics context
+ * @param i32Value The value to show
+ */
+void Numeric_Draw(tNumericDisplay *psNumeric, tContext *psContext, int32_t i32Value);
+
+/**
+ * @brief Forgets what is on screen so that the next draw redraws every cell
+ *
+ * @param psNumeric The readout to reset
+ *
+ * @note This should be called when the area behind the readout has been cleared
+ */
+void Numeric_Reset(tNumericDisplay *psNumeric);
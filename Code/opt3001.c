@@ -0,0 +1,305 @@
+#pragma region Includes
+#include "opt3001.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* XDCtools header files */
+#include <xdc/std.h>
+
+/* BIOS header files */
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TI-RTOS header files */
+#include <ti/drivers/GPIO.h>
+#include <ti/drivers/I2C.h>
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define OPT3001_REG_RESULT 0x00
+#define OPT3001_REG_CONFIG 0x01
+#define OPT3001_REG_LOW_LIMIT 0x02
+#define OPT3001_REG_DEVICE_ID 0x7F
+#define OPT3001_DEVICE_ID 0x3001
+#define OPT3001_CONFIG 0xC610 // Automatic range, 100 ms conversions, continuous, latched interrupt, active low
+#define OPT3001_END_OF_CONVERSION 0xC000 // A low limit with these exponent bits raises the interrupt after every conversion
+#define OPT3001_CONFIG_CRF 0x0080 // Conversion ready, cleared by reading the configuration
+#define OPT3001_CONFIG_MODE 0x0600 // Conversion mode, shut down after a reset
+
+/**
+ * @brief The transfers of the driver, each has its own transaction so they can all be queued at once
+ *
+ */
+typedef enum tOPT3001Transfer {
+	OPT3001_IDENTIFY = 0,
+	OPT3001_CONFIGURE,
+	OPT3001_ENABLE_INT,
+	OPT3001_READ_RESULT,
+	OPT3001_READ_FLAGS,
+
+	OPT3001_TRANSFER_COUNT
+} tOPT3001Transfer;
+
+/* Global constants */
+const uint8_t gc_ui8OPT3001Identify[1] = {OPT3001_REG_DEVICE_ID};
+const uint8_t gc_ui8OPT3001Configure[3] = {OPT3001_REG_CONFIG, OPT3001_CONFIG >> 8, OPT3001_CONFIG & 0xFF};
+const uint8_t gc_ui8OPT3001EnableInt[3] = {OPT3001_REG_LOW_LIMIT, OPT3001_END_OF_CONVERSION >> 8,
+										   OPT3001_END_OF_CONVERSION & 0xFF};
+const uint8_t gc_ui8OPT3001ReadResult[1] = {OPT3001_REG_RESULT};
+const uint8_t gc_ui8OPT3001ReadFlags[1] = {OPT3001_REG_CONFIG};
+
+/* Global variables */
+I2C_Handle g_hOPT3001I2C = NULL;
+I2C_Transaction g_sOPT3001Transfers[OPT3001_TRANSFER_COUNT];
+uint8_t ga_ui8OPT3001Replies[OPT3001_TRANSFER_COUNT][2];
+bool g_bOPT3001Configuring = false;
+bool g_bOPT3001Failed = false;
+bool g_bOPT3001Reading = false;
+bool g_bOPT3001ResultValid = false;
+bool g_bOPT3001Refill = true;
+uint32_t g_ui32OPT3001PolledConversions = 0;
+tOPT3001Stats g_sOPT3001Stats;
+
+/* Moving average, in 0.01 lux */
+uint32_t ga_ui32OPT3001Window[LIGHT_AVERAGE];
+uint32_t g_ui32OPT3001Sum = 0;
+uint8_t g_ui8OPT3001Next = 0;
+#pragma endregion
+
+#pragma region Internal functions
+void OPT3001_TransferFxn(I2C_Handle hI2C, I2C_Transaction *psTransfer, bool bSuccess);
+
+/**
+ * @brief Queues a transfer
+ *
+ * @param eTransfer The transfer
+ * @param pui8Write The bytes to write, the register first
+ * @param ui8WriteCount The number of bytes to write
+ * @param ui8ReadCount The number of bytes to read back
+ *
+ * @note This function is not intended to be called by the user
+ */
+void OPT3001_Queue(tOPT3001Transfer eTransfer, const uint8_t *pui8Write, uint8_t ui8WriteCount, uint8_t ui8ReadCount) {
+	I2C_Transaction *psTransfer = &g_sOPT3001Transfers[eTransfer];
+	psTransfer->slaveAddress = Board_OPT3001_ADDR;
+	psTransfer->writeBuf = (void *)pui8Write;
+	psTransfer->writeCount = ui8WriteCount;
+	psTransfer->readBuf = ga_ui8OPT3001Replies[eTransfer];
+	psTransfer->readCount = ui8ReadCount;
+	psTransfer->arg = (void *)eTransfer;
+
+	/* The callback of a transfer that could not be queued never comes, it is handled as failed instead */
+	if (!I2C_transfer(g_hOPT3001I2C, psTransfer))
+		OPT3001_TransferFxn(g_hOPT3001I2C, psTransfer, false);
+}
+
+/**
+ * @brief Queues the transfer that finds the sensor, it is configured once found
+ *
+ * @note This function is not intended to be called by the user
+ */
+void OPT3001_Configure() {
+	UInt uiKey = Hwi_disable();
+	bool bBusy = g_bOPT3001Configuring;
+	g_bOPT3001Configuring = true;
+	g_bOPT3001Failed = false;
+	Hwi_restore(uiKey);
+	if (bBusy)
+		return;
+
+	OPT3001_Queue(OPT3001_IDENTIFY, gc_ui8OPT3001Identify, 1, 2);
+}
+
+/**
+ * @brief Queues the transfers that read a conversion and clear the interrupt
+ *
+ * @return False if the previous conversion was still being read
+ *
+ * @note This function is not intended to be called by the user
+ */
+bool OPT3001_Read() {
+	UInt uiKey = Hwi_disable();
+	bool bBusy = g_bOPT3001Reading;
+	g_bOPT3001Reading = true;
+	Hwi_restore(uiKey);
+	if (bBusy)
+		return false;
+
+	/* The result before the flags, so the reading of the flags that releases the interrupt comes last */
+	OPT3001_Queue(OPT3001_READ_RESULT, gc_ui8OPT3001ReadResult, 1, 2);
+	OPT3001_Queue(OPT3001_READ_FLAGS, gc_ui8OPT3001ReadFlags, 1, 2);
+	return true;
+}
+
+/**
+ * @brief Adds a conversion to the moving average
+ *
+ * @param ui16Result The result register, a 4 bit exponent over a 12 bit mantissa
+ *
+ * @note This function is not intended to be called by the user
+ */
+void OPT3001_AddConversion(uint16_t ui16Result) {
+	/* 0.01 lux times 2 to the exponent per count, so the mantissa only needs shifting */
+	uint32_t ui32Light = (uint32_t)(ui16Result & 0x0FFF) << (ui16Result >> 12);
+
+	/* The first conversion after the sensor was configured fills the window, so the average neither rises from 0 nor
+	   holds the light from before the sensor was lost */
+	if (g_bOPT3001Refill) {
+		g_bOPT3001Refill = false;
+		for (uint8_t i = 0; i < LIGHT_AVERAGE; i++)
+			ga_ui32OPT3001Window[i] = ui32Light;
+		g_ui32OPT3001Sum = ui32Light * LIGHT_AVERAGE;
+	} else {
+		g_ui32OPT3001Sum += ui32Light - ga_ui32OPT3001Window[g_ui8OPT3001Next];
+		ga_ui32OPT3001Window[g_ui8OPT3001Next] = ui32Light;
+	}
+
+	g_ui8OPT3001Next = (g_ui8OPT3001Next + 1) % LIGHT_AVERAGE;
+	g_sOPT3001Stats.ui32Conversions++;
+}
+
+/**
+ * @brief Handles the end of a transfer
+ *
+ * @param hI2C The I2C bus
+ * @param psTransfer The transfer
+ * @param bSuccess Whether the sensor acknowledged it
+ *
+ * @note Called from the I2C interrupt
+ * @note This function is not intended to be called by the user
+ */
+void OPT3001_TransferFxn(I2C_Handle hI2C, I2C_Transaction *psTransfer, bool bSuccess) {
+	tOPT3001Transfer eTransfer = (tOPT3001Transfer)(uintptr_t)psTransfer->arg;
+	const uint8_t *pui8Reply = ga_ui8OPT3001Replies[eTransfer];
+	uint16_t ui16Reply = (pui8Reply[0] << 8) | pui8Reply[1];
+	if (!bSuccess)
+		g_sOPT3001Stats.ui32Errors++;
+
+	switch (eTransfer) {
+	case OPT3001_IDENTIFY:
+		/* Nothing is written to a device that is not the sensor */
+		if (bSuccess && ui16Reply == OPT3001_DEVICE_ID) {
+			OPT3001_Queue(OPT3001_CONFIGURE, gc_ui8OPT3001Configure, 3, 0);
+			OPT3001_Queue(OPT3001_ENABLE_INT, gc_ui8OPT3001EnableInt, 3, 0);
+		} else {
+			g_bOPT3001Configuring = false;
+		}
+		break;
+	case OPT3001_CONFIGURE:
+		g_bOPT3001Failed |= !bSuccess;
+		break;
+	case OPT3001_ENABLE_INT:
+		g_bOPT3001Failed |= !bSuccess;
+		g_sOPT3001Stats.bConfigured = !g_bOPT3001Failed;
+		g_bOPT3001Refill = !g_bOPT3001Failed;
+		g_bOPT3001Configuring = false;
+
+		/* Release an interrupt latched before the sensor was configured, its edge has passed */
+		if (!g_bOPT3001Failed)
+			OPT3001_Read();
+		break;
+	case OPT3001_READ_RESULT:
+		g_bOPT3001ResultValid = bSuccess;
+		break;
+	case OPT3001_READ_FLAGS:
+		/* A read with no conversion ready since the last one only released the interrupt */
+		if (bSuccess && g_bOPT3001ResultValid && (ui16Reply & OPT3001_CONFIG_CRF))
+			OPT3001_AddConversion((ga_ui8OPT3001Replies[OPT3001_READ_RESULT][0] << 8) |
+								  ga_ui8OPT3001Replies[OPT3001_READ_RESULT][1]);
+
+		/* A sensor that lost power came back shut down, the next poll configures it again */
+		if (bSuccess && (ui16Reply & OPT3001_CONFIG_MODE) != (OPT3001_CONFIG & OPT3001_CONFIG_MODE))
+			g_sOPT3001Stats.bConfigured = false;
+		g_bOPT3001Reading = false;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Handles the interrupt pin of the sensor, asserted at the end of every conversion
+ *
+ * @param uiIndex The board pin
+ *
+ * @note This function is not intended to be called by the user
+ */
+void OPT3001_IntFxn(unsigned int uiIndex) {
+	if (!OPT3001_Read())
+		g_sOPT3001Stats.ui32Missed++;
+}
+#pragma endregion
+
+#pragma region OPT3001 API functions
+/**
+ * @brief Initialize the OPT3001 light sensor and start its conversions
+ *
+ * @return True if the I2C bus could be opened
+ *
+ * @note The sensor is on Board_I2C0 at Board_OPT3001_ADDR with its interrupt on Board_OPT3001_INT. Every transfer is
+ *		 queued in callback mode, the sensor is configured once BIOS is started. Must be called after Board_initI2C
+ */
+bool OPT3001_Init() {
+	I2C_Params i2cParams;
+	I2C_Params_init(&i2cParams);
+	i2cParams.transferMode = I2C_MODE_CALLBACK;
+	i2cParams.transferCallbackFxn = OPT3001_TransferFxn;
+	i2cParams.bitRate = I2C_400kHz;
+	g_hOPT3001I2C = I2C_open(Board_I2C0, &i2cParams);
+	if (g_hOPT3001I2C == NULL)
+		return false;
+
+	GPIO_setCallback(Board_OPT3001_INT, OPT3001_IntFxn);
+	GPIO_enableInt(Board_OPT3001_INT);
+	OPT3001_Configure();
+	return true;
+}
+
+/**
+ * @brief Reads a conversion the interrupt has not signalled, and configures the sensor if it was not found or reset
+ *
+ * @note This function should be called periodically from a clock task, every LIGHT_WATCHDOG ms. It never blocks
+ */
+void OPT3001_Poll() {
+	if (g_hOPT3001I2C == NULL)
+		return;
+
+	if (!g_sOPT3001Stats.bConfigured) {
+		OPT3001_Configure();
+		return;
+	}
+
+	/* A conversion finishes every 100 ms, none since the last poll means an edge was lost */
+	uint32_t ui32Conversions = g_sOPT3001Stats.ui32Conversions;
+	if (ui32Conversions == g_ui32OPT3001PolledConversions && OPT3001_Read())
+		g_sOPT3001Stats.ui32Recoveries++;
+	g_ui32OPT3001PolledConversions = ui32Conversions;
+}
+
+/**
+ * @brief Gets the light level, the moving average of the last LIGHT_AVERAGE conversions
+ *
+ * @return The light level (0.01 lux), 0 until the first conversion is read
+ */
+uint32_t OPT3001_GetLight() {
+	return g_ui32OPT3001Sum / LIGHT_AVERAGE;
+}
+
+/**
+ * @brief Gets the statistics of the light sensor driver
+ *
+ * @param psStats The statistics to copy into
+ */
+void OPT3001_GetStats(tOPT3001Stats *psStats) {
+	UInt uiKey = Hwi_disable();
+	*psStats = g_sOPT3001Stats;
+	Hwi_restore(uiKey);
+}
+#pragma endregion
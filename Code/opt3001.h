@@ -0,0 +1,61 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Statistics of the light sensor driver
+ *
+ */
+typedef struct tOPT3001Stats {
+	/**
+	 * @brief The number of conversions read
+	 */
+	uint32_t ui32Conversions;
+	/**
+	 * @brief The number of I2C transfers that failed
+	 */
+	uint32_t ui32Errors;
+	/**
+	 * @brief The number of interrupts taken while the previous conversion was still being read
+	 */
+	uint32_t ui32Missed;
+	/**
+	 * @brief The number of reads started by OPT3001_Poll rather than by the interrupt
+	 */
+	uint32_t ui32Recoveries;
+	/**
+	 * @brief Whether the sensor was found and configured
+	 */
+	bool bConfigured;
+} tOPT3001Stats;
+
+/**
+ * @brief Initialize the OPT3001 light sensor and start its conversions
+ *
+ * @return True if the I2C bus could be opened
+ *
+ * @note The sensor is on Board_I2C0 at Board_OPT3001_ADDR with its interrupt on Board_OPT3001_INT. Every transfer is
+ *		 queued in callback mode, the sensor is configured once BIOS is started. Must be called after Board_initI2C
+ */
+bool OPT3001_Init();
+
+/**
+ * @brief Reads a conversion the interrupt has not signalled, and configures the sensor if it was not found or reset
+ *
+ * @note This function should be called periodically from a clock task, every LIGHT_WATCHDOG ms. It never blocks
+ */
+void OPT3001_Poll();
+
+/**
+ * @brief Gets the light level, the moving average of the last LIGHT_AVERAGE conversions
+ *
+ * @return The light level (0.01 lux), 0 until the first conversion is read
+ */
+uint32_t OPT3001_GetLight();
+
+/**
+ * @brief Gets the statistics of the light sensor driver
+ *
+ * @param psStats The statistics to copy into
+ */
+void OPT3001_GetStats(tOPT3001Stats *psStats);
@@ -0,0 +1,185 @@
+#pragma region Includes
+#include "power.h"
+#include "adcmgr.h"
+#include "decimator.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* XDCtools header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+#include <xdc/runtime/Timestamp.h>
+
+/* BIOS header files */
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define POWER_ADC_PORT GPIO_PORTE_BASE
+#define POWER_ADC_PINS (GPIO_PIN_3 | GPIO_PIN_2)
+#define POWER_ADC_PERIPH SYSCTL_PERIPH_GPIOE
+#define POWER_ADC_CODES 4096
+#define POWER_SAMPLE_GEN PWM_GEN_2 // The outputs of generator 2 are not used by the bridge
+#define POWER_STEPS 2
+#define POWER_BLOCK_LEN (POWER_BLOCK * POWER_STEPS)
+#define POWER_PRODUCT_SHIFT 8 // Keeps the product of a current and a voltage sample within the decimator input
+
+#if POWER_BLOCK % DECIMATOR_RATIO != 0
+#error "POWER_BLOCK must be a multiple of DECIMATOR_RATIO"
+#endif
+
+/* Global constants */
+const uint32_t gc_ui32PowerChannels[POWER_STEPS] = {ADC_CTL_CH0, ADC_CTL_CH1}; // Current first, then voltage
+
+/* Global variables */
+uint16_t ga_ui16PowerBuffer[2 * POWER_BLOCK_LEN];
+tDecimator g_sPowerCurrent;
+tDecimator g_sPowerVoltage;
+tDecimator g_sPowerProduct;
+tPowerReading g_sPowerReading;
+uint32_t g_ui32PowerWorstTime = 0;
+uint64_t g_ui64PowerBusyTime = 0;
+uint32_t g_ui32PowerTimestampFreq = 0;
+
+void Power_Block(const uint16_t *pui16Block, uint16_t ui16Count, void *pvArg);
+
+tADCClient g_sPowerClient = {
+	.pui32Channels = gc_ui32PowerChannels,
+	.ui8NumSteps = POWER_STEPS,
+	.ui32Trigger = ADC_TRIGGER_PWM2 | ADC_TRIGGER_PWM_MOD0,
+	.ui32RateHz = POWER_SAMPLE_RATE,
+	.pui16Buffer = ga_ui16PowerBuffer,
+	.ui16BlockLen = POWER_BLOCK_LEN,
+	.pfnBlock = Power_Block,
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Filters a block of current and voltage samples
+ *
+ * @param pui16Block The samples, current and voltage in turn
+ * @param ui16Count The number of samples
+ * @param pvArg Unused
+ *
+ * @note Called from the ADC interrupt once per block, the decimators keep the CPU out of the per sample path
+ * @note This function is not intended to be called by the user
+ */
+void Power_Block(const uint16_t *pui16Block, uint16_t ui16Count, void *pvArg) {
+	uint32_t ui32Entry = Timestamp_get32();
+	int32_t i32Current = 0;
+	int32_t i32Voltage = 0;
+	int32_t i32Product = 0;
+	bool bOutput = false;
+
+	/* The three decimators run in step, an output from one is an output from all */
+	for (uint16_t i = 0; i + 1 < ui16Count; i += POWER_STEPS) {
+		int32_t i32I = (int32_t)pui16Block[i] - POWER_CURRENT_ZERO;
+		int32_t i32V = pui16Block[i + 1];
+		int32_t i32P = (i32I * i32V + (1 << (POWER_PRODUCT_SHIFT - 1))) >> POWER_PRODUCT_SHIFT;
+		bOutput |= Decimator_Push(&g_sPowerCurrent, i32I, &i32Current);
+		Decimator_Push(&g_sPowerVoltage, i32V, &i32Voltage);
+		Decimator_Push(&g_sPowerProduct, i32P, &i32Product);
+	}
+
+	/* Scale to units, the decimator outputs carry DECIMATOR_SHIFT fractional bits */
+	if (bOutput) {
+		int64_t i64Current = (int64_t)i32Current * POWER_CURRENT_FULL / (POWER_ADC_CODES / 2);
+		int64_t i64Voltage = (int64_t)i32Voltage * POWER_VOLTAGE_FULL / POWER_ADC_CODES;
+		int64_t i64Power = ((int64_t)i32Product << POWER_PRODUCT_SHIFT) * POWER_CURRENT_FULL / (POWER_ADC_CODES / 2) *
+						   POWER_VOLTAGE_FULL / POWER_ADC_CODES / 1000;
+		g_sPowerReading.i32Current = (int32_t)(i64Current >> DECIMATOR_SHIFT);
+		g_sPowerReading.i32Voltage = (int32_t)(i64Voltage >> DECIMATOR_SHIFT);
+		g_sPowerReading.i32Power = (int32_t)(i64Power >> DECIMATOR_SHIFT);
+	}
+
+	uint32_t ui32Time = Timestamp_get32() - ui32Entry;
+	if (ui32Time > g_ui32PowerWorstTime)
+		g_ui32PowerWorstTime = ui32Time;
+	g_ui64PowerBusyTime += ui32Time;
+}
+#pragma endregion
+
+#pragma region Power API functions
+/**
+ * @brief Initialize the current and voltage sampling and start it
+ *
+ * @param ui32SysClock The frequency of the system clock
+ * @return True if the ADC manager took the sequence
+ *
+ * @note The current sensor is read on AIN0 (PE3) and the supply voltage on AIN1 (PE2), both POWER_SAMPLE_RATE times
+ *		 a second. PWM0 generator 2 triggers the sequence, it must be called after Commutation_Init which sets the
+ *		 PWM clock and ADCMgr_Init
+ */
+bool Power_Init(uint32_t ui32SysClock) {
+	Decimator_Reset(&g_sPowerCurrent);
+	Decimator_Reset(&g_sPowerVoltage);
+	Decimator_Reset(&g_sPowerProduct);
+
+	Types_FreqHz sFreq;
+	Timestamp_getFreq(&sFreq);
+	g_ui32PowerTimestampFreq = sFreq.lo;
+
+	SysCtlPeripheralEnable(POWER_ADC_PERIPH);
+	GPIOPinTypeADC(POWER_ADC_PORT, POWER_ADC_PINS);
+
+	/* The timer trigger belongs to the touch screen, a spare PWM generator paces the samples instead. It triggers the
+	   sequence as it reloads, with its outputs left disabled */
+	PWMGenConfigure(PWM0_BASE, POWER_SAMPLE_GEN, PWM_GEN_MODE_DOWN | PWM_GEN_MODE_NO_SYNC);
+	PWMGenPeriodSet(PWM0_BASE, POWER_SAMPLE_GEN, ui32SysClock / POWER_SAMPLE_RATE);
+	PWMGenIntTrigEnable(PWM0_BASE, POWER_SAMPLE_GEN, PWM_TR_CNT_LOAD);
+
+	if (!ADCMgr_Register(&g_sPowerClient))
+		return false;
+
+	PWMGenEnable(PWM0_BASE, POWER_SAMPLE_GEN);
+	return true;
+}
+
+/**
+ * @brief Gets the latest filtered readings
+ *
+ * @param psReading The readings to copy into
+ *
+ * @note Updated once per block, POWER_SAMPLE_RATE / POWER_BLOCK times a second
+ */
+void Power_Get(tPowerReading *psReading) {
+	UInt uiKey = Hwi_disable();
+	*psReading = g_sPowerReading;
+	Hwi_restore(uiKey);
+}
+
+/**
+ * @brief Gets the statistics of the power sampling
+ *
+ * @param psStats The statistics to copy into
+ */
+void Power_GetStats(tPowerStats *psStats) {
+	UInt uiKey = Hwi_disable();
+	uint32_t ui32Blocks = g_sPowerClient.ui32Blocks;
+	uint64_t ui64Busy = g_ui64PowerBusyTime;
+	psStats->ui32Blocks = ui32Blocks;
+	psStats->ui32Overruns = g_sPowerClient.ui32Overruns;
+	psStats->ui32WorstTime = g_ui32PowerWorstTime;
+	Hwi_restore(uiKey);
+
+	/* The load follows from the mean time per block and the block rate */
+	psStats->ui32MeanTime = ui32Blocks > 0 ? (uint32_t)(ui64Busy / ui32Blocks) : 0;
+	uint64_t ui64Load = g_ui32PowerTimestampFreq > 0 ? (uint64_t)psStats->ui32MeanTime * POWER_SAMPLE_RATE * 1000000 /
+														   ((uint64_t)POWER_BLOCK * g_ui32PowerTimestampFreq)
+													 : 0;
+	psStats->ui32Load = (uint32_t)ui64Load;
+	psStats->ui32LoadPerKHz = (uint32_t)(ui64Load * 1000 / (POWER_SAMPLE_RATE * POWER_STEPS));
+}
+#pragma endregion
@@ -0,0 +1,84 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief The filtered supply readings of the motor
+ *
+ */
+typedef struct tPowerReading {
+	/**
+	 * @brief The current drawn from the supply (mA)
+	 */
+	int32_t i32Current;
+	/**
+	 * @brief The supply voltage (mV)
+	 */
+	int32_t i32Voltage;
+	/**
+	 * @brief The power drawn from the supply, the mean of the product of the samples rather than the product of the
+	 *		  means (mW)
+	 */
+	int32_t i32Power;
+} tPowerReading;
+
+/**
+ * @brief Statistics of the power sampling
+ *
+ * @note Times are in timestamp counts, see Timestamp_getFreq. They cover the filtering of a block, not the entry of
+ *		 the ADC interrupt
+ */
+typedef struct tPowerStats {
+	/**
+	 * @brief The number of blocks filtered
+	 */
+	uint32_t ui32Blocks;
+	/**
+	 * @brief The number of blocks lost because the interrupt was not taken before the other half of the buffer filled
+	 */
+	uint32_t ui32Overruns;
+	/**
+	 * @brief The longest time spent filtering a block
+	 */
+	uint32_t ui32WorstTime;
+	/**
+	 * @brief The mean time spent filtering a block
+	 */
+	uint32_t ui32MeanTime;
+	/**
+	 * @brief The share of the CPU spent filtering (ppm)
+	 */
+	uint32_t ui32Load;
+	/**
+	 * @brief The share of the CPU spent filtering per kHz of samples, both channels counted (ppm)
+	 */
+	uint32_t ui32LoadPerKHz;
+} tPowerStats;
+
+/**
+ * @brief Initialize the current and voltage sampling and start it
+ *
+ * @param ui32SysClock The frequency of the system clock
+ * @return True if the ADC manager took the sequence
+ *
+ * @note The current sensor is read on AIN0 (PE3) and the supply voltage on AIN1 (PE2), both POWER_SAMPLE_RATE times
+ *		 a second. PWM0 generator 2 triggers the sequence, it must be called after Commutation_Init which sets the
+ *		 PWM clock and ADCMgr_Init
+ */
+bool Power_Init(uint32_t ui32SysClock);
+
+/**
+ * @brief Gets the latest filtered readings
+ *
+ * @param psReading The readings to copy into
+ *
+ * @note Updated once per block, POWER_SAMPLE_RATE / POWER_BLOCK times a second
+ */
+void Power_Get(tPowerReading *psReading);
+
+/**
+ * @brief Gets the statistics of the power sampling
+ *
+ * @param psStats The statistics to copy into
+ */
+void Power_GetStats(tPowerStats *psStats);
@@ -0,0 +1,71 @@
+#pragma region Includes
+#include "sensors.h"
+#include "power.h"
+#include "opt3001.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* TI-RTOS header files */
+#include <ti/drivers/GPIO.h>
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global variables */
+float g_fSensorsAccelCounter = 0;
+#pragma endregion
+
+#pragma region Sensors API functions
+/**
+ * @brief Reads the power drawn by the motor
+ *
+ * @return The power (W)
+ *
+ * @note The latest decimated reading of the current and voltage sampling, host builds use the motor plant instead
+ */
+int16_t Sensors_GetPower() {
+	tPowerReading sReading;
+	Power_Get(&sReading);
+	return (int16_t)((sReading.i32Power + 500) / 1000);
+}
+
+/**
+ * @brief Reads the ambient light level
+ *
+ * @return The light level (lux)
+ *
+ * @note The moving average of the OPT3001 conversions, rounded and limited to the range of the reading
+ */
+int16_t Sensors_GetLight() {
+	uint32_t ui32Light = (OPT3001_GetLight() + 50) / 100;
+	return ui32Light > INT16_MAX ? INT16_MAX : (int16_t)ui32Light;
+}
+
+/**
+ * @brief Reads the acceleration of the motor
+ *
+ * @return The acceleration, in MOTOR_ACCEL_SCALE RPM/s on the scale of the max acceleration setting
+ *
+ * @note Placeholder waveform until the accelerometer is wired up, host builds use the motor plant instead
+ */
+int16_t Sensors_GetAccel() {
+	g_fSensorsAccelCounter++;
+	return (((sin(g_fSensorsAccelCounter / 2) * 40) + (255 / 2)) + ((sin(g_fSensorsAccelCounter / 10) * 80) + (255 / 2))) / 2;
+}
+
+/**
+ * @brief Reads the e-stop input
+ *
+ * @return Whether the e-stop is engaged
+ *
+ * @note The input is pulled up, pressing the e-stop pulls it low
+ */
+bool Sensors_GetEStop() {
+	return GPIO_read(Board_ESTOP) == 0;
+}
+#pragma endregion
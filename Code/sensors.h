@@ -0,0 +1,31 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Reads the power drawn by the motor
+ *
+ * @return The power (W)
+ */
+int16_t Sensors_GetPower();
+
+/**
+ * @brief Reads the ambient light level
+ *
+ * @return The light level (lux)
+ */
+int16_t Sensors_GetLight();
+
+/**
+ * @brief Reads the acceleration of the motor
+ *
+ * @return The acceleration, in MOTOR_ACCEL_SCALE RPM/s on the scale of the max acceleration setting
+ */
+int16_t Sensors_GetAccel();
+
+/**
+ * @brief Reads the e-stop input
+ *
+ * @return Whether the e-stop is engaged
+ */
+bool Sensors_GetEStop();
@@ -68,3 +68,47 @@ float InverseLerp(float a, float b, float v) {
 float Map(float x, float in_min, float in_max, float out_min, float out_max) {
 	return Lerp(out_min, out_max, InverseLerp(in_min, in_max, x));
 }
+
+/**
+ * @brief Format an integer right aligned in a fixed width field without using printf
+ *
+ * @param value The value to format
+ * @param buffer The buffer to write, must hold width + 1 characters
+ * @param width The width of the field
+ * @param pad The character used to fill the field before the number (' ' or '0')
+ * @return True if the value fit in the field, otherwise the field is filled with '-'
+ */
+bool FormatInt(int32_t value, char *buffer, uint8_t width, char pad) {
+	bool negative = value < 0;
+	uint32_t magnitude = negative ? -(uint32_t)value : (uint32_t)value;
+	int16_t i = width;
+
+	buffer[width] = '\0';
+
+	/* Write the digits from the right, at least one even for zero */
+	do {
+		if (i == 0) {
+			memset(buffer, '-', width);
+			return false;
+		}
+		buffer[--i] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	/* The sign goes before the padding when zero padded, otherwise next to the digits */
+	if (negative) {
+		if (i == 0) {
+			memset(buffer, '-', width);
+			return false;
+		}
+		if (pad == '0') {
+			buffer[0] = '-';
+			memset(buffer + 1, pad, i - 1);
+			return true;
+		}
+		buffer[--i] = '-';
+	}
+
+	memset(buffer, pad, i);
+	return true;
+}
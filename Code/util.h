@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
 
 /**
  * @brief Convert the time given in hours, minutes and seconds to ticks (total seconds)
@@ -52,3 +53,14 @@ float InverseLerp(float a, float b, float v);
  * @return The mapped value
  */
 float Map(float x, float in_min, float in_max, float out_min, float out_max);
+
+/**
+ * @brief Format an integer right aligned in a fixed width field without using printf
+ *
+ * @param value The value to format
+ * @param buffer The buffer to write, must hold width + 1 characters
+ * @param width The width of the field
+ * @param pad The character used to fill the field before the number (' ' or '0')
+ * @return True if the value fit in the field, otherwise the field is filled with '-'
+ */
+bool FormatInt(int32_t value, char *buffer, uint8_t width, char pad);
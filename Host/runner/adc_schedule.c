@@ -0,0 +1,389 @@
+/**
+ * @file adc_schedule.c
+ * @brief Host check of the sequencer priorities and the schedulability test of the ADC manager
+ *
+ * adcmgr.c runs unchanged, the ADC and uDMA calls are stood in for and the sequencer priority
+ * register is kept in a variable, which ADCSequenceConfigure writes the priority of its sequencer
+ * into like TivaWare does. Each case starts from ADCMgr_Init, which leaves the touch screen on
+ * sequencer 3, configures sequencer 3 the way TouchScreenInit does, like main.c before any client,
+ * and registers its clients in order:
+ *   touch        nothing more, the touch screen alone
+ *   power        the current and voltage sampling, registered the way power.c does
+ *   blocking     power and a slow 8 step sequence are accepted, then a 200 kHz sequence is refused:
+ *                the 8 step sequence can hold the converter for longer than its period
+ *   utilisation  power then an 8 step sequence at 100 kHz, refused for loading the converter
+ *                over ADC_MAX_UTILISATION
+ *   touch late   power, then TouchScreenInit, which sets sequencer 3 back to priority 0: the order main.c
+ *                must not use
+ * For each case the result of the last registration, the priorities written to the sequencers,
+ * which must rank the clients by rate, and the worst case response time ADCMgr_CheckSchedule gives
+ * every client are checked against values worked out by hand.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make adc_schedule
+ *   ./adc_schedule
+ */
+#pragma region Includes
+#include "adc_schedule.h"
+#include "adcmgr.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_adc.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define ADC_SCHEDULE_POWER_BLOCK_LEN (POWER_BLOCK * 2)
+#define ADC_SCHEDULE_BLOCK_LEN 64
+#define ADC_SCHEDULE_MAX_CLIENTS 3
+
+/**
+ * @brief A set of clients registered on a fresh manager, and what the manager must make of it
+ *
+ */
+typedef struct tADCScheduleCase {
+	/**
+	 * @brief The name of the case
+	 */
+	const char *pcName;
+	/**
+	 * @brief The clients to register in order, only the last one may be refused
+	 */
+	tADCClient *psClients[ADC_SCHEDULE_MAX_CLIENTS];
+	/**
+	 * @brief The number of clients
+	 */
+	uint8_t ui8Count;
+	/**
+	 * @brief Whether the last client must be accepted
+	 */
+	bool bAccept;
+	/**
+	 * @brief The ADCSSPRI value after the last registration
+	 */
+	uint32_t ui32Priorities;
+	/**
+	 * @brief The response time of the touch screen and every client, fastest first (ns), or all 0 when the
+	 *		  utilisation test refuses the set before the response times are worked out
+	 */
+	uint32_t pui32ResponseNs[ADC_SCHEDULE_MAX_CLIENTS + 1];
+	/**
+	 * @brief The number of clients registered before the touch screen driver configures sequencer 3
+	 */
+	uint8_t ui8TouchAfter;
+} tADCScheduleCase;
+
+/* The manager's state, internal to adcmgr.c */
+extern tADCClient *g_psADCClients[ADC_SEQUENCER_COUNT];
+extern tADCClient g_sADCTouchClient;
+
+/* Global constants */
+const uint32_t gc_ui32ADCScheduleChannels[8] = {ADC_CTL_CH0, ADC_CTL_CH1, ADC_CTL_CH2, ADC_CTL_CH3,
+												ADC_CTL_CH0, ADC_CTL_CH1, ADC_CTL_CH2, ADC_CTL_CH3};
+
+/* Global variables */
+uint16_t ga_ui16ADCSchedulePower[ADC_SCHEDULE_POWER_BLOCK_LEN * 2];
+uint16_t ga_ui16ADCScheduleSlow[ADC_SCHEDULE_BLOCK_LEN * 2];
+uint16_t ga_ui16ADCScheduleFast[ADC_SCHEDULE_BLOCK_LEN * 2];
+uint16_t ga_ui16ADCScheduleFlood[ADC_SCHEDULE_BLOCK_LEN * 2];
+uint32_t g_ui32ADCSchedulePriorities = 0;
+uint8_t g_ui8ADCScheduleFailures = 0;
+
+/* The power sampling of power.c, both channels on each PWM trigger */
+tADCClient g_sADCSchedulePower = {
+	.pui32Channels = gc_ui32ADCScheduleChannels,
+	.ui8NumSteps = 2,
+	.ui32Trigger = ADC_TRIGGER_PWM2 | ADC_TRIGGER_PWM_MOD0,
+	.ui32RateHz = POWER_SAMPLE_RATE,
+	.pui16Buffer = ga_ui16ADCSchedulePower,
+	.ui16BlockLen = ADC_SCHEDULE_POWER_BLOCK_LEN,
+};
+
+/* A slow sequence that keeps the converter for 8 conversions once started */
+tADCClient g_sADCScheduleSlow = {
+	.pui32Channels = gc_ui32ADCScheduleChannels,
+	.ui8NumSteps = 8,
+	.ui32Trigger = ADC_TRIGGER_PROCESSOR,
+	.ui32RateHz = 500,
+	.pui16Buffer = ga_ui16ADCScheduleSlow,
+	.ui16BlockLen = ADC_SCHEDULE_BLOCK_LEN,
+};
+
+/* A fast sequence with a 5 us period */
+tADCClient g_sADCScheduleFast = {
+	.pui32Channels = gc_ui32ADCScheduleChannels,
+	.ui8NumSteps = 1,
+	.ui32Trigger = ADC_TRIGGER_PWM1,
+	.ui32RateHz = 200000,
+	.pui16Buffer = ga_ui16ADCScheduleFast,
+	.ui16BlockLen = ADC_SCHEDULE_BLOCK_LEN,
+};
+
+/* 800 k conversions a second, 80 % of the converter */
+tADCClient g_sADCScheduleFlood = {
+	.pui32Channels = gc_ui32ADCScheduleChannels,
+	.ui8NumSteps = 8,
+	.ui32Trigger = ADC_TRIGGER_PWM1,
+	.ui32RateHz = 100000,
+	.pui16Buffer = ga_ui16ADCScheduleFlood,
+	.ui16BlockLen = ADC_SCHEDULE_BLOCK_LEN,
+};
+
+/*
+ * Worked out from ADCMgr_CheckSchedule with 1 us conversions, fastest client first:
+ *   power     2 us + 1 us blocked by the touch screen                                   = 3 us
+ *   touch     1 us + 2 us for one power sequence                                        = 3 us
+ * With the slow sequence, every faster client can be blocked for its 8 us:
+ *   fast      1 us + 8 us, over its 5 us period                                         = 9 us
+ *   power     2 us + 8 us + 3 fast sequences in 13 us                                   = 13 us
+ *   touch     1 us + 8 us + 3 fast + 1 power sequence                                   = 14 us
+ *   slow      8 us + 3 fast + 1 power + 1 touch sequence                                = 14 us
+ */
+const tADCScheduleCase gc_sADCScheduleCases[] = {
+	{"touch", {NULL}, 0, true, 0x0321, {1000}},
+	{"power", {&g_sADCSchedulePower}, 1, true, 0x1302, {3000, 3000}},
+	{"blocking", {&g_sADCSchedulePower, &g_sADCScheduleSlow, &g_sADCScheduleFast}, 3, false, 0x1302,
+	 {9000, 13000, 14000, 14000}},
+	{"utilisation", {&g_sADCSchedulePower, &g_sADCScheduleFlood}, 2, false, 0x1302, {0}},
+	/* The manager still ranks touch second, but the register now has power and touch both at priority 0 */
+	{"touch late", {&g_sADCSchedulePower}, 1, true, 0x0302, {3000, 3000}, 1},
+};
+#pragma endregion
+
+#pragma region Stand-ins
+volatile uint32_t *ADCSchedule_Register(uint32_t ui32Address) {
+	if (ui32Address != ADC0_BASE + ADC_O_SSPRI) {
+		fprintf(stderr, "adc_schedule: unexpected register 0x%08x\n", ui32Address);
+		exit(1);
+	}
+	return &g_ui32ADCSchedulePriorities;
+}
+
+/* The ADC, uDMA and BIOS calls adcmgr.c makes, no conversion runs on the host */
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) {
+	return true;
+}
+
+void EK_TM4C1294XL_initDMA(void) {
+}
+
+void Hwi_Params_init(Hwi_Params *psParams) {
+	psParams->arg = 0;
+	psParams->priority = ~0;
+}
+
+void Hwi_construct(Hwi_Struct *psStruct, Int iIntNum, Hwi_FuncPtr pfnFxn, const Hwi_Params *psParams, void *pvEb) {
+	psStruct->iIntNum = iIntNum;
+	psStruct->pfnFxn = pfnFxn;
+	psStruct->arg = psParams != NULL ? psParams->arg : 0;
+}
+
+void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Trigger, uint32_t ui32Priority) {
+	uint32_t ui32Shift = ui32SequenceNum * 4;
+	g_ui32ADCSchedulePriorities = (g_ui32ADCSchedulePriorities & ~(0xf << ui32Shift)) | ((ui32Priority & 0x3) << ui32Shift);
+}
+
+void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Step, uint32_t ui32Config) {
+}
+
+void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+}
+
+void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+}
+
+void ADCSequenceDMAEnable(uint32_t ui32Base, uint32_t ui32SequenceNum) {
+}
+
+void ADCIntEnableEx(uint32_t ui32Base, uint32_t ui32IntFlags) {
+}
+
+void ADCIntClearEx(uint32_t ui32Base, uint32_t ui32IntFlags) {
+}
+
+void uDMAChannelAssign(uint32_t ui32Mapping) {
+}
+
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr) {
+}
+
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control) {
+}
+
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode, void *pvSrcAddr, void *pvDstAddr,
+							uint32_t ui32TransferSize) {
+}
+
+void uDMAChannelEnable(uint32_t ui32ChannelNum) {
+}
+
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum) {
+	return true;
+}
+
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex) {
+	return UDMA_MODE_STOP;
+}
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Configures sequencer 3 the way TouchScreenInit in drivers/touch.c does
+ *
+ */
+void ADCSchedule_TouchInit() {
+	ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_TIMER, 0);
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void ADCSchedule_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8ADCScheduleFailures++;
+}
+
+/**
+ * @brief Gets the name of a client
+ *
+ * @param psClient The client
+ * @return Its name
+ */
+const char *ADCSchedule_Name(const tADCClient *psClient) {
+	if (psClient == &g_sADCTouchClient)
+		return "touch";
+	if (psClient == &g_sADCSchedulePower)
+		return "power";
+	if (psClient == &g_sADCScheduleSlow)
+		return "slow";
+	if (psClient == &g_sADCScheduleFast)
+		return "fast";
+	return "flood";
+}
+
+/**
+ * @brief Runs a case and checks its outcome
+ *
+ * @param psCase The case
+ */
+void ADCSchedule_Run(const tADCScheduleCase *psCase) {
+	char pcName[32];
+	ADCMgr_Init();
+
+	/* Every client but the last must be accepted */
+	bool bAccepted = true;
+	for (uint8_t i = 0; i < psCase->ui8Count; i++) {
+		if (i == psCase->ui8TouchAfter)
+			ADCSchedule_TouchInit();
+		bAccepted = ADCMgr_Register(psCase->psClients[i]);
+		if (!bAccepted && i + 1 < psCase->ui8Count) {
+			snprintf(pcName, sizeof(pcName), "%s register", psCase->pcName);
+			ADCSchedule_Check(pcName, false, "%s refused", ADCSchedule_Name(psCase->psClients[i]));
+			return;
+		}
+	}
+	if (psCase->ui8TouchAfter >= psCase->ui8Count)
+		ADCSchedule_TouchInit();
+
+	/* A refused client must not keep a sequencer */
+	bool bClaimed = false;
+	const tADCClient *psLast = psCase->ui8Count > 0 ? psCase->psClients[psCase->ui8Count - 1] : &g_sADCTouchClient;
+	for (uint8_t i = 0; i < ADC_SEQUENCER_COUNT; i++)
+		bClaimed |= g_psADCClients[i] == psLast;
+	snprintf(pcName, sizeof(pcName), "%s %s", psCase->pcName, psCase->bAccept ? "accepted" : "refused");
+	ADCSchedule_Check(pcName, bAccepted == psCase->bAccept && bClaimed == psCase->bAccept, "%s %s, %s",
+					  ADCSchedule_Name(psLast), bAccepted ? "accepted" : "refused",
+					  bClaimed ? "owns a sequencer" : "owns no sequencer");
+
+	/* The registered clients are ranked by rate, fastest first */
+	bool bRanked = true;
+	for (uint8_t i = 0; i < ADC_SEQUENCER_COUNT; i++) {
+		for (uint8_t j = 0; j < ADC_SEQUENCER_COUNT; j++) {
+			const tADCClient *psI = g_psADCClients[i];
+			const tADCClient *psJ = g_psADCClients[j];
+			if (psI != NULL && psJ != NULL && psI->ui32RateHz > psJ->ui32RateHz && psI->ui8Priority >= psJ->ui8Priority)
+				bRanked = false;
+		}
+	}
+	snprintf(pcName, sizeof(pcName), "%s priorities", psCase->pcName);
+	ADCSchedule_Check(pcName, bRanked && g_ui32ADCSchedulePriorities == psCase->ui32Priorities,
+					  "ADCSSPRI 0x%04x, expected 0x%04x", g_ui32ADCSchedulePriorities, psCase->ui32Priorities);
+
+	/* The response times of the whole set, the refused client included, in the order the manager checks it */
+	const tADCClient *psSet[ADC_SCHEDULE_MAX_CLIENTS + 1] = {&g_sADCTouchClient};
+	uint8_t ui8Count = 1;
+	for (uint8_t i = 0; i < psCase->ui8Count; i++) {
+		const tADCClient *psClient = psCase->psClients[i];
+		uint8_t j = ui8Count++;
+		for (; j > 0 && psSet[j - 1]->ui32RateHz < psClient->ui32RateHz; j--)
+			psSet[j] = psSet[j - 1];
+		psSet[j] = psClient;
+	}
+
+	uint8_t pui8Steps[ADC_SCHEDULE_MAX_CLIENTS + 1];
+	uint32_t pui32Rates[ADC_SCHEDULE_MAX_CLIENTS + 1];
+	uint32_t pui32Response[ADC_SCHEDULE_MAX_CLIENTS + 1] = {0};
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		pui8Steps[i] = psSet[i]->ui8NumSteps;
+		pui32Rates[i] = psSet[i]->ui32RateHz;
+	}
+	bool bFeasible = ADCMgr_CheckSchedule(pui8Steps, pui32Rates, ui8Count, pui32Response);
+
+	char pcBounds[128];
+	int iLength = 0;
+	bool bBounds = bFeasible == psCase->bAccept;
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		bBounds &= pui32Response[i] == psCase->pui32ResponseNs[i];
+		iLength += snprintf(pcBounds + iLength, sizeof(pcBounds) - iLength, "%s%s %u ns of %u", i ? ", " : "",
+							ADCSchedule_Name(psSet[i]), pui32Response[i], 1000000000 / pui32Rates[i]);
+	}
+	snprintf(pcName, sizeof(pcName), "%s response", psCase->pcName);
+	ADCSchedule_Check(pcName, bBounds, "%s", pcBounds);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @param argc Unused
+ * @param argv Unused
+ * @return 0 if every check passed
+ */
+int main(int argc, char **argv) {
+	for (uint8_t i = 0; i < sizeof(gc_sADCScheduleCases) / sizeof(gc_sADCScheduleCases[0]); i++)
+		ADCSchedule_Run(&gc_sADCScheduleCases[i]);
+
+	return g_ui8ADCScheduleFailures ? 1 : 0;
+}
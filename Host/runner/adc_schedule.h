@@ -0,0 +1,17 @@
+/**
+ * @file adc_schedule.h
+ * @brief Host stand-in for the ADC register the manager writes directly
+ *
+ * adcmgr.c sets the sequencer priorities with a register store, so it is built with
+ * '-DADCMGR_HWREG(x)=(*ADCSchedule_Register(x))' and this header included.
+ */
+#pragma once
+#include <stdint.h>
+
+/**
+ * @brief Gets an emulated ADC register
+ *
+ * @param ui32Address The address of the register
+ * @return The register, the program exits on any register but ADCSSPRI
+ */
+volatile uint32_t *ADCSchedule_Register(uint32_t ui32Address);
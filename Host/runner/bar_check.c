@@ -0,0 +1,310 @@
+/**
+ * @file bar_check.c
+ * @brief Host check of the delta drawn bar meter
+ *
+ * bar.c runs unchanged on the graphics library, drawing on a framebuffer display that records every pixel
+ * written:
+ *   first draw           the outline and the whole inside of the bar are drawn, nothing outside of it
+ *   same value           drawing the value and limit on screen again writes no pixel
+ *   strips               a sequence of values and limits only writes the strip between the old and new level, the
+ *                        old and new marker when the limit moved, and the marker when the strip covered it
+ *   fresh draw           after every step of the sequence the bar matches one drawn from scratch
+ *
+ * The sequence is played on a vertical bar placed like the power bar of the main panel and on a horizontal one.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make bar_check
+ *   ./bar_check
+ */
+#pragma region Includes
+#include "bar.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define BAR_CHECK_WIDTH 320
+#define BAR_CHECK_HEIGHT 240
+#define BAR_CHECK_BACKGROUND ClrBlack
+#define BAR_CHECK_MAX 100
+
+/**
+ * @brief A value and limit drawn on a bar
+ *
+ */
+typedef struct tBarCheckStep {
+	int32_t i32Value;
+	int32_t i32Limit;
+} tBarCheckStep;
+
+/* The steps played on each bar, so that the level rises, falls, holds, crosses the marker and clamps */
+const tBarCheckStep gc_sBarCheckSteps[] = {
+	{40, 80}, {45, 80}, {30, 80}, {30, 60}, {70, 60}, {70, 60}, {90, 60}, {0, 0},
+	{100, 100}, {150, -5}, {50, 100}, {-10, 50}, {55, 50}, {20, 25},
+};
+
+/* Global variables */
+uint32_t g_pui32BarCheckFrame[BAR_CHECK_HEIGHT][BAR_CHECK_WIDTH];
+bool g_pbBarCheckWritten[BAR_CHECK_HEIGHT][BAR_CHECK_WIDTH];
+uint32_t g_ui32BarCheckPixels = 0;
+uint8_t g_ui8BarCheckFailures = 0;
+#pragma endregion
+
+#pragma region Display functions
+/**
+ * @brief Writes a pixel of the framebuffer and records it
+ *
+ * @param i32X The x position
+ * @param i32Y The y position
+ * @param ui32Value The color
+ */
+void BarCheck_Write(int32_t i32X, int32_t i32Y, uint32_t ui32Value) {
+	if (i32X < 0 || i32X >= BAR_CHECK_WIDTH || i32Y < 0 || i32Y >= BAR_CHECK_HEIGHT)
+		return;
+
+	g_pui32BarCheckFrame[i32Y][i32X] = ui32Value;
+	g_pbBarCheckWritten[i32Y][i32X] = true;
+	g_ui32BarCheckPixels++;
+}
+
+void BarCheck_PixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value) {
+	BarCheck_Write(i32X, i32Y, ui32Value);
+}
+
+void BarCheck_PixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y, int32_t i32X0, int32_t i32Count,
+								int32_t i32BPP, const uint8_t *pui8Data, const uint8_t *pui8Palette) {
+	/* The bar draws no text or images */
+}
+
+void BarCheck_LineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value) {
+	for (int32_t x = i32X1; x <= i32X2; x++)
+		BarCheck_Write(x, i32Y, ui32Value);
+}
+
+void BarCheck_LineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2, uint32_t ui32Value) {
+	for (int32_t y = i32Y1; y <= i32Y2; y++)
+		BarCheck_Write(i32X, y, ui32Value);
+}
+
+void BarCheck_RectFill(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value) {
+	for (int32_t y = psRect->i16YMin; y <= psRect->i16YMax; y++)
+		BarCheck_LineDrawH(pvDisplayData, psRect->i16XMin, psRect->i16XMax, y, ui32Value);
+}
+
+uint32_t BarCheck_ColorTranslate(void *pvDisplayData, uint32_t ui32Value) {
+	return ui32Value;
+}
+
+void BarCheck_Flush(void *pvDisplayData) {
+}
+
+const tDisplay g_sBarCheckDisplay = {
+	sizeof(tDisplay),
+	NULL,
+	BAR_CHECK_WIDTH,
+	BAR_CHECK_HEIGHT,
+	BarCheck_PixelDraw,
+	BarCheck_PixelDrawMultiple,
+	BarCheck_LineDrawH,
+	BarCheck_LineDrawV,
+	BarCheck_RectFill,
+	BarCheck_ColorTranslate,
+	BarCheck_Flush,
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void BarCheck_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8BarCheckFailures++;
+}
+
+/**
+ * @brief Gets the length of the inside of a bar and the width of a strip across it
+ *
+ * @param psBar The bar
+ * @param pi16Width The width of a strip (pixels)
+ * @return The number of positions along the bar
+ */
+int16_t BarCheck_Length(const tBarMeter *psBar, int16_t *pi16Width) {
+	int16_t i16Width = psBar->sRect.i16XMax - psBar->sRect.i16XMin - 1;
+	int16_t i16Height = psBar->sRect.i16YMax - psBar->sRect.i16YMin - 1;
+	*pi16Width = psBar->bVertical ? i16Width : i16Height;
+	return psBar->bVertical ? i16Height : i16Width;
+}
+
+/**
+ * @brief Converts a value to the number of positions it fills, the way the bar is specified
+ *
+ * @param psBar The bar
+ * @param i32Value The value
+ * @return The number of positions
+ */
+int16_t BarCheck_Position(const tBarMeter *psBar, int32_t i32Value) {
+	int16_t i16Width;
+	int16_t i16Length = BarCheck_Length(psBar, &i16Width);
+	if (i32Value <= 0)
+		return 0;
+	if (i32Value >= psBar->i32Max)
+		return i16Length;
+	return i32Value * i16Length / psBar->i32Max;
+}
+
+/**
+ * @brief Converts a limit to the position of its marker, the way the bar is specified
+ *
+ * @param psBar The bar
+ * @param i32Limit The limit
+ * @return The position, inside the bar
+ */
+int16_t BarCheck_Marker(const tBarMeter *psBar, int32_t i32Limit) {
+	int16_t i16Width;
+	int16_t i16Length = BarCheck_Length(psBar, &i16Width);
+	int16_t i16Position = BarCheck_Position(psBar, i32Limit);
+	return i16Position < i16Length ? i16Position : i16Length - 1;
+}
+
+/**
+ * @brief Draws a value and limit and records what it wrote
+ *
+ * @param psBar The bar
+ * @param psContext The graphics context
+ * @param psStep The value and limit to show
+ */
+void BarCheck_Draw(tBarMeter *psBar, tContext *psContext, const tBarCheckStep *psStep) {
+	memset(g_pbBarCheckWritten, 0, sizeof(g_pbBarCheckWritten));
+	g_ui32BarCheckPixels = 0;
+	Bar_Draw(psBar, psContext, psStep->i32Value, psStep->i32Limit);
+}
+
+/**
+ * @brief Counts the pixels written by the last draw outside of a rectangle
+ *
+ * @param psRect The rectangle
+ * @return The number of stray pixels
+ */
+uint32_t BarCheck_Stray(const tRectangle *psRect) {
+	uint32_t ui32Stray = 0;
+	for (int32_t y = 0; y < BAR_CHECK_HEIGHT; y++) {
+		for (int32_t x = 0; x < BAR_CHECK_WIDTH; x++)
+			ui32Stray += g_pbBarCheckWritten[y][x] && !GrRectContainsPoint(psRect, x, y);
+	}
+	return ui32Stray;
+}
+
+/**
+ * @brief Plays the sequence of steps on a bar
+ *
+ * @param psBar The bar, not drawn yet
+ * @param psContext The graphics context
+ * @param pcName The name of the bar in the report
+ */
+void BarCheck_Sequence(tBarMeter *psBar, tContext *psContext, const char *pcName) {
+	char pcName1[40], pcName2[40], pcName3[40], pcName4[40];
+	snprintf(pcName1, sizeof(pcName1), "first draw, %s", pcName);
+	snprintf(pcName2, sizeof(pcName2), "same value, %s", pcName);
+	snprintf(pcName3, sizeof(pcName3), "strips, %s", pcName);
+	snprintf(pcName4, sizeof(pcName4), "fresh draw, %s", pcName);
+
+	static uint32_t pui32Incremental[BAR_CHECK_HEIGHT][BAR_CHECK_WIDTH];
+	const tRectangle *psRect = &psBar->sRect;
+	int16_t i16Width;
+	BarCheck_Length(psBar, &i16Width);
+	uint8_t ui8Count = sizeof(gc_sBarCheckSteps) / sizeof(gc_sBarCheckSteps[0]);
+
+	/* The outline and every pixel inside are drawn the first time, nothing around them */
+	BarCheck_Draw(psBar, psContext, &gc_sBarCheckSteps[0]);
+	uint32_t ui32Missed = 0;
+	for (int32_t y = psRect->i16YMin; y <= psRect->i16YMax; y++) {
+		for (int32_t x = psRect->i16XMin; x <= psRect->i16XMax; x++)
+			ui32Missed += !g_pbBarCheckWritten[y][x];
+	}
+	uint32_t ui32Stray = BarCheck_Stray(psRect);
+	BarCheck_Check(pcName1, ui32Missed == 0 && ui32Stray == 0, "%u pixels, %u missed, %u stray", g_ui32BarCheckPixels,
+				   ui32Missed, ui32Stray);
+
+	/* Drawing it again writes nothing */
+	BarCheck_Draw(psBar, psContext, &gc_sBarCheckSteps[0]);
+	BarCheck_Check(pcName2, g_ui32BarCheckPixels == 0, "%u pixels", g_ui32BarCheckPixels);
+
+	int16_t i16Level = BarCheck_Position(psBar, gc_sBarCheckSteps[0].i32Value);
+	int16_t i16Marker = BarCheck_Marker(psBar, gc_sBarCheckSteps[0].i32Limit);
+	uint32_t ui32Pixels = 0, ui32Expected = 0, ui32Mismatched = 0;
+	ui32Stray = 0;
+	for (uint8_t s = 1; s < ui8Count; s++) {
+		const tBarCheckStep *psStep = &gc_sBarCheckSteps[s];
+
+		/* The strip between the levels, plus the old and new marker if it moved or the new one if the strip hid it */
+		int16_t i16NewLevel = BarCheck_Position(psBar, psStep->i32Value);
+		int16_t i16NewMarker = BarCheck_Marker(psBar, psStep->i32Limit);
+		int16_t i16Low = i16NewLevel < i16Level ? i16NewLevel : i16Level;
+		int16_t i16High = i16NewLevel < i16Level ? i16Level : i16NewLevel;
+		uint32_t ui32Rows = i16High - i16Low;
+		if (i16NewMarker != i16Marker)
+			ui32Rows += 2;
+		else if (i16Marker >= i16Low && i16Marker < i16High)
+			ui32Rows += 1;
+		ui32Expected += ui32Rows * i16Width;
+		i16Level = i16NewLevel;
+		i16Marker = i16NewMarker;
+
+		BarCheck_Draw(psBar, psContext, psStep);
+		ui32Pixels += g_ui32BarCheckPixels;
+		ui32Stray += BarCheck_Stray(psRect);
+
+		/* Clear the bar and draw it from scratch, it must look the same */
+		memcpy(pui32Incremental, g_pui32BarCheckFrame, sizeof(pui32Incremental));
+		GrContextForegroundSet(psContext, BAR_CHECK_BACKGROUND);
+		GrRectFill(psContext, psRect);
+		Bar_Reset(psBar);
+		BarCheck_Draw(psBar, psContext, psStep);
+		for (int32_t y = 0; y < BAR_CHECK_HEIGHT; y++) {
+			for (int32_t x = 0; x < BAR_CHECK_WIDTH; x++)
+				ui32Mismatched += pui32Incremental[y][x] != g_pui32BarCheckFrame[y][x];
+		}
+	}
+
+	BarCheck_Check(pcName3, ui32Pixels == ui32Expected && ui32Stray == 0, "%u pixels for %u in the strips, %u stray",
+				   ui32Pixels, ui32Expected, ui32Stray);
+	BarCheck_Check(pcName4, ui32Mismatched == 0, "%u pixels differ over %u steps", ui32Mismatched, ui8Count - 1);
+}
+#pragma endregion
+
+int main() {
+	tContext sContext;
+	tBarMeter sVertical = BarMeter(215, 107, 12, 67, true, BAR_CHECK_MAX, ClrBlue, BAR_CHECK_BACKGROUND, ClrWhite, ClrGray);
+	tBarMeter sHorizontal = BarMeter(20, 200, 90, 10, false, BAR_CHECK_MAX, ClrYellow, BAR_CHECK_BACKGROUND, ClrWhite,
+									 ClrGray);
+
+	GrContextInit(&sContext, &g_sBarCheckDisplay);
+	BarCheck_Sequence(&sVertical, &sContext, "vertical");
+	BarCheck_Sequence(&sHorizontal, &sContext, "horizontal");
+	printf("%s: %u check(s) failed\n", g_ui8BarCheckFailures == 0 ? "PASS" : "FAIL", g_ui8BarCheckFailures);
+	return g_ui8BarCheckFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file bridge.c
+ * @brief Host emulation of the PWM bridge outputs and the Hall sensor pins behind commutation.c
+ */
+#pragma region Includes
+#include "bridge.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* TivaWare header files */
+#include "inc/hw_gpio.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_pwm.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define BRIDGE_GEN_COUNT 4
+#define BRIDGE_GEN_INDEX(gen) (((gen) - PWM_GEN_0) / (PWM_GEN_1 - PWM_GEN_0))
+#define BRIDGE_HALL_BASE GPIO_PORTD_BASE
+#define BRIDGE_HALL_SHIFT 4
+#define BRIDGE_DATA_MASK 0x3FC // Address bits selecting the pins of a GPIO data access
+
+/**
+ * @brief A PWM generator with its two outputs
+ *
+ */
+typedef struct tBridgeGen {
+	uint32_t ui32Period;
+	uint32_t pui32Width[2];
+	volatile uint32_t ui32GenA;
+	volatile uint32_t ui32GenB;
+} tBridgeGen;
+
+/* Global variables */
+tBridgeGen g_psBridgeGens[BRIDGE_GEN_COUNT];
+volatile uint32_t g_ui32BridgeEnable = 0;
+uint8_t g_ui8BridgePins = 0;
+volatile uint32_t g_ui32BridgeRead = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Finds a PWM generator
+ *
+ * @param ui32Gen The generator, PWM_GEN_0 to PWM_GEN_3, or an output of it
+ * @return The generator, the program exits on an unknown one
+ */
+tBridgeGen *Bridge_FindGen(uint32_t ui32Gen) {
+	uint32_t ui32Index = BRIDGE_GEN_INDEX(ui32Gen & ~0x3F);
+	if ((ui32Gen & ~0x3F) < PWM_GEN_0 || ui32Index >= BRIDGE_GEN_COUNT) {
+		fprintf(stderr, "bridge: unknown generator 0x%08x\n", ui32Gen);
+		exit(1);
+	}
+	return &g_psBridgeGens[ui32Index];
+}
+#pragma endregion
+
+#pragma region Bridge API functions
+volatile uint32_t *Bridge_Register(uint32_t ui32Address) {
+	if (ui32Address == PWM0_BASE + PWM_O_ENABLE)
+		return &g_ui32BridgeEnable;
+
+	if ((ui32Address & ~BRIDGE_DATA_MASK) == BRIDGE_HALL_BASE + GPIO_O_DATA) {
+		g_ui32BridgeRead = g_ui8BridgePins & (ui32Address & BRIDGE_DATA_MASK) >> 2;
+		return &g_ui32BridgeRead;
+	}
+
+	uint32_t ui32Offset = ui32Address - PWM0_BASE;
+	if (ui32Offset >= PWM_GEN_0 && ui32Offset < PWM_GEN_0 + BRIDGE_GEN_COUNT * (PWM_GEN_1 - PWM_GEN_0)) {
+		tBridgeGen *psGen = Bridge_FindGen(ui32Offset);
+		if ((ui32Offset & 0x3F) == PWM_O_X_GENA)
+			return &psGen->ui32GenA;
+		if ((ui32Offset & 0x3F) == PWM_O_X_GENB)
+			return &psGen->ui32GenB;
+	}
+
+	fprintf(stderr, "bridge: unknown register 0x%08x\n", ui32Address);
+	exit(1);
+}
+
+void Bridge_SetHall(uint8_t ui8State) {
+	g_ui8BridgePins = (ui8State & 0x7) << BRIDGE_HALL_SHIFT;
+}
+
+uint32_t Bridge_GetOutputs() {
+	return g_ui32BridgeEnable;
+}
+
+uint32_t Bridge_GetPulseWidth(uint32_t ui32PWMOut) {
+	return Bridge_FindGen(ui32PWMOut)->pui32Width[ui32PWMOut & 1];
+}
+#pragma endregion
+
+#pragma region Driverlib functions
+/* Clocking and synchronization have no effect on the host */
+void PWMClockSet(uint32_t ui32Base, uint32_t ui32Config) {
+}
+
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen) {
+}
+
+void PWMSyncTimeBase(uint32_t ui32Base, uint32_t ui32GenBits) {
+}
+
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config) {
+	/* The actions driverlib sets up for counting down */
+	tBridgeGen *psGen = Bridge_FindGen(ui32Gen);
+	psGen->ui32GenA = PWM_X_GENA_ACTCMPAD_ONE | PWM_X_GENA_ACTLOAD_ZERO;
+	psGen->ui32GenB = 0;
+}
+
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period) {
+	Bridge_FindGen(ui32Gen)->ui32Period = ui32Period;
+}
+
+uint32_t PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen) {
+	return Bridge_FindGen(ui32Gen)->ui32Period;
+}
+
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width) {
+	tBridgeGen *psGen = Bridge_FindGen(ui32PWMOut);
+	if (ui32Width >= psGen->ui32Period && psGen->ui32Period != 0) {
+		fprintf(stderr, "bridge: pulse width %u is not shorter than the period %u\n", ui32Width, psGen->ui32Period);
+		exit(1);
+	}
+	psGen->pui32Width[ui32PWMOut & 1] = ui32Width;
+}
+
+void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable) {
+	if (bEnable)
+		g_ui32BridgeEnable |= ui32PWMOutBits;
+	else
+		g_ui32BridgeEnable &= ~ui32PWMOutBits;
+}
+#pragma endregion
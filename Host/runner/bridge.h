@@ -0,0 +1,46 @@
+/**
+ * @file bridge.h
+ * @brief Host emulation of the PWM bridge outputs and the Hall sensor pins behind commutation.c
+ *
+ * commutation.c reaches the registers on its fast path directly, so it is built with
+ * '-DCOMMUTATION_HWREG(x)=(*Bridge_Register(x))' and this header included. The output enables of
+ * PWM0, the generator actions and the Hall pins of port D are emulated, the PWM driverlib calls
+ * only keep the period and the pulse widths.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Gets an emulated register
+ *
+ * @param ui32Address The address of the register
+ * @return The register, the program exits on an unknown address
+ *
+ * @note Reads of the Hall pins only see the pins in the address mask, like on the target
+ */
+volatile uint32_t *Bridge_Register(uint32_t ui32Address);
+
+/**
+ * @brief Sets the levels of the Hall sensor pins
+ *
+ * @param ui8State The Hall state, A in bit 0, B in bit 1 and C in bit 2
+ *
+ * @note Only sets the levels, the edge is captured with GPTM_CaptureEdge
+ */
+void Bridge_SetHall(uint8_t ui8State);
+
+/**
+ * @brief Gets the output enables of PWM0
+ *
+ * @return The PWM_OUT_n_BIT flags of the enabled outputs
+ */
+uint32_t Bridge_GetOutputs();
+
+/**
+ * @brief Gets the pulse width of a PWM output
+ *
+ * @param ui32PWMOut The output, PWM_OUT_0 to PWM_OUT_7
+ * @return The width (PWM clocks)
+ */
+uint32_t Bridge_GetPulseWidth(uint32_t ui32PWMOut);
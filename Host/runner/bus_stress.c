@@ -0,0 +1,274 @@
+/**
+ * @file bus_stress.c
+ * @brief Host stress test and throughput benchmark for the seqlock data bus
+ *
+ * One producer thread publishes an increasing counter while reader threads
+ * check every sample they see for torn reads. The bus is built with the
+ * timestamp of each sample derived from its value, so a sample whose two
+ * fields came from different publishes is detected.
+ *
+ * The flood phase publishes as fast as possible, so the ring reader loses most
+ * samples and only the accounting of the lost ones is checked. The paced phase
+ * then keeps the producer within BUS_RING_LENGTH samples of the ring reader,
+ * which must get every sample, in order and intact.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make bus_stress
+ *   ./bus_stress
+ */
+#pragma region Includes
+#include "bus.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define STRESS_PUBLISHES 20000000
+#define STRESS_READERS 3
+#define STRESS_PACED 2000000
+
+/**
+ * @brief Results of a reader thread
+ *
+ */
+typedef struct tStressResult {
+	uint64_t ui64Reads;
+	uint64_t ui64Torn;
+	uint64_t ui64Backwards;
+	uint64_t ui64Lost;
+} tStressResult;
+
+/* Global variables */
+volatile bool g_bStressDone = false;
+tStressResult g_sResults[STRESS_READERS + 1];
+tStressResult g_sPaced;
+sem_t g_sStressFree;	// Ring entries the paced producer may fill without lapping the reader
+sem_t g_sStressFilled; // Samples published in the paced phase and not yet read
+uint8_t g_ui8StressFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void Stress_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8StressFailures++;
+}
+
+/**
+ * @brief Gets the time in seconds
+ *
+ * @return The monotonic time
+ */
+double Stress_Now() {
+	struct timespec sNow;
+	clock_gettime(CLOCK_MONOTONIC, &sNow);
+	return sNow.tv_sec + sNow.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Checks that a sample was not torn between two publishes
+ *
+ * @param psSample The sample to check
+ * @return True if the timestamp matches the value
+ */
+bool Stress_Intact(const tBusSample *psSample) {
+	return psSample->ui32Timestamp == (uint32_t)~(uint32_t)psSample->i32Value;
+}
+
+/**
+ * @brief Reads the latest value as fast as possible
+ *
+ * @param pvArg The result to fill in
+ * @return Unused
+ */
+void *Stress_LatestReader(void *pvArg) {
+	tStressResult *psResult = pvArg;
+	int32_t i32Prev = 0;
+	tBusSample sSample;
+
+	while (!g_bStressDone) {
+		if (!Bus_Read(BUS_TOPIC_SPEED, &sSample))
+			continue;
+
+		psResult->ui64Reads++;
+		if (!Stress_Intact(&sSample))
+			psResult->ui64Torn++;
+		if (sSample.i32Value < i32Prev)
+			psResult->ui64Backwards++;
+		i32Prev = sSample.i32Value;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Reads every sample through the ring
+ *
+ * @param pvArg The result to fill in
+ * @return Unused
+ */
+void *Stress_RingReader(void *pvArg) {
+	tStressResult *psResult = pvArg;
+	uint32_t ui32Cursor = 0;
+	int32_t i32Prev = 0;
+	tBusSample sSamples[BUS_RING_LENGTH];
+
+	while (true) {
+		bool bDone = g_bStressDone;
+		uint32_t ui32Lost;
+		uint32_t ui32Count = Bus_ReadRing(BUS_TOPIC_SPEED, &ui32Cursor, sSamples, BUS_RING_LENGTH, &ui32Lost);
+
+		psResult->ui64Lost += ui32Lost;
+		for (uint32_t i = 0; i < ui32Count; i++) {
+			psResult->ui64Reads++;
+			if (!Stress_Intact(&sSamples[i]))
+				psResult->ui64Torn++;
+			if (sSamples[i].i32Value <= i32Prev)
+				psResult->ui64Backwards++;
+			i32Prev = sSamples[i].i32Value;
+		}
+
+		if (bDone && ui32Count == 0)
+			break;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Reads every sample through the ring of the paced phase, and frees the entries it read for the producer
+ *
+ * @param pvArg The result to fill in
+ * @return Unused
+ *
+ * @note Every sample must follow the previous one, a skipped sample counts as out of order
+ */
+void *Stress_PacedReader(void *pvArg) {
+	tStressResult *psResult = pvArg;
+	uint32_t ui32Cursor = 0;
+	int32_t i32Prev = 0;
+	tBusSample sSamples[BUS_RING_LENGTH];
+
+	while (ui32Cursor < STRESS_PACED) {
+		sem_wait(&g_sStressFilled);
+		uint32_t ui32Lost;
+		uint32_t ui32Count = Bus_ReadRing(BUS_TOPIC_ACCEL, &ui32Cursor, sSamples, BUS_RING_LENGTH, &ui32Lost);
+
+		psResult->ui64Lost += ui32Lost;
+		for (uint32_t i = 0; i < ui32Count; i++) {
+			psResult->ui64Reads++;
+			if (!Stress_Intact(&sSamples[i]))
+				psResult->ui64Torn++;
+			if (sSamples[i].i32Value != i32Prev + 1)
+				psResult->ui64Backwards++;
+			i32Prev = sSamples[i].i32Value;
+		}
+
+		/* Hand the entries read back to the producer, the first one was waited for already */
+		for (uint32_t i = 0; i < ui32Count + ui32Lost; i++) {
+			if (i > 0)
+				sem_wait(&g_sStressFilled);
+			sem_post(&g_sStressFree);
+		}
+	}
+
+	return NULL;
+}
+#pragma endregion
+
+/**
+ * @brief Host test entry point
+ *
+ * @return 0 if every check passed
+ */
+int main(void) {
+	pthread_t sThreads[STRESS_READERS + 1];
+
+	/* Benchmark the producer alone */
+	double dStart = Stress_Now();
+	for (int32_t i = 1; i <= STRESS_PUBLISHES; i++) {
+		Bus_Publish(BUS_TOPIC_POWER, i);
+	}
+	double dAlone = Stress_Now() - dStart;
+
+	/* Stress the producer against the readers */
+	for (int i = 0; i < STRESS_READERS; i++) {
+		pthread_create(&sThreads[i], NULL, Stress_LatestReader, &g_sResults[i]);
+	}
+	pthread_create(&sThreads[STRESS_READERS], NULL, Stress_RingReader, &g_sResults[STRESS_READERS]);
+
+	dStart = Stress_Now();
+	for (int32_t i = 1; i <= STRESS_PUBLISHES; i++) {
+		Bus_Publish(BUS_TOPIC_SPEED, i);
+	}
+	double dContended = Stress_Now() - dStart;
+	g_bStressDone = true;
+
+	for (int i = 0; i <= STRESS_READERS; i++) {
+		pthread_join(sThreads[i], NULL);
+	}
+
+	/* Report */
+	printf("publish: %.1f M/s alone, %.1f M/s with %d readers\n", STRESS_PUBLISHES / dAlone / 1e6, STRESS_PUBLISHES / dContended / 1e6, STRESS_READERS + 1);
+	for (int i = 0; i <= STRESS_READERS; i++) {
+		tStressResult *psResult = &g_sResults[i];
+		char pcName[32];
+		snprintf(pcName, sizeof(pcName), "%s reader %d", i == STRESS_READERS ? "ring" : "latest", i);
+		Stress_Check(pcName, psResult->ui64Torn == 0 && psResult->ui64Backwards == 0,
+					 "%.1f M reads/s, %llu torn, %llu out of order, %llu lost", psResult->ui64Reads / dContended / 1e6,
+					 (unsigned long long)psResult->ui64Torn, (unsigned long long)psResult->ui64Backwards,
+					 (unsigned long long)psResult->ui64Lost);
+	}
+
+	/* Every published sample is either read or reported lost by the ring reader */
+	tStressResult *psRing = &g_sResults[STRESS_READERS];
+	Stress_Check("ring accounting", psRing->ui64Reads > 0 && psRing->ui64Reads + psRing->ui64Lost == STRESS_PUBLISHES,
+				 "%llu read + %llu lost of %d", (unsigned long long)psRing->ui64Reads,
+				 (unsigned long long)psRing->ui64Lost, STRESS_PUBLISHES);
+
+	/* Paced phase, a sample is only published once the reader cannot be lapped by it */
+	sem_init(&g_sStressFree, 0, BUS_RING_LENGTH);
+	sem_init(&g_sStressFilled, 0, 0);
+	pthread_create(&sThreads[0], NULL, Stress_PacedReader, &g_sPaced);
+	dStart = Stress_Now();
+	for (int32_t i = 1; i <= STRESS_PACED; i++) {
+		sem_wait(&g_sStressFree);
+		Bus_Publish(BUS_TOPIC_ACCEL, i);
+		sem_post(&g_sStressFilled);
+	}
+	pthread_join(sThreads[0], NULL);
+	double dPaced = Stress_Now() - dStart;
+
+	Stress_Check("paced ring reader",
+				 g_sPaced.ui64Reads == STRESS_PACED && g_sPaced.ui64Torn == 0 && g_sPaced.ui64Backwards == 0 &&
+					 g_sPaced.ui64Lost == 0,
+				 "%.1f M reads/s, %llu of %d read, %llu torn, %llu out of order, %llu lost", g_sPaced.ui64Reads / dPaced / 1e6,
+				 (unsigned long long)g_sPaced.ui64Reads, STRESS_PACED, (unsigned long long)g_sPaced.ui64Torn,
+				 (unsigned long long)g_sPaced.ui64Backwards, (unsigned long long)g_sPaced.ui64Lost);
+
+	printf("%s: %u check(s) failed\n", g_ui8StressFailures == 0 ? "PASS" : "FAIL", g_ui8StressFailures);
+	return g_ui8StressFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,548 @@
+/**
+ * @file commutation_check.c
+ * @brief Host check of the six-step commutation against Hall edges at full speed, under a GUI repaint load
+ *
+ * commutation.c, hall.c and motor.c run unchanged on the emulated capture timers, PWM outputs and
+ * Hall pins (see gptm.h and bridge.h). The Hall sensors turn at COMMUTATION_CHECK_SPEED the whole
+ * time while a low priority task keeps the CPU busy like a GUI repaint streaming pixels, and plays
+ * the script below the way the GUI and main.c would:
+ *   0 ms     start                         every edge commutates, one step forward per edge
+ *   300 ms   the Hall sensors read 7       the bridge opens for that edge, a fault is counted
+ *   400 ms   e-stop for 100 ms             pressed between two control periods, the bridge opens at once from
+ *                                          the input interrupt and no later edge drives it
+ *   500 ms   e-stop released               the bridge stays open, the e-stop cancelled the run
+ *   550 ms   start                         forward again, with the same pattern for each Hall state
+ *   600 ms   reverse                       one step back per edge, high and low side swapped
+ *   800 ms   stop                          the bridge opens and stays open while the motor coasts
+ *
+ * The bridge is also checked every COMMUTATION_CHECK_SAMPLE for a phase with both switches on. Only
+ * the repaint spends simulated time, so the latency histogram only shows on the target, it is
+ * read with Commutation_GetStats. The display is initialized last, like GUI_Init after
+ * Commutation_Init in main.c, and must leave the pins of the bridge to PWM (see pins.h).
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make commutation_check
+ *   ./commutation_check
+ */
+#pragma region Includes
+#include "sim.h"
+#include "gptm.h"
+#include "bridge.h"
+#include "pins.h"
+#include "commutation.h"
+#include "hall.h"
+#include "motor.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+#include "driverlib/timer.h"
+#include "drivers/Kentec320x240x16_ssd2119_spi.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define COMMUTATION_CHECK_DURATION 900 // ms
+#define COMMUTATION_CHECK_SPEED 6000   // RPM, well above MAX_SPEED
+#define COMMUTATION_CHECK_EDGE_CYCLES ((uint64_t)SIM_CPU_FREQ * 60 / (COMMUTATION_CHECK_SPEED * 6 * HALL_POLE_PAIRS))
+#define COMMUTATION_CHECK_SAMPLE 10			 // us
+#define COMMUTATION_CHECK_REPAINT_CHUNK 128 // CPU cycles, about a pixel on the display bus
+#define COMMUTATION_CHECK_SETTLE 2			 // Time allowed for an action to reach the bridge (ms)
+#define COMMUTATION_CHECK_MAX_EDGES 4096
+#define COMMUTATION_CHECK_FAULT 300
+#define COMMUTATION_CHECK_ESTOP 400
+#define COMMUTATION_CHECK_ESTOP_PHASE 500 // us after the control period, the e-stop input changes between two periods
+#define COMMUTATION_CHECK_RELEASE 500
+#define COMMUTATION_CHECK_RESTART 550
+#define COMMUTATION_CHECK_REVERSE 600
+#define COMMUTATION_CHECK_STOP 800
+
+/* The output enables of each phase, high side first */
+#define COMMUTATION_CHECK_A_HIGH PWM_OUT_2_BIT
+#define COMMUTATION_CHECK_A_LOW PWM_OUT_3_BIT
+#define COMMUTATION_CHECK_B_HIGH PWM_OUT_0_BIT
+#define COMMUTATION_CHECK_B_LOW PWM_OUT_1_BIT
+#define COMMUTATION_CHECK_C_HIGH PWM_OUT_6_BIT
+#define COMMUTATION_CHECK_C_LOW PWM_OUT_7_BIT
+
+/**
+ * @brief What the bridge should do during a span of the script
+ *
+ */
+typedef enum tCommutationCheckExpect {
+	COMMUTATION_CHECK_EXPECT_NONE,
+	COMMUTATION_CHECK_EXPECT_FORWARD,
+	COMMUTATION_CHECK_EXPECT_OPEN,
+	COMMUTATION_CHECK_EXPECT_REVERSE,
+} tCommutationCheckExpect;
+
+/**
+ * @brief A Hall edge and the pattern it left on the bridge
+ *
+ */
+typedef struct tCommutationCheckEdge {
+	uint64_t ui64Time;
+	uint8_t ui8State;
+	uint32_t ui32Outputs;
+} tCommutationCheckEdge;
+
+/* The six steps of the bridge in forward order, each drives one phase high and one low */
+const uint32_t gc_ui32CommutationCheckSteps[6] = {
+	COMMUTATION_CHECK_A_HIGH | COMMUTATION_CHECK_B_LOW, COMMUTATION_CHECK_A_HIGH | COMMUTATION_CHECK_C_LOW,
+	COMMUTATION_CHECK_B_HIGH | COMMUTATION_CHECK_C_LOW, COMMUTATION_CHECK_B_HIGH | COMMUTATION_CHECK_A_LOW,
+	COMMUTATION_CHECK_C_HIGH | COMMUTATION_CHECK_A_LOW, COMMUTATION_CHECK_C_HIGH | COMMUTATION_CHECK_B_LOW,
+};
+const uint32_t gc_ui32CommutationCheckPhases[3][2] = {
+	{COMMUTATION_CHECK_A_HIGH, COMMUTATION_CHECK_A_LOW},
+	{COMMUTATION_CHECK_B_HIGH, COMMUTATION_CHECK_B_LOW},
+	{COMMUTATION_CHECK_C_HIGH, COMMUTATION_CHECK_C_LOW},
+};
+const uint32_t gc_ui32CommutationCheckHighOut[3] = {PWM_OUT_2, PWM_OUT_0, PWM_OUT_6};
+
+/* The pins of each phase on the board, high side first */
+const uint32_t gc_ui32CommutationCheckPorts[3] = {GPIO_PORTF_BASE, GPIO_PORTF_BASE, GPIO_PORTK_BASE};
+const uint8_t gc_ui8CommutationCheckPins[3][2] = {
+	{GPIO_PIN_2, GPIO_PIN_3},
+	{GPIO_PIN_0, GPIO_PIN_1},
+	{GPIO_PIN_4, GPIO_PIN_5},
+};
+
+/* The Hall states of a forward turn, and the capture input of each sensor */
+const uint8_t gc_ui8CommutationCheckHall[6] = {5, 1, 3, 2, 6, 4};
+const uint32_t gc_ui32CommutationCheckInputs[HALL_CHANNEL_COUNT][2] = {
+	{TIMER3_BASE, TIMER_A},
+	{TIMER3_BASE, TIMER_B},
+	{TIMER4_BASE, TIMER_A},
+};
+
+/* Global variables */
+Task_Struct g_sCommutationCheckMotorTask;
+Task_Struct g_sCommutationCheckRepaintTask;
+char ga_cCommutationCheckMotorStack[2048];
+char ga_cCommutationCheckRepaintStack[2048];
+uint8_t g_ui8CommutationCheckPosition = 0;
+volatile bool g_bCommutationCheckReverse = false;
+volatile bool g_bCommutationCheckFault = false;
+volatile bool g_bCommutationCheckEStop = false;
+uint64_t g_ui64CommutationCheckEStopTime = 0;
+uint64_t g_ui64CommutationCheckOpenTime = 0;
+uint32_t g_ui32CommutationCheckShootThrough = 0;
+uint32_t g_ui32CommutationCheckDutyErrors = 0;
+uint64_t g_ui64CommutationCheckRepaint = 0;
+uint32_t g_ui32CommutationCheckEdges = 0;
+tCommutationCheckEdge ga_sCommutationCheckEdges[COMMUTATION_CHECK_MAX_EDGES];
+uint8_t g_ui8CommutationCheckFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Finds the step of the bridge a pattern drives
+ *
+ * @param ui32Outputs The output enables
+ * @return The step, or -1 if the pattern is not one of the six
+ */
+int8_t CommutationCheck_Step(uint32_t ui32Outputs) {
+	for (int8_t i = 0; i < 6; i++) {
+		if (gc_ui32CommutationCheckSteps[i] == ui32Outputs)
+			return i;
+	}
+	return -1;
+}
+
+/**
+ * @brief Checks whether a pattern turns on both switches of a phase
+ *
+ * @param ui32Outputs The output enables
+ * @return Whether a phase is shorted
+ */
+bool CommutationCheck_ShootThrough(uint32_t ui32Outputs) {
+	for (uint8_t i = 0; i < 3; i++) {
+		if ((ui32Outputs & gc_ui32CommutationCheckPhases[i][0]) && (ui32Outputs & gc_ui32CommutationCheckPhases[i][1]))
+			return true;
+	}
+	return false;
+}
+
+/**
+ * @brief Swaps the high and the low side of every phase in a pattern
+ *
+ * @param ui32Outputs The output enables
+ * @return The swapped output enables
+ */
+uint32_t CommutationCheck_Swap(uint32_t ui32Outputs) {
+	uint32_t ui32Swapped = 0;
+	for (uint8_t i = 0; i < 3; i++) {
+		if (ui32Outputs & gc_ui32CommutationCheckPhases[i][0])
+			ui32Swapped |= gc_ui32CommutationCheckPhases[i][1];
+		if (ui32Outputs & gc_ui32CommutationCheckPhases[i][1])
+			ui32Swapped |= gc_ui32CommutationCheckPhases[i][0];
+	}
+	return ui32Swapped;
+}
+
+/**
+ * @brief Gets what the bridge should do at a point of the script
+ *
+ * @param ui64Time The time (CPU cycles)
+ * @return The expectation, none while an action is settling
+ */
+tCommutationCheckExpect CommutationCheck_Expect(uint64_t ui64Time) {
+	const uint32_t pui32Actions[] = {0, COMMUTATION_CHECK_ESTOP, COMMUTATION_CHECK_RESTART, COMMUTATION_CHECK_REVERSE,
+									 COMMUTATION_CHECK_STOP, COMMUTATION_CHECK_DURATION};
+	const tCommutationCheckExpect peExpect[] = {COMMUTATION_CHECK_EXPECT_FORWARD, COMMUTATION_CHECK_EXPECT_OPEN,
+												COMMUTATION_CHECK_EXPECT_FORWARD, COMMUTATION_CHECK_EXPECT_REVERSE,
+												COMMUTATION_CHECK_EXPECT_OPEN};
+
+	for (uint8_t i = 0; i < 5; i++) {
+		if (ui64Time < SIM_CYCLES_MS(pui32Actions[i + 1]))
+			return ui64Time < SIM_CYCLES_MS(pui32Actions[i] + COMMUTATION_CHECK_SETTLE) ? COMMUTATION_CHECK_EXPECT_NONE
+																						: peExpect[i];
+	}
+	return COMMUTATION_CHECK_EXPECT_NONE;
+}
+
+/**
+ * @brief Moves the rotor one Hall edge and records what the commutation did with it
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every COMMUTATION_CHECK_EDGE_CYCLES
+ */
+void CommutationCheck_Edge(uintptr_t arg) {
+	uint8_t ui8Old = gc_ui8CommutationCheckHall[g_ui8CommutationCheckPosition];
+	uint8_t ui8State;
+	if (g_bCommutationCheckFault) {
+		/* A broken sensor wire, the rotor does not move */
+		g_bCommutationCheckFault = false;
+		ui8State = 7;
+	} else {
+		g_ui8CommutationCheckPosition = (g_ui8CommutationCheckPosition + (g_bCommutationCheckReverse ? 5 : 1)) % 6;
+		ui8State = gc_ui8CommutationCheckHall[g_ui8CommutationCheckPosition];
+	}
+
+	/* Capture on the sensor that changed */
+	uint8_t ui8Changed = (ui8Old ^ ui8State) & 0x7;
+	uint8_t ui8Channel = ui8Changed & 1 ? 0 : ui8Changed & 2 ? 1 : 2;
+	Bridge_SetHall(ui8State);
+	GPTM_CaptureEdge(gc_ui32CommutationCheckInputs[ui8Channel][0], gc_ui32CommutationCheckInputs[ui8Channel][1]);
+
+	if (g_ui32CommutationCheckEdges < COMMUTATION_CHECK_MAX_EDGES)
+		ga_sCommutationCheckEdges[g_ui32CommutationCheckEdges] = (tCommutationCheckEdge){Sim_Now(), ui8State, Bridge_GetOutputs()};
+	g_ui32CommutationCheckEdges++;
+}
+
+/**
+ * @brief Watches the bridge between edges
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every COMMUTATION_CHECK_SAMPLE
+ */
+void CommutationCheck_Sample(uintptr_t arg) {
+	uint32_t ui32Outputs = Bridge_GetOutputs();
+	if (CommutationCheck_ShootThrough(ui32Outputs))
+		g_ui32CommutationCheckShootThrough++;
+
+	if (g_bCommutationCheckEStop && ui32Outputs == 0 && g_ui64CommutationCheckOpenTime == 0)
+		g_ui64CommutationCheckOpenTime = Sim_Now();
+
+	/* The high sides follow the duty of the speed loop */
+	tMotorStatus sStatus;
+	Motor_GetStatus(&sStatus);
+	uint32_t ui32Period = PWMGenPeriodGet(PWM0_BASE, PWM_GEN_1);
+	uint32_t ui32Width = (uint32_t)sStatus.i32Duty * ui32Period / (COMMUTATION_DUTY_MAX + 1);
+	if (ui32Width == 0)
+		ui32Width = 1;
+	for (uint8_t i = 0; i < 3; i++) {
+		if (Bridge_GetPulseWidth(gc_ui32CommutationCheckHighOut[i]) != ui32Width)
+			g_ui32CommutationCheckDutyErrors++;
+	}
+}
+
+/**
+ * @brief Presses or releases the e-stop like its input interrupt
+ *
+ * @param arg Whether the e-stop is pressed
+ *
+ * @note Called from interrupt context, COMMUTATION_CHECK_ESTOP_PHASE after the press and the release of the script
+ */
+void CommutationCheck_EStop(uintptr_t arg) {
+	if (arg) {
+		g_ui64CommutationCheckEStopTime = Sim_Now();
+		g_bCommutationCheckEStop = true;
+	} else {
+		g_bCommutationCheckEStop = false;
+	}
+	Motor_EStop(arg != 0);
+}
+
+/**
+ * @brief Streams pixels to the display while playing the script
+ *
+ * @param arg0 Unused
+ * @param arg1 Unused
+ *
+ * @note Runs at the lowest priority and never waits, like the GUI task in the middle of a repaint
+ */
+void CommutationCheck_Repaint(UArg arg0, UArg arg1) {
+	uint32_t ui32Done = 0;
+
+	while (Sim_Now() < SIM_CYCLES_MS(COMMUTATION_CHECK_DURATION)) {
+		uint32_t ui32Now = Sim_Now() / SIM_TICK_CYCLES;
+		if (ui32Now >= ui32Done) {
+			if (ui32Done == 0) {
+				Motor_Post(MOTOR_COMMAND_SPEED, MAX_SPEED);
+				Motor_Post(MOTOR_COMMAND_STATE, 1);
+			} else if (ui32Done == COMMUTATION_CHECK_FAULT) {
+				g_bCommutationCheckFault = true;
+			} else if (ui32Done == COMMUTATION_CHECK_RESTART) {
+				Motor_Post(MOTOR_COMMAND_STATE, 1);
+			} else if (ui32Done == COMMUTATION_CHECK_REVERSE) {
+				g_bCommutationCheckReverse = true;
+				Commutation_SetMode(COMMUTATION_REVERSE);
+			} else if (ui32Done == COMMUTATION_CHECK_STOP) {
+				Motor_Post(MOTOR_COMMAND_STATE, 0);
+			}
+			ui32Done++;
+		}
+
+		Sim_Advance(COMMUTATION_CHECK_REPAINT_CHUNK);
+		g_ui64CommutationCheckRepaint += COMMUTATION_CHECK_REPAINT_CHUNK;
+	}
+	Sim_Stop();
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void CommutationCheck_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8CommutationCheckFailures++;
+}
+
+/**
+ * @brief Checks the edges of a span of the script, where the bridge turns the rotor one way
+ *
+ * @param pcName The name of the check
+ * @param eExpect COMMUTATION_CHECK_EXPECT_FORWARD or COMMUTATION_CHECK_EXPECT_REVERSE
+ * @param pi8Map The step given to each Hall state so far, -1 for none, checked and updated
+ */
+void CommutationCheck_CheckTurning(const char *pcName, tCommutationCheckExpect eExpect, int8_t *pi8Map) {
+	uint32_t ui32Edges = 0;
+	uint32_t ui32Wrong = 0;
+	uint32_t ui32Order = 0;
+	int8_t i8Last = -1;
+
+	for (uint32_t i = 0; i < g_ui32CommutationCheckEdges && i < COMMUTATION_CHECK_MAX_EDGES; i++) {
+		const tCommutationCheckEdge *psEdge = &ga_sCommutationCheckEdges[i];
+		if (CommutationCheck_Expect(psEdge->ui64Time) != eExpect) {
+			i8Last = -1;
+			continue;
+		}
+
+		ui32Edges++;
+		if (psEdge->ui8State == 7) {
+			if (psEdge->ui32Outputs != 0)
+				ui32Wrong++;
+			continue;
+		}
+
+		/* Reverse drives each step with the high and the low side swapped, which turns the rotor back */
+		uint32_t ui32Outputs = psEdge->ui32Outputs;
+		if (eExpect == COMMUTATION_CHECK_EXPECT_REVERSE)
+			ui32Outputs = CommutationCheck_Swap(ui32Outputs);
+		int8_t i8Step = CommutationCheck_Step(ui32Outputs);
+		if (i8Step < 0 || (pi8Map[psEdge->ui8State] >= 0 && pi8Map[psEdge->ui8State] != i8Step)) {
+			ui32Wrong++;
+			i8Last = -1;
+			continue;
+		}
+		pi8Map[psEdge->ui8State] = i8Step;
+
+		/* Swapped back, the steps follow the rotor backwards */
+		int8_t i8Advance = eExpect == COMMUTATION_CHECK_EXPECT_REVERSE ? 5 : 1;
+		if (i8Last >= 0 && i8Step != (i8Last + i8Advance) % 6)
+			ui32Order++;
+		i8Last = i8Step;
+	}
+	CommutationCheck_Check(pcName, ui32Edges > 0 && ui32Wrong == 0 && ui32Order == 0,
+						   "%u edges, %u wrong patterns, %u out of order", ui32Edges, ui32Wrong, ui32Order);
+}
+
+/**
+ * @brief Checks the edges of a span of the script, where the bridge is open
+ *
+ * @param pcName The name of the check
+ * @param ui64Start The start of the span (CPU cycles)
+ * @param ui64End The end of the span (CPU cycles)
+ */
+void CommutationCheck_CheckOpen(const char *pcName, uint64_t ui64Start, uint64_t ui64End) {
+	uint32_t ui32Edges = 0;
+	uint32_t ui32Driven = 0;
+	for (uint32_t i = 0; i < g_ui32CommutationCheckEdges && i < COMMUTATION_CHECK_MAX_EDGES; i++) {
+		const tCommutationCheckEdge *psEdge = &ga_sCommutationCheckEdges[i];
+		if (psEdge->ui64Time < ui64Start || psEdge->ui64Time >= ui64End)
+			continue;
+
+		ui32Edges++;
+		if (psEdge->ui32Outputs != 0)
+			ui32Driven++;
+	}
+	CommutationCheck_Check(pcName, ui32Edges > 0 && ui32Driven == 0, "%u edges, %u driven", ui32Edges, ui32Driven);
+}
+
+/**
+ * @brief Checks every span of the script and prints the report
+ *
+ */
+void CommutationCheck_Report() {
+	int8_t pi8Forward[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+	int8_t pi8Reverse[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+	CommutationCheck_CheckTurning("forward", COMMUTATION_CHECK_EXPECT_FORWARD, pi8Forward);
+	CommutationCheck_CheckTurning("reverse", COMMUTATION_CHECK_EXPECT_REVERSE, pi8Reverse);
+
+	/* The same Hall state gives the same step both ways, with the sides swapped */
+	uint8_t ui8Mapped = 0;
+	uint8_t ui8Mismatch = 0;
+	for (uint8_t i = 1; i < 7; i++) {
+		if (pi8Forward[i] >= 0)
+			ui8Mapped++;
+		if (pi8Forward[i] != pi8Reverse[i])
+			ui8Mismatch++;
+	}
+	CommutationCheck_Check("hall states", ui8Mapped == 6 && ui8Mismatch == 0, "%u of 6 states seen, %u differ in reverse",
+						   ui8Mapped, ui8Mismatch);
+
+	/* No edge after the press may drive the bridge, not even before the next control period, nor after the release
+	   until the next start */
+	CommutationCheck_CheckOpen("e-stop", g_ui64CommutationCheckEStopTime,
+							   SIM_CYCLES_MS(COMMUTATION_CHECK_RELEASE) + SIM_CYCLES_US(COMMUTATION_CHECK_ESTOP_PHASE));
+	CommutationCheck_CheckOpen("e-stop release",
+							   SIM_CYCLES_MS(COMMUTATION_CHECK_RELEASE) + SIM_CYCLES_US(COMMUTATION_CHECK_ESTOP_PHASE),
+							   SIM_CYCLES_MS(COMMUTATION_CHECK_RESTART));
+	uint64_t ui64Open = g_ui64CommutationCheckOpenTime - g_ui64CommutationCheckEStopTime;
+	CommutationCheck_Check("e-stop delay", g_ui64CommutationCheckOpenTime != 0 && ui64Open <= SIM_CYCLES_US(COMMUTATION_CHECK_SAMPLE),
+						   "open after %.3f us", (double)ui64Open * 1000 / SIM_TICK_CYCLES);
+	CommutationCheck_CheckOpen("stop", SIM_CYCLES_MS(COMMUTATION_CHECK_STOP + COMMUTATION_CHECK_SETTLE),
+							   SIM_CYCLES_MS(COMMUTATION_CHECK_DURATION));
+	CommutationCheck_Check("shoot-through", g_ui32CommutationCheckShootThrough == 0, "%u samples with a shorted phase",
+						   g_ui32CommutationCheckShootThrough);
+	CommutationCheck_Check("duty", g_ui32CommutationCheckDutyErrors == 0, "%u samples off the speed loop duty",
+						   g_ui32CommutationCheckDutyErrors);
+
+	/* Every edge is commutated, none is lost to the repaint */
+	tCommutationStats sStats;
+	Commutation_GetStats(&sStats);
+	tHallStats sHall;
+	Hall_GetStats(&sHall);
+	CommutationCheck_Check("no lost edge", sStats.ui32Commutations == g_ui32CommutationCheckEdges && sStats.ui32Faults == 1,
+						   "%u edges, %u commutated, %u faults", g_ui32CommutationCheckEdges, sStats.ui32Commutations,
+						   sStats.ui32Faults);
+	double dLoad = (double)g_ui64CommutationCheckRepaint / SIM_CYCLES_MS(COMMUTATION_CHECK_DURATION);
+	CommutationCheck_Check("repaint load", dLoad >= 0.99, "%.1f %% of the CPU repainting", dLoad * 100);
+
+	/* The full scale of the duty just fits under the period */
+	Commutation_SetDuty(COMMUTATION_DUTY_MAX);
+	uint32_t ui32Full = Bridge_GetPulseWidth(PWM_OUT_2);
+	Commutation_SetDuty(COMMUTATION_DUTY_MAX / 2 + 1);
+	uint32_t ui32Half = Bridge_GetPulseWidth(PWM_OUT_2);
+	uint32_t ui32Period = PWMGenPeriodGet(PWM0_BASE, PWM_GEN_1);
+	CommutationCheck_Check("duty scale", ui32Full == ui32Period - 1 && ui32Half == ui32Period / 2,
+						   "full %u, half %u of %u", ui32Full, ui32Half, ui32Period);
+
+	/* The display comes up after the bridge and must not take over any of its pins */
+	Types_FreqHz sFreq;
+	BIOS_getCpuFreq(&sFreq);
+	Kentec320x240x16_SSD2119Init(sFreq.lo);
+	uint8_t ui8PWM = 0;
+	for (uint8_t i = 0; i < 3; i++) {
+		for (uint8_t j = 0; j < 2; j++)
+			ui8PWM += Pins_GetUse(gc_ui32CommutationCheckPorts[i], gc_ui8CommutationCheckPins[i][j]) == PINS_PWM;
+	}
+	CommutationCheck_Check("pin ownership", ui8PWM == 6 && Pins_GetConflicts() == 0, "%u of 6 bridge pins on PWM, %u conflict(s) %s",
+						   ui8PWM, Pins_GetConflicts(), Pins_GetFirstConflict());
+
+	printf("latency histogram (%u counts per bin, worst %u):", 1 << COMMUTATION_HISTOGRAM_SHIFT, sStats.ui32WorstLatency);
+	for (uint8_t i = 0; i < COMMUTATION_HISTOGRAM_BINS; i++)
+		printf(" %u", sStats.pui32Latency[i]);
+	printf("\n");
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @param argc Unused
+ * @param argv Unused
+ * @return 0 if every check passed
+ */
+int main(int argc, char **argv) {
+	Types_FreqHz sFreq;
+	BIOS_getCpuFreq(&sFreq);
+	Bridge_SetHall(gc_ui8CommutationCheckHall[0]);
+	Hall_Init();
+	Commutation_Init(sFreq.lo);
+	Motor_Init(sFreq.lo);
+
+	Clock_Params clockParams;
+	Clock_Params_init(&clockParams);
+	clockParams.startFlag = true;
+	clockParams.period = HALL_PUBLISH_PERIOD;
+	Clock_create((Clock_FuncPtr)Hall_Publish, HALL_PUBLISH_PERIOD, &clockParams, NULL);
+
+	uint8_t ui8Edge = Sim_TimerCreate(CommutationCheck_Edge, 0);
+	uint8_t ui8Sample = Sim_TimerCreate(CommutationCheck_Sample, 0);
+	Sim_TimerStart(ui8Edge, COMMUTATION_CHECK_EDGE_CYCLES, COMMUTATION_CHECK_EDGE_CYCLES);
+	Sim_TimerStart(ui8Sample, 0, SIM_CYCLES_US(COMMUTATION_CHECK_SAMPLE));
+	uint8_t ui8Press = Sim_TimerCreate(CommutationCheck_EStop, true);
+	uint8_t ui8Release = Sim_TimerCreate(CommutationCheck_EStop, false);
+	Sim_TimerStart(ui8Press, SIM_CYCLES_MS(COMMUTATION_CHECK_ESTOP) + SIM_CYCLES_US(COMMUTATION_CHECK_ESTOP_PHASE), 0);
+	Sim_TimerStart(ui8Release, SIM_CYCLES_MS(COMMUTATION_CHECK_RELEASE) + SIM_CYCLES_US(COMMUTATION_CHECK_ESTOP_PHASE), 0);
+
+	Task_Params taskParams;
+	Task_Params_init(&taskParams);
+	taskParams.stackSize = sizeof(ga_cCommutationCheckMotorStack);
+	taskParams.stack = &ga_cCommutationCheckMotorStack;
+	taskParams.priority = 3;
+	Task_construct(&g_sCommutationCheckMotorTask, (Task_FuncPtr)Motor_Control, &taskParams, NULL);
+	taskParams.stackSize = sizeof(ga_cCommutationCheckRepaintStack);
+	taskParams.stack = &ga_cCommutationCheckRepaintStack;
+	taskParams.priority = 1;
+	Task_construct(&g_sCommutationCheckRepaintTask, CommutationCheck_Repaint, &taskParams, NULL);
+
+	BIOS_start();
+
+	CommutationCheck_Report();
+	printf("%s: %u check(s) failed\n", g_ui8CommutationCheckFailures == 0 ? "PASS" : "FAIL",
+		   g_ui8CommutationCheckFailures);
+	return g_ui8CommutationCheckFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file devices.c
+ * @brief Host stand-ins for the board, the ADC manager, the power sampling and the resistive touch screen
+ */
+#pragma region Includes
+#include "devices.h"
+#include "sim.h"
+#include "adcmgr.h"
+#include "power.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* TI-RTOS header files */
+#include <ti/drivers/GPIO.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+
+/* Driver header files */
+#include "drivers/touch.h"
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/**
+ * @brief States of the pen as reported to the touch screen callback
+ *
+ */
+typedef enum tDevicesPen {
+	DEVICES_PEN_UP,
+	DEVICES_PEN_PRESSED,
+	DEVICES_PEN_TAPPED,
+	DEVICES_PEN_DOWN,
+	DEVICES_PEN_RELEASED,
+} tDevicesPen;
+
+/* Global variables */
+unsigned int g_puiDevicesGPIO[DEVICES_GPIO_COUNT];
+GPIO_CallbackFxn g_pfnDevicesGPIOCallbacks[DEVICES_GPIO_COUNT];
+bool g_pbDevicesGPIOEnabled[DEVICES_GPIO_COUNT];
+int32_t (*g_pfnDevicesTouch)(uint32_t ui32Message, int32_t i32X, int32_t i32Y) = NULL;
+tDevicesPen g_eDevicesPen = DEVICES_PEN_UP;
+int32_t g_i32DevicesTouchX = 0;
+int32_t g_i32DevicesTouchY = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports the pen to the touch screen callback like the debouncer of the touch driver
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every DEVICES_TOUCH_PERIOD
+ */
+void Devices_TouchSample(uintptr_t arg) {
+	uint32_t ui32Message;
+	switch (g_eDevicesPen) {
+	case DEVICES_PEN_PRESSED:
+		ui32Message = WIDGET_MSG_PTR_DOWN;
+		g_eDevicesPen = DEVICES_PEN_DOWN;
+		break;
+	case DEVICES_PEN_TAPPED:
+		ui32Message = WIDGET_MSG_PTR_DOWN;
+		g_eDevicesPen = DEVICES_PEN_RELEASED;
+		break;
+	case DEVICES_PEN_DOWN:
+		ui32Message = WIDGET_MSG_PTR_MOVE;
+		break;
+	case DEVICES_PEN_RELEASED:
+		ui32Message = WIDGET_MSG_PTR_UP;
+		g_eDevicesPen = DEVICES_PEN_UP;
+		break;
+	default:
+		return;
+	}
+
+	if (g_pfnDevicesTouch != NULL)
+		g_pfnDevicesTouch(ui32Message, g_i32DevicesTouchX, g_i32DevicesTouchY);
+}
+#pragma endregion
+
+#pragma region Device API functions
+void Devices_Start() {
+	uint8_t ui8Timer = Sim_TimerCreate(Devices_TouchSample, 0);
+	Sim_TimerStart(ui8Timer, Sim_Now(), SIM_CYCLES_MS(DEVICES_TOUCH_PERIOD));
+}
+
+void Devices_TouchPress(int32_t i32X, int32_t i32Y) {
+	g_i32DevicesTouchX = i32X;
+	g_i32DevicesTouchY = i32Y;
+	if (g_eDevicesPen == DEVICES_PEN_UP)
+		g_eDevicesPen = DEVICES_PEN_PRESSED;
+}
+
+void Devices_RaisePin(unsigned int uiIndex) {
+	if (uiIndex < DEVICES_GPIO_COUNT && g_pbDevicesGPIOEnabled[uiIndex] && g_pfnDevicesGPIOCallbacks[uiIndex] != NULL)
+		g_pfnDevicesGPIOCallbacks[uiIndex](uiIndex);
+}
+
+void Devices_SetPin(unsigned int uiIndex, unsigned int uiLevel) {
+	if (uiIndex >= DEVICES_GPIO_COUNT || g_puiDevicesGPIO[uiIndex] == uiLevel)
+		return;
+
+	g_puiDevicesGPIO[uiIndex] = uiLevel;
+	Devices_RaisePin(uiIndex);
+}
+
+void Devices_TouchRelease() {
+	/* A tap shorter than a sample still goes down before it goes up */
+	if (g_eDevicesPen == DEVICES_PEN_DOWN)
+		g_eDevicesPen = DEVICES_PEN_RELEASED;
+	else if (g_eDevicesPen == DEVICES_PEN_PRESSED)
+		g_eDevicesPen = DEVICES_PEN_TAPPED;
+}
+#pragma endregion
+
+#pragma region Board functions
+void EK_TM4C1294XL_initGeneral(void) {
+}
+
+void EK_TM4C1294XL_initGPIO(void) {
+	/* The buttons are pulled up */
+	g_puiDevicesGPIO[Board_BUTTON0] = 1;
+	g_puiDevicesGPIO[Board_BUTTON1] = 1;
+}
+
+void GPIO_write(unsigned int uiIndex, unsigned int uiValue) {
+	if (uiIndex < DEVICES_GPIO_COUNT)
+		g_puiDevicesGPIO[uiIndex] = uiValue;
+}
+
+unsigned int GPIO_read(unsigned int uiIndex) {
+	return uiIndex < DEVICES_GPIO_COUNT ? g_puiDevicesGPIO[uiIndex] : 0;
+}
+
+void GPIO_setCallback(unsigned int uiIndex, GPIO_CallbackFxn pfnCallback) {
+	if (uiIndex < DEVICES_GPIO_COUNT)
+		g_pfnDevicesGPIOCallbacks[uiIndex] = pfnCallback;
+}
+
+void GPIO_enableInt(unsigned int uiIndex) {
+	if (uiIndex < DEVICES_GPIO_COUNT)
+		g_pbDevicesGPIOEnabled[uiIndex] = true;
+}
+
+void GPIO_disableInt(unsigned int uiIndex) {
+	if (uiIndex < DEVICES_GPIO_COUNT)
+		g_pbDevicesGPIOEnabled[uiIndex] = false;
+}
+
+void EK_TM4C1294XL_initI2C(void) {
+}
+
+void ADCMgr_Init() {
+}
+
+/* The power reading comes from the motor plant instead, see sensors.c */
+bool Power_Init(uint32_t ui32SysClock) {
+	return true;
+}
+
+void TouchScreenInit(uint32_t ui32SysClock) {
+}
+
+void TouchScreenCallbackSet(int32_t (*pfnCallback)(uint32_t ui32Message, int32_t i32X, int32_t i32Y)) {
+	g_pfnDevicesTouch = pfnCallback;
+}
+#pragma endregion
@@ -0,0 +1,50 @@
+/**
+ * @file devices.h
+ * @brief Host stand-ins for the board, the ADC manager and the resistive touch screen
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define DEVICES_TOUCH_PERIOD 4 // The touch driver reads an X/Y pair every 4 ADC samples of 1 ms (ms)
+#define DEVICES_GPIO_COUNT 16
+
+/**
+ * @brief Starts sampling the touch screen, must be called once the simulation runs
+ *
+ */
+void Devices_Start();
+
+/**
+ * @brief Puts the pen down or moves it
+ *
+ * @param i32X The x position of the pen
+ * @param i32Y The y position of the pen
+ */
+void Devices_TouchPress(int32_t i32X, int32_t i32Y);
+
+/**
+ * @brief Raises the interrupt of a board pin, as its edge would
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ *
+ * @note The callback set with GPIO_setCallback is called straight away if the interrupt is enabled
+ */
+void Devices_RaisePin(unsigned int uiIndex);
+
+/**
+ * @brief Drives an input pin, raising its interrupt if the level changes
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ * @param uiLevel The level to drive, 0 or 1
+ *
+ * @note Pins are taken on both edges, the callback reads the level to tell them apart
+ */
+void Devices_SetPin(unsigned int uiIndex, unsigned int uiLevel);
+
+/**
+ * @brief Lifts the pen
+ *
+ */
+void Devices_TouchRelease();
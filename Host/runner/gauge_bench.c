@@ -0,0 +1,250 @@
+/**
+ * @file gauge_bench.c
+ * @brief Host render check and benchmark for the incremental analog gauge
+ *
+ * gauge.c runs unchanged on the graphics library, drawing on a framebuffer display that counts the
+ * primitives and pixels written. On the target each primitive is at least one SPI window setup, so the
+ * counts model the bus cost of a drawing. The needle moves through a sequence of values:
+ *   render               after every update the framebuffer matches a gauge drawn from scratch at the same value
+ *   update cost          an update writes fewer pixels than a full draw, on average and at worst
+ *
+ * Also reports the pixels and primitives each update writes and the time it takes on the host.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make gauge_bench
+ *   ./gauge_bench
+ */
+#pragma region Includes
+#include "gauge.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define GAUGE_BENCH_WIDTH 320
+#define GAUGE_BENCH_HEIGHT 240
+#define GAUGE_BENCH_BACKGROUND ClrBlack
+#define GAUGE_BENCH_UPDATES 2000
+#define GAUGE_BENCH_MAX_SPEED 255
+
+/* Global variables */
+uint32_t g_pui32GaugeBenchFrame[GAUGE_BENCH_HEIGHT][GAUGE_BENCH_WIDTH];
+uint32_t g_pui32GaugeBenchReference[GAUGE_BENCH_HEIGHT][GAUGE_BENCH_WIDTH];
+uint32_t g_ui32GaugeBenchCalls = 0;
+uint32_t g_ui32GaugeBenchPixels = 0;
+uint8_t g_ui8GaugeBenchFailures = 0;
+#pragma endregion
+
+#pragma region Display functions
+/**
+ * @brief Writes a pixel of the framebuffer and counts it
+ *
+ * @param i32X The x position
+ * @param i32Y The y position
+ * @param ui32Value The color
+ */
+void GaugeBench_Write(int32_t i32X, int32_t i32Y, uint32_t ui32Value) {
+	if (i32X < 0 || i32X >= GAUGE_BENCH_WIDTH || i32Y < 0 || i32Y >= GAUGE_BENCH_HEIGHT)
+		return;
+
+	g_pui32GaugeBenchFrame[i32Y][i32X] = ui32Value;
+	g_ui32GaugeBenchPixels++;
+}
+
+void GaugeBench_PixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value) {
+	g_ui32GaugeBenchCalls++;
+	GaugeBench_Write(i32X, i32Y, ui32Value);
+}
+
+void GaugeBench_PixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y, int32_t i32X0, int32_t i32Count,
+								  int32_t i32BPP, const uint8_t *pui8Data, const uint8_t *pui8Palette) {
+	/* The gauge draws no text or images */
+}
+
+void GaugeBench_LineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value) {
+	g_ui32GaugeBenchCalls++;
+	for (int32_t x = i32X1; x <= i32X2; x++)
+		GaugeBench_Write(x, i32Y, ui32Value);
+}
+
+void GaugeBench_LineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2, uint32_t ui32Value) {
+	g_ui32GaugeBenchCalls++;
+	for (int32_t y = i32Y1; y <= i32Y2; y++)
+		GaugeBench_Write(i32X, y, ui32Value);
+}
+
+void GaugeBench_RectFill(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value) {
+	g_ui32GaugeBenchCalls++;
+	for (int32_t y = psRect->i16YMin; y <= psRect->i16YMax; y++) {
+		for (int32_t x = psRect->i16XMin; x <= psRect->i16XMax; x++)
+			GaugeBench_Write(x, y, ui32Value);
+	}
+}
+
+uint32_t GaugeBench_ColorTranslate(void *pvDisplayData, uint32_t ui32Value) {
+	return ui32Value;
+}
+
+void GaugeBench_Flush(void *pvDisplayData) {
+}
+
+const tDisplay g_sGaugeBenchDisplay = {
+	sizeof(tDisplay),
+	NULL,
+	GAUGE_BENCH_WIDTH,
+	GAUGE_BENCH_HEIGHT,
+	GaugeBench_PixelDraw,
+	GaugeBench_PixelDrawMultiple,
+	GaugeBench_LineDrawH,
+	GaugeBench_LineDrawV,
+	GaugeBench_RectFill,
+	GaugeBench_ColorTranslate,
+	GaugeBench_Flush,
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void GaugeBench_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8GaugeBenchFailures++;
+}
+
+/**
+ * @brief Creates the gauge used on the main panel
+ *
+ * @return The gauge
+ */
+tGauge GaugeBench_Gauge() {
+	tGauge sGauge = Gauge(262, 140, 33, 10, 0, GAUGE_BENCH_MAX_SPEED, GAUGE_BENCH_BACKGROUND, GAUGE_BENCH_BACKGROUND,
+						  ClrWhite, ClrRed);
+	return sGauge;
+}
+
+/**
+ * @brief Clears the framebuffer and the counts
+ *
+ */
+void GaugeBench_Clear() {
+	for (int32_t y = 0; y < GAUGE_BENCH_HEIGHT; y++) {
+		for (int32_t x = 0; x < GAUGE_BENCH_WIDTH; x++)
+			g_pui32GaugeBenchFrame[y][x] = GAUGE_BENCH_BACKGROUND;
+	}
+	g_ui32GaugeBenchCalls = 0;
+	g_ui32GaugeBenchPixels = 0;
+}
+
+/**
+ * @brief Draws a gauge from scratch on a cleared display into the reference frame
+ *
+ * @param i32Value The value to show
+ */
+void GaugeBench_Reference(int32_t i32Value) {
+	static tGauge sGauge;
+	tContext sContext;
+
+	sGauge = GaugeBench_Gauge();
+	GaugeBench_Clear();
+	GrContextInit(&sContext, &g_sGaugeBenchDisplay);
+	Gauge_Draw(&sGauge, &sContext, i32Value);
+	memcpy(g_pui32GaugeBenchReference, g_pui32GaugeBenchFrame, sizeof(g_pui32GaugeBenchReference));
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @return 0 if every check passed
+ */
+int main(void) {
+	static tGauge sGauge;
+	static int32_t pi32Values[GAUGE_BENCH_UPDATES];
+	static uint32_t pui32Frame[GAUGE_BENCH_HEIGHT][GAUGE_BENCH_WIDTH];
+	tContext sContext;
+	uint32_t ui32Mismatches = 0;
+	uint32_t ui32MaxPixels = 0, ui32TotalPixels = 0, ui32TotalCalls = 0;
+
+	/* Small steps like a motor speeding up, with a few jumps across the scale */
+	srand(1);
+	int32_t i32Value = 0;
+	for (int i = 0; i < GAUGE_BENCH_UPDATES; i++) {
+		i32Value += (i % 200 == 199) ? rand() % GAUGE_BENCH_MAX_SPEED - GAUGE_BENCH_MAX_SPEED / 2 : rand() % 7 - 3;
+		if (i32Value < -10)
+			i32Value = -10;
+		if (i32Value > GAUGE_BENCH_MAX_SPEED + 10)
+			i32Value = GAUGE_BENCH_MAX_SPEED + 10;
+		pi32Values[i] = i32Value;
+	}
+
+	/* Full draw cost */
+	GaugeBench_Reference(0);
+	uint32_t ui32FullPixels = g_ui32GaugeBenchPixels;
+	uint32_t ui32FullCalls = g_ui32GaugeBenchCalls;
+
+	/* Render check, the incremental frame must match a fresh drawing */
+	sGauge = GaugeBench_Gauge();
+	GaugeBench_Clear();
+	GrContextInit(&sContext, &g_sGaugeBenchDisplay);
+	Gauge_Draw(&sGauge, &sContext, 0);
+	for (int i = 0; i < GAUGE_BENCH_UPDATES; i++) {
+		g_ui32GaugeBenchCalls = 0;
+		g_ui32GaugeBenchPixels = 0;
+		Gauge_Draw(&sGauge, &sContext, pi32Values[i]);
+
+		ui32TotalPixels += g_ui32GaugeBenchPixels;
+		ui32TotalCalls += g_ui32GaugeBenchCalls;
+		if (g_ui32GaugeBenchPixels > ui32MaxPixels)
+			ui32MaxPixels = g_ui32GaugeBenchPixels;
+
+		memcpy(pui32Frame, g_pui32GaugeBenchFrame, sizeof(pui32Frame));
+		GaugeBench_Reference(pi32Values[i]);
+		if (memcmp(pui32Frame, g_pui32GaugeBenchReference, sizeof(pui32Frame)) != 0)
+			ui32Mismatches++;
+		memcpy(g_pui32GaugeBenchFrame, pui32Frame, sizeof(pui32Frame));
+	}
+
+	/* Time the updates alone */
+	sGauge = GaugeBench_Gauge();
+	Gauge_Draw(&sGauge, &sContext, 0);
+	clock_t sStart = clock();
+	for (int i = 0; i < GAUGE_BENCH_UPDATES; i++)
+		Gauge_Draw(&sGauge, &sContext, pi32Values[i]);
+	double dSeconds = (double)(clock() - sStart) / CLOCKS_PER_SEC;
+
+	printf("full draw: %u pixels in %u primitives, face %u runs\n", ui32FullPixels, ui32FullCalls, sGauge.ui16Runs);
+	printf("update: %.1f pixels in %.1f primitives on average, %u pixels at most\n",
+		   (double)ui32TotalPixels / GAUGE_BENCH_UPDATES, (double)ui32TotalCalls / GAUGE_BENCH_UPDATES, ui32MaxPixels);
+	printf("update: %.2f us on the host\n", dSeconds * 1e6 / GAUGE_BENCH_UPDATES);
+	GaugeBench_Check("render", ui32Mismatches == 0, "%u of %d updates differ from a fresh drawing", ui32Mismatches,
+					 GAUGE_BENCH_UPDATES);
+	GaugeBench_Check("update cost", ui32MaxPixels < ui32FullPixels, "%.1f pixels on average, %u at most, %u for a full draw",
+					 (double)ui32TotalPixels / GAUGE_BENCH_UPDATES, ui32MaxPixels, ui32FullPixels);
+	printf("%s: %u check(s) failed\n", g_ui8GaugeBenchFailures == 0 ? "PASS" : "FAIL", g_ui8GaugeBenchFailures);
+	return g_ui8GaugeBenchFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file gptm.c
+ * @brief Host emulation of the general-purpose timers behind the timer driverlib calls
+ */
+#pragma region Includes
+#include "gptm.h"
+#include "sim.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* TivaWare header files */
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define GPTM_PIOSC_FREQ 16000000
+#define GPTM_HALF_A 0
+#define GPTM_HALF_B 1
+#define GPTM_HALF_FLAGS(half) ((half) == GPTM_HALF_A ? 0x00FF : 0xFF00)
+
+/**
+ * @brief Modes of a timer half
+ *
+ */
+typedef enum tGPTMMode {
+	GPTM_MODE_PERIODIC,
+	GPTM_MODE_CAPTURE,
+} tGPTMMode;
+
+/**
+ * @brief One half of a timer, or the whole timer in full-width periodic mode
+ *
+ */
+typedef struct tGPTMHalf {
+	uint32_t ui32IntNum;
+	tGPTMMode eMode;
+	uint32_t ui32Load;
+	uint32_t ui32Prescale;
+	uint64_t ui64Origin;
+	uint32_t ui32Captured;
+	uint32_t ui32Timeouts;
+	bool bCreated;
+	uint8_t ui8Timer;
+} tGPTMHalf;
+
+/**
+ * @brief A timer and the simulated timer behind it
+ *
+ */
+typedef struct tGPTM {
+	uint32_t ui32Base;
+	bool bPIOSC;
+	uint32_t ui32IntMask;
+	uint32_t ui32IntStatus;
+	tGPTMHalf psHalves[2];
+} tGPTM;
+
+/* Global variables */
+tGPTM g_psGPTM[GPTM_COUNT] = {
+	{TIMER0_BASE, .psHalves = {{INT_TIMER0A}, {INT_TIMER0B}}}, {TIMER1_BASE, .psHalves = {{INT_TIMER1A}, {INT_TIMER1B}}},
+	{TIMER2_BASE, .psHalves = {{INT_TIMER2A}, {INT_TIMER2B}}}, {TIMER3_BASE, .psHalves = {{INT_TIMER3A}, {INT_TIMER3B}}},
+	{TIMER4_BASE, .psHalves = {{INT_TIMER4A}, {INT_TIMER4B}}}, {TIMER5_BASE, .psHalves = {{INT_TIMER5A}, {INT_TIMER5B}}},
+	{TIMER6_BASE, .psHalves = {{INT_TIMER6A}, {INT_TIMER6B}}}, {TIMER7_BASE, .psHalves = {{INT_TIMER7A}, {INT_TIMER7B}}},
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Finds the timer at a base address
+ *
+ * @param ui32Base The base address
+ * @return The timer, the program exits on an unknown address
+ */
+tGPTM *GPTM_Find(uint32_t ui32Base) {
+	for (uint8_t i = 0; i < GPTM_COUNT; i++) {
+		if (g_psGPTM[i].ui32Base == ui32Base)
+			return &g_psGPTM[i];
+	}
+
+	fprintf(stderr, "gptm: unknown timer 0x%08x\n", ui32Base);
+	exit(1);
+}
+
+/**
+ * @brief Sets the interrupt flags of a timer and raises the interrupts they enable
+ *
+ * @param psGPTM The timer
+ * @param ui32Flags The TIMER_TIMx_TIMEOUT and TIMER_CAPx_EVENT flags to set
+ *
+ * @note Must be called from interrupt context
+ */
+void GPTM_Raise(tGPTM *psGPTM, uint32_t ui32Flags) {
+	psGPTM->ui32IntStatus |= ui32Flags;
+	for (uint8_t i = GPTM_HALF_A; i <= GPTM_HALF_B; i++) {
+		if (ui32Flags & psGPTM->ui32IntMask & GPTM_HALF_FLAGS(i))
+			Sim_Interrupt(psGPTM->psHalves[i].ui32IntNum);
+	}
+}
+
+/**
+ * @brief Times out a timer in periodic mode
+ *
+ * @param arg The timer
+ *
+ * @note Called from interrupt context every load + 1 cycles while the timer is enabled
+ */
+void GPTM_Timeout(uintptr_t arg) {
+	tGPTM *psGPTM = (tGPTM *)arg;
+	psGPTM->psHalves[GPTM_HALF_A].ui32Timeouts++;
+	GPTM_Raise(psGPTM, TIMER_TIMA_TIMEOUT);
+}
+
+/**
+ * @brief Reads the counter of a timer half in capture mode
+ *
+ * @param psGPTM The timer
+ * @param psHalf The half
+ * @return The count, wrapped at the load and prescale values
+ */
+uint32_t GPTM_Count(tGPTM *psGPTM, tGPTMHalf *psHalf) {
+	uint64_t ui64Range = (uint64_t)(psHalf->ui32Load | psHalf->ui32Prescale << 16) + 1;
+	uint64_t ui64Elapsed = Sim_Now() - psHalf->ui64Origin;
+	if (psGPTM->bPIOSC)
+		ui64Elapsed = ui64Elapsed * GPTM_PIOSC_FREQ / SIM_CPU_FREQ;
+	return (uint32_t)(ui64Elapsed % ui64Range);
+}
+#pragma endregion
+
+#pragma region GPTM API functions
+uint32_t GPTM_GetTimeouts(uint32_t ui32Base) {
+	return GPTM_Find(ui32Base)->psHalves[GPTM_HALF_A].ui32Timeouts;
+}
+
+void GPTM_CaptureEdge(uint32_t ui32Base, uint32_t ui32Timer) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	uint8_t ui8Half = ui32Timer == TIMER_B ? GPTM_HALF_B : GPTM_HALF_A;
+	tGPTMHalf *psHalf = &psGPTM->psHalves[ui8Half];
+	if (psHalf->eMode != GPTM_MODE_CAPTURE)
+		return;
+
+	psHalf->ui32Captured = GPTM_Count(psGPTM, psHalf);
+	GPTM_Raise(psGPTM, ui8Half == GPTM_HALF_B ? TIMER_CAPB_EVENT : TIMER_CAPA_EVENT);
+}
+#pragma endregion
+
+#pragma region Driverlib functions
+/* Clock gating has no effect on the host */
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {
+}
+
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) {
+	return true;
+}
+
+void TimerClockSourceSet(uint32_t ui32Base, uint32_t ui32Source) {
+	GPTM_Find(ui32Base)->bPIOSC = ui32Source == TIMER_CLOCK_PIOSC;
+}
+
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	if (ui32Config == TIMER_CFG_PERIODIC) {
+		if (psGPTM->bPIOSC) {
+			fprintf(stderr, "gptm: periodic timers must count the system clock\n");
+			exit(1);
+		}
+		psGPTM->psHalves[GPTM_HALF_A].eMode = GPTM_MODE_PERIODIC;
+		return;
+	}
+
+	/* Split timers are only emulated in edge-time capture mode counting up */
+	uint32_t ui32A = ui32Config & 0xFF;
+	uint32_t ui32B = ui32Config & 0xFF00;
+	if (!(ui32Config & TIMER_CFG_SPLIT_PAIR) || (ui32A != 0 && ui32A != TIMER_CFG_A_CAP_TIME_UP) ||
+		(ui32B != 0 && ui32B != TIMER_CFG_B_CAP_TIME_UP)) {
+		fprintf(stderr, "gptm: unsupported configuration 0x%08x\n", ui32Config);
+		exit(1);
+	}
+	psGPTM->psHalves[GPTM_HALF_A].eMode = ui32A != 0 ? GPTM_MODE_CAPTURE : GPTM_MODE_PERIODIC;
+	psGPTM->psHalves[GPTM_HALF_B].eMode = ui32B != 0 ? GPTM_MODE_CAPTURE : GPTM_MODE_PERIODIC;
+}
+
+void TimerControlEvent(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Event) {
+	/* Edges are only raised by GPTM_CaptureEdge, which decides which edges exist */
+}
+
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	if (ui32Timer & TIMER_A)
+		psGPTM->psHalves[GPTM_HALF_A].ui32Load = ui32Value;
+	if (ui32Timer & TIMER_B)
+		psGPTM->psHalves[GPTM_HALF_B].ui32Load = ui32Value;
+}
+
+void TimerPrescaleSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	if (ui32Timer & TIMER_A)
+		psGPTM->psHalves[GPTM_HALF_A].ui32Prescale = ui32Value;
+	if (ui32Timer & TIMER_B)
+		psGPTM->psHalves[GPTM_HALF_B].ui32Prescale = ui32Value;
+}
+
+uint32_t TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	tGPTMHalf *psHalf = &psGPTM->psHalves[ui32Timer == TIMER_B ? GPTM_HALF_B : GPTM_HALF_A];
+	return psHalf->eMode == GPTM_MODE_CAPTURE ? psHalf->ui32Captured : 0;
+}
+
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+	GPTM_Find(ui32Base)->ui32IntMask |= ui32IntFlags;
+}
+
+void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags) {
+	GPTM_Find(ui32Base)->ui32IntMask &= ~ui32IntFlags;
+}
+
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags) {
+	GPTM_Find(ui32Base)->ui32IntStatus &= ~ui32IntFlags;
+}
+
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	return bMasked ? psGPTM->ui32IntStatus & psGPTM->ui32IntMask : psGPTM->ui32IntStatus;
+}
+
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer) {
+	tGPTM *psGPTM = GPTM_Find(ui32Base);
+	for (uint8_t i = GPTM_HALF_A; i <= GPTM_HALF_B; i++) {
+		tGPTMHalf *psHalf = &psGPTM->psHalves[i];
+		if (!(ui32Timer & GPTM_HALF_FLAGS(i)))
+			continue;
+
+		psHalf->ui32Timeouts = 0;
+		psHalf->ui64Origin = Sim_Now();
+		if (psHalf->eMode != GPTM_MODE_PERIODIC || i != GPTM_HALF_A)
+			continue;
+
+		if (!psHalf->bCreated) {
+			psHalf->ui8Timer = Sim_TimerCreate(GPTM_Timeout, (uintptr_t)psGPTM);
+			psHalf->bCreated = true;
+		}
+		uint64_t ui64Period = (uint64_t)psHalf->ui32Load + 1;
+		Sim_TimerStart(psHalf->ui8Timer, Sim_Now() + ui64Period, ui64Period);
+	}
+}
+
+void TimerSynchronize(uint32_t ui32Base, uint32_t ui32Timers) {
+	/* Two bits per timer, A then B */
+	for (uint8_t i = 0; i < GPTM_COUNT; i++) {
+		for (uint8_t j = GPTM_HALF_A; j <= GPTM_HALF_B; j++) {
+			if (ui32Timers & (1 << (i * 2 + j)))
+				g_psGPTM[i].psHalves[j].ui64Origin = Sim_Now();
+		}
+	}
+}
+#pragma endregion
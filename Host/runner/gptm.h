@@ -0,0 +1,32 @@
+/**
+ * @file gptm.h
+ * @brief Host emulation of the general-purpose timers behind the timer driverlib calls
+ *
+ * Full-width periodic timers counting the system clock, and split timers capturing edge times
+ * counting up from either clock, are emulated, which is how the application uses them. A timeout
+ * or a captured edge raises the interrupt of the timer half when it is enabled.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define GPTM_COUNT 8
+
+/**
+ * @brief Gets the number of times a timer has timed out
+ *
+ * @param ui32Base The base address of the timer
+ * @return The number of timeouts since the timer was enabled
+ */
+uint32_t GPTM_GetTimeouts(uint32_t ui32Base);
+
+/**
+ * @brief Captures an edge on the input of a timer half in edge-time mode
+ *
+ * @param ui32Base The base address of the timer
+ * @param ui32Timer TIMER_A or TIMER_B
+ *
+ * @note Must be called from a timer function, like an interrupt. Halves in other modes ignore the edge
+ */
+void GPTM_CaptureEdge(uint32_t ui32Base, uint32_t ui32Timer);
@@ -0,0 +1,568 @@
+/**
+ * @file gui_runner.c
+ * @brief Headless host runner for the GUI, plays a scripted scenario and reports every frame
+ *
+ * gui.c, util.c and main.c run unchanged on the TivaWare graphics library and the target
+ * display driver. SYS/BIOS, the SSI bus, the display controller and the touch screen are
+ * simulated (see sim.h, ssd2119.h and devices.h). The motor controller drives the simulated
+ * motor, which feeds the power and acceleration readings back (see plant.h), and the light sensor
+ * sits on the emulated I2C bus at a steady light level (see lightsensor.h). Only the display
+ * bus spends simulated time, so a frame takes as long as its SPI traffic would on the target
+ * and the results do not depend on the host.
+ *
+ * Scenario commands, one per line, everything after a '#' is a comment:
+ *   wait <ms>           let time pass
+ *   tap <x> <y>         press for RUNNER_TAP_TIME, then release
+ *   hold <x> <y> <ms>   press for a time, then release
+ *   estop <0|1>         press or release the e-stop button
+ *   repaint             repaint the whole screen, as a panel switch did before panel transitions
+ *   dump <file>         write the screen as a PPM image, once the frame being painted is finished
+ *   mark <text>         write a marker line into the frame report
+ *   latency             check at the end that taps landed during a root repaint and a plot redraw, and
+ *                       that no tap waited longer than the render task takes to paint one chunk of the plot
+ *   invalidate <r> ...  mark the GUI_REGION_x regions of gui.c dirty together
+ *   budget <us>         set the frame budget of the render task
+ *   painted <r> ...     check that the first frame after the last invalidate or budget step was dirty in
+ *                       every region given, and painted them all
+ *   deferred <r> ...    check that the first frame after the last invalidate or budget step was dirty in
+ *                       every region given, and left them dirty for a later frame
+ *
+ * Writes frames.csv with one line per frame to the output directory, and a summary to stdout. Exits
+ * with 1 if a check failed, or if main.c claimed a pin for two uses (see pins.h).
+ *
+ * Build and run from this directory with the Makefile, against the TivaWare subset in ../tivaware
+ * or the install given by TIVAWARE:
+ *   make demo
+ *   ./gui_runner <scenario> [<output directory>]
+ */
+#pragma region Includes
+#include "sim.h"
+#include "ssd2119.h"
+#include "pins.h"
+#include "devices.h"
+#include "plant.h"
+#include "lightsensor.h"
+#include "gui.h"
+#include "Board.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+#include <xdc/runtime/Timestamp.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* The application entry point, renamed on the command line */
+#undef main
+int App_Main(void);
+
+/* Global defines */
+#define RUNNER_MAX_STEPS 512
+#define RUNNER_MAX_DUMPS 8
+#define RUNNER_TEXT_LENGTH 64
+#define RUNNER_TAP_TIME 100		// ms
+#define RUNNER_SETTLE_TIME 500	// ms, after the last step
+#define RUNNER_LIGHT 35			// lux
+#define RUNNER_REGION_ROOT 0	// GUI_REGION_ROOT of gui.c
+#define RUNNER_REGION_PLOT 8	// GUI_REGION_GRAPH_CONTENT of gui.c
+#define RUNNER_REGION_COUNT 16	// GUI_REGION_COUNT of gui.c
+
+/**
+ * @brief Scenario commands
+ *
+ */
+typedef enum tRunnerCommand {
+	RUNNER_WAIT,
+	RUNNER_TAP,
+	RUNNER_HOLD,
+	RUNNER_ESTOP,
+	RUNNER_REPAINT,
+	RUNNER_DUMP,
+	RUNNER_MARK,
+	RUNNER_LATENCY,
+	RUNNER_INVALIDATE,
+	RUNNER_BUDGET,
+	RUNNER_PAINTED,
+	RUNNER_DEFERRED,
+} tRunnerCommand;
+
+/**
+ * @brief A step of the scenario
+ *
+ */
+typedef struct tRunnerStep {
+	tRunnerCommand eCommand;
+	int32_t i32X;
+	int32_t i32Y;
+	uint32_t ui32Time;
+	uint32_t ui32Regions;
+	char pcText[RUNNER_TEXT_LENGTH];
+} tRunnerStep;
+
+/**
+ * @brief Bus and time use of the frame being painted
+ *
+ */
+typedef struct tRunnerFrame {
+	uint64_t ui64Start;
+	uint32_t ui32Dirty;
+	uint32_t ui32Bytes;
+	uint32_t ui32Transactions;
+	tSSD2119Stats sBus;
+} tRunnerFrame;
+
+/* Display driver bus counters */
+extern uint32_t g_ui32SSD2119SPIBytes;
+extern uint32_t g_ui32SSD2119SPITransactions;
+
+/* GUI state inspected for the report */
+extern uint32_t g_ui32DirtyRegions;
+extern uint32_t g_ui32FrameBudget;
+extern uint32_t g_ui32TapStamp;
+extern int32_t g_i32GraphPainted;
+
+/* GUI internals driven by the scenario */
+void GUI_Invalidate(uint8_t ui8Region);
+
+/* Global variables */
+tRunnerStep g_psRunnerSteps[RUNNER_MAX_STEPS];
+uint16_t g_ui16RunnerSteps = 0;
+uint16_t g_ui16RunnerStep = 0;
+uint8_t g_ui8RunnerScript;
+bool g_bRunnerHolding = false;
+const char *g_pcRunnerOutput = ".";
+const char *g_ppcRunnerDumps[RUNNER_MAX_DUMPS];
+uint8_t g_ui8RunnerDumps = 0;
+FILE *g_psRunnerReport = NULL;
+bool g_bRunnerInFrame = false;
+tRunnerFrame g_sRunnerFrame;
+tGUIFrameStats g_sRunnerStats;
+uint32_t g_ui32RunnerFrames = 0;
+uint64_t g_ui64RunnerWorstSpan = 0;
+uint64_t g_ui64RunnerBusCycles = 0;
+uint64_t g_ui64RunnerHold = 0;		 // When the render task last took the GUI gate
+uint64_t g_ui64RunnerStart = 0;		 // The time BIOS_start ran the first task
+uint64_t g_ui64RunnerWorstHold = 0;	 // The longest the render task kept the gate
+uint64_t g_ui64RunnerChunk = 0;		 // The longest it kept the gate while drawing columns of the plot
+int32_t g_i32RunnerPainted = 0;		 // The last plot column drawn when the render task took the gate
+uint32_t g_ui32RunnerRootTaps = 0;	 // Taps dispatched in the middle of a root repaint
+uint32_t g_ui32RunnerPlotTaps = 0;	 // Taps dispatched in the middle of a plot redraw
+bool g_bRunnerCheckLatency = false;
+bool g_bRunnerPass = true;				 // False once the check of a step failed
+uint32_t g_ui32RunnerSince = 0;			 // Frames painted since the last invalidate or budget step
+uint32_t g_ui32RunnerCommitDirty = 0;	 // The regions dirty when the first of them started
+uint32_t g_ui32RunnerCommitLeft = 0;	 // The regions it left dirty
+uint32_t g_ui32RunnerCommitDeferred = 0; // The regions it deferred
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Converts simulated CPU cycles to microseconds
+ *
+ * @param ui64Cycles The cycles
+ * @return The time (us)
+ */
+double Runner_Us(uint64_t ui64Cycles) {
+	return (double)ui64Cycles * 1e6 / SIM_CPU_FREQ;
+}
+
+/**
+ * @brief Reads a list of regions
+ *
+ * @param pcArgs The region numbers, separated by spaces
+ * @param pui32Regions Set to the regions, one bit per region
+ * @return True if there was at least one region and every one is a GUI_REGION_x
+ */
+bool Runner_Regions(const char *pcArgs, uint32_t *pui32Regions) {
+	int iRegion, iOffset;
+	*pui32Regions = 0;
+	while (sscanf(pcArgs, "%d %n", &iRegion, &iOffset) == 1) {
+		if (iRegion < 0 || iRegion >= RUNNER_REGION_COUNT)
+			return false;
+		*pui32Regions |= 1 << iRegion;
+		pcArgs += iOffset;
+	}
+
+	return *pui32Regions != 0 && *pcArgs == '\0';
+}
+
+/**
+ * @brief Reads a scenario file
+ *
+ * @param pcPath The file to read
+ * @return True if every line was understood
+ */
+bool Runner_Load(const char *pcPath) {
+	FILE *psFile = fopen(pcPath, "r");
+	if (psFile == NULL) {
+		fprintf(stderr, "%s: cannot open\n", pcPath);
+		return false;
+	}
+
+	char pcLine[256];
+	for (uint32_t ui32Line = 1; fgets(pcLine, sizeof(pcLine), psFile) != NULL; ui32Line++) {
+		char *pcComment = strchr(pcLine, '#');
+		if (pcComment != NULL)
+			*pcComment = '\0';
+
+		char pcCommand[16];
+		int iOffset = 0;
+		if (sscanf(pcLine, "%15s %n", pcCommand, &iOffset) != 1)
+			continue;
+
+		if (g_ui16RunnerSteps == RUNNER_MAX_STEPS) {
+			fprintf(stderr, "%s:%u: more than %d steps\n", pcPath, ui32Line, RUNNER_MAX_STEPS);
+			fclose(psFile);
+			return false;
+		}
+
+		tRunnerStep *psStep = &g_psRunnerSteps[g_ui16RunnerSteps];
+		const char *pcArgs = pcLine + iOffset;
+		bool bValid;
+		memset(psStep, 0, sizeof(*psStep));
+		if (strcmp(pcCommand, "wait") == 0) {
+			psStep->eCommand = RUNNER_WAIT;
+			bValid = sscanf(pcArgs, "%u", &psStep->ui32Time) == 1;
+		} else if (strcmp(pcCommand, "tap") == 0) {
+			psStep->eCommand = RUNNER_TAP;
+			psStep->ui32Time = RUNNER_TAP_TIME;
+			bValid = sscanf(pcArgs, "%d %d", &psStep->i32X, &psStep->i32Y) == 2;
+		} else if (strcmp(pcCommand, "hold") == 0) {
+			psStep->eCommand = RUNNER_HOLD;
+			bValid = sscanf(pcArgs, "%d %d %u", &psStep->i32X, &psStep->i32Y, &psStep->ui32Time) == 3;
+		} else if (strcmp(pcCommand, "estop") == 0) {
+			psStep->eCommand = RUNNER_ESTOP;
+			bValid = sscanf(pcArgs, "%d", &psStep->i32X) == 1;
+		} else if (strcmp(pcCommand, "repaint") == 0) {
+			psStep->eCommand = RUNNER_REPAINT;
+			bValid = true;
+		} else if (strcmp(pcCommand, "dump") == 0) {
+			psStep->eCommand = RUNNER_DUMP;
+			bValid = sscanf(pcArgs, "%63s", psStep->pcText) == 1;
+		} else if (strcmp(pcCommand, "mark") == 0) {
+			psStep->eCommand = RUNNER_MARK;
+			bValid = sscanf(pcArgs, "%63[^\n]", psStep->pcText) == 1;
+		} else if (strcmp(pcCommand, "latency") == 0) {
+			psStep->eCommand = RUNNER_LATENCY;
+			bValid = true;
+		} else if (strcmp(pcCommand, "invalidate") == 0) {
+			psStep->eCommand = RUNNER_INVALIDATE;
+			bValid = Runner_Regions(pcArgs, &psStep->ui32Regions);
+		} else if (strcmp(pcCommand, "budget") == 0) {
+			psStep->eCommand = RUNNER_BUDGET;
+			bValid = sscanf(pcArgs, "%u", &psStep->ui32Time) == 1;
+		} else if (strcmp(pcCommand, "painted") == 0) {
+			psStep->eCommand = RUNNER_PAINTED;
+			bValid = Runner_Regions(pcArgs, &psStep->ui32Regions);
+		} else if (strcmp(pcCommand, "deferred") == 0) {
+			psStep->eCommand = RUNNER_DEFERRED;
+			bValid = Runner_Regions(pcArgs, &psStep->ui32Regions);
+		} else {
+			bValid = false;
+		}
+
+		if (!bValid) {
+			fprintf(stderr, "%s:%u: cannot parse '%s'\n", pcPath, ui32Line, pcCommand);
+			fclose(psFile);
+			return false;
+		}
+		g_ui16RunnerSteps++;
+	}
+
+	fclose(psFile);
+	return true;
+}
+
+/**
+ * @brief Writes the frames waiting to be dumped
+ *
+ */
+void Runner_Dump() {
+	for (uint8_t i = 0; i < g_ui8RunnerDumps; i++) {
+		char pcPath[512];
+		snprintf(pcPath, sizeof(pcPath), "%s/%s", g_pcRunnerOutput, g_ppcRunnerDumps[i]);
+		if (!SSD2119_WritePPM(pcPath))
+			fprintf(stderr, "%s: cannot write\n", pcPath);
+	}
+	g_ui8RunnerDumps = 0;
+}
+
+/**
+ * @brief Ends the simulation
+ *
+ * @param arg Unused
+ */
+void Runner_Stop(uintptr_t arg) {
+	Sim_Stop();
+}
+
+/**
+ * @brief Prints the result of a check
+ *
+ * @param pcName The name of the check
+ * @param bPass True if the check passed
+ * @param pcFormat The format of the details, followed by its arguments
+ * @return True if the check passed
+ */
+bool Runner_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	return bPass;
+}
+
+/**
+ * @brief Runs the scenario up to the next step that takes time
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context
+ */
+void Runner_Script(uintptr_t arg) {
+	if (g_bRunnerHolding) {
+		Devices_TouchRelease();
+		g_bRunnerHolding = false;
+	}
+
+	while (g_ui16RunnerStep < g_ui16RunnerSteps) {
+		const tRunnerStep *psStep = &g_psRunnerSteps[g_ui16RunnerStep++];
+		switch (psStep->eCommand) {
+		case RUNNER_WAIT:
+			Sim_TimerStart(g_ui8RunnerScript, Sim_Now() + SIM_CYCLES_MS(psStep->ui32Time), 0);
+			return;
+		case RUNNER_TAP:
+		case RUNNER_HOLD:
+			Devices_TouchPress(psStep->i32X, psStep->i32Y);
+			g_bRunnerHolding = true;
+			Sim_TimerStart(g_ui8RunnerScript, Sim_Now() + SIM_CYCLES_MS(psStep->ui32Time), 0);
+			return;
+		case RUNNER_ESTOP:
+			/* The button pulls the input low */
+			Devices_SetPin(Board_ESTOP, psStep->i32X == 0);
+			break;
+		case RUNNER_REPAINT:
+			/* Cancels a frame being painted, so it is best given once the screen has settled */
+			GUI_Invalidate(RUNNER_REGION_ROOT);
+			break;
+		case RUNNER_DUMP:
+			/* A frame being painted is dumped once it is finished */
+			if (g_ui8RunnerDumps < RUNNER_MAX_DUMPS)
+				g_ppcRunnerDumps[g_ui8RunnerDumps++] = psStep->pcText;
+			if (!g_bRunnerInFrame)
+				Runner_Dump();
+			break;
+		case RUNNER_MARK:
+			fprintf(g_psRunnerReport, "# %.3f ms: %s\n", Runner_Us(Sim_Now()) / 1000, psStep->pcText);
+			break;
+		case RUNNER_LATENCY:
+			g_bRunnerCheckLatency = true;
+			break;
+		case RUNNER_INVALIDATE:
+			/* Several regions invalidated at once must be painted by one commit */
+			for (uint8_t i = 0; i < RUNNER_REGION_COUNT; i++) {
+				if (psStep->ui32Regions & (1 << i))
+					GUI_Invalidate(i);
+			}
+			g_ui32RunnerSince = 0;
+			break;
+		case RUNNER_BUDGET:
+			g_ui32FrameBudget = SIM_CYCLES_US(psStep->ui32Time);
+			g_ui32RunnerSince = 0;
+			break;
+		case RUNNER_PAINTED:
+			g_bRunnerPass &= Runner_Check("painted in one commit",
+										  g_ui32RunnerSince > 0 &&
+											  (g_ui32RunnerCommitDirty & psStep->ui32Regions) == psStep->ui32Regions &&
+											  (g_ui32RunnerCommitLeft & psStep->ui32Regions) == 0,
+										  "regions 0x%04x, frame dirty 0x%04x, left 0x%04x", psStep->ui32Regions,
+										  g_ui32RunnerCommitDirty, g_ui32RunnerCommitLeft);
+			break;
+		case RUNNER_DEFERRED:
+			g_bRunnerPass &= Runner_Check("deferred by the budget",
+										  g_ui32RunnerSince > 0 &&
+											  (g_ui32RunnerCommitDirty & psStep->ui32Regions) == psStep->ui32Regions &&
+											  (g_ui32RunnerCommitLeft & psStep->ui32Regions) == psStep->ui32Regions &&
+											  g_ui32RunnerCommitDeferred >= (uint32_t)__builtin_popcount(psStep->ui32Regions),
+										  "regions 0x%04x, frame dirty 0x%04x, left 0x%04x, %u deferred",
+										  psStep->ui32Regions, g_ui32RunnerCommitDirty, g_ui32RunnerCommitLeft,
+										  g_ui32RunnerCommitDeferred);
+			break;
+		}
+	}
+
+	/* Let the last frames settle before stopping */
+	uint8_t ui8Stop = Sim_TimerCreate(Runner_Stop, 0);
+	Sim_TimerStart(ui8Stop, Sim_Now() + SIM_CYCLES_MS(RUNNER_SETTLE_TIME), 0);
+}
+
+/**
+ * @brief Starts the simulated devices and the scenario once the application has created its clocks
+ *
+ */
+void Runner_Start() {
+	g_ui64RunnerStart = Sim_Now();
+	Devices_Start();
+	Plant_Start(NULL, 0);
+	LightSensor_Start();
+	LightSensor_SetLux(RUNNER_LIGHT);
+
+	g_ui8RunnerScript = Sim_TimerCreate(Runner_Script, 0);
+	Sim_TimerStart(g_ui8RunnerScript, Sim_Now(), 0);
+}
+
+/**
+ * @brief Tracks the frames painted by the render task
+ *
+ * @param eTrace The kernel event
+ * @param pvTask The function of the task that caused it
+ *
+ * @note A frame starts when the render task takes the GUI gate and ends when it gives it up
+ *		 with the frame statistics changed, the traffic of the input task in between is included
+ */
+void Runner_Trace(tSimTrace eTrace, void *pvTask) {
+	/* A tap taken by the input task while a frame is being painted waited for the render task to yield */
+	if (pvTask == (void *)GUI_Handle && eTrace == SIM_TRACE_GATE_ENTER && g_bRunnerInFrame && g_ui32TapStamp != 0) {
+		if (g_sRunnerFrame.ui32Dirty & (1 << RUNNER_REGION_ROOT))
+			g_ui32RunnerRootTaps++;
+		else if (g_sRunnerFrame.ui32Dirty & (1 << RUNNER_REGION_PLOT))
+			g_ui32RunnerPlotTaps++;
+	}
+	if (pvTask != (void *)GUI_Render)
+		return;
+
+	/* Time every stretch the render task holds the gate for, between the yields */
+	if (eTrace == SIM_TRACE_GATE_ENTER) {
+		g_ui64RunnerHold = Sim_Now();
+		g_i32RunnerPainted = g_i32GraphPainted;
+	} else if (eTrace == SIM_TRACE_GATE_LEAVE) {
+		uint64_t ui64Hold = Sim_Now() - g_ui64RunnerHold;
+		if (ui64Hold > g_ui64RunnerWorstHold)
+			g_ui64RunnerWorstHold = ui64Hold;
+		if (g_i32GraphPainted != g_i32RunnerPainted && ui64Hold > g_ui64RunnerChunk)
+			g_ui64RunnerChunk = ui64Hold;
+	}
+
+	if (eTrace == SIM_TRACE_GATE_ENTER && !g_bRunnerInFrame) {
+		g_bRunnerInFrame = true;
+		g_sRunnerFrame.ui64Start = Sim_Now();
+		g_sRunnerFrame.ui32Dirty = g_ui32DirtyRegions;
+		g_sRunnerFrame.ui32Bytes = g_ui32SSD2119SPIBytes;
+		g_sRunnerFrame.ui32Transactions = g_ui32SSD2119SPITransactions;
+		g_sRunnerFrame.sBus = g_sSSD2119Stats;
+		return;
+	}
+
+	tGUIFrameStats sStats;
+	GUI_GetFrameStats(&sStats);
+	if (eTrace != SIM_TRACE_GATE_LEAVE || !g_bRunnerInFrame ||
+		(sStats.ui32Frames == g_sRunnerStats.ui32Frames && sStats.ui32Cancelled == g_sRunnerStats.ui32Cancelled))
+		return;
+
+	bool bCancelled = sStats.ui32Cancelled != g_sRunnerStats.ui32Cancelled;
+	uint64_t ui64Span = Sim_Now() - g_sRunnerFrame.ui64Start;
+	uint64_t ui64Bus = g_sSSD2119Stats.ui64BusCycles - g_sRunnerFrame.sBus.ui64BusCycles;
+
+	/* Keep what the first frame after an invalidate or budget step painted, for the painted and deferred checks */
+	if (!bCancelled && g_ui32RunnerSince++ == 0) {
+		g_ui32RunnerCommitDirty = g_sRunnerFrame.ui32Dirty;
+		g_ui32RunnerCommitLeft = g_ui32DirtyRegions;
+		g_ui32RunnerCommitDeferred = sStats.ui32Deferred - g_sRunnerStats.ui32Deferred;
+	}
+	g_sRunnerStats = sStats;
+	g_bRunnerInFrame = false;
+
+	fprintf(g_psRunnerReport, "%u,%.3f,%s,0x%04x,%u,%u,%u,%.1f,%.1f\n", g_ui32RunnerFrames,
+			Runner_Us(g_sRunnerFrame.ui64Start) / 1000, bCancelled ? "cancelled" : "done", g_sRunnerFrame.ui32Dirty,
+			g_ui32SSD2119SPIBytes - g_sRunnerFrame.ui32Bytes, g_ui32SSD2119SPITransactions - g_sRunnerFrame.ui32Transactions,
+			g_sSSD2119Stats.ui32Pixels - g_sRunnerFrame.sBus.ui32Pixels, Runner_Us(ui64Bus), Runner_Us(ui64Span));
+
+	g_ui32RunnerFrames++;
+	g_ui64RunnerBusCycles += ui64Bus;
+	if (ui64Span > g_ui64RunnerWorstSpan)
+		g_ui64RunnerWorstSpan = ui64Span;
+	if (!bCancelled)
+		Runner_Dump();
+}
+#pragma endregion
+
+/**
+ * @brief Host runner entry point
+ *
+ * @param argc The number of arguments
+ * @param argv The scenario file and optionally the output directory
+ * @return 0 if the scenario ran and its checks passed
+ */
+int main(int argc, char **argv) {
+	if (argc < 2 || argc > 3) {
+		fprintf(stderr, "usage: %s <scenario> [<output directory>]\n", argv[0]);
+		return 2;
+	}
+	if (argc == 3)
+		g_pcRunnerOutput = argv[2];
+	if (!Runner_Load(argv[1]))
+		return 1;
+
+	mkdir(g_pcRunnerOutput, 0777);
+	char pcPath[512];
+	snprintf(pcPath, sizeof(pcPath), "%s/frames.csv", g_pcRunnerOutput);
+	g_psRunnerReport = fopen(pcPath, "w");
+	if (g_psRunnerReport == NULL) {
+		fprintf(stderr, "%s: cannot write\n", pcPath);
+		return 1;
+	}
+	fprintf(g_psRunnerReport, "frame,start_ms,result,dirty,spi_bytes,spi_transactions,pixels,bus_us,span_us\n");
+
+	/* Run the application until the scenario is over */
+	Sim_SetStartHook(Runner_Start);
+	Sim_SetTraceHook(Runner_Trace);
+	App_Main();
+	fclose(g_psRunnerReport);
+
+	tGUIFrameStats sStats;
+	GUI_GetFrameStats(&sStats);
+	printf("simulated %.1f ms, %u frames (%u cancelled, %u over budget, %u regions deferred)\n",
+		   Runner_Us(Sim_Now()) / 1000, g_ui32RunnerFrames, sStats.ui32Cancelled, sStats.ui32Overruns, sStats.ui32Deferred);
+	printf("bus: %u bytes in %u transactions, %.1f ms busy\n", g_ui32SSD2119SPIBytes, g_ui32SSD2119SPITransactions,
+		   Runner_Us(g_ui64RunnerBusCycles) / 1000);
+	printf("frames: worst %.1f us painting, worst %.1f us with input\n", Runner_Us(sStats.ui32WorstTime),
+		   Runner_Us(g_ui64RunnerWorstSpan));
+	printf("transitions: %u, worst %.1f us\n", sStats.ui32Transitions, Runner_Us(sStats.ui32WorstTransition));
+	printf("taps: %u, worst latency %.1f us, %.1f us during a repaint\n", sStats.ui32Taps,
+		   Runner_Us(sStats.ui32WorstTapLatency), Runner_Us(sStats.ui32WorstRepaintTapLatency));
+	printf("pulses: worst %.1f us to painted\n", Runner_Us(sStats.ui32WorstPulseLatency));
+	printf("render: worst %.1f us holding the gate, %.1f us for a chunk of the plot\n", Runner_Us(g_ui64RunnerWorstHold),
+		   Runner_Us(g_ui64RunnerChunk));
+	uint64_t ui64Run = Sim_Now() - g_ui64RunnerStart;
+	printf("cpu: %.1f ms busy after BIOS_start, %.1f %% idle\n", Runner_Us(Sim_GetBusy()) / 1000,
+		   ui64Run == 0 ? 0.0 : 100.0 * (double)(ui64Run - Sim_GetBusy()) / (double)ui64Run);
+	printf("pins: %u conflict(s) %s\n", Pins_GetConflicts(), Pins_GetFirstConflict());
+	printf("report: %s\n", pcPath);
+	g_bRunnerPass &= Pins_GetConflicts() == 0;
+	if (!g_bRunnerCheckLatency)
+		return g_bRunnerPass ? 0 : 1;
+
+	/* A tap waits for at most one stretch of painting, which is never longer than a chunk of the plot */
+	bool bPass = g_bRunnerPass;
+	bPass &= Runner_Check("taps during a root repaint", g_ui32RunnerRootTaps > 0, "%u", g_ui32RunnerRootTaps);
+	bPass &= Runner_Check("taps during a plot redraw", g_ui32RunnerPlotTaps > 0, "%u", g_ui32RunnerPlotTaps);
+	bPass &= Runner_Check("tap latency", g_ui64RunnerChunk > 0 && sStats.ui32WorstTapLatency <= g_ui64RunnerChunk,
+						  "worst %.1f us, a chunk of the plot %.1f us", Runner_Us(sStats.ui32WorstTapLatency),
+						  Runner_Us(g_ui64RunnerChunk));
+	bPass &= Runner_Check("render gate hold", g_ui64RunnerWorstHold <= g_ui64RunnerChunk, "worst %.1f us",
+						  Runner_Us(g_ui64RunnerWorstHold));
+	return bPass ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+/**
+ * @file hall_edges.c
+ * @brief Host check of the Hall sensor speed estimator against synthetic edge streams
+ *
+ * hall.c runs unchanged on the emulated capture timers (see gptm.h). A speed profile is turned into
+ * the edges of three Hall sensors, with the sensors placed a few degrees off and the magnet poles
+ * not quite even, like on a real motor. The speed published on the data bus is compared with the
+ * profile once per millisecond:
+ *   0 ms      3000 RPM                high speed accuracy
+ *   1000 ms   200 RPM                 accuracy
+ *   2000 ms   10 RPM                  low speed accuracy
+ *   4000 ms   ramp to 300 RPM in 1 s  lag of the window
+ *   5500 ms   sudden stop             decay, then 0 after HALL_TIMEOUT
+ *   6500 ms   6 RPM                   restart, accuracy near the slowest speed
+ *
+ * The capture interrupt is then timed on the host. Only its cost relative to the emulated driverlib
+ * calls shows here, the target value is read with Hall_GetStats.
+ *
+ * Writes hall.csv with one line per millisecond, prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make hall_edges
+ *   ./hall_edges
+ */
+#pragma region Includes
+#include "sim.h"
+#include "gptm.h"
+#include "hall.h"
+#include "bus.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/timer.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define HALL_EDGES_DURATION 10000 // ms
+#define HALL_EDGES_STEP 1e-6	  // Integration step of the profile (s)
+#define HALL_EDGES_PER_TURN (6 * HALL_POLE_PAIRS)
+#define HALL_EDGES_BENCHMARK 1000000
+#define HALL_EDGES_ISR_BUDGET 1000 // ns
+
+/**
+ * @brief A segment of the speed profile, the speed moves linearly to the start of the next one
+ *
+ */
+typedef struct tHallEdgesSegment {
+	uint32_t ui32Start; // ms
+	double dFrom;		// RPM
+	double dTo;			// RPM
+} tHallEdgesSegment;
+
+/**
+ * @brief A capture input and the sensor edge it sees
+ *
+ */
+typedef struct tHallEdgesInput {
+	uint32_t ui32Base;
+	uint32_t ui32Timer;
+	double dOffset; // Placement error (edges)
+} tHallEdgesInput;
+
+/* The speed profile, in time order */
+const tHallEdgesSegment gc_sHallEdgesProfile[] = {
+	{0, 3000, 3000},
+	{1000, 200, 200},
+	{2000, 10, 10},
+	{4000, 10, 300},
+	{5000, 300, 300},
+	{5500, 0, 0},
+	{6500, 6, 6},
+};
+
+/* The sensors, wired like hall.c expects, and the order their edges come in */
+const tHallEdgesInput gc_sHallEdgesInputs[HALL_CHANNEL_COUNT] = {
+	{TIMER3_BASE, TIMER_A, 0},
+	{TIMER3_BASE, TIMER_B, 0.04},
+	{TIMER4_BASE, TIMER_A, -0.03},
+};
+const uint8_t gc_ui8HallEdgesSequence[6] = {0, 2, 1, 0, 2, 1};
+#define HALL_EDGES_POLE_OFFSET 0.02 // Rising edges come late and falling edges early by this much (edges)
+
+/* The capture interrupt, internal to hall.c */
+void Hall_CaptureHwi(UArg arg);
+
+/* Global variables */
+uint8_t g_ui8HallEdgesTimer;
+uint32_t g_ui32HallEdgesNext = 0;
+double g_dHallEdgesTime = 0;
+int32_t ga_i32HallEdgesSpeed[HALL_EDGES_DURATION];
+uint8_t g_ui8HallEdgesFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets the speed of the profile
+ *
+ * @param dTime The time (s)
+ * @return The speed (RPM)
+ */
+double HallEdges_Profile(double dTime) {
+	uint8_t ui8Count = sizeof(gc_sHallEdgesProfile) / sizeof(gc_sHallEdgesProfile[0]);
+	for (uint8_t i = ui8Count; i > 0; i--) {
+		const tHallEdgesSegment *psSegment = &gc_sHallEdgesProfile[i - 1];
+		double dStart = psSegment->ui32Start / 1000.0;
+		if (dTime < dStart)
+			continue;
+
+		double dEnd = i < ui8Count ? gc_sHallEdgesProfile[i].ui32Start / 1000.0 : HALL_EDGES_DURATION / 1000.0;
+		return psSegment->dFrom + (psSegment->dTo - psSegment->dFrom) * (dTime - dStart) / (dEnd - dStart);
+	}
+	return 0;
+}
+
+/**
+ * @brief Gets the electrical position of an edge
+ *
+ * @param ui32Edge The edge number
+ * @return The position (edges)
+ */
+double HallEdges_Position(uint32_t ui32Edge) {
+	uint8_t ui8Step = ui32Edge % 6;
+	double dPole = ui8Step % 2 == 0 ? HALL_EDGES_POLE_OFFSET : -HALL_EDGES_POLE_OFFSET;
+	return ui32Edge + gc_sHallEdgesInputs[gc_ui8HallEdgesSequence[ui8Step]].dOffset + dPole;
+}
+
+/**
+ * @brief Schedules the next edge by following the profile from the last one
+ *
+ * @note The edge is not scheduled when the profile ends first
+ */
+void HallEdges_Schedule() {
+	double dTarget = HallEdges_Position(g_ui32HallEdgesNext) - HallEdges_Position(g_ui32HallEdgesNext - 1);
+	double dTime = g_dHallEdgesTime;
+	double dPosition = 0;
+	while (dTime < HALL_EDGES_DURATION / 1000.0) {
+		double dStep = HallEdges_Profile(dTime) / 60 * HALL_EDGES_PER_TURN * HALL_EDGES_STEP;
+		if (dPosition + dStep >= dTarget) {
+			g_dHallEdgesTime = dTime + HALL_EDGES_STEP * (dTarget - dPosition) / dStep;
+			Sim_TimerStart(g_ui8HallEdgesTimer, (uint64_t)llround(g_dHallEdgesTime * SIM_CPU_FREQ), 0);
+			return;
+		}
+		dPosition += dStep;
+		dTime += HALL_EDGES_STEP;
+	}
+}
+
+/**
+ * @brief Captures an edge on the sensor it belongs to and schedules the next one
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context at each edge
+ */
+void HallEdges_Edge(uintptr_t arg) {
+	const tHallEdgesInput *psInput = &gc_sHallEdgesInputs[gc_ui8HallEdgesSequence[g_ui32HallEdgesNext % 6]];
+	GPTM_CaptureEdge(psInput->ui32Base, psInput->ui32Timer);
+
+	g_ui32HallEdgesNext++;
+	HallEdges_Schedule();
+}
+
+/**
+ * @brief Records the published speed
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every millisecond, after the publish clock
+ */
+void HallEdges_Sample(uintptr_t arg) {
+	uint32_t ui32Now = Sim_Now() / SIM_TICK_CYCLES;
+	if (ui32Now >= HALL_EDGES_DURATION) {
+		Sim_Stop();
+		return;
+	}
+
+	tBusSample sSample;
+	ga_i32HallEdgesSpeed[ui32Now] = Bus_Read(BUS_TOPIC_SPEED, &sSample) ? sSample.i32Value : -1;
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void HallEdges_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8HallEdgesFailures++;
+}
+
+/**
+ * @brief Checks the published speed against the profile over a span of samples
+ *
+ * @param pcName The name of the check
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @param dTolerance The largest error allowed, on top of the whole RPM resolution (RPM)
+ */
+void HallEdges_CheckAccuracy(const char *pcName, uint32_t ui32Start, uint32_t ui32End, double dTolerance) {
+	double dWorst = 0;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		double dError = ga_i32HallEdgesSpeed[i] - HallEdges_Profile(i / 1000.0);
+		if (fabs(dError) > fabs(dWorst))
+			dWorst = dError;
+	}
+	HallEdges_Check(pcName, fabs(dWorst) <= dTolerance + 1, "worst error %+.2f RPM", dWorst);
+}
+
+/**
+ * @brief Checks every phase of the profile and prints the report
+ *
+ */
+void HallEdges_Report() {
+	HallEdges_CheckAccuracy("3000 RPM", 800, 1000, 3000 * 0.001);
+	HallEdges_CheckAccuracy("200 RPM", 1800, 2000, 0);
+	HallEdges_CheckAccuracy("10 RPM", 3600, 4000, 0);
+
+	/* The window averages the last HALL_WINDOW edges and is only updated at the next edge, so once it only holds
+	   ramp edges it lags by half its length and an edge period. Its length is taken at the slower speed it started at */
+	double dWorst = 0;
+	double dAllowed = 0;
+	double dMargin = INFINITY;
+	for (uint32_t i = 4500; i < 5000; i++) {
+		double dSpeed = HallEdges_Profile(i / 1000.0);
+		double dWindow = HALL_WINDOW * 60 / (HALL_EDGES_PER_TURN * dSpeed);
+		dWindow = HALL_WINDOW * 60 / (HALL_EDGES_PER_TURN * HallEdges_Profile(i / 1000.0 - dWindow));
+		double dLag = 290 * (dWindow / 2 + dWindow / HALL_WINDOW + HALL_PUBLISH_PERIOD / 1000.0) + 1;
+		double dError = ga_i32HallEdgesSpeed[i] - dSpeed;
+		if (dLag - fabs(dError) < dMargin) {
+			dMargin = dLag - fabs(dError);
+			dWorst = dError;
+			dAllowed = dLag;
+		}
+	}
+	HallEdges_Check("ramp lag", dMargin >= 0, "worst error %+.2f RPM, allowed %.2f RPM", dWorst, dAllowed);
+	HallEdges_CheckAccuracy("300 RPM", 5300, 5500, 0);
+
+	/* After the stop the speed may only fall, and is 0 once HALL_TIMEOUT has passed since the last edge */
+	uint32_t ui32Rises = 0;
+	uint32_t ui32Zero = 6500;
+	for (uint32_t i = 5501; i < 6500; i++) {
+		if (ga_i32HallEdgesSpeed[i] > ga_i32HallEdgesSpeed[i - 1])
+			ui32Rises++;
+		if (ga_i32HallEdgesSpeed[i] == 0 && ui32Zero == 6500)
+			ui32Zero = i;
+	}
+	HallEdges_Check("stop decay", ui32Rises == 0, "%u rises", ui32Rises);
+	HallEdges_Check("stop timeout", ui32Zero <= 5500 + HALL_TIMEOUT + 2 * HALL_PUBLISH_PERIOD, "0 RPM after %u ms",
+					ui32Zero - 5500);
+	HallEdges_CheckAccuracy("6 RPM", 9500, 10000, 0);
+
+	tHallStats sStats;
+	Hall_GetStats(&sStats);
+	HallEdges_Check("restarts", sStats.ui32Restarts == 1, "%u edges, %u restarts", sStats.ui32Edges, sStats.ui32Restarts);
+}
+
+/**
+ * @brief Times the capture interrupt
+ *
+ */
+void HallEdges_Benchmark() {
+	struct timespec sStart, sEnd;
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	for (uint32_t i = 0; i < HALL_EDGES_BENCHMARK; i++) {
+		Hall_CaptureHwi(i % HALL_CHANNEL_COUNT);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+	double dNs = ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec)) / HALL_EDGES_BENCHMARK;
+	HallEdges_Check("capture interrupt", dNs <= HALL_EDGES_ISR_BUDGET, "%.1f ns per edge on the host", dNs);
+}
+
+/**
+ * @brief Writes the recorded speeds
+ *
+ * @param pcPath The file to write
+ */
+void HallEdges_WriteCSV(const char *pcPath) {
+	FILE *psFile = fopen(pcPath, "w");
+	if (psFile == NULL) {
+		fprintf(stderr, "hall_edges: cannot write %s\n", pcPath);
+		return;
+	}
+
+	fprintf(psFile, "ms,profile,speed\n");
+	for (uint32_t i = 0; i < HALL_EDGES_DURATION; i++) {
+		fprintf(psFile, "%u,%.2f,%d\n", i, HallEdges_Profile(i / 1000.0), ga_i32HallEdgesSpeed[i]);
+	}
+	fclose(psFile);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @param argc The number of arguments
+ * @param argv Optionally the file to write the speeds to
+ * @return 0 if every check passed
+ */
+int main(int argc, char **argv) {
+	Hall_Init();
+
+	/* The publish clock is created before the sampler, so each sample sees the speed of its own tick */
+	Clock_Params clockParams;
+	Clock_Params_init(&clockParams);
+	clockParams.startFlag = true;
+	clockParams.period = HALL_PUBLISH_PERIOD;
+	Clock_create((Clock_FuncPtr)Hall_Publish, HALL_PUBLISH_PERIOD, &clockParams, NULL);
+	uint8_t ui8Sample = Sim_TimerCreate(HallEdges_Sample, 0);
+	Sim_TimerStart(ui8Sample, 0, SIM_CYCLES_MS(1));
+
+	/* Edge 0 is at time 0 */
+	g_ui8HallEdgesTimer = Sim_TimerCreate(HallEdges_Edge, 0);
+	Sim_TimerStart(g_ui8HallEdgesTimer, 0, 0);
+
+	BIOS_start();
+
+	HallEdges_WriteCSV(argc > 1 ? argv[1] : "hall.csv");
+	HallEdges_Report();
+	HallEdges_Benchmark();
+	printf("%s: %u check(s) failed\n", g_ui8HallEdgesFailures == 0 ? "PASS" : "FAIL", g_ui8HallEdgesFailures);
+	return g_ui8HallEdgesFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file history_check.c
+ * @brief Host check of the multi-resolution graph history against a reference built from the raw samples
+ *
+ * history.c runs unchanged. Four channels are added the way GUI_GraphInit does, each with its own depth:
+ *   short                GRAPH_COLUMN_MAX buckets per level, like a graph channel
+ *   long                 HISTORY_CHECK_LONG buckets per level
+ *   too long             more than is left of HISTORY_RAM_BUDGET, it keeps nothing but is still numbered
+ *   tiny                 fits in what the too long channel left
+ *
+ * A seeded random stream is then added until the coarsest level has wrapped around. After every sample the
+ * newest bucket of every level must be the one the sample count gives, so a bucket is folded into the next
+ * level as soon as it is complete. At the end every bucket still held, on every level and channel, must match
+ * the min, max and mean of the reference, which folds the raw samples level by level. The buckets past the
+ * depth of a channel must be gone, and History_GetAll must flag exactly the channels that hold a bucket.
+ *
+ * History_Add is then timed on the host. It folds a sample into every level at once, so its cost does not grow
+ * with the depth of the history.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make history_check
+ *   ./history_check
+ */
+#pragma region Includes
+#include "history.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define HISTORY_CHECK_CHANNELS 4
+#define HISTORY_CHECK_SHORT 240 // GRAPH_COLUMN_MAX of gui.c
+#define HISTORY_CHECK_LONG 600
+#define HISTORY_CHECK_TOO_LONG 2000
+#define HISTORY_CHECK_TINY 100
+#define HISTORY_CHECK_BUCKETS (HISTORY_CHECK_LONG + 50) // Buckets of the coarsest level, so it wraps around
+#define HISTORY_CHECK_SEED 12345
+#define HISTORY_CHECK_BENCHMARK 1000000
+#define HISTORY_CHECK_ADD_BUDGET 100 // ns on the host
+
+/* The depth each channel asks for, and whether it fits */
+const uint16_t gc_ui16HistoryCheckDepth[HISTORY_CHECK_CHANNELS] = {HISTORY_CHECK_SHORT, HISTORY_CHECK_LONG,
+																	HISTORY_CHECK_TOO_LONG, HISTORY_CHECK_TINY};
+const bool gc_bHistoryCheckFits[HISTORY_CHECK_CHANNELS] = {true, true, false, true};
+
+/* Global variables */
+tHistoryBucket *g_psHistoryCheckReference[HISTORY_LEVEL_COUNT]; // Every bucket of every level, channels adjacent
+uint32_t g_ui32HistoryCheckBuckets[HISTORY_LEVEL_COUNT];
+uint8_t g_ui8HistoryCheckFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void HistoryCheck_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8HistoryCheckFailures++;
+}
+
+/**
+ * @brief Compares two buckets
+ *
+ * @param psA The first bucket
+ * @param psB The second bucket
+ * @return Whether the min, max and mean are the same
+ */
+bool HistoryCheck_Same(const tHistoryBucket *psA, const tHistoryBucket *psB) {
+	return psA->ui8Min == psB->ui8Min && psA->ui8Max == psB->ui8Max && psA->ui8Mean == psB->ui8Mean;
+}
+
+/**
+ * @brief Builds the reference of every level above the finest from the level below
+ *
+ * @note A bucket is the min and max of the buckets below and the mean of their means, as the levels are folded
+ */
+void HistoryCheck_Fold() {
+	uint32_t ui32Factor = 1;
+	for (uint8_t l = 1; l < HISTORY_LEVEL_COUNT; l++) {
+		ui32Factor = History_Samples(l) / History_Samples(l - 1);
+		g_ui32HistoryCheckBuckets[l] = g_ui32HistoryCheckBuckets[l - 1] / ui32Factor;
+		g_psHistoryCheckReference[l] = calloc((size_t)g_ui32HistoryCheckBuckets[l] * HISTORY_CHECK_CHANNELS,
+											  sizeof(tHistoryBucket));
+
+		for (uint32_t b = 0; b < g_ui32HistoryCheckBuckets[l]; b++) {
+			for (uint8_t c = 0; c < HISTORY_CHECK_CHANNELS; c++) {
+				tHistoryBucket *psBucket = &g_psHistoryCheckReference[l][b * HISTORY_CHECK_CHANNELS + c];
+				uint32_t ui32Sum = 0;
+				*psBucket = (tHistoryBucket){UINT8_MAX, 0, 0};
+				for (uint32_t i = b * ui32Factor; i < (b + 1) * ui32Factor; i++) {
+					const tHistoryBucket *psBelow = &g_psHistoryCheckReference[l - 1][i * HISTORY_CHECK_CHANNELS + c];
+					if (psBelow->ui8Min < psBucket->ui8Min)
+						psBucket->ui8Min = psBelow->ui8Min;
+					if (psBelow->ui8Max > psBucket->ui8Max)
+						psBucket->ui8Max = psBelow->ui8Max;
+					ui32Sum += psBelow->ui8Mean;
+				}
+				psBucket->ui8Mean = ui32Sum / ui32Factor;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Adds the channels like GUI_GraphInit
+ *
+ */
+void HistoryCheck_Channels() {
+	uint8_t ui8Wrong = 0;
+	uint16_t pui16Length[HISTORY_CHECK_CHANNELS];
+	for (uint8_t c = 0; c < HISTORY_CHECK_CHANNELS; c++) {
+		bool bFits = History_AddChannel(gc_ui16HistoryCheckDepth[c]);
+		pui16Length[c] = History_Length(c);
+		if (bFits != gc_bHistoryCheckFits[c] || pui16Length[c] != (bFits ? gc_ui16HistoryCheckDepth[c] : 0))
+			ui8Wrong++;
+	}
+	HistoryCheck_Check("channels", ui8Wrong == 0, "keep %u, %u, %u and %u buckets per level of %u bytes", pui16Length[0],
+					   pui16Length[1], pui16Length[2], pui16Length[3], HISTORY_RAM_BUDGET);
+}
+
+/**
+ * @brief Adds the random stream, checking the newest bucket of every level after each sample
+ *
+ */
+void HistoryCheck_Stream() {
+	uint32_t ui32Samples = History_Samples(HISTORY_LEVEL_COUNT - 1) * HISTORY_CHECK_BUCKETS;
+	g_ui32HistoryCheckBuckets[0] = ui32Samples;
+	g_psHistoryCheckReference[0] = calloc((size_t)ui32Samples * HISTORY_CHECK_CHANNELS, sizeof(tHistoryBucket));
+
+	/* Slow ramps with noise, so the levels see different ranges and means */
+	srand(HISTORY_CHECK_SEED);
+	uint32_t ui32Late = 0;
+	for (uint32_t i = 0; i < ui32Samples; i++) {
+		uint8_t pui8Values[HISTORY_CHECK_CHANNELS];
+		for (uint8_t c = 0; c < HISTORY_CHECK_CHANNELS; c++) {
+			int32_t i32Value = (int32_t)((i >> (4 + 2 * c)) % 200) + rand() % 56;
+			pui8Values[c] = i32Value;
+			g_psHistoryCheckReference[0][i * HISTORY_CHECK_CHANNELS + c] = (tHistoryBucket){i32Value, i32Value, i32Value};
+		}
+		History_Add(pui8Values);
+
+		for (uint8_t l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+			if (History_Latest(l) != (int32_t)((i + 1) / History_Samples(l)) - 1)
+				ui32Late++;
+		}
+	}
+	HistoryCheck_Check("folded at once", ui32Late == 0, "%u samples, %u late buckets", ui32Samples, ui32Late);
+}
+
+/**
+ * @brief Checks every bucket still held against the reference, and that the older ones are gone
+ *
+ */
+void HistoryCheck_Buckets() {
+	uint32_t ui32Held = 0;
+	uint32_t ui32Wrong = 0;
+	uint32_t ui32Kept = 0;
+	uint32_t ui32Flags = 0;
+
+	for (uint8_t l = 0; l < HISTORY_LEVEL_COUNT; l++) {
+		int32_t i32Latest = History_Latest(l);
+		int32_t i32Oldest = i32Latest - HISTORY_CHECK_LONG - 10;
+		for (int32_t b = i32Oldest < 0 ? 0 : i32Oldest; b <= i32Latest; b++) {
+			tHistoryBucket psAll[HISTORY_CHECK_CHANNELS];
+			uint32_t ui32Mask = History_GetAll(l, b, psAll);
+			const tHistoryBucket *psReference = &g_psHistoryCheckReference[l][b * HISTORY_CHECK_CHANNELS];
+
+			for (uint8_t c = 0; c < HISTORY_CHECK_CHANNELS; c++) {
+				tHistoryBucket sBucket;
+				bool bExpect = b > i32Latest - (int32_t)History_Length(c);
+				bool bHeld = History_Get(c, l, b, &sBucket);
+				if (bHeld != bExpect) {
+					ui32Kept++;
+					continue;
+				}
+				if (((ui32Mask >> c) & 1) != bExpect)
+					ui32Flags++;
+				if (!bHeld)
+					continue;
+
+				ui32Held++;
+				if (!HistoryCheck_Same(&sBucket, &psReference[c]) || !HistoryCheck_Same(&psAll[c], &psReference[c]))
+					ui32Wrong++;
+			}
+		}
+	}
+	HistoryCheck_Check("min, max and mean", ui32Held > 0 && ui32Wrong == 0, "%u buckets held, %u wrong", ui32Held,
+					   ui32Wrong);
+	HistoryCheck_Check("ring depth", ui32Kept == 0, "%u buckets held past or dropped before the depth", ui32Kept);
+	HistoryCheck_Check("get all", ui32Flags == 0, "%u channels flagged wrong", ui32Flags);
+
+	/* The means of means only lose the rounding of each level against the mean of the raw samples */
+	uint32_t ui32Samples = History_Samples(HISTORY_LEVEL_COUNT - 1);
+	double dWorst = 0;
+	for (uint32_t b = 0; b < g_ui32HistoryCheckBuckets[HISTORY_LEVEL_COUNT - 1]; b++) {
+		for (uint8_t c = 0; c < HISTORY_CHECK_CHANNELS; c++) {
+			uint32_t ui32Sum = 0;
+			for (uint32_t i = b * ui32Samples; i < (b + 1) * ui32Samples; i++) {
+				ui32Sum += g_psHistoryCheckReference[0][i * HISTORY_CHECK_CHANNELS + c].ui8Mean;
+			}
+			double dError = (double)ui32Sum / ui32Samples -
+							g_psHistoryCheckReference[HISTORY_LEVEL_COUNT - 1][b * HISTORY_CHECK_CHANNELS + c].ui8Mean;
+			if (dError > dWorst)
+				dWorst = dError;
+		}
+	}
+	HistoryCheck_Check("mean rounding", dWorst < HISTORY_LEVEL_COUNT - 1, "worst %.2f below the raw mean", dWorst);
+}
+
+/**
+ * @brief Times History_Add on the host
+ *
+ */
+void HistoryCheck_Benchmark() {
+	uint8_t pui8Values[HISTORY_CHECK_CHANNELS] = {0};
+	struct timespec sStart, sEnd;
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	for (uint32_t i = 0; i < HISTORY_CHECK_BENCHMARK; i++) {
+		pui8Values[i & (HISTORY_CHECK_CHANNELS - 1)] = i;
+		History_Add(pui8Values);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+	double dNs = ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec)) / HISTORY_CHECK_BENCHMARK;
+	HistoryCheck_Check("add", dNs <= HISTORY_CHECK_ADD_BUDGET, "%.1f ns per sample on the host", dNs);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @return 0 if every check passed
+ */
+int main() {
+	HistoryCheck_Channels();
+	HistoryCheck_Stream();
+	HistoryCheck_Fold();
+	HistoryCheck_Buckets();
+	HistoryCheck_Benchmark();
+	printf("%s: %u check(s) failed\n", g_ui8HistoryCheckFailures == 0 ? "PASS" : "FAIL", g_ui8HistoryCheckFailures);
+	return g_ui8HistoryCheckFailures == 0 ? 0 : 1;
+}
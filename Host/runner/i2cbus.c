@@ -0,0 +1,197 @@
+/**
+ * @file i2cbus.c
+ * @brief Host emulation of the I2C buses behind the TI-RTOS I2C driver
+ */
+#pragma region Includes
+#include "i2cbus.h"
+#include "sim.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/* TI-RTOS header files */
+#include <ti/drivers/I2C.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define I2CBUS_BYTE_BITS 9 // Eight data bits and the acknowledge
+#define I2CBUS_FRAME_BITS 2 // The start and stop conditions
+
+/**
+ * @brief A bus, behind the handle the driver hands out
+ *
+ */
+struct I2C_Config {
+	I2C_Params sParams;
+	bool bOpen;
+	bool bBusy;
+	bool bCreated;
+	uint8_t ui8Timer;
+	const tI2CBusDevice *psDevices[I2CBUS_DEVICES];
+	I2C_Transaction *psQueue[I2CBUS_QUEUE];
+	uint8_t ui8Head;
+	uint8_t ui8Count;
+	uint32_t ui32Fail;
+	uint64_t ui64Started;
+	tI2CBusStats sStats;
+};
+
+/* Global variables */
+struct I2C_Config g_psI2CBus[I2CBUS_COUNT];
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets a bus
+ *
+ * @param uiIndex The index of the bus in the board table
+ * @return The bus, the program exits on an unknown index
+ */
+struct I2C_Config *I2CBus_Find(unsigned int uiIndex) {
+	if (uiIndex < I2CBUS_COUNT)
+		return &g_psI2CBus[uiIndex];
+
+	fprintf(stderr, "i2cbus: unknown bus %u\n", uiIndex);
+	exit(1);
+}
+
+/**
+ * @brief Starts clocking out the transfer at the head of the queue
+ *
+ * @param psBus The bus
+ */
+void I2CBus_Start(struct I2C_Config *psBus) {
+	I2C_Transaction *psTransfer = psBus->psQueue[psBus->ui8Head];
+	uint32_t ui32Bits = I2CBUS_FRAME_BITS;
+	if (psTransfer->writeCount > 0)
+		ui32Bits += (1 + psTransfer->writeCount) * I2CBUS_BYTE_BITS;
+	if (psTransfer->readCount > 0)
+		ui32Bits += (1 + psTransfer->readCount) * I2CBUS_BYTE_BITS + (psTransfer->writeCount > 0 ? 1 : 0);
+
+	uint32_t ui32Rate = psBus->sParams.bitRate == I2C_400kHz ? 400000 : 100000;
+	psBus->bBusy = true;
+	psBus->ui64Started = Sim_Now();
+	Sim_TimerStart(psBus->ui8Timer, psBus->ui64Started + (uint64_t)ui32Bits * SIM_CPU_FREQ / ui32Rate, 0);
+}
+
+/**
+ * @brief Completes the transfer at the head of the queue and starts the next one
+ *
+ * @param arg The bus
+ *
+ * @note Called from interrupt context once the transfer has been clocked out
+ */
+void I2CBus_Complete(uintptr_t arg) {
+	struct I2C_Config *psBus = (struct I2C_Config *)arg;
+	I2C_Transaction *psTransfer = psBus->psQueue[psBus->ui8Head];
+	psBus->ui8Head = (psBus->ui8Head + 1) % I2CBUS_QUEUE;
+	psBus->ui8Count--;
+	psBus->bBusy = false;
+	psBus->sStats.ui64BusyCycles += Sim_Now() - psBus->ui64Started;
+
+	const tI2CBusDevice *psDevice = NULL;
+	for (uint8_t i = 0; i < I2CBUS_DEVICES; i++) {
+		if (psBus->psDevices[i] != NULL && psBus->psDevices[i]->ui8Address == psTransfer->slaveAddress)
+			psDevice = psBus->psDevices[i];
+	}
+
+	/* The write goes first and the read only follows an acknowledged write */
+	bool bSuccess = psDevice != NULL;
+	if (bSuccess && psBus->ui32Fail > 0) {
+		psBus->ui32Fail--;
+		bSuccess = false;
+	}
+	if (bSuccess && psTransfer->writeCount > 0)
+		bSuccess = psDevice->pfnWrite(psTransfer->writeBuf, psTransfer->writeCount);
+	if (bSuccess && psTransfer->readCount > 0)
+		bSuccess = psDevice->pfnRead(psTransfer->readBuf, psTransfer->readCount);
+
+	psBus->sStats.ui32Transfers++;
+	if (!bSuccess)
+		psBus->sStats.ui32Failures++;
+
+	/* The callback may queue more transfers, which start straight away on the idle bus */
+	psBus->sParams.transferCallbackFxn(psBus, psTransfer, bSuccess);
+	if (!psBus->bBusy && psBus->ui8Count > 0)
+		I2CBus_Start(psBus);
+}
+#pragma endregion
+
+#pragma region I2CBus API functions
+void I2CBus_Attach(unsigned int uiIndex, const tI2CBusDevice *psDevice) {
+	struct I2C_Config *psBus = I2CBus_Find(uiIndex);
+	for (uint8_t i = 0; i < I2CBUS_DEVICES; i++) {
+		if (psBus->psDevices[i] == NULL) {
+			psBus->psDevices[i] = psDevice;
+			return;
+		}
+	}
+
+	fprintf(stderr, "i2cbus: too many devices on bus %u\n", uiIndex);
+	exit(1);
+}
+
+void I2CBus_Fail(unsigned int uiIndex, uint32_t ui32Count) {
+	I2CBus_Find(uiIndex)->ui32Fail += ui32Count;
+}
+
+void I2CBus_GetStats(unsigned int uiIndex, tI2CBusStats *psStats) {
+	*psStats = I2CBus_Find(uiIndex)->sStats;
+}
+#pragma endregion
+
+#pragma region TI-RTOS I2C functions
+void I2C_init() {
+}
+
+void I2C_Params_init(I2C_Params *psParams) {
+	psParams->transferMode = I2C_MODE_BLOCKING;
+	psParams->transferCallbackFxn = NULL;
+	psParams->bitRate = I2C_100kHz;
+	psParams->custom = 0;
+}
+
+I2C_Handle I2C_open(unsigned int uiIndex, I2C_Params *psParams) {
+	struct I2C_Config *psBus = I2CBus_Find(uiIndex);
+	if (psBus->bOpen || psParams == NULL || psParams->transferMode != I2C_MODE_CALLBACK ||
+		psParams->transferCallbackFxn == NULL)
+		return NULL;
+
+	/* The timer outlives a close, a bus opened again reuses it */
+	if (!psBus->bCreated) {
+		psBus->ui8Timer = Sim_TimerCreate(I2CBus_Complete, (uintptr_t)psBus);
+		psBus->bCreated = true;
+	}
+	psBus->sParams = *psParams;
+	psBus->bOpen = true;
+	return psBus;
+}
+
+void I2C_close(I2C_Handle hHandle) {
+	hHandle->bOpen = false;
+}
+
+bool I2C_transfer(I2C_Handle hHandle, I2C_Transaction *psTransaction) {
+	if (!hHandle->bOpen || (psTransaction->writeCount == 0 && psTransaction->readCount == 0))
+		return false;
+
+	if (hHandle->ui8Count == I2CBUS_QUEUE) {
+		hHandle->sStats.ui32Refused++;
+		return false;
+	}
+
+	hHandle->psQueue[(hHandle->ui8Head + hHandle->ui8Count) % I2CBUS_QUEUE] = psTransaction;
+	hHandle->ui8Count++;
+	if (hHandle->ui8Count > hHandle->sStats.ui32MaxQueued)
+		hHandle->sStats.ui32MaxQueued = hHandle->ui8Count;
+
+	if (!hHandle->bBusy)
+		I2CBus_Start(hHandle);
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,90 @@
+/**
+ * @file i2cbus.h
+ * @brief Host emulation of the I2C buses behind the TI-RTOS I2C driver (see ti/drivers/I2C.h)
+ *
+ * Transfers are queued per bus and clocked out one at a time, each taking the time its bytes, with
+ * their acknowledge bits, take at the bit rate the bus was opened with. The device at the slave
+ * address then sees the write and the read, and the callback is called from interrupt context.
+ * A transfer to an address no device answers to is not acknowledged and fails.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Global defines */
+#define I2CBUS_COUNT 2
+#define I2CBUS_DEVICES 4 // Devices per bus
+#define I2CBUS_QUEUE 8	 // Transfers per bus
+
+/**
+ * @brief A device on a bus
+ *
+ */
+typedef struct tI2CBusDevice {
+	/**
+	 * @brief The slave address
+	 */
+	uint8_t ui8Address;
+	/**
+	 * @brief Takes the bytes written, returns false to not acknowledge them
+	 */
+	bool (*pfnWrite)(const uint8_t *pui8Data, size_t szCount);
+	/**
+	 * @brief Fills the bytes read, returns false to not acknowledge the address
+	 */
+	bool (*pfnRead)(uint8_t *pui8Data, size_t szCount);
+} tI2CBusDevice;
+
+/**
+ * @brief Statistics of a bus
+ *
+ */
+typedef struct tI2CBusStats {
+	/**
+	 * @brief The number of transfers completed, failed ones included
+	 */
+	uint32_t ui32Transfers;
+	/**
+	 * @brief The number of transfers that failed
+	 */
+	uint32_t ui32Failures;
+	/**
+	 * @brief The number of transfers refused as the queue was full
+	 */
+	uint32_t ui32Refused;
+	/**
+	 * @brief The most transfers queued at once
+	 */
+	uint32_t ui32MaxQueued;
+	/**
+	 * @brief The time the bus was busy (CPU cycles)
+	 */
+	uint64_t ui64BusyCycles;
+} tI2CBusStats;
+
+/**
+ * @brief Attaches a device to a bus
+ *
+ * @param uiIndex The index of the bus in the board table
+ * @param psDevice The device, it must stay valid
+ */
+void I2CBus_Attach(unsigned int uiIndex, const tI2CBusDevice *psDevice);
+
+/**
+ * @brief Fails the next transfers on a bus, like a glitch on the lines would
+ *
+ * @param uiIndex The index of the bus in the board table
+ * @param ui32Count The number of transfers to fail
+ *
+ * @note The devices do not see the failed transfers
+ */
+void I2CBus_Fail(unsigned int uiIndex, uint32_t ui32Count);
+
+/**
+ * @brief Gets the statistics of a bus
+ *
+ * @param uiIndex The index of the bus in the board table
+ * @param psStats The statistics to copy into
+ */
+void I2CBus_GetStats(unsigned int uiIndex, tI2CBusStats *psStats);
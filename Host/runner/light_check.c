@@ -0,0 +1,338 @@
+/**
+ * @file light_check.c
+ * @brief Host check of the OPT3001 light sensor driver against the sensor model on the emulated I2C bus
+ *
+ * opt3001.c runs unchanged on the emulated bus (see i2cbus.h) with the sensor model attached (see
+ * lightsensor.h), its interrupt pin raised through the board pin stand-ins (see devices.h). No task
+ * runs, every driver function is called from interrupt context like on the target. The light level
+ * follows a profile with some noise on every conversion, and the reading is recorded every 10 ms:
+ *   0 ms       sensor off the bus     the driver keeps looking for it
+ *   1000 ms    350 lux, 5 % noise     found by the poll, accuracy
+ *   4000 ms    2 lux, 5 % noise       settling of the moving average
+ *   5000 ms    5 lux, 1 lux noise     flicker around the night threshold
+ *   7000 ms    60000 lux, 1 % noise   top of the range
+ *   8000 ms                           two failed transfers, the interrupt stays latched
+ *   8600 ms                           an interrupt edge is lost
+ *   9500 ms    20 lux, 2 % noise      off the bus for 300 ms, it comes back reset and is configured
+ *                                     again, accuracy after the reset
+ *
+ * Writes light.csv with one line per sample, prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make light_check
+ *   ./light_check
+ */
+#pragma region Includes
+#include "sim.h"
+#include "i2cbus.h"
+#include "lightsensor.h"
+#include "opt3001.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define LIGHT_CHECK_DURATION 12500 // ms
+#define LIGHT_CHECK_PERIOD 10	   // ms
+#define LIGHT_CHECK_SAMPLES (LIGHT_CHECK_DURATION / LIGHT_CHECK_PERIOD)
+#define LIGHT_CHECK_CONVERSION 100 // ms
+#define LIGHT_CHECK_SEED 3001
+
+/**
+ * @brief A segment of the light profile
+ *
+ */
+typedef struct tLightCheckSegment {
+	uint32_t ui32Start; // ms
+	double dLux;
+	double dNoise; // Largest relative deviation, or in lux when negative
+} tLightCheckSegment;
+
+/* The light profile, in time order */
+const tLightCheckSegment gc_sLightCheckProfile[] = {
+	{0, 350, 0.05}, {4000, 2, 0.05}, {5000, 5, -1}, {7000, 60000, 0.01}, {9500, 20, 0.02},
+};
+
+/* Global variables */
+uint32_t g_ui32LightCheckNext = 0;
+double ga_dLightCheckLux[LIGHT_CHECK_SAMPLES];
+uint32_t ga_ui32LightCheckReading[LIGHT_CHECK_SAMPLES];
+uint32_t ga_ui32LightCheckConversions[LIGHT_CHECK_SAMPLES];
+uint8_t g_ui8LightCheckFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets the segment of the profile at a time
+ *
+ * @param ui32Time The time (ms)
+ * @return The segment
+ */
+const tLightCheckSegment *LightCheck_Segment(uint32_t ui32Time) {
+	uint8_t ui8Count = sizeof(gc_sLightCheckProfile) / sizeof(gc_sLightCheckProfile[0]);
+	for (uint8_t i = ui8Count; i > 1; i--) {
+		if (ui32Time >= gc_sLightCheckProfile[i - 1].ui32Start)
+			return &gc_sLightCheckProfile[i - 1];
+	}
+	return &gc_sLightCheckProfile[0];
+}
+
+/**
+ * @brief Plays the events of the scenario
+ *
+ * @param ui32Time The time (ms)
+ *
+ * @note Called from interrupt context
+ */
+void LightCheck_Events(uint32_t ui32Time) {
+	switch (ui32Time) {
+	case 0:
+		LightSensor_SetPresent(false);
+		break;
+	case 1000:
+		LightSensor_SetPresent(true);
+		break;
+	case 8000:
+		I2CBus_Fail(Board_I2C0, 2);
+		break;
+	case 8600:
+		LightSensor_DropEdge();
+		break;
+	case 9500:
+		LightSensor_SetPresent(false);
+		break;
+	case 9800:
+		LightSensor_SetPresent(true);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Sets the light level with fresh noise, plays the events and records the reading
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every LIGHT_CHECK_PERIOD ms
+ */
+void LightCheck_Sample(uintptr_t arg) {
+	uint32_t ui32Now = Sim_Now() / SIM_TICK_CYCLES;
+	if (g_ui32LightCheckNext >= LIGHT_CHECK_SAMPLES) {
+		Sim_Stop();
+		return;
+	}
+
+	const tLightCheckSegment *psSegment = LightCheck_Segment(ui32Now);
+	double dNoise = 2.0 * rand() / RAND_MAX - 1;
+	dNoise *= psSegment->dNoise < 0 ? -psSegment->dNoise : psSegment->dNoise * psSegment->dLux;
+	LightSensor_SetLux(psSegment->dLux + dNoise);
+	LightCheck_Events(ui32Now);
+
+	ga_dLightCheckLux[g_ui32LightCheckNext] = psSegment->dLux;
+	ga_ui32LightCheckReading[g_ui32LightCheckNext] = OPT3001_GetLight();
+	tOPT3001Stats sStats;
+	OPT3001_GetStats(&sStats);
+	ga_ui32LightCheckConversions[g_ui32LightCheckNext] = sStats.ui32Conversions;
+	g_ui32LightCheckNext++;
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void LightCheck_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8LightCheckFailures++;
+}
+
+/**
+ * @brief Checks the reading against the profile over a span of samples
+ *
+ * @param pcName The name of the check
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @param dTolerance The largest error allowed, relative to the light level
+ * @param dFloor The largest error allowed at low light, on top of the resolution (lux)
+ */
+void LightCheck_CheckAccuracy(const char *pcName, uint32_t ui32Start, uint32_t ui32End, double dTolerance,
+							  double dFloor) {
+	double dWorst = 0;
+	double dAllowed = 0;
+	for (uint32_t i = ui32Start / LIGHT_CHECK_PERIOD; i < ui32End / LIGHT_CHECK_PERIOD; i++) {
+		double dError = ga_ui32LightCheckReading[i] / 100.0 - ga_dLightCheckLux[i];
+		if (fabs(dError) > fabs(dWorst)) {
+			dWorst = dError;
+			dAllowed = fmax(dTolerance * ga_dLightCheckLux[i], dFloor) + 0.01;
+		}
+	}
+	LightCheck_Check(pcName, dAllowed == 0 || fabs(dWorst) <= dAllowed, "worst error %+.2f lux", dWorst);
+}
+
+/**
+ * @brief Gets the time of the first conversion read after a time
+ *
+ * @param ui32Start The time (ms)
+ * @return The time of the first sample that saw it (ms), or LIGHT_CHECK_DURATION if none did
+ */
+uint32_t LightCheck_FirstConversion(uint32_t ui32Start) {
+	uint32_t ui32First = ui32Start / LIGHT_CHECK_PERIOD;
+	for (uint32_t i = ui32First + 1; i < LIGHT_CHECK_SAMPLES; i++) {
+		if (ga_ui32LightCheckConversions[i] != ga_ui32LightCheckConversions[ui32First])
+			return i * LIGHT_CHECK_PERIOD;
+	}
+	return LIGHT_CHECK_DURATION;
+}
+
+/**
+ * @brief Gets the longest time without a conversion read over a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @return The longest gap (ms)
+ */
+uint32_t LightCheck_LongestGap(uint32_t ui32Start, uint32_t ui32End) {
+	uint32_t ui32Last = ui32Start;
+	uint32_t ui32Longest = 0;
+	for (uint32_t i = ui32Start / LIGHT_CHECK_PERIOD + 1; i < ui32End / LIGHT_CHECK_PERIOD; i++) {
+		if (ga_ui32LightCheckConversions[i] == ga_ui32LightCheckConversions[i - 1])
+			continue;
+		if (i * LIGHT_CHECK_PERIOD - ui32Last > ui32Longest)
+			ui32Longest = i * LIGHT_CHECK_PERIOD - ui32Last;
+		ui32Last = i * LIGHT_CHECK_PERIOD;
+	}
+	return ui32Longest;
+}
+
+/**
+ * @brief Checks every phase of the scenario and prints the report
+ *
+ */
+void LightCheck_Report() {
+	/* The poll finds the sensor, then its first conversion takes a conversion time */
+	uint32_t ui32Allowed = LIGHT_WATCHDOG + 2 * LIGHT_CHECK_CONVERSION + LIGHT_CHECK_PERIOD;
+	uint32_t ui32Found = LightCheck_FirstConversion(1000) - 1000;
+	LightCheck_Check("found late", ui32Found <= ui32Allowed, "first conversion %u ms after it came", ui32Found);
+	LightCheck_CheckAccuracy("350 lux", 3000, 4000, 0.03, 0);
+
+	/* The average has settled once the window only holds conversions of the new level */
+	uint32_t ui32Settled = 4000;
+	for (uint32_t i = 4000 / LIGHT_CHECK_PERIOD; i < 5000 / LIGHT_CHECK_PERIOD; i++) {
+		if (fabs(ga_ui32LightCheckReading[i] / 100.0 - 2) > 2 * 0.05 + 0.01)
+			ui32Settled = (i + 1) * LIGHT_CHECK_PERIOD;
+	}
+	ui32Allowed = (LIGHT_AVERAGE + 1) * LIGHT_CHECK_CONVERSION + LIGHT_CHECK_PERIOD;
+	LightCheck_Check("step settling", ui32Settled - 4000 <= ui32Allowed, "settled after %u ms, allowed %u ms",
+					 ui32Settled - 4000, ui32Allowed);
+
+	/* Noise of up to 1 lux averages to a deviation of 1 / sqrt(3 * LIGHT_AVERAGE) lux, three of those are allowed */
+	LightCheck_CheckAccuracy("5 lux flicker", 6000, 7000, 0, 3 / sqrt(3 * LIGHT_AVERAGE));
+	LightCheck_CheckAccuracy("60000 lux", 7900, 8000, 0.01, 0);
+
+	/* A latched interrupt that was lost is only read again by the poll, by the second one when a conversion was read
+	   since the first */
+	tOPT3001Stats sStats;
+	OPT3001_GetStats(&sStats);
+	ui32Allowed = 2 * LIGHT_WATCHDOG + LIGHT_CHECK_CONVERSION + LIGHT_CHECK_PERIOD;
+	uint32_t ui32Gap = LightCheck_LongestGap(7900, 9500);
+	LightCheck_Check("lost interrupts", ui32Gap <= ui32Allowed && sStats.ui32Recoveries >= 2,
+					 "longest gap %u ms, allowed %u ms, %u recoveries", ui32Gap, ui32Allowed, sStats.ui32Recoveries);
+	LightCheck_CheckAccuracy("60000 lux after faults", 9000, 9500, 0.01, 0);
+
+	/* Off the bus, the sensor is only missed by the poll after its last conversion */
+	ui32Found = LightCheck_FirstConversion(9800) - 9800;
+	ui32Allowed = 2 * LIGHT_WATCHDOG + 2 * LIGHT_CHECK_CONVERSION + LIGHT_CHECK_PERIOD;
+	LightCheck_Check("reset", ui32Found <= ui32Allowed && sStats.bConfigured,
+					 "first conversion %u ms after it came back, allowed %u ms", ui32Found, ui32Allowed);
+	LightCheck_CheckAccuracy("20 lux", 11500, 12500, 0.03, 0);
+
+	tI2CBusStats sBus;
+	I2CBus_GetStats(Board_I2C0, &sBus);
+	LightCheck_Check("bus", sBus.ui32Refused == 0 && sStats.ui32Missed == 0,
+					 "%u transfers, %u failed, %u refused, %u queued at most, %.2f %% busy", sBus.ui32Transfers,
+					 sBus.ui32Failures, sBus.ui32Refused, sBus.ui32MaxQueued,
+					 100.0 * sBus.ui64BusyCycles / SIM_CYCLES_MS(LIGHT_CHECK_DURATION));
+	printf("     %u of %u conversions read, %u transfer errors\n", sStats.ui32Conversions,
+		   LightSensor_GetConversions(), sStats.ui32Errors);
+}
+
+/**
+ * @brief Writes the recorded readings
+ *
+ * @param pcPath The file to write
+ */
+void LightCheck_WriteCSV(const char *pcPath) {
+	FILE *psFile = fopen(pcPath, "w");
+	if (psFile == NULL) {
+		fprintf(stderr, "light_check: cannot write %s\n", pcPath);
+		return;
+	}
+
+	fprintf(psFile, "ms,profile,reading,conversions\n");
+	for (uint32_t i = 0; i < LIGHT_CHECK_SAMPLES; i++) {
+		fprintf(psFile, "%u,%.2f,%.2f,%u\n", i * LIGHT_CHECK_PERIOD, ga_dLightCheckLux[i],
+				ga_ui32LightCheckReading[i] / 100.0, ga_ui32LightCheckConversions[i]);
+	}
+	fclose(psFile);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @param argc The number of arguments
+ * @param argv Optionally the file to write the readings to
+ * @return 0 if every check passed
+ */
+int main(int argc, char **argv) {
+	srand(LIGHT_CHECK_SEED);
+	LightSensor_Start();
+
+	/* The sampler is created first, so the sensor is off the bus before the driver looks for it */
+	uint8_t ui8Sample = Sim_TimerCreate(LightCheck_Sample, 0);
+	Sim_TimerStart(ui8Sample, 0, SIM_CYCLES_MS(LIGHT_CHECK_PERIOD));
+
+	/* Like main.c */
+	if (!OPT3001_Init()) {
+		printf("FAIL: the bus could not be opened\n");
+		return 1;
+	}
+	Clock_Params clockParams;
+	Clock_Params_init(&clockParams);
+	clockParams.startFlag = true;
+	clockParams.period = LIGHT_WATCHDOG;
+	Clock_create((Clock_FuncPtr)OPT3001_Poll, LIGHT_WATCHDOG, &clockParams, NULL);
+
+	BIOS_start();
+
+	LightCheck_WriteCSV(argc > 1 ? argv[1] : "light.csv");
+	LightCheck_Report();
+	printf("%s: %u check(s) failed\n", g_ui8LightCheckFailures == 0 ? "PASS" : "FAIL", g_ui8LightCheckFailures);
+	return g_ui8LightCheckFailures == 0 ? 0 : 1;
+}
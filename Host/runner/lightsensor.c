@@ -0,0 +1,259 @@
+/**
+ * @file lightsensor.c
+ * @brief Host model of the OPT3001 light sensor on the emulated I2C bus
+ */
+#pragma region Includes
+#include "lightsensor.h"
+#include "i2cbus.h"
+#include "devices.h"
+#include "sim.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define LIGHTSENSOR_REG_RESULT 0x00
+#define LIGHTSENSOR_REG_CONFIG 0x01
+#define LIGHTSENSOR_REG_LOW_LIMIT 0x02
+#define LIGHTSENSOR_REG_HIGH_LIMIT 0x03
+#define LIGHTSENSOR_REG_MANUFACTURER_ID 0x7E
+#define LIGHTSENSOR_REG_DEVICE_ID 0x7F
+#define LIGHTSENSOR_CONFIG_RESET 0xC810	   // Automatic range, 800 ms conversions, shut down, latched
+#define LIGHTSENSOR_CONFIG_WRITABLE 0xFE1F // The range, time, mode, latch, polarity, mask and fault count
+#define LIGHTSENSOR_CONFIG_CT 0x0800
+#define LIGHTSENSOR_CONFIG_MODE 0x0600
+#define LIGHTSENSOR_CONFIG_SINGLE 0x0200
+#define LIGHTSENSOR_CONFIG_OVF 0x0100
+#define LIGHTSENSOR_CONFIG_FLAGS 0x00E0 // Conversion ready and the two limit flags, cleared by a read
+#define LIGHTSENSOR_CONFIG_CRF 0x0080
+#define LIGHTSENSOR_CONFIG_L 0x0010
+#define LIGHTSENSOR_AUTO_RANGE 0xC
+#define LIGHTSENSOR_END_OF_CONVERSION 0xC000
+#define LIGHTSENSOR_TICK 100 // ms, the short conversion time, the long one is 8 ticks
+
+/* Global variables */
+uint16_t g_ui16LightSensorConfig;
+uint16_t g_ui16LightSensorLowLimit;
+uint16_t g_ui16LightSensorHighLimit;
+uint16_t g_ui16LightSensorResult;
+uint8_t g_ui8LightSensorPointer;
+uint8_t g_ui8LightSensorTicks;
+bool g_bLightSensorAsserted;
+bool g_bLightSensorPresent = true;
+bool g_bLightSensorDropEdge = false;
+double g_dLightSensorLux = 0;
+uint32_t g_ui32LightSensorConversions = 0;
+uint8_t g_ui8LightSensorTimer;
+
+bool LightSensor_Write(const uint8_t *pui8Data, size_t szCount);
+bool LightSensor_Read(uint8_t *pui8Data, size_t szCount);
+
+const tI2CBusDevice gc_sLightSensorDevice = {
+	.ui8Address = Board_OPT3001_ADDR,
+	.pfnWrite = LightSensor_Write,
+	.pfnRead = LightSensor_Read,
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Puts the registers in their power-up state
+ *
+ */
+void LightSensor_Reset() {
+	g_ui16LightSensorConfig = LIGHTSENSOR_CONFIG_RESET;
+	g_ui16LightSensorLowLimit = 0x0000;
+	g_ui16LightSensorHighLimit = 0xBFFF;
+	g_ui16LightSensorResult = 0;
+	g_ui8LightSensorPointer = LIGHTSENSOR_REG_RESULT;
+	g_ui8LightSensorTicks = 0;
+	g_bLightSensorAsserted = false;
+}
+
+/**
+ * @brief Encodes a light level as the result register does
+ *
+ * @param dLux The light level (lux)
+ * @return The result, a 4 bit exponent over a 12 bit mantissa, with the overflow flag in bit 16
+ */
+uint32_t LightSensor_Encode(double dLux) {
+	double dCounts = fmax(dLux, 0) * 100;
+	uint8_t ui8Range = g_ui16LightSensorConfig >> 12;
+	uint8_t ui8Exponent = ui8Range;
+	if (ui8Range == LIGHTSENSOR_AUTO_RANGE) {
+		ui8Exponent = 0;
+		while (ui8Exponent < 11 && dCounts / (1 << ui8Exponent) > 4095)
+			ui8Exponent++;
+	}
+
+	long lMantissa = lround(dCounts / (1 << ui8Exponent));
+	uint32_t ui32Overflow = lMantissa > 4095 ? 0x10000 : 0;
+	return ui32Overflow | (uint32_t)ui8Exponent << 12 | (uint32_t)(lMantissa > 4095 ? 4095 : lMantissa);
+}
+
+/**
+ * @brief Converts when a conversion is due and raises the interrupt
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every LIGHTSENSOR_TICK ms
+ */
+void LightSensor_Tick(uintptr_t arg) {
+	uint16_t ui16Mode = g_ui16LightSensorConfig & LIGHTSENSOR_CONFIG_MODE;
+	if (!g_bLightSensorPresent || ui16Mode == 0) {
+		g_ui8LightSensorTicks = 0;
+		return;
+	}
+
+	uint8_t ui8Ticks = g_ui16LightSensorConfig & LIGHTSENSOR_CONFIG_CT ? 8 : 1;
+	if (++g_ui8LightSensorTicks < ui8Ticks)
+		return;
+	g_ui8LightSensorTicks = 0;
+
+	uint32_t ui32Result = LightSensor_Encode(g_dLightSensorLux);
+	g_ui16LightSensorResult = (uint16_t)ui32Result;
+	g_ui16LightSensorConfig = (g_ui16LightSensorConfig & ~LIGHTSENSOR_CONFIG_OVF) | LIGHTSENSOR_CONFIG_CRF |
+							  (ui32Result >> 16 ? LIGHTSENSOR_CONFIG_OVF : 0);
+	if (ui16Mode == LIGHTSENSOR_CONFIG_SINGLE)
+		g_ui16LightSensorConfig &= ~LIGHTSENSOR_CONFIG_MODE;
+	g_ui32LightSensorConversions++;
+
+	/* Only the end-of-conversion interrupt is modelled. A latched pin that is still low gives no edge */
+	if ((g_ui16LightSensorLowLimit & LIGHTSENSOR_END_OF_CONVERSION) != LIGHTSENSOR_END_OF_CONVERSION)
+		return;
+	if (!(g_ui16LightSensorConfig & LIGHTSENSOR_CONFIG_L))
+		g_bLightSensorAsserted = false;
+	if (g_bLightSensorAsserted)
+		return;
+
+	g_bLightSensorAsserted = true;
+	if (g_bLightSensorDropEdge)
+		g_bLightSensorDropEdge = false;
+	else
+		Devices_RaisePin(Board_OPT3001_INT);
+}
+
+/**
+ * @brief Takes a write, the register pointer then optionally the register
+ *
+ * @param pui8Data The bytes written
+ * @param szCount The number of bytes
+ * @return False if the sensor is off the bus
+ *
+ * @note Called from interrupt context by the bus
+ */
+bool LightSensor_Write(const uint8_t *pui8Data, size_t szCount) {
+	if (!g_bLightSensorPresent)
+		return false;
+
+	g_ui8LightSensorPointer = pui8Data[0];
+	if (szCount < 3)
+		return true;
+
+	uint16_t ui16Value = (pui8Data[1] << 8) | pui8Data[2];
+	switch (g_ui8LightSensorPointer) {
+	case LIGHTSENSOR_REG_CONFIG: {
+		/* Leaving shutdown starts a conversion from scratch */
+		bool bStarting = !(g_ui16LightSensorConfig & LIGHTSENSOR_CONFIG_MODE) && (ui16Value & LIGHTSENSOR_CONFIG_MODE);
+		g_ui16LightSensorConfig =
+			(g_ui16LightSensorConfig & ~LIGHTSENSOR_CONFIG_WRITABLE) | (ui16Value & LIGHTSENSOR_CONFIG_WRITABLE);
+		if (bStarting) {
+			g_ui8LightSensorTicks = 0;
+			Sim_TimerStart(g_ui8LightSensorTimer, Sim_Now() + SIM_CYCLES_MS(LIGHTSENSOR_TICK),
+						   SIM_CYCLES_MS(LIGHTSENSOR_TICK));
+		}
+		break;
+	}
+	case LIGHTSENSOR_REG_LOW_LIMIT:
+		g_ui16LightSensorLowLimit = ui16Value;
+		break;
+	case LIGHTSENSOR_REG_HIGH_LIMIT:
+		g_ui16LightSensorHighLimit = ui16Value;
+		break;
+	default:
+		/* The result and the IDs are read only */
+		break;
+	}
+	return true;
+}
+
+/**
+ * @brief Fills a read of the register the pointer selects
+ *
+ * @param pui8Data The bytes to fill
+ * @param szCount The number of bytes
+ * @return False if the sensor is off the bus
+ *
+ * @note Called from interrupt context by the bus
+ */
+bool LightSensor_Read(uint8_t *pui8Data, size_t szCount) {
+	if (!g_bLightSensorPresent)
+		return false;
+
+	uint16_t ui16Value = 0xFFFF;
+	switch (g_ui8LightSensorPointer) {
+	case LIGHTSENSOR_REG_RESULT:
+		ui16Value = g_ui16LightSensorResult;
+		break;
+	case LIGHTSENSOR_REG_CONFIG:
+		/* Reading the configuration clears the flags and releases a latched interrupt */
+		ui16Value = g_ui16LightSensorConfig;
+		g_ui16LightSensorConfig &= ~LIGHTSENSOR_CONFIG_FLAGS;
+		g_bLightSensorAsserted = false;
+		break;
+	case LIGHTSENSOR_REG_LOW_LIMIT:
+		ui16Value = g_ui16LightSensorLowLimit;
+		break;
+	case LIGHTSENSOR_REG_HIGH_LIMIT:
+		ui16Value = g_ui16LightSensorHighLimit;
+		break;
+	case LIGHTSENSOR_REG_MANUFACTURER_ID:
+		ui16Value = 0x5449;
+		break;
+	case LIGHTSENSOR_REG_DEVICE_ID:
+		ui16Value = 0x3001;
+		break;
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i < szCount; i++) {
+		pui8Data[i] = i % 2 == 0 ? ui16Value >> 8 : ui16Value & 0xFF;
+	}
+	return true;
+}
+#pragma endregion
+
+#pragma region LightSensor API functions
+void LightSensor_Start() {
+	LightSensor_Reset();
+	g_ui8LightSensorTimer = Sim_TimerCreate(LightSensor_Tick, 0);
+	I2CBus_Attach(Board_I2C0, &gc_sLightSensorDevice);
+}
+
+void LightSensor_SetLux(double dLux) {
+	g_dLightSensorLux = dLux;
+}
+
+void LightSensor_SetPresent(bool bPresent) {
+	if (bPresent && !g_bLightSensorPresent)
+		LightSensor_Reset();
+	g_bLightSensorPresent = bPresent;
+}
+
+void LightSensor_DropEdge() {
+	g_bLightSensorDropEdge = true;
+}
+
+uint32_t LightSensor_GetConversions() {
+	return g_ui32LightSensorConversions;
+}
+#pragma endregion
@@ -0,0 +1,48 @@
+/**
+ * @file lightsensor.h
+ * @brief Host model of the OPT3001 light sensor on the emulated I2C bus (see i2cbus.h)
+ *
+ * The registers the driver uses are modelled: the result, the configuration with its conversion
+ * ready flag, the low limit that selects the end-of-conversion interrupt, and the IDs. Conversions
+ * follow the configured mode and time, with the automatic or a fixed range, and the INT pin falls
+ * at the end of each one, staying low until the configuration is read when it is latched. Window
+ * comparisons and the fault count are not modelled.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Attaches the sensor to Board_I2C0 at Board_OPT3001_ADDR, powered up and shut down
+ *
+ * @note Must be called before BIOS_start or from a timer function, the interrupt goes to Board_OPT3001_INT
+ */
+void LightSensor_Start();
+
+/**
+ * @brief Sets the light level the following conversions measure
+ *
+ * @param dLux The light level (lux)
+ */
+void LightSensor_SetLux(double dLux);
+
+/**
+ * @brief Takes the sensor off the bus or puts it back, like a loose connector would
+ *
+ * @param bPresent Whether the sensor answers, it is reset when it comes back
+ */
+void LightSensor_SetPresent(bool bPresent);
+
+/**
+ * @brief Hides the next falling edge of the interrupt pin from the processor
+ *
+ * @note The pin still falls, so with a latched interrupt no edge follows until the configuration is read
+ */
+void LightSensor_DropEdge();
+
+/**
+ * @brief Gets the number of conversions made
+ *
+ * @return The number of conversions since the sensor was started
+ */
+uint32_t LightSensor_GetConversions();
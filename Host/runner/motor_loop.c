@@ -0,0 +1,421 @@
+/**
+ * @file motor_loop.c
+ * @brief Host validation of the motor speed loop against a simulated motor
+ *
+ * motor.c and control.c run unchanged, triggered by the emulated TIMER2A (see gptm.h). The motor
+ * is a first-order plant, speed = MOTOR_LOOP_FULL_SPEED * duty at steady state with a time
+ * constant of MOTOR_LOOP_TAU, integrated every MOTOR_LOOP_STEP and published on the data bus
+ * like the speed sensor. A fixed scenario steps the setpoints and every phase is checked:
+ *   0 ms     start at 200 RPM                  overshoot, settling time and steady-state error
+ *   1500 ms  load step                         recovery
+ *   2000 ms  max power 50 %, 250 RPM           duty clamped to the power limit
+ *   3000 ms  max power 100 %                   overshoot after saturation, the windup check
+ *   4000 ms  max accel 10, 100 RPM             reference slope
+ *            in a burst of speeds, as a held button posts them
+ *   6000 ms  e-stop for 500 ms                 duty off, and still off after the release
+ *   6700 ms  start                             a bumpless restart from the coasting speed
+ *   7000 ms  stop                              duty off
+ *
+ * The mailbox must have applied one command per kind and period, the rest of a burst replaced before it was
+ * applied.
+ *
+ * Only the plant spends simulated time, so the jitter and execution times reported here only
+ * show the structure of the loop (no missed periods, interrupt to task hand-off). The target
+ * values are read with Motor_GetTimingStats.
+ *
+ * Writes motor.csv with one line per control period, prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make motor_loop
+ *   ./motor_loop
+ */
+#pragma region Includes
+#include "sim.h"
+#include "gptm.h"
+#include "motor.h"
+#include "bus.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+#include <xdc/runtime/Timestamp.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Task.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define MOTOR_LOOP_FULL_SPEED 300.0 // Speed at full duty without load (RPM)
+#define MOTOR_LOOP_TAU 0.1			// Mechanical time constant (s)
+#define MOTOR_LOOP_LOAD 30.0		// Speed lost to the load step at the same duty (RPM)
+#define MOTOR_LOOP_STEP 100			// Plant integration step (us)
+#define MOTOR_LOOP_DURATION 7500	// ms
+#define MOTOR_LOOP_BAND 2			// Settled within this many RPM of the setpoint
+#define MOTOR_LOOP_RESOLUTION 1		// The speed is published in whole RPM
+#define MOTOR_LOOP_DUTY_MAX 32767
+
+/**
+ * @brief Kinds of scenario step
+ *
+ */
+typedef enum tMotorLoopAction {
+	MOTOR_LOOP_ACTION_POST,
+	MOTOR_LOOP_ACTION_LOAD,
+	MOTOR_LOOP_ACTION_ESTOP,
+} tMotorLoopAction;
+
+/**
+ * @brief A step of the scenario
+ *
+ */
+typedef struct tMotorLoopStep {
+	uint32_t ui32Time; // ms
+	tMotorLoopAction eAction;
+	tMotorCommand eCommand;
+	int32_t i32Value;
+} tMotorLoopStep;
+
+/**
+ * @brief The state of the loop at the end of a control period
+ *
+ */
+typedef struct tMotorLoopSample {
+	double dSpeed;
+	tMotorStatus sStatus;
+} tMotorLoopSample;
+
+/* The scenario, in time order */
+const tMotorLoopStep gc_sMotorLoopSteps[] = {
+	{0, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_POWER, MAX_POWER},
+	{0, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_ACCEL, MAX_ACCEL},
+	{0, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 200},
+	{0, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_STATE, 1},
+	{1500, MOTOR_LOOP_ACTION_LOAD, 0, 1},
+	{2000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_POWER, MAX_POWER / 2},
+	{2000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 250},
+	{3000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_POWER, MAX_POWER},
+	{4000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_ACCEL, 10},
+	{4000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 240},
+	{4000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 200},
+	{4000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 150},
+	{4000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 100},
+	{6000, MOTOR_LOOP_ACTION_ESTOP, 0, 1},
+	{6500, MOTOR_LOOP_ACTION_ESTOP, 0, 0},
+	{6700, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_STATE, 1},
+	{7000, MOTOR_LOOP_ACTION_POST, MOTOR_COMMAND_STATE, 0},
+};
+
+/* Global variables */
+Task_Struct g_sMotorLoopTask;
+char ga_cMotorLoopStack[2048];
+double g_dMotorLoopSpeed = 0;
+bool g_bMotorLoopLoad = false;
+uint8_t g_ui8MotorLoopStep = 0;
+tMotorLoopSample ga_sMotorLoopSamples[MOTOR_LOOP_DURATION];
+uint8_t g_ui8MotorLoopFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Integrates the motor over one step and publishes its speed
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every MOTOR_LOOP_STEP, before the control timer
+ */
+void MotorLoop_Plant(uintptr_t arg) {
+	tMotorStatus sStatus;
+	Motor_GetStatus(&sStatus);
+
+	double dTarget = MOTOR_LOOP_FULL_SPEED * sStatus.i32Duty / MOTOR_LOOP_DUTY_MAX - (g_bMotorLoopLoad ? MOTOR_LOOP_LOAD : 0);
+	if (dTarget < 0)
+		dTarget = 0;
+	g_dMotorLoopSpeed += (dTarget - g_dMotorLoopSpeed) * (MOTOR_LOOP_STEP * 1e-6 / MOTOR_LOOP_TAU);
+	Bus_Publish(BUS_TOPIC_SPEED, (int32_t)lround(g_dMotorLoopSpeed));
+}
+
+/**
+ * @brief Runs the scenario steps that are due and records the previous control period
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every millisecond, just before the control timer
+ */
+void MotorLoop_Script(uintptr_t arg) {
+	uint32_t ui32Now = Sim_Now() / SIM_TICK_CYCLES;
+	if (ui32Now > 0 && ui32Now <= MOTOR_LOOP_DURATION) {
+		tMotorLoopSample *psSample = &ga_sMotorLoopSamples[ui32Now - 1];
+		psSample->dSpeed = g_dMotorLoopSpeed;
+		Motor_GetStatus(&psSample->sStatus);
+	}
+	if (ui32Now >= MOTOR_LOOP_DURATION) {
+		Sim_Stop();
+		return;
+	}
+
+	while (g_ui8MotorLoopStep < sizeof(gc_sMotorLoopSteps) / sizeof(gc_sMotorLoopSteps[0]) &&
+		   gc_sMotorLoopSteps[g_ui8MotorLoopStep].ui32Time <= ui32Now) {
+		const tMotorLoopStep *psStep = &gc_sMotorLoopSteps[g_ui8MotorLoopStep++];
+		switch (psStep->eAction) {
+		case MOTOR_LOOP_ACTION_POST:
+			Motor_Post(psStep->eCommand, psStep->i32Value);
+			break;
+		case MOTOR_LOOP_ACTION_LOAD:
+			g_bMotorLoopLoad = psStep->i32Value != 0;
+			break;
+		case MOTOR_LOOP_ACTION_ESTOP:
+			Motor_EStop(psStep->i32Value != 0);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void MotorLoop_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8MotorLoopFailures++;
+}
+
+/**
+ * @brief Finds the largest speed above a setpoint in a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @param i32Setpoint The setpoint (RPM)
+ * @return The overshoot (RPM)
+ */
+double MotorLoop_Overshoot(uint32_t ui32Start, uint32_t ui32End, int32_t i32Setpoint) {
+	double dPeak = 0;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		if (ga_sMotorLoopSamples[i].dSpeed - i32Setpoint > dPeak)
+			dPeak = ga_sMotorLoopSamples[i].dSpeed - i32Setpoint;
+	}
+	return dPeak;
+}
+
+/**
+ * @brief Finds the time after which the speed stays within MOTOR_LOOP_BAND of a setpoint
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @param i32Setpoint The setpoint (RPM)
+ * @return The time from the first sample (ms)
+ */
+uint32_t MotorLoop_Settling(uint32_t ui32Start, uint32_t ui32End, int32_t i32Setpoint) {
+	uint32_t ui32Settled = ui32End;
+	for (uint32_t i = ui32End; i > ui32Start; i--) {
+		if (fabs(ga_sMotorLoopSamples[i - 1].dSpeed - i32Setpoint) > MOTOR_LOOP_BAND)
+			break;
+		ui32Settled = i - 1;
+	}
+	return ui32Settled - ui32Start;
+}
+
+/**
+ * @brief Finds the mean speed error over a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @param i32Setpoint The setpoint (RPM)
+ * @return The mean of the setpoint minus the speed (RPM)
+ */
+double MotorLoop_Error(uint32_t ui32Start, uint32_t ui32End, int32_t i32Setpoint) {
+	double dSum = 0;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		dSum += i32Setpoint - ga_sMotorLoopSamples[i].dSpeed;
+	}
+	return dSum / (ui32End - ui32Start);
+}
+
+/**
+ * @brief Finds the largest duty in a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @return The duty
+ */
+int32_t MotorLoop_PeakDuty(uint32_t ui32Start, uint32_t ui32End) {
+	int32_t i32Peak = 0;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		if (ga_sMotorLoopSamples[i].sStatus.i32Duty > i32Peak)
+			i32Peak = ga_sMotorLoopSamples[i].sStatus.i32Duty;
+	}
+	return i32Peak;
+}
+
+/**
+ * @brief Checks every phase of the scenario and prints the report
+ *
+ */
+void MotorLoop_Report() {
+	/* Start: the S-curve at full acceleration takes 200 / 2550 s plus MOTOR_JERK_TIME and saturates the duty, integrating
+	   through it overshoots */
+	double dOvershoot = MotorLoop_Overshoot(0, 1500, 200);
+	uint32_t ui32Settling = MotorLoop_Settling(0, 1500, 200);
+	double dError = MotorLoop_Error(1000, 1500, 200);
+	MotorLoop_Check("start overshoot", dOvershoot < 200 * 0.05, "%.1f RPM", dOvershoot);
+	MotorLoop_Check("start settling", ui32Settling < 250 + MOTOR_JERK_TIME, "%u ms", ui32Settling);
+	MotorLoop_Check("start steady-state error", fabs(dError) < MOTOR_LOOP_RESOLUTION, "%.2f RPM", dError);
+
+	/* Load step: the integrator must take the load within the same time */
+	dError = MotorLoop_Error(1800, 2000, 200);
+	ui32Settling = MotorLoop_Settling(1500, 2000, 200);
+	MotorLoop_Check("load recovery", ui32Settling < 250, "%u ms", ui32Settling);
+	MotorLoop_Check("load steady-state error", fabs(dError) < MOTOR_LOOP_RESOLUTION, "%.2f RPM", dError);
+
+	/* Half power cannot reach 250 RPM, the duty must stay at the limit */
+	int32_t i32Duty = MotorLoop_PeakDuty(2000, 3000);
+	int32_t i32Limit = MAX_POWER / 2 * MOTOR_LOOP_DUTY_MAX / MAX_POWER;
+	MotorLoop_Check("power clamp", i32Duty <= i32Limit, "peak duty %d of %d", i32Duty, i32Limit);
+
+	/* The integral must not have grown past the power limit while the duty was clamped */
+	dOvershoot = MotorLoop_Overshoot(3000, 4000, 250);
+	ui32Settling = MotorLoop_Settling(3000, 4000, 250);
+	MotorLoop_Check("windup overshoot", dOvershoot < 250 * 0.05, "%.1f RPM", dOvershoot);
+	MotorLoop_Check("windup settling", ui32Settling < 300, "%u ms", ui32Settling);
+
+	/* Max accel 10 ramps the reference at 100 RPM/s, 150 RPM take 1.5 s plus MOTOR_JERK_TIME */
+	int32_t i32Slope = 0;
+	for (uint32_t i = 4001; i < 6000; i++) {
+		int32_t i32Step = ga_sMotorLoopSamples[i - 1].sStatus.i32Reference - ga_sMotorLoopSamples[i].sStatus.i32Reference;
+		if (i32Step > i32Slope)
+			i32Slope = i32Step;
+	}
+	uint32_t ui32Reached = 4000;
+	while (ui32Reached < 6000 && ga_sMotorLoopSamples[ui32Reached].sStatus.i32Reference > 100)
+		ui32Reached++;
+	MotorLoop_Check("accel limit", i32Slope <= 1 && ui32Reached - 4000 >= 1450, "reference at setpoint after %u ms",
+					ui32Reached - 4000);
+	dError = MotorLoop_Error(5600, 6000, 100);
+	MotorLoop_Check("accel steady-state error", fabs(dError) < MOTOR_LOOP_RESOLUTION, "%.2f RPM", dError);
+
+	/* E-stop: off from the first period and after the release, then a new start from the coasting speed */
+	i32Duty = MotorLoop_PeakDuty(6001, 6500);
+	MotorLoop_Check("e-stop", i32Duty == 0, "peak duty %d", i32Duty);
+	i32Duty = MotorLoop_PeakDuty(6501, 6700);
+	MotorLoop_Check("e-stop release", i32Duty == 0, "peak duty %d until the next start", i32Duty);
+	int32_t i32Jump = abs(ga_sMotorLoopSamples[6701].sStatus.i32Reference - (int32_t)lround(ga_sMotorLoopSamples[6700].dSpeed));
+	dOvershoot = MotorLoop_Overshoot(6700, 7000, 100);
+	MotorLoop_Check("e-stop restart", i32Jump <= 3 && dOvershoot < 100 * 0.05, "reference jump %d RPM, overshoot %.1f RPM",
+					i32Jump, dOvershoot);
+
+	/* Stop */
+	i32Duty = MotorLoop_PeakDuty(7001, MOTOR_LOOP_DURATION);
+	MotorLoop_Check("stop", i32Duty == 0, "peak duty %d", i32Duty);
+
+	/* Posts of the same kind in the same step are replaced by the last one, the most kinds are posted at the start */
+	uint32_t ui32Posted = 0, ui32Coalesced = 0;
+	uint8_t ui8Steps = sizeof(gc_sMotorLoopSteps) / sizeof(gc_sMotorLoopSteps[0]);
+	for (uint8_t i = 0; i < ui8Steps; i++) {
+		const tMotorLoopStep *psStep = &gc_sMotorLoopSteps[i];
+		if (psStep->eAction != MOTOR_LOOP_ACTION_POST)
+			continue;
+		ui32Posted++;
+		for (uint8_t j = i + 1; j < ui8Steps; j++) {
+			const tMotorLoopStep *psLater = &gc_sMotorLoopSteps[j];
+			if (psLater->ui32Time == psStep->ui32Time && psLater->eAction == MOTOR_LOOP_ACTION_POST &&
+				psLater->eCommand == psStep->eCommand) {
+				ui32Coalesced++;
+				break;
+			}
+		}
+	}
+	tMotorMailboxStats sMailbox;
+	Motor_GetMailboxStats(&sMailbox);
+	MotorLoop_Check("mailbox", sMailbox.ui32Posted == ui32Posted && sMailbox.ui32Coalesced == ui32Coalesced &&
+								   sMailbox.ui32Applied == ui32Posted - ui32Coalesced && sMailbox.ui8Depth == 0 &&
+								   sMailbox.ui8PeakDepth == MOTOR_COMMAND_COUNT,
+					"%u posted, %u applied, %u coalesced of %u, peak depth %u", sMailbox.ui32Posted, sMailbox.ui32Applied,
+					sMailbox.ui32Coalesced, ui32Coalesced, sMailbox.ui8PeakDepth);
+
+	tMotorTimingStats sTiming;
+	Types_FreqHz sFreq;
+	Motor_GetTimingStats(&sTiming);
+	Timestamp_getFreq(&sFreq);
+	uint32_t ui32PerUs = sFreq.lo / 1000000;
+	uint32_t ui32Timeouts = GPTM_GetTimeouts(TIMER2_BASE);
+	MotorLoop_Check("control periods", sTiming.ui32Missed == 0 && sTiming.ui32Periods + 1 >= ui32Timeouts,
+					"%u of %u timer periods, %u missed", sTiming.ui32Periods, ui32Timeouts, sTiming.ui32Missed);
+	printf("timing: worst jitter %u us, worst latency %u us, worst execution %u us\n", sTiming.ui32WorstJitter / ui32PerUs,
+		   sTiming.ui32WorstLatency / ui32PerUs, sTiming.ui32WorstExecution / ui32PerUs);
+}
+
+/**
+ * @brief Writes the recorded control periods
+ *
+ * @param pcPath The file to write
+ */
+void MotorLoop_WriteCSV(const char *pcPath) {
+	FILE *psFile = fopen(pcPath, "w");
+	if (psFile == NULL) {
+		fprintf(stderr, "motor_loop: cannot write %s\n", pcPath);
+		return;
+	}
+
+	fprintf(psFile, "ms,running,reference,speed,duty\n");
+	for (uint32_t i = 0; i < MOTOR_LOOP_DURATION; i++) {
+		const tMotorLoopSample *psSample = &ga_sMotorLoopSamples[i];
+		fprintf(psFile, "%u,%d,%d,%.2f,%d\n", i, psSample->sStatus.bRunning, psSample->sStatus.i32Reference, psSample->dSpeed,
+				psSample->sStatus.i32Duty);
+	}
+	fclose(psFile);
+}
+#pragma endregion
+
+/**
+ * @brief Host validation entry point
+ *
+ * @param argc The number of arguments
+ * @param argv Optionally the file to write the control periods to
+ * @return 0 if every check passed
+ */
+int main(int argc, char **argv) {
+	/* The plant and the script are created first, so they run before the control timer at the same time */
+	uint8_t ui8Plant = Sim_TimerCreate(MotorLoop_Plant, 0);
+	uint8_t ui8Script = Sim_TimerCreate(MotorLoop_Script, 0);
+	Sim_TimerStart(ui8Plant, SIM_CYCLES_US(MOTOR_LOOP_STEP), SIM_CYCLES_US(MOTOR_LOOP_STEP));
+	Sim_TimerStart(ui8Script, 0, SIM_CYCLES_MS(1));
+
+	Types_FreqHz sFreq;
+	BIOS_getCpuFreq(&sFreq);
+	Motor_Init(sFreq.lo);
+
+	Task_Params taskParams;
+	Task_Params_init(&taskParams);
+	taskParams.stackSize = sizeof(ga_cMotorLoopStack);
+	taskParams.stack = &ga_cMotorLoopStack;
+	taskParams.priority = 3;
+	Task_construct(&g_sMotorLoopTask, (Task_FuncPtr)Motor_Control, &taskParams, NULL);
+
+	BIOS_start();
+
+	MotorLoop_WriteCSV(argc > 1 ? argv[1] : "motor.csv");
+	MotorLoop_Report();
+	printf("%s: %u check(s) failed\n", g_ui8MotorLoopFailures == 0 ? "PASS" : "FAIL", g_ui8MotorLoopFailures);
+	return g_ui8MotorLoopFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,347 @@
+/**
+ * @file numeric_check.c
+ * @brief Host check of the fixed width numeric readout and the integer formatting behind it
+ *
+ * util.c and numeric.c run unchanged on the graphics library, drawing on a framebuffer display that records
+ * every pixel written:
+ *   format               FormatInt against a table of values, widths and pads, including the overflow cases
+ *   first draw           every cell of a readout is cleared and drawn once
+ *   same value           drawing the value on screen again writes no pixel
+ *   cells                a sequence of values only writes the cells whose character changed, one fill each
+ *   fresh draw           after every value of the sequence the readout matches one drawn from scratch
+ *
+ * The sequence is played on a space padded readout with the speed font and on a zero padded one with the
+ * option font, as on the main panel.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make numeric_check
+ *   ./numeric_check
+ */
+#pragma region Includes
+#include "numeric.h"
+#include "util.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdarg.h>
+
+/* GRLib header files */
+#include "grlib/grlib.h"
+#include "fonts/fontnf24.h"
+#include "fonts/fontnf36.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define NUMERIC_CHECK_WIDTH 320
+#define NUMERIC_CHECK_HEIGHT 240
+#define NUMERIC_CHECK_BACKGROUND ClrBlack
+
+/**
+ * @brief A FormatInt case and what it should give
+ *
+ */
+typedef struct tNumericCheckFormat {
+	int32_t i32Value;
+	uint8_t ui8Width;
+	char cPad;
+	const char *pcText;
+	bool bFits;
+} tNumericCheckFormat;
+
+const tNumericCheckFormat gc_sNumericCheckFormats[] = {
+	{0, 3, ' ', "  0", true},
+	{42, 4, ' ', "  42", true},
+	{42, 4, '0', "0042", true},
+	{-42, 4, ' ', " -42", true},
+	{-42, 4, '0', "-042", true},
+	{999, 3, ' ', "999", true},
+	{1000, 3, ' ', "---", false},
+	{-99, 3, ' ', "-99", true},
+	{-100, 3, '0', "---", false},
+	{-100, 4, '0', "-100", true},
+	{-1, 1, ' ', "-", false},
+	{5, 1, '0', "5", true},
+	{INT32_MAX, 6, ' ', "------", false},
+	{INT32_MIN, 6, '0', "------", false},
+};
+
+/* The values played on each readout, so that one, several, all and no cells change */
+const int32_t gc_i32NumericCheckValues[] = {1234, 1235, 1245, 1245, 5, -5, -15, 12345, 0, 9999, 99, -9, 10};
+
+/* Global variables */
+uint32_t g_pui32NumericCheckFrame[NUMERIC_CHECK_HEIGHT][NUMERIC_CHECK_WIDTH];
+bool g_pbNumericCheckWritten[NUMERIC_CHECK_HEIGHT][NUMERIC_CHECK_WIDTH];
+uint32_t g_ui32NumericCheckFills = 0;
+uint32_t g_ui32NumericCheckPixels = 0;
+uint8_t g_ui8NumericCheckFailures = 0;
+#pragma endregion
+
+#pragma region Display functions
+/**
+ * @brief Writes a pixel of the framebuffer and records it
+ *
+ * @param i32X The x position
+ * @param i32Y The y position
+ * @param ui32Value The color
+ */
+void NumericCheck_Write(int32_t i32X, int32_t i32Y, uint32_t ui32Value) {
+	if (i32X < 0 || i32X >= NUMERIC_CHECK_WIDTH || i32Y < 0 || i32Y >= NUMERIC_CHECK_HEIGHT)
+		return;
+
+	g_pui32NumericCheckFrame[i32Y][i32X] = ui32Value;
+	g_pbNumericCheckWritten[i32Y][i32X] = true;
+	g_ui32NumericCheckPixels++;
+}
+
+void NumericCheck_PixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value) {
+	NumericCheck_Write(i32X, i32Y, ui32Value);
+}
+
+void NumericCheck_PixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y, int32_t i32X0, int32_t i32Count,
+									int32_t i32BPP, const uint8_t *pui8Data, const uint8_t *pui8Palette) {
+	/* Only the 1 bpp runs used for text, the palette holds the background then the foreground */
+	const uint32_t *pui32Palette = (const uint32_t *)pui8Palette;
+	for (int32_t i = 0; i < i32Count; i++) {
+		int32_t i32Bit = i32X0 + i;
+		bool bSet = (pui8Data[i32Bit / 8] >> (7 - i32Bit % 8)) & 1;
+		NumericCheck_Write(i32X + i, i32Y, pui32Palette[bSet]);
+	}
+}
+
+void NumericCheck_LineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value) {
+	for (int32_t x = i32X1; x <= i32X2; x++)
+		NumericCheck_Write(x, i32Y, ui32Value);
+}
+
+void NumericCheck_LineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2, uint32_t ui32Value) {
+	for (int32_t y = i32Y1; y <= i32Y2; y++)
+		NumericCheck_Write(i32X, y, ui32Value);
+}
+
+void NumericCheck_RectFill(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value) {
+	g_ui32NumericCheckFills++;
+	for (int32_t y = psRect->i16YMin; y <= psRect->i16YMax; y++)
+		NumericCheck_LineDrawH(pvDisplayData, psRect->i16XMin, psRect->i16XMax, y, ui32Value);
+}
+
+uint32_t NumericCheck_ColorTranslate(void *pvDisplayData, uint32_t ui32Value) {
+	return ui32Value;
+}
+
+void NumericCheck_Flush(void *pvDisplayData) {
+}
+
+const tDisplay g_sNumericCheckDisplay = {
+	sizeof(tDisplay),
+	NULL,
+	NUMERIC_CHECK_WIDTH,
+	NUMERIC_CHECK_HEIGHT,
+	NumericCheck_PixelDraw,
+	NumericCheck_PixelDrawMultiple,
+	NumericCheck_LineDrawH,
+	NumericCheck_LineDrawV,
+	NumericCheck_RectFill,
+	NumericCheck_ColorTranslate,
+	NumericCheck_Flush,
+};
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void NumericCheck_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8NumericCheckFailures++;
+}
+
+/**
+ * @brief Gets a cell of a readout, laid out the way Numeric_Draw does
+ *
+ * @param psNumeric The readout, drawn at least once
+ * @param ui8Cell The index of the cell
+ * @return The cell
+ */
+tRectangle NumericCheck_Cell(const tNumericDisplay *psNumeric, uint8_t ui8Cell) {
+	int16_t i16Left = psNumeric->i16X - (psNumeric->ui8CellWidth * psNumeric->ui8Width) / 2;
+	int16_t i16Top = psNumeric->i16Y - GrFontBaselineGet(psNumeric->psFont) / 2;
+	return (tRectangle){
+		i16Left + ui8Cell * psNumeric->ui8CellWidth,
+		i16Top,
+		i16Left + (ui8Cell + 1) * psNumeric->ui8CellWidth - 1,
+		i16Top + GrFontHeightGet(psNumeric->psFont) - 1
+	};
+}
+
+/**
+ * @brief Draws a value and records what it wrote
+ *
+ * @param psNumeric The readout
+ * @param psContext The graphics context
+ * @param i32Value The value to show
+ */
+void NumericCheck_Draw(tNumericDisplay *psNumeric, tContext *psContext, int32_t i32Value) {
+	memset(g_pbNumericCheckWritten, 0, sizeof(g_pbNumericCheckWritten));
+	g_ui32NumericCheckFills = 0;
+	g_ui32NumericCheckPixels = 0;
+	Numeric_Draw(psNumeric, psContext, i32Value);
+}
+
+/**
+ * @brief Counts the pixels written by the last draw outside of the cells that should have been drawn
+ *
+ * @param psNumeric The readout
+ * @param pbChanged Which cells should have been drawn
+ * @return The number of stray pixels
+ */
+uint32_t NumericCheck_Stray(const tNumericDisplay *psNumeric, const bool *pbChanged) {
+	uint32_t ui32Stray = 0;
+	for (int32_t y = 0; y < NUMERIC_CHECK_HEIGHT; y++) {
+		for (int32_t x = 0; x < NUMERIC_CHECK_WIDTH; x++) {
+			if (!g_pbNumericCheckWritten[y][x])
+				continue;
+
+			bool bInside = false;
+			for (uint8_t i = 0; i < psNumeric->ui8Width && !bInside; i++) {
+				tRectangle sCell = NumericCheck_Cell(psNumeric, i);
+				bInside = pbChanged[i] && GrRectContainsPoint(&sCell, x, y);
+			}
+			if (!bInside)
+				ui32Stray++;
+		}
+	}
+
+	return ui32Stray;
+}
+
+/**
+ * @brief Checks FormatInt against the table of cases
+ */
+void NumericCheck_Format() {
+	uint8_t ui8Wrong = 0;
+	const tNumericCheckFormat *psFirst = NULL;
+	char pcFirst[NUMERIC_MAX_WIDTH + 1] = "";
+	uint8_t ui8Count = sizeof(gc_sNumericCheckFormats) / sizeof(gc_sNumericCheckFormats[0]);
+
+	for (uint8_t i = 0; i < ui8Count; i++) {
+		const tNumericCheckFormat *psCase = &gc_sNumericCheckFormats[i];
+		char pcText[NUMERIC_MAX_WIDTH + 2];
+		memset(pcText, '#', sizeof(pcText));
+
+		bool bFits = FormatInt(psCase->i32Value, pcText, psCase->ui8Width, psCase->cPad);
+		if (bFits != psCase->bFits || strcmp(pcText, psCase->pcText) != 0) {
+			if (psFirst == NULL) {
+				psFirst = psCase;
+				strncpy(pcFirst, pcText, NUMERIC_MAX_WIDTH);
+			}
+			ui8Wrong++;
+		}
+	}
+
+	if (psFirst == NULL)
+		NumericCheck_Check("format", true, "%u cases", ui8Count);
+	else
+		NumericCheck_Check("format", false, "%u of %u cases wrong, %d width %u pad '%c' gave \"%s\" for \"%s\"", ui8Wrong,
+						   ui8Count, psFirst->i32Value, psFirst->ui8Width, psFirst->cPad, pcFirst, psFirst->pcText);
+}
+
+/**
+ * @brief Plays the sequence of values on a readout
+ *
+ * @param psNumeric The readout, not drawn yet
+ * @param psContext The graphics context
+ * @param pcName The name of the readout in the report
+ */
+void NumericCheck_Sequence(tNumericDisplay *psNumeric, tContext *psContext, const char *pcName) {
+	char pcName1[40], pcName2[40], pcName3[40], pcName4[40];
+	snprintf(pcName1, sizeof(pcName1), "first draw, %s", pcName);
+	snprintf(pcName2, sizeof(pcName2), "same value, %s", pcName);
+	snprintf(pcName3, sizeof(pcName3), "cells, %s", pcName);
+	snprintf(pcName4, sizeof(pcName4), "fresh draw, %s", pcName);
+
+	char pcShown[NUMERIC_MAX_WIDTH + 1];
+	char pcText[NUMERIC_MAX_WIDTH + 1];
+	bool pbChanged[NUMERIC_MAX_WIDTH];
+	static uint32_t pui32Incremental[NUMERIC_CHECK_HEIGHT][NUMERIC_CHECK_WIDTH];
+	uint8_t ui8Count = sizeof(gc_i32NumericCheckValues) / sizeof(gc_i32NumericCheckValues[0]);
+
+	/* Every cell is drawn the first time */
+	memset(pbChanged, true, sizeof(pbChanged));
+	NumericCheck_Draw(psNumeric, psContext, gc_i32NumericCheckValues[0]);
+	uint32_t ui32FullPixels = g_ui32NumericCheckPixels;
+	uint32_t ui32Stray = NumericCheck_Stray(psNumeric, pbChanged);
+	NumericCheck_Check(pcName1, g_ui32NumericCheckFills == psNumeric->ui8Width && ui32Stray == 0,
+					   "%u fill(s) for %u cells, %u pixels, %u stray", g_ui32NumericCheckFills, psNumeric->ui8Width,
+					   ui32FullPixels, ui32Stray);
+	FormatInt(gc_i32NumericCheckValues[0], pcShown, psNumeric->ui8Width, psNumeric->cPad);
+
+	/* Drawing it again writes nothing */
+	NumericCheck_Draw(psNumeric, psContext, gc_i32NumericCheckValues[0]);
+	NumericCheck_Check(pcName2, g_ui32NumericCheckPixels == 0, "%u pixels", g_ui32NumericCheckPixels);
+
+	uint32_t ui32Fills = 0, ui32Expected = 0, ui32Pixels = 0, ui32Mismatched = 0;
+	ui32Stray = 0;
+	for (uint8_t v = 1; v < ui8Count; v++) {
+		int32_t i32Value = gc_i32NumericCheckValues[v];
+		FormatInt(i32Value, pcText, psNumeric->ui8Width, psNumeric->cPad);
+		for (uint8_t i = 0; i < psNumeric->ui8Width; i++) {
+			pbChanged[i] = pcText[i] != pcShown[i];
+			ui32Expected += pbChanged[i];
+		}
+		strcpy(pcShown, pcText);
+
+		NumericCheck_Draw(psNumeric, psContext, i32Value);
+		ui32Fills += g_ui32NumericCheckFills;
+		ui32Pixels += g_ui32NumericCheckPixels;
+		ui32Stray += NumericCheck_Stray(psNumeric, pbChanged);
+
+		/* Clear the readout and draw it from scratch, it must look the same */
+		memcpy(pui32Incremental, g_pui32NumericCheckFrame, sizeof(pui32Incremental));
+		tRectangle sArea = NumericCheck_Cell(psNumeric, 0);
+		sArea.i16XMax = NumericCheck_Cell(psNumeric, psNumeric->ui8Width - 1).i16XMax;
+		GrContextForegroundSet(psContext, NUMERIC_CHECK_BACKGROUND);
+		GrRectFill(psContext, &sArea);
+		Numeric_Reset(psNumeric);
+		NumericCheck_Draw(psNumeric, psContext, i32Value);
+		for (int32_t y = 0; y < NUMERIC_CHECK_HEIGHT; y++) {
+			for (int32_t x = 0; x < NUMERIC_CHECK_WIDTH; x++)
+				ui32Mismatched += pui32Incremental[y][x] != g_pui32NumericCheckFrame[y][x];
+		}
+	}
+
+	NumericCheck_Check(pcName3, ui32Fills == ui32Expected && ui32Stray == 0,
+					   "%u fill(s) for %u changed cells, %u pixels, %u stray", ui32Fills, ui32Expected, ui32Pixels,
+					   ui32Stray);
+	NumericCheck_Check(pcName4, ui32Mismatched == 0, "%u pixels differ over %u values", ui32Mismatched, ui8Count - 1);
+}
+#pragma endregion
+
+int main() {
+	tContext sContext;
+	tNumericDisplay sSpeed = NumericDisplay(&g_sFontNf36, ClrRed, NUMERIC_CHECK_BACKGROUND, 107, 64, 4, ' ');
+	tNumericDisplay sOption = NumericDisplay(&g_sFontNf24, ClrRed, NUMERIC_CHECK_BACKGROUND, 198, 153, 2, '0');
+
+	GrContextInit(&sContext, &g_sNumericCheckDisplay);
+	NumericCheck_Format();
+	NumericCheck_Sequence(&sSpeed, &sContext, "speed");
+	NumericCheck_Sequence(&sOption, &sContext, "option");
+	printf("%s: %u check(s) failed\n", g_ui8NumericCheckFailures == 0 ? "PASS" : "FAIL", g_ui8NumericCheckFailures);
+	return g_ui8NumericCheckFailures == 0 ? 0 : 1;
+}
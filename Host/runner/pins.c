@@ -0,0 +1,117 @@
+/**
+ * @file pins.c
+ * @brief Host model of who owns the GPIO pins, behind the GPIOPinType driverlib calls
+ */
+#pragma region Includes
+#include "pins.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define PINS_PORT_COUNT 15
+#define PINS_PORT_STRIDE (GPIO_PORTB_BASE - GPIO_PORTA_BASE)
+
+/* Global constants */
+const char gc_cPinsPorts[PINS_PORT_COUNT] = "ABCDEFGHJKLMNPQ";
+const char *const gc_pcPinsUses[PINS_USE_COUNT] = {
+	[PINS_UNUSED] = "unused", [PINS_GPIO_OUTPUT] = "GPIO output", [PINS_TIMER] = "timer",
+	[PINS_PWM] = "PWM",		  [PINS_SSI] = "SSI",
+};
+
+/* Global variables */
+tPinsUse g_ppePins[PINS_PORT_COUNT][8];
+uint32_t g_ui32PinsConflicts = 0;
+char g_pcPinsFirstConflict[64] = "";
+#pragma endregion
+
+#pragma region Pins functions
+/**
+ * @brief Gets the index of a GPIO port
+ *
+ * @param ui32Port The base address of the port
+ * @return The index, the program exits on an unknown port
+ *
+ * @note This function is not intended to be called by the user
+ */
+uint32_t Pins_FindPort(uint32_t ui32Port) {
+	uint32_t ui32Index = (ui32Port - GPIO_PORTA_BASE) / PINS_PORT_STRIDE;
+	if (ui32Port < GPIO_PORTA_BASE || ui32Index >= PINS_PORT_COUNT || ui32Port % PINS_PORT_STRIDE != 0) {
+		fprintf(stderr, "pins: no GPIO port at 0x%08x\n", ui32Port);
+		exit(2);
+	}
+	return ui32Index;
+}
+
+/**
+ * @brief Claims pins for a use, counting the pins that had another one
+ *
+ * @param ui32Port The base address of the GPIO port
+ * @param ui8Pins The pins
+ * @param eUse What the pins are used for from now on
+ *
+ * @note This function is not intended to be called by the user
+ */
+void Pins_Claim(uint32_t ui32Port, uint8_t ui8Pins, tPinsUse eUse) {
+	uint32_t ui32Index = Pins_FindPort(ui32Port);
+	for (uint8_t i = 0; i < 8; i++) {
+		if (!(ui8Pins & (1 << i)))
+			continue;
+
+		tPinsUse ePrevious = g_ppePins[ui32Index][i];
+		if (ePrevious != PINS_UNUSED && ePrevious != eUse) {
+			if (g_ui32PinsConflicts++ == 0)
+				snprintf(g_pcPinsFirstConflict, sizeof(g_pcPinsFirstConflict), "P%c%u %s, then %s",
+						 gc_cPinsPorts[ui32Index], i, gc_pcPinsUses[ePrevious], gc_pcPinsUses[eUse]);
+		}
+		g_ppePins[ui32Index][i] = eUse;
+	}
+}
+
+tPinsUse Pins_GetUse(uint32_t ui32Port, uint8_t ui8Pin) {
+	for (uint8_t i = 0; i < 8; i++) {
+		if (ui8Pin == (1 << i))
+			return g_ppePins[Pins_FindPort(ui32Port)][i];
+	}
+	return PINS_UNUSED;
+}
+
+uint32_t Pins_GetConflicts() {
+	return g_ui32PinsConflicts;
+}
+
+const char *Pins_GetFirstConflict() {
+	return g_pcPinsFirstConflict;
+}
+#pragma endregion
+
+#pragma region Driverlib functions
+/* The alternate function follows from the use, the pin mux itself is not modelled */
+void GPIOPinConfigure(uint32_t ui32PinConfig) {
+}
+
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins) {
+	Pins_Claim(ui32Port, ui8Pins, PINS_GPIO_OUTPUT);
+}
+
+void GPIOPinTypeTimer(uint32_t ui32Port, uint8_t ui8Pins) {
+	Pins_Claim(ui32Port, ui8Pins, PINS_TIMER);
+}
+
+void GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins) {
+	Pins_Claim(ui32Port, ui8Pins, PINS_PWM);
+}
+
+void GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins) {
+	Pins_Claim(ui32Port, ui8Pins, PINS_SSI);
+}
+#pragma endregion
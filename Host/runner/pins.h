@@ -0,0 +1,47 @@
+/**
+ * @file pins.h
+ * @brief Host model of who owns the GPIO pins, behind the GPIOPinType driverlib calls
+ *
+ * Each GPIOPinType call claims its pins for one use. A pin claimed again for another use is a
+ * conflict, like the backlight output of the display taking over a PWM output of the bridge on the
+ * target. The conflicts are counted whatever order the modules are initialized in.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief What a pin is used for
+ *
+ */
+typedef enum tPinsUse {
+	PINS_UNUSED,
+	PINS_GPIO_OUTPUT,
+	PINS_TIMER,
+	PINS_PWM,
+	PINS_SSI,
+	PINS_USE_COUNT,
+} tPinsUse;
+
+/**
+ * @brief Gets what a pin is used for
+ *
+ * @param ui32Port The base address of the GPIO port
+ * @param ui8Pin The pin, GPIO_PIN_0 to GPIO_PIN_7
+ * @return The use of the last claim of the pin
+ */
+tPinsUse Pins_GetUse(uint32_t ui32Port, uint8_t ui8Pin);
+
+/**
+ * @brief Gets the number of pins claimed for another use than they had
+ *
+ * @return The number of conflicts since the program started
+ */
+uint32_t Pins_GetConflicts();
+
+/**
+ * @brief Gets the name of a pin and of its two uses for the first conflict
+ *
+ * @return A text like "PG1 PWM, then GPIO output", or an empty text without a conflict
+ */
+const char *Pins_GetFirstConflict();
@@ -0,0 +1,219 @@
+/**
+ * @file plant.c
+ * @brief Simulated brushless motor driven by the emulated PWM bridge, sensed by the emulated Hall inputs
+ */
+#pragma region Includes
+#include "plant.h"
+#include "bridge.h"
+#include "gptm.h"
+#include "sim.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <math.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/pwm.h"
+#include "driverlib/timer.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define PLANT_DT (PLANT_STEP * 1e-6)
+#define PLANT_RPM (60 / (2 * M_PI))
+#define PLANT_SECTOR_OFFSET (150 * M_PI / 180) // Hall state 5 starts 150 degrees before phase A, see commutation.c
+
+/**
+ * @brief A phase of the motor and the bridge leg driving it
+ *
+ */
+typedef struct tPlantPhase {
+	uint32_t ui32High;
+	uint32_t ui32Low;
+	uint32_t ui32HighOut;
+	double dAngle; // Electrical angle of the winding (rad)
+} tPlantPhase;
+
+/* Global constants */
+const tPlantParams gc_sPlantDefault = {
+	.dSupply = 24,
+	.dSupplyLimit = 10,
+	.dResistance = 0.8,
+	.dKe = 0.8,
+	.dInertia = 0.073,
+	.dViscous = 0.001,
+	.dCoulomb = 0.05,
+	.ui8PolePairs = 4,
+};
+
+const tPlantPhase gc_sPlantPhases[3] = {
+	{PWM_OUT_2_BIT, PWM_OUT_3_BIT, PWM_OUT_2, 0},
+	{PWM_OUT_0_BIT, PWM_OUT_1_BIT, PWM_OUT_0, 2 * M_PI / 3},
+	{PWM_OUT_6_BIT, PWM_OUT_7_BIT, PWM_OUT_6, 4 * M_PI / 3},
+};
+
+/* The Hall states of a forward turn, and the capture input of each sensor */
+const uint8_t gc_ui8PlantHall[6] = {5, 1, 3, 2, 6, 4};
+const uint32_t gc_ui32PlantInputs[3][2] = {
+	{TIMER3_BASE, TIMER_A},
+	{TIMER3_BASE, TIMER_B},
+	{TIMER4_BASE, TIMER_A},
+};
+
+/* Global variables */
+tPlantParams g_sPlantParams;
+tPlantState g_sPlantState;
+double g_dPlantOmega = 0; // rad/s
+double g_dPlantLoad = 0;
+uint8_t g_ui8PlantHall = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets the Hall state the sensors read at a rotor angle
+ *
+ * @param dAngle The mechanical angle (rad)
+ * @return The Hall state
+ */
+uint8_t Plant_Hall(double dAngle) {
+	double dElectrical = fmod(dAngle * g_sPlantParams.ui8PolePairs + PLANT_SECTOR_OFFSET, 2 * M_PI);
+	if (dElectrical < 0)
+		dElectrical += 2 * M_PI;
+	uint8_t ui8Sector = (uint8_t)(dElectrical / (M_PI / 3)) % 6;
+	return gc_ui8PlantHall[ui8Sector];
+}
+
+/**
+ * @brief Works out the current and the torque from the pattern on the bridge
+ *
+ * @param psState The state to update
+ *
+ * @note A pattern that is not one high and one low side on different phases is counted and treated as open
+ */
+void Plant_Electrics(tPlantState *psState) {
+	const tPlantParams *psParams = &g_sPlantParams;
+	uint32_t ui32Outputs = Bridge_GetOutputs();
+	const tPlantPhase *psHigh = NULL;
+	const tPlantPhase *psLow = NULL;
+	uint32_t ui32Known = 0;
+	bool bValid = true;
+
+	for (uint8_t i = 0; i < 3; i++) {
+		const tPlantPhase *psPhase = &gc_sPlantPhases[i];
+		ui32Known |= psPhase->ui32High | psPhase->ui32Low;
+		bool bHigh = ui32Outputs & psPhase->ui32High;
+		bool bLow = ui32Outputs & psPhase->ui32Low;
+		if ((bHigh && (bLow || psHigh != NULL)) || (bLow && psLow != NULL))
+			bValid = false;
+		if (bHigh)
+			psHigh = psPhase;
+		if (bLow)
+			psLow = psPhase;
+	}
+	bValid = bValid && !(ui32Outputs & ~ui32Known);
+
+	psState->dCurrent = 0;
+	psState->dTorque = 0;
+	psState->dPower = 0;
+	if ((ui32Outputs & ui32Known) == 0)
+		return;
+	if (!bValid || psHigh == NULL || psLow == NULL) {
+		psState->ui32BadPatterns++;
+		return;
+	}
+
+	/* The driven pair makes a field along the difference of the two windings, the torque and the back-EMF follow
+	   its angle to the rotor, 1 when it leads by 90 electrical degrees */
+	double dElectrical = psState->dAngle * psParams->ui8PolePairs;
+	double dX = (cos(psHigh->dAngle) - cos(psLow->dAngle)) / sqrt(3);
+	double dY = (sin(psHigh->dAngle) - sin(psLow->dAngle)) / sqrt(3);
+	double dAlignment = dY * cos(dElectrical) - dX * sin(dElectrical);
+
+	double dPeriod = PWMGenPeriodGet(PWM0_BASE, PWM_GEN_1);
+	double dDuty = dPeriod > 0 ? Bridge_GetPulseWidth(psHigh->ui32HighOut) / dPeriod : 0;
+	double dEMF = psParams->dKe * g_dPlantOmega * dAlignment;
+	double dCurrent = (dDuty * psParams->dSupply - dEMF) / psParams->dResistance;
+
+	/* The body diodes only return current to the supply once the back-EMF is above it */
+	if (dCurrent < 0)
+		dCurrent = dEMF > psParams->dSupply ? (psParams->dSupply - dEMF) / psParams->dResistance : 0;
+
+	/* The supply sees the phase current for the on time of the high side */
+	if (dDuty * dCurrent > psParams->dSupplyLimit) {
+		dCurrent = psParams->dSupplyLimit / dDuty;
+		psState->ui32Limited++;
+	}
+
+	psState->dCurrent = dCurrent;
+	psState->dTorque = psParams->dKe * dCurrent * dAlignment;
+	psState->dPower = psParams->dSupply * dDuty * dCurrent;
+}
+
+/**
+ * @brief Moves the motor one step forward and raises the Hall edge it crosses
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every PLANT_STEP
+ */
+void Plant_Step(uintptr_t arg) {
+	const tPlantParams *psParams = &g_sPlantParams;
+	tPlantState *psState = &g_sPlantState;
+	Plant_Electrics(psState);
+
+	/* Friction and the load hold the rotor until the torque overcomes them */
+	double dOmega = g_dPlantOmega;
+	double dHold = psParams->dCoulomb + g_dPlantLoad;
+	double dDirection = dOmega != 0 ? copysign(1, dOmega) : copysign(1, psState->dTorque);
+	double dNet = psState->dTorque - psParams->dViscous * dOmega - dHold * dDirection;
+	if (dOmega == 0 && fabs(psState->dTorque) <= dHold)
+		dNet = 0;
+
+	double dNext = dOmega + dNet / psParams->dInertia * PLANT_DT;
+	if (dOmega != 0 && dNext * dOmega < 0 && fabs(psState->dTorque) <= dHold)
+		dNext = 0;
+
+	g_dPlantOmega = dNext;
+	psState->dAngle = fmod(psState->dAngle + (dOmega + dNext) / 2 * PLANT_DT, 2 * M_PI);
+	psState->dSpeed = dNext * PLANT_RPM;
+	psState->dAccel = (dNext - dOmega) / PLANT_DT * PLANT_RPM;
+
+	/* Capture on the sensor that changed */
+	uint8_t ui8Hall = Plant_Hall(psState->dAngle);
+	uint8_t ui8Changed = ui8Hall ^ g_ui8PlantHall;
+	if (ui8Changed == 0)
+		return;
+
+	g_ui8PlantHall = ui8Hall;
+	Bridge_SetHall(ui8Hall);
+	for (uint8_t i = 0; i < 3; i++) {
+		if (ui8Changed & (1 << i))
+			GPTM_CaptureEdge(gc_ui32PlantInputs[i][0], gc_ui32PlantInputs[i][1]);
+	}
+	psState->ui32Edges++;
+}
+#pragma endregion
+
+#pragma region Plant API functions
+void Plant_Start(const tPlantParams *psParams, double dAngle) {
+	g_sPlantParams = psParams != NULL ? *psParams : gc_sPlantDefault;
+	g_sPlantState = (tPlantState){.dAngle = dAngle};
+	g_dPlantOmega = 0;
+	g_ui8PlantHall = Plant_Hall(dAngle);
+	Bridge_SetHall(g_ui8PlantHall);
+
+	uint8_t ui8Timer = Sim_TimerCreate(Plant_Step, 0);
+	Sim_TimerStart(ui8Timer, Sim_Now() + SIM_CYCLES_US(PLANT_STEP), SIM_CYCLES_US(PLANT_STEP));
+}
+
+void Plant_SetLoad(double dTorque) {
+	g_dPlantLoad = fabs(dTorque);
+}
+
+void Plant_GetState(tPlantState *psState) {
+	*psState = g_sPlantState;
+}
+#pragma endregion
@@ -0,0 +1,132 @@
+/**
+ * @file plant.h
+ * @brief Simulated brushless motor driven by the emulated PWM bridge, sensed by the emulated Hall inputs
+ *
+ * The motor is modelled by its averaged electrics, a resistance behind the back-EMF fed with the
+ * PWM duty of the supply, and its mechanics, an inertia with viscous and Coulomb friction and a
+ * load torque. The torque and the back-EMF follow the angle between the rotor and the phases the
+ * bridge drives, so a commutation error shows as lost torque rather than being assumed away. The
+ * supply clamps the current it can deliver.
+ *
+ * The plant is integrated every PLANT_STEP while the simulation runs. It reads the output enables
+ * and pulse widths of the bridge (see bridge.h), and raises Hall edges on the capture timers that
+ * hall.c listens on (see gptm.h) as the rotor turns.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define PLANT_STEP 10 // Integration step (us)
+
+/**
+ * @brief Physical parameters of the motor and its supply
+ *
+ */
+typedef struct tPlantParams {
+	/**
+	 * @brief The supply voltage (V)
+	 */
+	double dSupply;
+	/**
+	 * @brief The most current the supply delivers (A)
+	 */
+	double dSupplyLimit;
+	/**
+	 * @brief The resistance of two phases in series (ohm)
+	 */
+	double dResistance;
+	/**
+	 * @brief The back-EMF and torque constant, between two phases (V s/rad, N m/A)
+	 */
+	double dKe;
+	/**
+	 * @brief The inertia of the rotor and what it drives (kg m^2)
+	 */
+	double dInertia;
+	/**
+	 * @brief The viscous friction (N m s/rad)
+	 */
+	double dViscous;
+	/**
+	 * @brief The Coulomb friction (N m)
+	 */
+	double dCoulomb;
+	/**
+	 * @brief The number of pole pairs
+	 */
+	uint8_t ui8PolePairs;
+} tPlantParams;
+
+/**
+ * @brief The state of the motor
+ *
+ */
+typedef struct tPlantState {
+	/**
+	 * @brief The speed (RPM)
+	 */
+	double dSpeed;
+	/**
+	 * @brief The acceleration (RPM/s)
+	 */
+	double dAccel;
+	/**
+	 * @brief The current in the driven phases (A)
+	 */
+	double dCurrent;
+	/**
+	 * @brief The power drawn from the supply (W)
+	 */
+	double dPower;
+	/**
+	 * @brief The torque of the motor (N m)
+	 */
+	double dTorque;
+	/**
+	 * @brief The mechanical angle of the rotor (rad)
+	 */
+	double dAngle;
+	/**
+	 * @brief The number of Hall edges raised
+	 */
+	uint32_t ui32Edges;
+	/**
+	 * @brief The number of steps the bridge drove a pattern that is not a six-step one
+	 */
+	uint32_t ui32BadPatterns;
+	/**
+	 * @brief The number of steps the supply limited the current
+	 */
+	uint32_t ui32Limited;
+} tPlantState;
+
+/**
+ * @brief The default motor, a geared hub motor that does 300 RPM at full duty with a 100 ms time constant
+ *
+ */
+extern const tPlantParams gc_sPlantDefault;
+
+/**
+ * @brief Starts the plant, at rest with the rotor at an angle
+ *
+ * @param psParams The parameters of the motor, or NULL for gc_sPlantDefault
+ * @param dAngle The mechanical angle of the rotor (rad)
+ *
+ * @note Must be called before BIOS_start or from its start hook, after Hall_Init
+ */
+void Plant_Start(const tPlantParams *psParams, double dAngle);
+
+/**
+ * @brief Sets the load torque, it opposes the rotation
+ *
+ * @param dTorque The load torque (N m)
+ */
+void Plant_SetLoad(double dTorque);
+
+/**
+ * @brief Gets the state of the motor
+ *
+ * @param psState The state to copy into
+ */
+void Plant_GetState(tPlantState *psState);
@@ -0,0 +1,408 @@
+/**
+ * @file plant_loop.c
+ * @brief Host check of the whole motor path in closed loop against the simulated motor
+ *
+ * motor.c, control.c, commutation.c and hall.c run unchanged. The speed loop drives the
+ * emulated bridge, the simulated motor (see plant.h) turns and raises Hall edges, and the speed
+ * estimated from them closes the loop. A fixed scenario steps the setpoints:
+ *   0 ms     start at 200 RPM                  overshoot, steady-state error of the plant speed
+ *   2000 ms  load step                         limit cycle amplitude, steady-state error
+ *   3000 ms  250 RPM at 70 % max power         the duty clamp holds the motor below the setpoint
+ *   4000 ms  e-stop for 500 ms                 no current from the next control period, nor after the release
+ *   4800 ms  start                             the motor speeds up again
+ *   5500 ms  stop                              no current, the motor coasts down
+ *
+ * The supply limit and the commutation are checked throughout, and the run must be faster than
+ * real time on the host.
+ *
+ * Writes plant.csv with one line per millisecond, prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make plant_loop
+ *   ./plant_loop
+ */
+#pragma region Includes
+#include "sim.h"
+#include "plant.h"
+#include "motor.h"
+#include "hall.h"
+#include "commutation.h"
+#include "bus.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Task.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define PLANT_LOOP_DURATION 7000 // ms
+#define PLANT_LOOP_LOAD 0.5		 // Load torque of the load step (N m)
+#define PLANT_LOOP_BAND 3		 // Mean speed error allowed once settled (RPM)
+#define PLANT_LOOP_RIPPLE 10	 // Overshoot and limit cycle allowed around the setpoint (%)
+#define PLANT_LOOP_START_ANGLE 0.1 // rad
+
+/**
+ * @brief Kinds of scenario step
+ *
+ */
+typedef enum tPlantLoopAction {
+	PLANT_LOOP_ACTION_POST,
+	PLANT_LOOP_ACTION_LOAD,
+	PLANT_LOOP_ACTION_ESTOP,
+} tPlantLoopAction;
+
+/**
+ * @brief A step of the scenario
+ *
+ */
+typedef struct tPlantLoopStep {
+	uint32_t ui32Time; // ms
+	tPlantLoopAction eAction;
+	tMotorCommand eCommand;
+	int32_t i32Value;
+} tPlantLoopStep;
+
+/**
+ * @brief The state of the loop and the motor at the end of a millisecond
+ *
+ */
+typedef struct tPlantLoopSample {
+	tPlantState sPlant;
+	tMotorStatus sStatus;
+	double dPeakPower;
+	double dPeakCurrent;
+} tPlantLoopSample;
+
+/* The scenario, in time order */
+const tPlantLoopStep gc_sPlantLoopSteps[] = {
+	{0, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_ACCEL, MAX_ACCEL},
+	{0, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 200},
+	{0, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_STATE, 1},
+	{2000, PLANT_LOOP_ACTION_LOAD, 0, 1},
+	{3000, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_MAX_POWER, MAX_POWER * 7 / 10},
+	{3000, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_SPEED, 250},
+	{4000, PLANT_LOOP_ACTION_ESTOP, 0, 1},
+	{4500, PLANT_LOOP_ACTION_ESTOP, 0, 0},
+	{4800, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_STATE, 1},
+	{5500, PLANT_LOOP_ACTION_POST, MOTOR_COMMAND_STATE, 0},
+};
+
+/* Global variables */
+Task_Struct g_sPlantLoopTask;
+char ga_cPlantLoopStack[2048];
+uint8_t g_ui8PlantLoopStep = 0;
+tPlantLoopSample ga_sPlantLoopSamples[PLANT_LOOP_DURATION];
+double g_dPlantLoopPeakPower = 0;
+double g_dPlantLoopPeakCurrent = 0;
+uint8_t g_ui8PlantLoopFailures = 0;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Keeps the peaks of the supply power and current between samples
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every PLANT_STEP, after the plant
+ */
+void PlantLoop_Watch(uintptr_t arg) {
+	tPlantState sPlant;
+	Plant_GetState(&sPlant);
+	if (sPlant.dPower > g_dPlantLoopPeakPower)
+		g_dPlantLoopPeakPower = sPlant.dPower;
+	if (fabs(sPlant.dCurrent) > g_dPlantLoopPeakCurrent)
+		g_dPlantLoopPeakCurrent = fabs(sPlant.dCurrent);
+}
+
+/**
+ * @brief Runs the scenario steps that are due and records the previous millisecond
+ *
+ * @param arg Unused
+ *
+ * @note Called from interrupt context every millisecond
+ */
+void PlantLoop_Script(uintptr_t arg) {
+	uint32_t ui32Now = Sim_Now() / SIM_TICK_CYCLES;
+	if (ui32Now > 0 && ui32Now <= PLANT_LOOP_DURATION) {
+		tPlantLoopSample *psSample = &ga_sPlantLoopSamples[ui32Now - 1];
+		Plant_GetState(&psSample->sPlant);
+		Motor_GetStatus(&psSample->sStatus);
+		psSample->dPeakPower = g_dPlantLoopPeakPower;
+		psSample->dPeakCurrent = g_dPlantLoopPeakCurrent;
+		g_dPlantLoopPeakPower = 0;
+		g_dPlantLoopPeakCurrent = 0;
+	}
+	if (ui32Now >= PLANT_LOOP_DURATION) {
+		Sim_Stop();
+		return;
+	}
+
+	while (g_ui8PlantLoopStep < sizeof(gc_sPlantLoopSteps) / sizeof(gc_sPlantLoopSteps[0]) &&
+		   gc_sPlantLoopSteps[g_ui8PlantLoopStep].ui32Time <= ui32Now) {
+		const tPlantLoopStep *psStep = &gc_sPlantLoopSteps[g_ui8PlantLoopStep++];
+		switch (psStep->eAction) {
+		case PLANT_LOOP_ACTION_POST:
+			Motor_Post(psStep->eCommand, psStep->i32Value);
+			break;
+		case PLANT_LOOP_ACTION_LOAD:
+			Plant_SetLoad(psStep->i32Value ? PLANT_LOOP_LOAD : 0);
+			break;
+		case PLANT_LOOP_ACTION_ESTOP:
+			Motor_EStop(psStep->i32Value != 0);
+			break;
+		}
+	}
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void PlantLoop_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8PlantLoopFailures++;
+}
+
+/**
+ * @brief Finds the highest speed in a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @return The speed of the motor (RPM)
+ */
+double PlantLoop_Peak(uint32_t ui32Start, uint32_t ui32End) {
+	double dPeak = ga_sPlantLoopSamples[ui32Start].sPlant.dSpeed;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		if (ga_sPlantLoopSamples[i].sPlant.dSpeed > dPeak)
+			dPeak = ga_sPlantLoopSamples[i].sPlant.dSpeed;
+	}
+	return dPeak;
+}
+
+/**
+ * @brief Finds the lowest speed in a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @return The speed of the motor (RPM)
+ */
+double PlantLoop_Trough(uint32_t ui32Start, uint32_t ui32End) {
+	double dTrough = ga_sPlantLoopSamples[ui32Start].sPlant.dSpeed;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		if (ga_sPlantLoopSamples[i].sPlant.dSpeed < dTrough)
+			dTrough = ga_sPlantLoopSamples[i].sPlant.dSpeed;
+	}
+	return dTrough;
+}
+
+/**
+ * @brief Finds the mean speed error over a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @param i32Setpoint The setpoint (RPM)
+ * @return The mean of the setpoint minus the speed of the motor (RPM)
+ */
+double PlantLoop_Error(uint32_t ui32Start, uint32_t ui32End, int32_t i32Setpoint) {
+	double dSum = 0;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		dSum += i32Setpoint - ga_sPlantLoopSamples[i].sPlant.dSpeed;
+	}
+	return dSum / (ui32End - ui32Start);
+}
+
+/**
+ * @brief Finds the largest supply current in a span of samples
+ *
+ * @param ui32Start The first sample (ms)
+ * @param ui32End The sample after the last (ms)
+ * @return The current (A)
+ */
+double PlantLoop_PeakCurrent(uint32_t ui32Start, uint32_t ui32End) {
+	double dPeak = 0;
+	for (uint32_t i = ui32Start; i < ui32End; i++) {
+		if (ga_sPlantLoopSamples[i].dPeakCurrent > dPeak)
+			dPeak = ga_sPlantLoopSamples[i].dPeakCurrent;
+	}
+	return dPeak;
+}
+
+/**
+ * @brief Checks every phase of the scenario and prints the report
+ *
+ * @param dWall The time the simulation took on the host (s)
+ */
+void PlantLoop_Report(double dWall) {
+	const tPlantParams *psParams = &gc_sPlantDefault;
+
+	/* Start: the speed loop was tuned on a motor that brakes at zero duty, this one can only coast back from an overshoot */
+	double dOvershoot = PlantLoop_Peak(0, 2000) - 200;
+	double dError = PlantLoop_Error(1500, 2000, 200);
+	PlantLoop_Check("start overshoot", dOvershoot < 200 * PLANT_LOOP_RIPPLE / 100, "%.1f RPM", dOvershoot);
+	PlantLoop_Check("start steady-state error", fabs(dError) < PLANT_LOOP_BAND, "%.2f RPM", dError);
+
+	/* The Hall estimate agrees with the motor once the speed is steady */
+	double dWorst = 0;
+	for (uint32_t i = 1500; i < 2000; i++) {
+		double dDiff = ga_sPlantLoopSamples[i].sStatus.i32Speed - ga_sPlantLoopSamples[i].sPlant.dSpeed;
+		if (fabs(dDiff) > fabs(dWorst))
+			dWorst = dDiff;
+	}
+	PlantLoop_Check("hall estimate", fabs(dWorst) <= 2, "worst difference %+.2f RPM", dWorst);
+
+	/* Load: the loop unwinds its integral while coasting down from an overshoot, so it settles into a limit cycle
+	   around the setpoint rather than onto it */
+	double dHigh = PlantLoop_Peak(2500, 3000) - 200;
+	double dLow = 200 - PlantLoop_Trough(2500, 3000);
+	dError = PlantLoop_Error(2500, 3000, 200);
+	PlantLoop_Check("load ripple", dHigh < 200 * PLANT_LOOP_RIPPLE / 100 && dLow < 200 * PLANT_LOOP_RIPPLE / 100,
+					"+%.1f/-%.1f RPM", dHigh, dLow);
+	PlantLoop_Check("load steady-state error", fabs(dError) < PLANT_LOOP_BAND, "%.2f RPM", dError);
+
+	/* The duty clamp keeps the loaded motor below 250 RPM */
+	int32_t i32Peak = 0;
+	int32_t i32Limit = MAX_POWER * 7 / 10 * COMMUTATION_DUTY_MAX / MAX_POWER;
+	for (uint32_t i = 3000; i < 4000; i++) {
+		if (ga_sPlantLoopSamples[i].sStatus.i32Duty > i32Peak)
+			i32Peak = ga_sPlantLoopSamples[i].sStatus.i32Duty;
+	}
+	double dSpeed = ga_sPlantLoopSamples[3999].sPlant.dSpeed;
+	PlantLoop_Check("power clamp", i32Peak <= i32Limit && dSpeed < 250 - PLANT_LOOP_BAND,
+					"peak duty %d of %d, %.1f RPM", i32Peak, i32Limit, dSpeed);
+
+	/* E-stop opens the bridge from the next control period and the motor slows down */
+	double dCurrent = PlantLoop_PeakCurrent(4002, 4500);
+	PlantLoop_Check("e-stop", dCurrent == 0 && ga_sPlantLoopSamples[4499].sPlant.dSpeed < ga_sPlantLoopSamples[4000].sPlant.dSpeed,
+					"peak current %.2f A, %.1f RPM after 500 ms", dCurrent, ga_sPlantLoopSamples[4499].sPlant.dSpeed);
+	int32_t i32Duty = 0;
+	for (uint32_t i = 4500; i < 4800; i++) {
+		if (ga_sPlantLoopSamples[i].sStatus.i32Duty > i32Duty)
+			i32Duty = ga_sPlantLoopSamples[i].sStatus.i32Duty;
+	}
+	dCurrent = PlantLoop_PeakCurrent(4502, 4800);
+	PlantLoop_Check("e-stop release", i32Duty == 0 && dCurrent == 0, "peak duty %d, peak current %.2f A until the next start",
+					i32Duty, dCurrent);
+	PlantLoop_Check("e-stop restart", ga_sPlantLoopSamples[5499].sPlant.dSpeed > ga_sPlantLoopSamples[4800].sPlant.dSpeed,
+					"%.1f RPM after 700 ms", ga_sPlantLoopSamples[5499].sPlant.dSpeed);
+
+	/* Stop: the motor coasts, the speed only falls */
+	dCurrent = PlantLoop_PeakCurrent(5502, PLANT_LOOP_DURATION);
+	uint32_t ui32Rises = 0;
+	for (uint32_t i = 5502; i < PLANT_LOOP_DURATION; i++) {
+		if (ga_sPlantLoopSamples[i].sPlant.dSpeed > ga_sPlantLoopSamples[i - 1].sPlant.dSpeed)
+			ui32Rises++;
+	}
+	PlantLoop_Check("stop", dCurrent == 0 && ui32Rises == 0, "peak current %.2f A, %u rises", dCurrent, ui32Rises);
+
+	/* The supply limit holds and every pattern the bridge drove was a six-step one */
+	double dPower = 0;
+	for (uint32_t i = 0; i < PLANT_LOOP_DURATION; i++) {
+		if (ga_sPlantLoopSamples[i].dPeakPower > dPower)
+			dPower = ga_sPlantLoopSamples[i].dPeakPower;
+	}
+	tPlantState sPlant;
+	Plant_GetState(&sPlant);
+	PlantLoop_Check("supply limit", dPower <= psParams->dSupply * psParams->dSupplyLimit * 1.0001,
+					"peak %.1f W of %.1f W, limited %.1f %% of the time", dPower, psParams->dSupply * psParams->dSupplyLimit,
+					100.0 * sPlant.ui32Limited / (PLANT_LOOP_DURATION * 1000 / PLANT_STEP));
+	tCommutationStats sStats;
+	Commutation_GetStats(&sStats);
+	PlantLoop_Check("commutation", sPlant.ui32BadPatterns == 0 && sStats.ui32Faults == 0 && sStats.ui32Commutations == sPlant.ui32Edges,
+					"%u edges, %u commutated, %u bad patterns", sPlant.ui32Edges, sStats.ui32Commutations,
+					sPlant.ui32BadPatterns);
+
+	double dRatio = PLANT_LOOP_DURATION / 1000.0 / dWall;
+	PlantLoop_Check("faster than real time", dRatio > 1, "%.1fx on the host", dRatio);
+}
+
+/**
+ * @brief Writes the recorded samples
+ *
+ * @param pcPath The file to write
+ */
+void PlantLoop_WriteCSV(const char *pcPath) {
+	FILE *psFile = fopen(pcPath, "w");
+	if (psFile == NULL) {
+		fprintf(stderr, "plant_loop: cannot write %s\n", pcPath);
+		return;
+	}
+
+	fprintf(psFile, "ms,reference,speed,estimate,duty,current,power,accel\n");
+	for (uint32_t i = 0; i < PLANT_LOOP_DURATION; i++) {
+		const tPlantLoopSample *psSample = &ga_sPlantLoopSamples[i];
+		fprintf(psFile, "%u,%d,%.2f,%d,%d,%.3f,%.2f,%.1f\n", i, psSample->sStatus.i32Reference, psSample->sPlant.dSpeed,
+				psSample->sStatus.i32Speed, psSample->sStatus.i32Duty, psSample->sPlant.dCurrent, psSample->sPlant.dPower,
+				psSample->sPlant.dAccel);
+	}
+	fclose(psFile);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @param argc The number of arguments
+ * @param argv Optionally the file to write the samples to
+ * @return 0 if every check passed
+ */
+int main(int argc, char **argv) {
+	Types_FreqHz sFreq;
+	BIOS_getCpuFreq(&sFreq);
+	Hall_Init();
+	Commutation_Init(sFreq.lo);
+	Motor_Init(sFreq.lo);
+
+	/* The script runs before the control timer at the same time, the watch right after the plant */
+	uint8_t ui8Script = Sim_TimerCreate(PlantLoop_Script, 0);
+	Sim_TimerStart(ui8Script, 0, SIM_CYCLES_MS(1));
+	Plant_Start(NULL, PLANT_LOOP_START_ANGLE);
+	uint8_t ui8Watch = Sim_TimerCreate(PlantLoop_Watch, 0);
+	Sim_TimerStart(ui8Watch, SIM_CYCLES_US(PLANT_STEP), SIM_CYCLES_US(PLANT_STEP));
+
+	Clock_Params clockParams;
+	Clock_Params_init(&clockParams);
+	clockParams.startFlag = true;
+	clockParams.period = HALL_PUBLISH_PERIOD;
+	Clock_create((Clock_FuncPtr)Hall_Publish, HALL_PUBLISH_PERIOD, &clockParams, NULL);
+
+	Task_Params taskParams;
+	Task_Params_init(&taskParams);
+	taskParams.stackSize = sizeof(ga_cPlantLoopStack);
+	taskParams.stack = &ga_cPlantLoopStack;
+	taskParams.priority = 3;
+	Task_construct(&g_sPlantLoopTask, (Task_FuncPtr)Motor_Control, &taskParams, NULL);
+
+	struct timespec sStart, sEnd;
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	BIOS_start();
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+	PlantLoop_WriteCSV(argc > 1 ? argv[1] : "plant.csv");
+	PlantLoop_Report((sEnd.tv_sec - sStart.tv_sec) + (sEnd.tv_nsec - sStart.tv_nsec) * 1e-9);
+	printf("%s: %u check(s) failed\n", g_ui8PlantLoopFailures == 0 ? "PASS" : "FAIL", g_ui8PlantLoopFailures);
+	return g_ui8PlantLoopFailures == 0 ? 0 : 1;
+}
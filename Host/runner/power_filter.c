@@ -0,0 +1,502 @@
+/**
+ * @file power_filter.c
+ * @brief Host check of the current and voltage decimation against reference waveforms
+ *
+ * power.c and decimator.c run unchanged. The ADC manager and the PWM generator that paces the
+ * samples are stood in for here, the ping-pong blocks are filled from a waveform sampled at the
+ * instants the generator would trigger the sequence, rounded to ADC codes, and handed to the block
+ * function of power.c like the DMA interrupt does. Each waveform runs on a fresh decimator:
+ *   dc          5 A at 24 V with ADC noise      accuracy of the current, voltage and power
+ *   step        0 to 8 A at 200 ms              settling time and overshoot
+ *   chopped     10 A at 10 to 90 % of 20 kHz,   mean of a PWM current sampled across its period,
+ *               the supply sagging while on     power against the mean of the product
+ *   passband    2 A at 8 Hz on 5 A              droop of the compensated response
+ *   stopband    4 A at 100 Hz on 5 A            rejection before the last decimation
+ *   ac power    3 A and 2 V at 1 kHz, 60 deg    power is the mean of v i, not the product of the means
+ *   full scale  +/-20 A at 33 V                 no overflow at the ends of the ADC range
+ *
+ * The chopped current is only resolved to about 1 % of its peak: the samples walk across the PWM
+ * period, and the harmonics that alias close to DC pass the decimator. The anti-alias filter in
+ * front of the ADC is what brings it closer.
+ *
+ * The block function is then timed on the host, and the load per kHz of samples is read back with
+ * Power_GetStats, which times itself with the host clock here. The target value is read the same way.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make power_filter
+ *   ./power_filter
+ */
+#pragma region Includes
+#include "power.h"
+#include "adcmgr.h"
+#include "decimator.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+#include <xdc/runtime/Timestamp.h>
+#include <ti/sysbios/hal/Hwi.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/adc.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+#include "driverlib/sysctl.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define POWER_FILTER_CLOCK 120000000 // Hz
+#define POWER_FILTER_DURATION 1000	  // ms
+#define POWER_FILTER_SETTLED 100	  // Outputs before this are left out of the accuracy checks (ms)
+#define POWER_FILTER_REFERENCE 200	  // Steps per sample period the reference mean is integrated with
+#define POWER_FILTER_NOISE 3		  // Peak ADC noise (codes)
+#define POWER_FILTER_SETTLE 80		  // ms
+#define POWER_FILTER_OVERSHOOT 5	  // The compensator rings on a step, the price of its flat passband (%)
+#define POWER_FILTER_CHOPPED 2		  // Largest error of a chopped current, its harmonics alias (% of the peak)
+#define POWER_FILTER_BENCHMARK 100000 // Blocks
+#define POWER_FILTER_BUDGET 100		  // ns per pair of samples
+#define POWER_FILTER_OUTPUTS (POWER_FILTER_DURATION * POWER_SAMPLE_RATE / (1000 * POWER_BLOCK))
+#define POWER_FILTER_MA_PER_CODE ((double)POWER_CURRENT_FULL / 2048)
+#define POWER_FILTER_MV_PER_CODE ((double)POWER_VOLTAGE_FULL / 4096)
+
+/**
+ * @brief A reference waveform
+ *
+ * @param dTime The time (s)
+ * @param pdCurrent The current (A)
+ * @param pdVoltage The voltage (V)
+ */
+typedef void (*tPowerFilterWaveform)(double dTime, double *pdCurrent, double *pdVoltage);
+
+/* The block function, internal to power.c */
+void Power_Block(const uint16_t *pui16Block, uint16_t ui16Count, void *pvArg);
+
+/* Global variables */
+tADCClient *g_psPowerFilterClient = NULL;
+uint32_t g_ui32PowerFilterPeriod = 0;
+uint32_t g_ui32PowerFilterTrigger = 0;
+bool g_bPowerFilterRunning = false;
+uint16_t ga_ui16PowerFilterBlock[POWER_BLOCK * 2];
+tPowerReading ga_sPowerFilterOutputs[POWER_FILTER_OUTPUTS];
+double g_dPowerFilterPhase = 0; // Of the waveforms that need one (rad)
+double g_dPowerFilterDuty = 0;
+uint8_t g_ui8PowerFilterFailures = 0;
+#pragma endregion
+
+#pragma region Stand-ins
+/* The ADC manager, the sampling generator and the BIOS calls power.c makes, the clock is the host one */
+bool ADCMgr_Register(tADCClient *psClient) {
+	if (psClient->ui32Trigger == ADC_TRIGGER_TIMER || psClient->ui16BlockLen % psClient->ui8NumSteps != 0)
+		return false;
+	psClient->ui32Blocks = 0;
+	psClient->ui32Overruns = 0;
+	g_psPowerFilterClient = psClient;
+	return true;
+}
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {
+}
+
+void GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins) {
+}
+
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config) {
+	g_bPowerFilterRunning = false;
+}
+
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period) {
+	g_ui32PowerFilterPeriod = ui32Period;
+}
+
+void PWMGenIntTrigEnable(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32IntTrig) {
+	g_ui32PowerFilterTrigger |= ui32IntTrig;
+}
+
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen) {
+	/* Triggers before the sequence is registered would be lost */
+	g_bPowerFilterRunning = g_psPowerFilterClient != NULL;
+}
+
+UInt32 Timestamp_get32() {
+	struct timespec sNow;
+	clock_gettime(CLOCK_MONOTONIC, &sNow);
+	return (UInt32)(sNow.tv_sec * 1000000000ull + sNow.tv_nsec);
+}
+
+void Timestamp_getFreq(Types_FreqHz *psFreq) {
+	psFreq->hi = 0;
+	psFreq->lo = 1000000000;
+}
+
+UInt Hwi_disable() {
+	return 0;
+}
+
+void Hwi_restore(UInt uiKey) {
+}
+#pragma endregion
+
+#pragma region Waveforms
+void PowerFilter_DC(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = 5;
+	*pdVoltage = 24;
+}
+
+void PowerFilter_Step(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = dTime < 0.2 ? 0 : 8;
+	*pdVoltage = 24;
+}
+
+/* The supply current of the bridge flows while the high side is on, and the supply sags under it */
+void PowerFilter_Chopped(double dTime, double *pdCurrent, double *pdVoltage) {
+	double dPhase = fmod(dTime * COMMUTATION_PWM_FREQ, 1);
+	bool bOn = dPhase < g_dPowerFilterDuty;
+	*pdCurrent = bOn ? 10 : 0;
+	*pdVoltage = bOn ? 23.8 : 24;
+}
+
+void PowerFilter_Passband(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = 5 + 2 * sin(2 * M_PI * 8 * dTime + g_dPowerFilterPhase);
+	*pdVoltage = 24;
+}
+
+void PowerFilter_Stopband(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = 5 + 4 * sin(2 * M_PI * 100 * dTime + g_dPowerFilterPhase);
+	*pdVoltage = 24;
+}
+
+void PowerFilter_AC(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = 5 + 3 * sin(2 * M_PI * 1000 * dTime);
+	*pdVoltage = 24 + 2 * sin(2 * M_PI * 1000 * dTime + M_PI / 3);
+}
+
+void PowerFilter_FullPositive(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = POWER_CURRENT_FULL / 1000.0;
+	*pdVoltage = POWER_VOLTAGE_FULL / 1000.0;
+}
+
+void PowerFilter_FullNegative(double dTime, double *pdCurrent, double *pdVoltage) {
+	*pdCurrent = -POWER_CURRENT_FULL / 1000.0;
+	*pdVoltage = POWER_VOLTAGE_FULL / 1000.0;
+}
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Converts to an ADC code, as the converter rounds and clips
+ *
+ * @param dValue The value, in codes
+ * @return The code
+ */
+uint16_t PowerFilter_Code(double dValue) {
+	long lCode = lround(dValue);
+	return lCode < 0 ? 0 : lCode > 4095 ? 4095 : (uint16_t)lCode;
+}
+
+/**
+ * @brief Samples a waveform through power.c, one output per block
+ *
+ * @param pfnWaveform The waveform
+ * @param ui8Noise The peak ADC noise (codes)
+ * @return False if power.c did not start the sampling
+ */
+bool PowerFilter_Run(tPowerFilterWaveform pfnWaveform, uint8_t ui8Noise) {
+	g_psPowerFilterClient = NULL;
+	if (!Power_Init(POWER_FILTER_CLOCK) || !g_bPowerFilterRunning)
+		return false;
+
+	tADCClient *psClient = g_psPowerFilterClient;
+	double dPeriod = (double)g_ui32PowerFilterPeriod / POWER_FILTER_CLOCK;
+	uint64_t ui64Sample = 0;
+	srand(1);
+
+	for (uint32_t i = 0; i < POWER_FILTER_OUTPUTS; i++) {
+		for (uint16_t j = 0; j < POWER_BLOCK; j++) {
+			double dCurrent, dVoltage;
+			pfnWaveform(ui64Sample++ * dPeriod, &dCurrent, &dVoltage);
+			int32_t i32Noise = ui8Noise > 0 ? rand() % (2 * ui8Noise + 1) - ui8Noise : 0;
+			ga_ui16PowerFilterBlock[2 * j] =
+				PowerFilter_Code(dCurrent * 1000 / POWER_FILTER_MA_PER_CODE + POWER_CURRENT_ZERO + i32Noise);
+			ga_ui16PowerFilterBlock[2 * j + 1] = PowerFilter_Code(dVoltage * 1000 / POWER_FILTER_MV_PER_CODE - i32Noise);
+		}
+
+		psClient->ui32Blocks++;
+		psClient->pfnBlock(ga_ui16PowerFilterBlock, psClient->ui16BlockLen, psClient->pvArg);
+		Power_Get(&ga_sPowerFilterOutputs[i]);
+	}
+	return true;
+}
+
+/**
+ * @brief Gets the mean of a waveform over the settled outputs, integrated finer than it is sampled
+ *
+ * @param pfnWaveform The waveform
+ * @param pdCurrent The mean current (mA)
+ * @param pdVoltage The mean voltage (mV)
+ * @param pdPower The mean power (mW)
+ */
+void PowerFilter_Reference(tPowerFilterWaveform pfnWaveform, double *pdCurrent, double *pdVoltage, double *pdPower) {
+	double dStart = POWER_FILTER_SETTLED / 1000.0;
+	double dEnd = POWER_FILTER_DURATION / 1000.0;
+	double dStep = 1.0 / (POWER_SAMPLE_RATE * POWER_FILTER_REFERENCE);
+	double dCurrent = 0, dVoltage = 0, dPower = 0;
+	uint64_t ui64Count = 0;
+	for (double dTime = dStart; dTime < dEnd; dTime += dStep) {
+		double dI, dV;
+		pfnWaveform(dTime, &dI, &dV);
+		dCurrent += dI;
+		dVoltage += dV;
+		dPower += dI * dV;
+		ui64Count++;
+	}
+	*pdCurrent = dCurrent * 1000 / ui64Count;
+	*pdVoltage = dVoltage * 1000 / ui64Count;
+	*pdPower = dPower * 1000 / ui64Count;
+}
+
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void PowerFilter_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+	if (!bPass)
+		g_ui8PowerFilterFailures++;
+}
+
+/**
+ * @brief Finds the worst error of the settled outputs of a waveform against its mean
+ *
+ * @param pfnWaveform The waveform
+ * @param ui8Noise The peak ADC noise (codes)
+ * @param pdMean The mean current (mA), voltage (mV) and power (mW)
+ * @param pdWorst The worst error of each
+ * @return False if power.c did not start the sampling
+ */
+bool PowerFilter_Errors(tPowerFilterWaveform pfnWaveform, uint8_t ui8Noise, double *pdMean, double *pdWorst) {
+	if (!PowerFilter_Run(pfnWaveform, ui8Noise))
+		return false;
+
+	PowerFilter_Reference(pfnWaveform, &pdMean[0], &pdMean[1], &pdMean[2]);
+	for (uint8_t j = 0; j < 3; j++)
+		pdWorst[j] = 0;
+
+	for (uint32_t i = POWER_FILTER_SETTLED * POWER_SAMPLE_RATE / (1000 * POWER_BLOCK); i < POWER_FILTER_OUTPUTS; i++) {
+		const tPowerReading *psReading = &ga_sPowerFilterOutputs[i];
+		double pdError[3] = {psReading->i32Current - pdMean[0], psReading->i32Voltage - pdMean[1],
+							 psReading->i32Power - pdMean[2]};
+		for (uint8_t j = 0; j < 3; j++) {
+			if (fabs(pdError[j]) > fabs(pdWorst[j]))
+				pdWorst[j] = pdError[j];
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Checks the settled outputs of a waveform against its mean
+ *
+ * @param pcName The name of the check
+ * @param pfnWaveform The waveform
+ * @param ui8Noise The peak ADC noise (codes)
+ * @param dTolerance The largest error allowed, on top of half a code of the current and the voltage (% of the mean)
+ */
+void PowerFilter_CheckMean(const char *pcName, tPowerFilterWaveform pfnWaveform, uint8_t ui8Noise, double dTolerance) {
+	double pdMean[3], pdWorst[3];
+	if (!PowerFilter_Errors(pfnWaveform, ui8Noise, pdMean, pdWorst)) {
+		PowerFilter_Check(pcName, false, "sampling not started");
+		return;
+	}
+
+	double pdLimit[3] = {
+		fabs(pdMean[0]) * dTolerance / 100 + POWER_FILTER_MA_PER_CODE / 2,
+		fabs(pdMean[1]) * dTolerance / 100 + POWER_FILTER_MV_PER_CODE / 2,
+		fabs(pdMean[2]) * dTolerance / 100 +
+			(fabs(pdMean[0]) * POWER_FILTER_MV_PER_CODE + pdMean[1] * POWER_FILTER_MA_PER_CODE) / 2000,
+	};
+	bool bPass = true;
+	for (uint8_t j = 0; j < 3; j++)
+		bPass = bPass && fabs(pdWorst[j]) <= pdLimit[j];
+
+	PowerFilter_Check(pcName, bPass, "%.0f mA %+.1f, %.0f mV %+.1f, %.0f mW %+.1f", pdMean[0], pdWorst[0], pdMean[1],
+					  pdWorst[1], pdMean[2], pdWorst[2]);
+}
+
+/**
+ * @brief Checks a chopped current over the range of duty cycles
+ *
+ */
+void PowerFilter_CheckChopped() {
+	double dWorstCurrent = 0, dWorstPower = 0;
+	double dCurrentDuty = 0, dPowerDuty = 0;
+	for (uint8_t i = 1; i <= 9; i++) {
+		double pdMean[3], pdWorst[3];
+		g_dPowerFilterDuty = i / 10.0;
+		if (!PowerFilter_Errors(PowerFilter_Chopped, 0, pdMean, pdWorst)) {
+			PowerFilter_Check("chopped", false, "sampling not started");
+			return;
+		}
+
+		/* Relative to the current and the power while on */
+		if (fabs(pdWorst[0]) / 10000 > fabs(dWorstCurrent)) {
+			dWorstCurrent = pdWorst[0] / 10000;
+			dCurrentDuty = g_dPowerFilterDuty;
+		}
+		if (fabs(pdWorst[2]) / (10 * 23800) > fabs(dWorstPower)) {
+			dWorstPower = pdWorst[2] / (10 * 23800);
+			dPowerDuty = g_dPowerFilterDuty;
+		}
+	}
+
+	bool bPass = fabs(dWorstCurrent) * 100 <= POWER_FILTER_CHOPPED && fabs(dWorstPower) * 100 <= POWER_FILTER_CHOPPED;
+	PowerFilter_Check("chopped", bPass, "current %+.2f %% at %.0f %% duty, power %+.2f %% at %.0f %% duty",
+					  dWorstCurrent * 100, dCurrentDuty * 100, dWorstPower * 100, dPowerDuty * 100);
+}
+
+/**
+ * @brief Checks the settling of the current after a step
+ *
+ */
+void PowerFilter_CheckStep() {
+	if (!PowerFilter_Run(PowerFilter_Step, 0)) {
+		PowerFilter_Check("step", false, "sampling not started");
+		return;
+	}
+
+	/* Settled once every later output is within 1 % of the step */
+	double dMs = 1000.0 * POWER_BLOCK / POWER_SAMPLE_RATE;
+	uint32_t ui32Settled = 0;
+	double dPeak = 0;
+	for (uint32_t i = 0; i < POWER_FILTER_OUTPUTS; i++) {
+		double dCurrent = ga_sPowerFilterOutputs[i].i32Current;
+		if (fabs(dCurrent - (i * dMs >= 200 ? 8000 : 0)) > 80)
+			ui32Settled = i + 1;
+		if (dCurrent > dPeak)
+			dPeak = dCurrent;
+	}
+
+	double dSettle = ui32Settled * dMs - 200;
+	PowerFilter_Check("step settling", dSettle <= POWER_FILTER_SETTLE, "%.1f ms to 1 %%", dSettle);
+	PowerFilter_Check("step overshoot", dPeak <= 8000 * (1 + POWER_FILTER_OVERSHOOT / 100.0), "%.2f %%",
+					  (dPeak - 8000) / 80);
+}
+
+/**
+ * @brief Checks the amplitude of the current for a sine, over a few phases of it against the output instants
+ *
+ * @param pcName The name of the check
+ * @param pfnWaveform The waveform, a sine of the current on 5 A
+ * @param dAmplitude The amplitude of the sine (mA)
+ * @param dLow The lowest gain allowed (dB)
+ * @param dHigh The highest gain allowed (dB)
+ */
+void PowerFilter_CheckGain(const char *pcName, tPowerFilterWaveform pfnWaveform, double dAmplitude, double dLow,
+						   double dHigh) {
+	double dWorst = 0;
+	for (uint8_t k = 0; k < 4; k++) {
+		g_dPowerFilterPhase = k * M_PI / 4;
+		if (!PowerFilter_Run(pfnWaveform, 0)) {
+			PowerFilter_Check(pcName, false, "sampling not started");
+			return;
+		}
+
+		double dMin = INFINITY, dMax = -INFINITY;
+		for (uint32_t i = POWER_FILTER_SETTLED * POWER_SAMPLE_RATE / (1000 * POWER_BLOCK); i < POWER_FILTER_OUTPUTS; i++) {
+			dMin = fmin(dMin, ga_sPowerFilterOutputs[i].i32Current);
+			dMax = fmax(dMax, ga_sPowerFilterOutputs[i].i32Current);
+		}
+
+		/* The largest swing either side of the 5 A, which the output instants may miss the peak of */
+		double dSwing = fmax(dMax - 5000, 5000 - dMin);
+		if (dSwing > dWorst)
+			dWorst = dSwing;
+	}
+	g_dPowerFilterPhase = 0;
+
+	double dGain = 20 * log10(dWorst / dAmplitude);
+	PowerFilter_Check(pcName, dGain >= dLow && dGain <= dHigh, "%+.2f dB", dGain);
+}
+
+/**
+ * @brief Checks the sample clock power.c sets up
+ *
+ */
+void PowerFilter_CheckClock() {
+	g_psPowerFilterClient = NULL;
+	g_ui32PowerFilterTrigger = 0;
+	bool bStarted = Power_Init(POWER_FILTER_CLOCK);
+	double dRate = g_ui32PowerFilterPeriod > 0 ? (double)POWER_FILTER_CLOCK / g_ui32PowerFilterPeriod : 0;
+	bool bPass = bStarted && g_bPowerFilterRunning && g_psPowerFilterClient->ui32Trigger != ADC_TRIGGER_TIMER &&
+				 (g_ui32PowerFilterTrigger & PWM_TR_CNT_LOAD) && fabs(dRate / POWER_SAMPLE_RATE - 1) < 0.001 &&
+				 g_ui32PowerFilterPeriod <= 65536;
+	PowerFilter_Check("sample clock", bPass, "%.1f Hz per channel", dRate);
+}
+
+/**
+ * @brief Times the block function
+ *
+ */
+void PowerFilter_Benchmark() {
+	PowerFilter_Run(PowerFilter_DC, POWER_FILTER_NOISE);
+	tADCClient *psClient = g_psPowerFilterClient;
+
+	struct timespec sStart, sEnd;
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	for (uint32_t i = 0; i < POWER_FILTER_BENCHMARK; i++) {
+		psClient->ui32Blocks++;
+		psClient->pfnBlock(ga_ui16PowerFilterBlock, psClient->ui16BlockLen, psClient->pvArg);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+	double dNs = ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec)) /
+				 ((double)POWER_FILTER_BENCHMARK * POWER_BLOCK);
+	PowerFilter_Check("block function", dNs <= POWER_FILTER_BUDGET, "%.1f ns per pair of samples on the host", dNs);
+
+	tPowerStats sStats;
+	Power_GetStats(&sStats);
+	printf("     %-26s %u blocks, mean %u ns, worst %u ns, %u ppm per kHz on the host\n", "load", sStats.ui32Blocks,
+		   sStats.ui32MeanTime, sStats.ui32WorstTime, sStats.ui32LoadPerKHz);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @return 0 if every check passed
+ */
+int main() {
+	PowerFilter_CheckClock();
+	PowerFilter_CheckMean("dc", PowerFilter_DC, POWER_FILTER_NOISE, 0.1);
+	PowerFilter_CheckStep();
+	PowerFilter_CheckChopped();
+	PowerFilter_CheckGain("passband 8 Hz", PowerFilter_Passband, 2000, -0.2, 0.2);
+	PowerFilter_CheckGain("stopband 100 Hz", PowerFilter_Stopband, 4000, -INFINITY, -40);
+	PowerFilter_CheckMean("ac power", PowerFilter_AC, 0, 0.2);
+	PowerFilter_CheckMean("full scale +", PowerFilter_FullPositive, 0, 0.1);
+	PowerFilter_CheckMean("full scale -", PowerFilter_FullNegative, 0, 0.1);
+	PowerFilter_Benchmark();
+
+	printf("%s: %u check(s) failed\n", g_ui8PowerFilterFailures == 0 ? "PASS" : "FAIL", g_ui8PowerFilterFailures);
+	return g_ui8PowerFilterFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,321 @@
+/**
+ * @file scurve_check.c
+ * @brief Host check of the S-curve setpoint planner against its limits
+ *
+ * control.c runs unchanged. Every step of every plan is checked against the limits it was given:
+ *   moves from rest      every max acceleration setting, short and long moves both ways: acceleration,
+ *                        jerk, no overshoot, landing, time against the continuous profile
+ *   retargets            a seeded random stream of new targets and limits while moving: jerk, acceleration
+ *                        within the limit or falling towards it, landing on the last target
+ *
+ * The acceleration is checked both as the change of the value and as the planner state. A plan snaps onto its
+ * target at the end. From rest that only drops the rounding, below SCURVE_CHECK_CORRECTION. A new target just
+ * past where the value can stop may not be reachable in whole steps, the jump must then stay within half a
+ * step at the max acceleration.
+ *
+ * The planner and a step are then timed on the host. A step is O(1), it must cost the same on a long plan as
+ * on a short one. Only its cost relative to the host shows here, the target value is in the worst execution of
+ * Motor_GetTimingStats.
+ *
+ * Prints a report and exits with 1 if a check failed.
+ *
+ * Build and run from this directory with the Makefile, or with make check to run every check:
+ *   make scurve_check
+ *   ./scurve_check
+ */
+#pragma region Includes
+#include "control.h"
+#include "motor.h"
+#include "config.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SCURVE_CHECK_COUNTER() __rdtsc()
+#else
+#define SCURVE_CHECK_COUNTER() 0
+#endif
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define SCURVE_CHECK_ONE ((int64_t)1 << 24)
+#define SCURVE_CHECK_RETARGETS 20000
+#define SCURVE_CHECK_SEED 12345
+#define SCURVE_CHECK_SLACK 3		 // Steps a plan may take beyond the continuous profile, one per rounded segment
+#define SCURVE_CHECK_CORRECTION 0.01 // Largest jump onto the target at the end of a move from rest (RPM)
+#define SCURVE_CHECK_BENCHMARK 1000000
+#define SCURVE_CHECK_STEP_BUDGET 50 // ns on the host
+
+/**
+ * @brief What a run of steps did to the limits
+ *
+ */
+typedef struct tSCurveCheckRun {
+	uint32_t ui32Steps;
+	uint32_t ui32AccelOver;
+	uint32_t ui32JerkOver;
+	uint32_t ui32Overshoot;
+	uint32_t ui32Reversals;
+	int64_t i64WorstCorrection; // The largest jump at the end of a plan (Q24)
+	uint32_t ui32CorrectionOver; // Jumps of more than half a step at the max acceleration
+} tSCurveCheckRun;
+
+/* Global variables */
+uint8_t g_ui8SCurveCheckFailures = 0;
+volatile int32_t g_i32SCurveCheckSink;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Reports a check
+ *
+ * @param pcName The name of the check
+ * @param bPass Whether it passed
+ * @param pcFormat The measured values, printf style
+ */
+void SCurveCheck_Check(const char *pcName, bool bPass, const char *pcFormat, ...) {
+	va_list args;
+	va_start(args, pcFormat);
+	printf("%s %-26s ", bPass ? "PASS" : "FAIL", pcName);
+	vprintf(pcFormat, args);
+	printf("\n");
+	va_end(args);
+
+	if (!bPass)
+		g_ui8SCurveCheckFailures++;
+}
+
+/**
+ * @brief Converts a max acceleration setting to the limits of the planner, the way motor.c does
+ *
+ * @param i32Setting The max acceleration setting
+ * @param pi32MaxAccel The largest change per step (Q24)
+ * @param pi32MaxJerk The largest change of the change per step (Q24)
+ */
+void SCurveCheck_Limits(int32_t i32Setting, int32_t *pi32MaxAccel, int32_t *pi32MaxJerk) {
+	*pi32MaxAccel = ((int64_t)i32Setting * MOTOR_ACCEL_SCALE << 24) / MOTOR_CONTROL_RATE;
+	*pi32MaxJerk = *pi32MaxAccel / (MOTOR_JERK_TIME * MOTOR_CONTROL_RATE / 1000);
+	if (*pi32MaxJerk < 1)
+		*pi32MaxJerk = 1;
+}
+
+/**
+ * @brief Finds the steps the continuous profile takes to move from rest to rest
+ *
+ * @param dDistance The distance (Q24)
+ * @param dMaxAccel The largest change per step (Q24)
+ * @param dMaxJerk The largest change of the change per step (Q24)
+ * @return The steps
+ */
+double SCurveCheck_Ideal(double dDistance, double dMaxAccel, double dMaxJerk) {
+	double dPeak = fmin(sqrt(dMaxJerk * dDistance), dMaxAccel);
+	return 2 * dPeak / dMaxJerk + (dDistance - dPeak * dPeak / dMaxJerk) / dPeak;
+}
+
+/**
+ * @brief Steps a planner until its plan is done, checking every step
+ *
+ * @param psCurve The planner
+ * @param i32MaxAccel The largest change per step it was planned with (Q24)
+ * @param i32MaxJerk The largest change of the change per step it was planned with (Q24)
+ * @param ui32Steps The most steps to run, it stops early once at rest on the target
+ * @param psRun The run to add the steps to
+ *
+ * @note The acceleration may be above a limit lowered during a move, it must then fall towards the limit
+ */
+void SCurveCheck_Run(tControlSCurve *psCurve, int32_t i32MaxAccel, int32_t i32MaxJerk, uint32_t ui32Steps,
+					 tSCurveCheckRun *psRun) {
+	int64_t i64Target = (int64_t)psCurve->i32Target << 24;
+	int64_t i64Start = psCurve->i64Value;
+	int32_t i32Bound = abs(psCurve->i32Accel) > i32MaxAccel ? abs(psCurve->i32Accel) : i32MaxAccel;
+	int8_t i8Direction = 0;
+
+	for (uint32_t i = 0; i < ui32Steps && !(psCurve->i64Value == i64Target && psCurve->i32Accel == 0); i++) {
+		int64_t i64Last = psCurve->i64Value;
+		int32_t i32Last = psCurve->i32Accel;
+		Control_SCurveStep(psCurve);
+		psRun->ui32Steps++;
+
+		int64_t i64Change = psCurve->i64Value - i64Last;
+		int64_t i64Correction = llabs(i64Change - (((int64_t)i32Last + psCurve->i32Accel) >> 1));
+		if (abs(psCurve->i32Accel) > i32Bound || llabs(i64Change) > i32Bound)
+			psRun->ui32AccelOver++;
+		if (i64Correction > psRun->i64WorstCorrection)
+			psRun->i64WorstCorrection = i64Correction;
+		if (2 * i64Correction > i32MaxAccel)
+			psRun->ui32CorrectionOver++;
+		if (abs(psCurve->i32Accel) < i32Bound && abs(psCurve->i32Accel) >= i32MaxAccel)
+			i32Bound = abs(psCurve->i32Accel);
+		if (abs(psCurve->i32Accel - i32Last) > i32MaxJerk)
+			psRun->ui32JerkOver++;
+		if ((i64Start <= i64Target && psCurve->i64Value > i64Target) || (i64Start >= i64Target && psCurve->i64Value < i64Target))
+			psRun->ui32Overshoot++;
+
+		int8_t i8Step = (psCurve->i64Value > i64Last) - (psCurve->i64Value < i64Last);
+		if (i8Step != 0 && i8Direction != 0 && i8Step != i8Direction)
+			psRun->ui32Reversals++;
+		if (i8Step != 0)
+			i8Direction = i8Step;
+	}
+}
+
+/**
+ * @brief Checks moves from rest for every max acceleration setting
+ *
+ */
+void SCurveCheck_Moves() {
+	const int32_t pi32Moves[][2] = {{0, 200}, {200, 0}, {0, 1}, {100, 99}, {0, MAX_SPEED}, {-50, 50}, {0, 300}};
+	tSCurveCheckRun sRun = {0};
+	uint32_t ui32Plans = 0, ui32Missed = 0, ui32Late = 0;
+	double dWorstLate = 0;
+
+	for (int32_t i32Setting = 1; i32Setting <= MAX_ACCEL; i32Setting++) {
+		int32_t i32MaxAccel, i32MaxJerk;
+		SCurveCheck_Limits(i32Setting, &i32MaxAccel, &i32MaxJerk);
+
+		for (uint8_t i = 0; i < sizeof(pi32Moves) / sizeof(pi32Moves[0]); i++) {
+			tControlSCurve sCurve;
+			Control_SCurveReset(&sCurve, pi32Moves[i][0]);
+			Control_SCurvePlan(&sCurve, pi32Moves[i][1], i32MaxAccel, i32MaxJerk);
+			ui32Plans++;
+
+			uint32_t ui32Before = sRun.ui32Steps;
+			double dIdeal = SCurveCheck_Ideal(fabs((double)(pi32Moves[i][1] - pi32Moves[i][0]) * SCURVE_CHECK_ONE), i32MaxAccel,
+											  i32MaxJerk);
+			SCurveCheck_Run(&sCurve, i32MaxAccel, i32MaxJerk, (uint32_t)dIdeal + 1000, &sRun);
+
+			if (sCurve.i64Value != (int64_t)pi32Moves[i][1] << 24 || sCurve.i32Accel != 0)
+				ui32Missed++;
+			double dLate = sRun.ui32Steps - ui32Before - dIdeal;
+			if (dLate > SCURVE_CHECK_SLACK)
+				ui32Late++;
+			if (dLate > dWorstLate)
+				dWorstLate = dLate;
+		}
+	}
+
+	SCurveCheck_Check("moves: acceleration", sRun.ui32AccelOver == 0, "%u plans, %u steps, %u over", ui32Plans,
+					  sRun.ui32Steps, sRun.ui32AccelOver);
+	SCurveCheck_Check("moves: jerk", sRun.ui32JerkOver == 0, "%u over", sRun.ui32JerkOver);
+	SCurveCheck_Check("moves: overshoot", sRun.ui32Overshoot == 0 && sRun.ui32Reversals == 0, "%u steps past, %u reversals",
+					  sRun.ui32Overshoot, sRun.ui32Reversals);
+	SCurveCheck_Check("moves: landing", ui32Missed == 0 && sRun.i64WorstCorrection <= SCURVE_CHECK_CORRECTION * SCURVE_CHECK_ONE,
+					  "%u off the target, worst correction %.6f RPM", ui32Missed,
+					  (double)sRun.i64WorstCorrection / SCURVE_CHECK_ONE);
+	SCurveCheck_Check("moves: duration", ui32Late == 0, "worst %.1f steps beyond the continuous profile", dWorstLate);
+}
+
+/**
+ * @brief Checks a stream of new targets and limits given while moving
+ *
+ */
+void SCurveCheck_Retargets() {
+	tControlSCurve sCurve;
+	tSCurveCheckRun sRun = {0};
+	int32_t i32MaxAccel = 0, i32MaxJerk = 0, i32Target = 0;
+	Control_SCurveReset(&sCurve, 0);
+	srand(SCURVE_CHECK_SEED);
+
+	for (uint32_t i = 0; i < SCURVE_CHECK_RETARGETS; i++) {
+		i32Target = rand() % (2 * MAX_SPEED + 1) - MAX_SPEED;
+		SCurveCheck_Limits(1 + rand() % MAX_ACCEL, &i32MaxAccel, &i32MaxJerk);
+		Control_SCurvePlan(&sCurve, i32Target, i32MaxAccel, i32MaxJerk);
+
+		/* Overshoot and reversals are expected when the target moves behind the value */
+		SCurveCheck_Run(&sCurve, i32MaxAccel, i32MaxJerk, rand() % 500, &sRun);
+	}
+	SCurveCheck_Run(&sCurve, i32MaxAccel, i32MaxJerk, UINT32_MAX, &sRun);
+
+	SCurveCheck_Check("retargets: acceleration", sRun.ui32AccelOver == 0, "%u plans, %u steps, %u over",
+					  SCURVE_CHECK_RETARGETS, sRun.ui32Steps, sRun.ui32AccelOver);
+	SCurveCheck_Check("retargets: jerk", sRun.ui32JerkOver == 0, "%u over", sRun.ui32JerkOver);
+	SCurveCheck_Check("retargets: landing",
+					  sCurve.i64Value == (int64_t)i32Target << 24 && sCurve.i32Accel == 0 && sRun.ui32CorrectionOver == 0,
+					  "%.4f of %d, worst correction %.3f RPM", (double)sCurve.i64Value / SCURVE_CHECK_ONE, i32Target,
+					  (double)sRun.i64WorstCorrection / SCURVE_CHECK_ONE);
+}
+
+/**
+ * @brief Times steps along a plan
+ *
+ * @param i32Target The target of the plan, from rest at 0
+ * @param i32Setting The max acceleration setting
+ * @param pdNs The time per step (ns)
+ * @param pdCounts The time stamp counts per step, 0 where the host has no counter
+ */
+void SCurveCheck_TimeSteps(int32_t i32Target, int32_t i32Setting, double *pdNs, double *pdCounts) {
+	int32_t i32MaxAccel, i32MaxJerk;
+	SCurveCheck_Limits(i32Setting, &i32MaxAccel, &i32MaxJerk);
+	tControlSCurve sCurve;
+	Control_SCurveReset(&sCurve, 0);
+	Control_SCurvePlan(&sCurve, i32Target, i32MaxAccel, i32MaxJerk);
+	tControlSCurve sPlanned = sCurve;
+
+	struct timespec sStart, sEnd;
+	uint64_t ui64Start = SCURVE_CHECK_COUNTER();
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	for (uint32_t i = 0; i < SCURVE_CHECK_BENCHMARK; i++) {
+		g_i32SCurveCheckSink = Control_SCurveStep(&sCurve);
+		if (sCurve.ui8Segment == sCurve.ui8Segments)
+			sCurve = sPlanned;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+	uint64_t ui64End = SCURVE_CHECK_COUNTER();
+
+	*pdNs = ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec)) / SCURVE_CHECK_BENCHMARK;
+	*pdCounts = (double)(ui64End - ui64Start) / SCURVE_CHECK_BENCHMARK;
+}
+
+/**
+ * @brief Times the planner and a step
+ *
+ */
+void SCurveCheck_Benchmark() {
+	int32_t i32MaxAccel, i32MaxJerk;
+	SCurveCheck_Limits(MAX_ACCEL, &i32MaxAccel, &i32MaxJerk);
+	tControlSCurve sCurve;
+
+	struct timespec sStart, sEnd;
+	uint64_t ui64Start = SCURVE_CHECK_COUNTER();
+	clock_gettime(CLOCK_MONOTONIC, &sStart);
+	for (uint32_t i = 0; i < SCURVE_CHECK_BENCHMARK; i++) {
+		Control_SCurveReset(&sCurve, 0);
+		Control_SCurvePlan(&sCurve, 1 + i % MAX_SPEED, i32MaxAccel, i32MaxJerk);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &sEnd);
+	uint64_t ui64End = SCURVE_CHECK_COUNTER();
+	double dNs = ((sEnd.tv_sec - sStart.tv_sec) * 1e9 + (sEnd.tv_nsec - sStart.tv_nsec)) / SCURVE_CHECK_BENCHMARK;
+	SCurveCheck_Check("plan", true, "%.1f ns, %.0f counts per plan on the host", dNs,
+					  (double)(ui64End - ui64Start) / SCURVE_CHECK_BENCHMARK);
+
+	/* A short plan at full acceleration and a long one at the lowest */
+	double dShortNs, dShortCounts, dLongNs, dLongCounts;
+	SCurveCheck_TimeSteps(10, MAX_ACCEL, &dShortNs, &dShortCounts);
+	SCurveCheck_TimeSteps(MAX_SPEED, 1, &dLongNs, &dLongCounts);
+	SCurveCheck_Check("step", dShortNs <= SCURVE_CHECK_STEP_BUDGET && dLongNs <= SCURVE_CHECK_STEP_BUDGET,
+					  "%.1f ns, %.0f counts short, %.1f ns, %.0f counts long on the host", dShortNs, dShortCounts, dLongNs,
+					  dLongCounts);
+}
+#pragma endregion
+
+/**
+ * @brief Host check entry point
+ *
+ * @return 0 if every check passed
+ */
+int main() {
+	SCurveCheck_Moves();
+	SCurveCheck_Retargets();
+	SCurveCheck_Benchmark();
+	printf("%s: %u check(s) failed\n", g_ui8SCurveCheckFailures == 0 ? "PASS" : "FAIL", g_ui8SCurveCheckFailures);
+	return g_ui8SCurveCheckFailures == 0 ? 0 : 1;
+}
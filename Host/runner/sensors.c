@@ -0,0 +1,69 @@
+/**
+ * @file sensors.c
+ * @brief Host stand-in for the sensors, reads the power and the acceleration off the simulated motor
+ *
+ * Replaces Code/sensors.c in host builds that start the plant (see plant.h). The light is read
+ * through the driver like on the target, from the sensor model (see lightsensor.h).
+ */
+#pragma region Includes
+#include "sensors.h"
+#include "plant.h"
+#include "sim.h"
+#include "motor.h"
+#include "opt3001.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/* TI-RTOS header files */
+#include <ti/drivers/GPIO.h>
+
+/* Board header file */
+#include "Board.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global variables */
+double g_dSensorsLastSpeed = 0;
+uint64_t g_ui64SensorsLastTime = 0;
+#pragma endregion
+
+#pragma region Sensors API functions
+int16_t Sensors_GetPower() {
+	tPlantState sPlant;
+	Plant_GetState(&sPlant);
+	return (int16_t)lround(sPlant.dPower);
+}
+
+int16_t Sensors_GetLight() {
+	uint32_t ui32Light = (OPT3001_GetLight() + 50) / 100;
+	return ui32Light > INT16_MAX ? INT16_MAX : (int16_t)ui32Light;
+}
+
+/**
+ * @brief Reads the acceleration of the motor
+ *
+ * @return The acceleration, in MOTOR_ACCEL_SCALE RPM/s on the scale of the max acceleration setting
+ *
+ * @note Averaged since the previous call, like an accelerometer sampled at the publish rate, the magnitude
+ *		 as the bar shows no direction
+ */
+int16_t Sensors_GetAccel() {
+	tPlantState sPlant;
+	Plant_GetState(&sPlant);
+	uint64_t ui64Now = Sim_Now();
+	double dAccel = 0;
+	if (ui64Now > g_ui64SensorsLastTime)
+		dAccel = (sPlant.dSpeed - g_dSensorsLastSpeed) * SIM_CPU_FREQ / (ui64Now - g_ui64SensorsLastTime);
+
+	g_dSensorsLastSpeed = sPlant.dSpeed;
+	g_ui64SensorsLastTime = ui64Now;
+	return (int16_t)lround(fabs(dAccel) / MOTOR_ACCEL_SCALE);
+}
+
+bool Sensors_GetEStop() {
+	return GPIO_read(Board_ESTOP) == 0;
+}
+#pragma endregion
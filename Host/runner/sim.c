@@ -0,0 +1,541 @@
+/**
+ * @file sim.c
+ * @brief Simulated CPU and the host stand-ins of the SYS/BIOS modules used by the application
+ */
+#pragma region Includes
+#include "sim.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+
+/* BIOS header files */
+#include <xdc/std.h>
+#include <xdc/runtime/Timestamp.h>
+#include <xdc/runtime/Types.h>
+#include <ti/sysbios/BIOS.h>
+#include <ti/sysbios/knl/Clock.h>
+#include <ti/sysbios/knl/Event.h>
+#include <ti/sysbios/knl/Task.h>
+#include <ti/sysbios/gates/GateMutexPri.h>
+#include <ti/sysbios/hal/Hwi.h>
+#include <ti/sysbios/utils/Load.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/**
+ * @brief States of a task
+ *
+ */
+typedef enum tSimTaskState {
+	SIM_TASK_READY,
+	SIM_TASK_PEND_EVENT,
+	SIM_TASK_PEND_GATE,
+	SIM_TASK_DONE,
+} tSimTaskState;
+
+/**
+ * @brief A task and what it is blocked on
+ *
+ */
+typedef struct tSimTask {
+	ucontext_t sContext;
+	Task_FuncPtr pfnFxn;
+	UArg arg0;
+	UArg arg1;
+	Int iPriority;
+	tSimTaskState eState;
+	uint64_t ui64ReadySeq;
+	uint64_t ui64Deadline;
+	Event_Handle hEvent;
+	UInt uiMask;
+	UInt uiResult;
+	GateMutexPri_Handle hGate;
+	uint64_t ui64Busy;
+	uint64_t ui64WindowStart;
+	uint64_t ui64WindowBusy;
+} tSimTask;
+
+/**
+ * @brief A timer, which is also the object behind a clock
+ *
+ */
+typedef struct Clock_Object {
+	tSimTimerFxn pfnFxn;
+	uintptr_t arg;
+	bool bActive;
+	uint64_t ui64Due;
+	uint64_t ui64Period;
+} tSimTimer;
+
+/* Global variables */
+tSimTask g_psSimTasks[SIM_MAX_TASKS];
+uint8_t g_ui8SimTasks = 0;
+tSimTask *g_psSimCurrent = NULL;
+ucontext_t g_sSimScheduler;
+uint64_t g_ui64SimReadySeq = 0;
+tSimTimer g_psSimTimers[SIM_MAX_TIMERS];
+uint8_t g_ui8SimTimers = 0;
+uint64_t g_ui64SimNow = 0;
+uint64_t g_ui64SimNext = UINT64_MAX;
+bool g_bSimInterrupt = false;
+bool g_bSimStopped = false;
+void (*g_pfnSimStart)() = NULL;
+tSimTraceFxn g_pfnSimTrace = NULL;
+bool g_bSimLoadValid = false;
+Hwi_Struct *g_psSimVectors[SIM_MAX_INTERRUPTS];
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Finds the next time a timer fires or a pend times out
+ *
+ */
+void Sim_UpdateNext() {
+	g_ui64SimNext = UINT64_MAX;
+	for (uint8_t i = 0; i < g_ui8SimTimers; i++) {
+		if (g_psSimTimers[i].bActive && g_psSimTimers[i].ui64Due < g_ui64SimNext)
+			g_ui64SimNext = g_psSimTimers[i].ui64Due;
+	}
+	for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+		tSimTask *psTask = &g_psSimTasks[i];
+		if (psTask->eState == SIM_TASK_PEND_EVENT && psTask->ui64Deadline < g_ui64SimNext)
+			g_ui64SimNext = psTask->ui64Deadline;
+	}
+}
+
+/**
+ * @brief Makes a task ready to run, behind the ready tasks of the same priority
+ *
+ * @param psTask The task
+ */
+void Sim_Ready(tSimTask *psTask) {
+	psTask->eState = SIM_TASK_READY;
+	psTask->ui64ReadySeq = g_ui64SimReadySeq++;
+}
+
+/**
+ * @brief Finds the task to run next
+ *
+ * @return The highest priority ready task, the longest waiting one among equals, or NULL if none is ready
+ */
+tSimTask *Sim_Highest() {
+	tSimTask *psBest = NULL;
+	for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+		tSimTask *psTask = &g_psSimTasks[i];
+		if (psTask->eState != SIM_TASK_READY)
+			continue;
+		if (psBest == NULL || psTask->iPriority > psBest->iPriority ||
+			(psTask->iPriority == psBest->iPriority && psTask->ui64ReadySeq < psBest->ui64ReadySeq))
+			psBest = psTask;
+	}
+	return psBest;
+}
+
+/**
+ * @brief Gives the CPU back to the scheduler from the running task
+ *
+ */
+void Sim_Suspend() {
+	tSimTask *psTask = g_psSimCurrent;
+	swapcontext(&psTask->sContext, &g_sSimScheduler);
+}
+
+/**
+ * @brief Lets a higher priority ready task run before the running one continues
+ *
+ */
+void Sim_Preempt() {
+	if (g_psSimCurrent == NULL || g_bSimInterrupt)
+		return;
+
+	tSimTask *psNext = Sim_Highest();
+	if (g_bSimStopped || (psNext != NULL && psNext->iPriority > g_psSimCurrent->iPriority))
+		Sim_Suspend();
+}
+
+/**
+ * @brief Fires every timer and times out every pend up to a point in time
+ *
+ * @param ui64Time The time to move to
+ */
+void Sim_AdvanceTo(uint64_t ui64Time) {
+	while (g_ui64SimNext <= ui64Time) {
+		if (g_ui64SimNext > g_ui64SimNow)
+			g_ui64SimNow = g_ui64SimNext;
+
+		/* Interrupts first, in the order their timers were created */
+		g_bSimInterrupt = true;
+		for (uint8_t i = 0; i < g_ui8SimTimers; i++) {
+			tSimTimer *psTimer = &g_psSimTimers[i];
+			if (!psTimer->bActive || psTimer->ui64Due > g_ui64SimNow)
+				continue;
+
+			psTimer->bActive = psTimer->ui64Period != 0;
+			psTimer->ui64Due += psTimer->ui64Period;
+			psTimer->pfnFxn(psTimer->arg);
+		}
+		g_bSimInterrupt = false;
+
+		for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+			tSimTask *psTask = &g_psSimTasks[i];
+			if (psTask->eState != SIM_TASK_PEND_EVENT || psTask->ui64Deadline > g_ui64SimNow)
+				continue;
+
+			psTask->hEvent->psPending = NULL;
+			psTask->uiResult = 0;
+			Sim_Ready(psTask);
+		}
+
+		Sim_UpdateNext();
+	}
+
+	if (ui64Time > g_ui64SimNow)
+		g_ui64SimNow = ui64Time;
+}
+
+/**
+ * @brief Closes a load window, keeping the time each task ran during it
+ *
+ * @param arg Unused
+ */
+void Sim_LoadWindow(uintptr_t arg) {
+	for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+		tSimTask *psTask = &g_psSimTasks[i];
+		psTask->ui64WindowBusy = psTask->ui64Busy - psTask->ui64WindowStart;
+		psTask->ui64WindowStart = psTask->ui64Busy;
+	}
+	g_bSimLoadValid = true;
+}
+
+/**
+ * @brief Entry point of every task
+ *
+ * @param iTask The index of the task
+ */
+void Sim_TaskMain(int iTask) {
+	tSimTask *psTask = &g_psSimTasks[iTask];
+	psTask->pfnFxn(psTask->arg0, psTask->arg1);
+
+	psTask->eState = SIM_TASK_DONE;
+	Sim_Suspend();
+}
+#pragma endregion
+
+#pragma region Simulation API functions
+uint64_t Sim_Now() {
+	return g_ui64SimNow;
+}
+
+uint64_t Sim_GetBusy() {
+	uint64_t ui64Busy = 0;
+	for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+		ui64Busy += g_psSimTasks[i].ui64Busy;
+	}
+	return ui64Busy;
+}
+
+void Sim_Advance(uint64_t ui64Cycles) {
+	if (g_psSimCurrent != NULL && !g_bSimInterrupt)
+		g_psSimCurrent->ui64Busy += ui64Cycles;
+
+	Sim_AdvanceTo(g_ui64SimNow + ui64Cycles);
+	Sim_Preempt();
+}
+
+uint8_t Sim_TimerCreate(tSimTimerFxn pfnFxn, uintptr_t arg) {
+	if (g_ui8SimTimers == SIM_MAX_TIMERS) {
+		fprintf(stderr, "sim: out of timers\n");
+		exit(1);
+	}
+
+	g_psSimTimers[g_ui8SimTimers] = (tSimTimer){pfnFxn, arg, false, 0, 0};
+	return g_ui8SimTimers++;
+}
+
+void Sim_TimerStart(uint8_t ui8Timer, uint64_t ui64Due, uint64_t ui64Period) {
+	tSimTimer *psTimer = &g_psSimTimers[ui8Timer];
+	psTimer->bActive = true;
+	psTimer->ui64Due = ui64Due < g_ui64SimNow ? g_ui64SimNow : ui64Due;
+	psTimer->ui64Period = ui64Period;
+	if (psTimer->ui64Due < g_ui64SimNext)
+		g_ui64SimNext = psTimer->ui64Due;
+}
+
+void Sim_Interrupt(uint32_t ui32IntNum) {
+	if (ui32IntNum < SIM_MAX_INTERRUPTS && g_psSimVectors[ui32IntNum] != NULL)
+		g_psSimVectors[ui32IntNum]->pfnFxn(g_psSimVectors[ui32IntNum]->arg);
+}
+
+void Sim_SetStartHook(void (*pfnStart)()) {
+	g_pfnSimStart = pfnStart;
+}
+
+void Sim_SetTraceHook(tSimTraceFxn pfnTrace) {
+	g_pfnSimTrace = pfnTrace;
+}
+
+void Sim_Stop() {
+	g_bSimStopped = true;
+}
+#pragma endregion
+
+#pragma region BIOS functions
+void BIOS_start() {
+	uint8_t ui8Load = Sim_TimerCreate(Sim_LoadWindow, 0);
+	Sim_TimerStart(ui8Load, g_ui64SimNow + SIM_CYCLES_MS(SIM_LOAD_WINDOW), SIM_CYCLES_MS(SIM_LOAD_WINDOW));
+
+	if (g_pfnSimStart != NULL)
+		g_pfnSimStart();
+
+	while (!g_bSimStopped) {
+		tSimTask *psTask = Sim_Highest();
+		if (psTask != NULL) {
+			g_psSimCurrent = psTask;
+			swapcontext(&g_sSimScheduler, &psTask->sContext);
+			g_psSimCurrent = NULL;
+			continue;
+		}
+
+		/* Idle until the next interrupt, or forever if there is none */
+		if (g_ui64SimNext == UINT64_MAX)
+			break;
+		Sim_AdvanceTo(g_ui64SimNext);
+	}
+}
+
+void BIOS_getCpuFreq(Types_FreqHz *psFreq) {
+	psFreq->hi = 0;
+	psFreq->lo = SIM_CPU_FREQ;
+}
+
+UInt32 Timestamp_get32() {
+	return (UInt32)g_ui64SimNow;
+}
+
+void Timestamp_getFreq(Types_FreqHz *psFreq) {
+	psFreq->hi = 0;
+	psFreq->lo = SIM_CPU_FREQ;
+}
+#pragma endregion
+
+#pragma region Hwi functions
+void Hwi_Params_init(Hwi_Params *psParams) {
+	psParams->arg = 0;
+	psParams->priority = -1;
+}
+
+void Hwi_construct(Hwi_Struct *psStruct, Int iIntNum, Hwi_FuncPtr pfnFxn, const Hwi_Params *psParams, void *pvEb) {
+	if (iIntNum < 0 || iIntNum >= SIM_MAX_INTERRUPTS) {
+		fprintf(stderr, "sim: bad interrupt number %d\n", iIntNum);
+		exit(1);
+	}
+
+	psStruct->iIntNum = iIntNum;
+	psStruct->pfnFxn = pfnFxn;
+	psStruct->arg = psParams != NULL ? psParams->arg : 0;
+	g_psSimVectors[iIntNum] = psStruct;
+}
+
+UInt Hwi_disable() {
+	return 0;
+}
+
+void Hwi_restore(UInt uiKey) {
+}
+#pragma endregion
+
+#pragma region Clock functions
+void Clock_Params_init(Clock_Params *psParams) {
+	psParams->period = 0;
+	psParams->startFlag = false;
+	psParams->arg = 0;
+}
+
+Clock_Handle Clock_create(Clock_FuncPtr pfnFxn, UInt32 ui32Timeout, const Clock_Params *psParams, void *pvEb) {
+	Clock_Params sParams;
+	Clock_Params_init(&sParams);
+	if (psParams != NULL)
+		sParams = *psParams;
+
+	/* A clock function is called like any other timer function */
+	uint8_t ui8Timer = Sim_TimerCreate((tSimTimerFxn)pfnFxn, sParams.arg);
+	if (sParams.startFlag) {
+		uint64_t ui64Tick = g_ui64SimNow / SIM_TICK_CYCLES;
+		Sim_TimerStart(ui8Timer, (ui64Tick + ui32Timeout) * SIM_TICK_CYCLES, (uint64_t)sParams.period * SIM_TICK_CYCLES);
+	}
+	return &g_psSimTimers[ui8Timer];
+}
+
+UInt32 Clock_getTicks() {
+	return (UInt32)(g_ui64SimNow / SIM_TICK_CYCLES);
+}
+#pragma endregion
+
+#pragma region Task functions
+void Task_Params_init(Task_Params *psParams) {
+	memset(psParams, 0, sizeof(*psParams));
+	psParams->priority = 1;
+}
+
+void Task_construct(Task_Struct *psStruct, Task_FuncPtr pfnFxn, const Task_Params *psParams, void *pvEb) {
+	Task_Params sParams;
+	Task_Params_init(&sParams);
+	if (psParams != NULL)
+		sParams = *psParams;
+	if (g_ui8SimTasks == SIM_MAX_TASKS) {
+		fprintf(stderr, "sim: out of tasks\n");
+		exit(1);
+	}
+
+	/* Host code needs far more stack than the target, so the given stack is not used */
+	tSimTask *psTask = &g_psSimTasks[g_ui8SimTasks];
+	memset(psTask, 0, sizeof(*psTask));
+	psTask->pfnFxn = pfnFxn;
+	psTask->arg0 = sParams.arg0;
+	psTask->arg1 = sParams.arg1;
+	psTask->iPriority = sParams.priority;
+	getcontext(&psTask->sContext);
+	psTask->sContext.uc_stack.ss_sp = malloc(SIM_STACK_SIZE);
+	psTask->sContext.uc_stack.ss_size = SIM_STACK_SIZE;
+	psTask->sContext.uc_link = NULL;
+	makecontext(&psTask->sContext, (void (*)())Sim_TaskMain, 1, (int)g_ui8SimTasks);
+	Sim_Ready(psTask);
+
+	psStruct->psTask = psTask;
+	g_ui8SimTasks++;
+}
+
+Task_Handle Task_handle(Task_Struct *psTask) {
+	return psTask;
+}
+
+void Task_yield() {
+	Sim_Ready(g_psSimCurrent);
+	Sim_Suspend();
+}
+#pragma endregion
+
+#pragma region Event functions
+void Event_construct(Event_Struct *psEvent, const Event_Params *psParams) {
+	psEvent->uiPosted = 0;
+	psEvent->psPending = NULL;
+}
+
+Event_Handle Event_handle(Event_Struct *psEvent) {
+	return psEvent;
+}
+
+void Event_post(Event_Handle hEvent, UInt uiIds) {
+	hEvent->uiPosted |= uiIds;
+
+	tSimTask *psTask = hEvent->psPending;
+	if (psTask == NULL || !(hEvent->uiPosted & psTask->uiMask))
+		return;
+
+	psTask->uiResult = hEvent->uiPosted & psTask->uiMask;
+	hEvent->uiPosted &= ~psTask->uiResult;
+	hEvent->psPending = NULL;
+	Sim_Ready(psTask);
+	Sim_Preempt();
+}
+
+UInt Event_pend(Event_Handle hEvent, UInt uiAndMask, UInt uiOrMask, UInt32 ui32Timeout) {
+	UInt uiResult = hEvent->uiPosted & uiOrMask;
+	if (uiResult != 0 || ui32Timeout == BIOS_NO_WAIT) {
+		hEvent->uiPosted &= ~uiResult;
+		return uiResult;
+	}
+
+	tSimTask *psTask = g_psSimCurrent;
+	psTask->eState = SIM_TASK_PEND_EVENT;
+	psTask->hEvent = hEvent;
+	psTask->uiMask = uiOrMask;
+	psTask->ui64Deadline = UINT64_MAX;
+	if (ui32Timeout != BIOS_WAIT_FOREVER)
+		psTask->ui64Deadline = ((uint64_t)Clock_getTicks() + ui32Timeout) * SIM_TICK_CYCLES;
+	hEvent->psPending = psTask;
+	Sim_UpdateNext();
+
+	Sim_Suspend();
+	return psTask->uiResult;
+}
+#pragma endregion
+
+#pragma region Gate functions
+void GateMutexPri_construct(GateMutexPri_Struct *psGate, const GateMutexPri_Params *psParams) {
+	psGate->psOwner = NULL;
+}
+
+GateMutexPri_Handle GateMutexPri_handle(GateMutexPri_Struct *psGate) {
+	return psGate;
+}
+
+IArg GateMutexPri_enter(GateMutexPri_Handle hGate) {
+	tSimTask *psTask = g_psSimCurrent;
+	if (hGate->psOwner == psTask)
+		return 1;
+
+	/* The owner always runs while it is blocked here, so priority inheritance happens by itself */
+	if (hGate->psOwner != NULL) {
+		psTask->eState = SIM_TASK_PEND_GATE;
+		psTask->hGate = hGate;
+		Sim_Suspend();
+	} else {
+		hGate->psOwner = psTask;
+	}
+
+	if (g_pfnSimTrace != NULL)
+		g_pfnSimTrace(SIM_TRACE_GATE_ENTER, (void *)psTask->pfnFxn);
+	return 0;
+}
+
+void GateMutexPri_leave(GateMutexPri_Handle hGate, IArg iKey) {
+	if (iKey != 0)
+		return;
+
+	if (g_pfnSimTrace != NULL)
+		g_pfnSimTrace(SIM_TRACE_GATE_LEAVE, (void *)g_psSimCurrent->pfnFxn);
+
+	/* Hand the gate straight to the highest priority waiter */
+	tSimTask *psNext = NULL;
+	for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+		tSimTask *psTask = &g_psSimTasks[i];
+		if (psTask->eState == SIM_TASK_PEND_GATE && psTask->hGate == hGate &&
+			(psNext == NULL || psTask->iPriority > psNext->iPriority))
+			psNext = psTask;
+	}
+
+	hGate->psOwner = psNext;
+	if (psNext != NULL) {
+		Sim_Ready(psNext);
+		Sim_Preempt();
+	}
+}
+#pragma endregion
+
+#pragma region Load functions
+Bool Load_getTaskLoad(Task_Handle hTask, Load_Stat *psStat) {
+	psStat->threadTime = (UInt32)hTask->psTask->ui64WindowBusy;
+	psStat->totalTime = (UInt32)SIM_CYCLES_MS(SIM_LOAD_WINDOW);
+	return g_bSimLoadValid;
+}
+
+UInt32 Load_calculateLoad(Load_Stat *psStat) {
+	if (psStat->totalTime == 0)
+		return 0;
+	return (UInt32)((uint64_t)psStat->threadTime * 100 / psStat->totalTime);
+}
+
+UInt32 Load_getCPULoad() {
+	uint64_t ui64Busy = 0;
+	for (uint8_t i = 0; i < g_ui8SimTasks; i++) {
+		ui64Busy += g_psSimTasks[i].ui64WindowBusy;
+	}
+	return (UInt32)(ui64Busy * 100 / SIM_CYCLES_MS(SIM_LOAD_WINDOW));
+}
+#pragma endregion
@@ -0,0 +1,125 @@
+/**
+ * @file sim.h
+ * @brief Simulated CPU behind the host stand-ins of SYS/BIOS
+ *
+ * Tasks run as coroutines and only the simulated hardware spends time, through Sim_Advance.
+ * Clocks and the simulated peripherals are timers that fire as interrupts whenever time
+ * passes, readying tasks that then preempt lower priority ones like on the target.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define SIM_CPU_FREQ 120000000
+#define SIM_TICK_CYCLES (SIM_CPU_FREQ / 1000)
+#define SIM_CYCLES_US(us) ((uint64_t)(us) * (SIM_CPU_FREQ / 1000000))
+#define SIM_CYCLES_MS(ms) ((uint64_t)(ms) * SIM_TICK_CYCLES)
+#define SIM_MAX_TASKS 8
+#define SIM_MAX_TIMERS 32
+#define SIM_MAX_INTERRUPTS 128
+#define SIM_STACK_SIZE (256 * 1024)
+#define SIM_LOAD_WINDOW 1000 // ms
+
+/**
+ * @brief Function called when a timer fires, from interrupt context
+ *
+ */
+typedef void (*tSimTimerFxn)(uintptr_t arg);
+
+/**
+ * @brief Kernel events reported to the trace hook
+ *
+ */
+typedef enum tSimTrace {
+	/**
+	 * @brief A task entered a gate
+	 */
+	SIM_TRACE_GATE_ENTER,
+	/**
+	 * @brief A task is about to leave a gate
+	 */
+	SIM_TRACE_GATE_LEAVE,
+} tSimTrace;
+
+/**
+ * @brief Function called on kernel events
+ *
+ * @param eTrace The event
+ * @param pvTask The function of the task that caused it
+ */
+typedef void (*tSimTraceFxn)(tSimTrace eTrace, void *pvTask);
+
+/**
+ * @brief Gets the simulated time
+ *
+ * @return The number of CPU cycles since the simulation started
+ */
+uint64_t Sim_Now();
+
+/**
+ * @brief Gets the time the tasks have spent running
+ *
+ * @return The number of CPU cycles spent by every task since the simulation started
+ *
+ * @note Only the display bus and Sim_Advance spend time, so the rest of the period is idle
+ */
+uint64_t Sim_GetBusy();
+
+/**
+ * @brief Spends simulated time, firing the timers that fall due
+ *
+ * @param ui64Cycles The number of CPU cycles spent
+ *
+ * @note When called from a task, a higher priority task readied by a timer preempts it before this returns
+ */
+void Sim_Advance(uint64_t ui64Cycles);
+
+/**
+ * @brief Creates a stopped timer
+ *
+ * @param pfnFxn The function to call when the timer fires
+ * @param arg The argument to pass to the function
+ * @return The timer index
+ *
+ * @note Timers that fall due at the same time fire in the order they were created
+ */
+uint8_t Sim_TimerCreate(tSimTimerFxn pfnFxn, uintptr_t arg);
+
+/**
+ * @brief Starts or restarts a timer
+ *
+ * @param ui8Timer The timer index
+ * @param ui64Due The time of the first call (CPU cycles)
+ * @param ui64Period The time between calls, or 0 to fire once (CPU cycles)
+ */
+void Sim_TimerStart(uint8_t ui8Timer, uint64_t ui64Due, uint64_t ui64Period);
+
+/**
+ * @brief Raises a hardware interrupt, calling the function constructed for it
+ *
+ * @param ui32IntNum The interrupt number
+ *
+ * @note Must be called from a timer function, an interrupt without a function is ignored
+ */
+void Sim_Interrupt(uint32_t ui32IntNum);
+
+/**
+ * @brief Sets the function BIOS_start calls before running the first task
+ *
+ * @param pfnStart The function
+ */
+void Sim_SetStartHook(void (*pfnStart)());
+
+/**
+ * @brief Sets the function called on kernel events
+ *
+ * @param pfnTrace The function, or NULL
+ */
+void Sim_SetTraceHook(tSimTraceFxn pfnTrace);
+
+/**
+ * @brief Stops the simulation, BIOS_start returns once the running task gives up the CPU
+ *
+ */
+void Sim_Stop();
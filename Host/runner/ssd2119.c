@@ -0,0 +1,229 @@
+/**
+ * @file ssd2119.c
+ * @brief Host emulation of the SSD2119 display controller behind the SSI and GPIO driverlib calls
+ */
+#pragma region Includes
+#include "ssd2119.h"
+#include "sim.h"
+
+/* Standard header files */
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* TivaWare header files */
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines, the pins must match drivers/Kentec320x240x16_ssd2119_spi.c */
+#define SSD2119_SSI_BASE SSI3_BASE
+#define SSD2119_CS_BASE GPIO_PORTP_BASE
+#define SSD2119_CS_PIN GPIO_PIN_3
+#define SSD2119_DC_BASE GPIO_PORTP_BASE
+#define SSD2119_DC_PIN GPIO_PIN_4
+#define SSD2119_GPIO_CYCLES 8 // A driverlib call to write a pin
+#define SSD2119_ENTRY_MODE_REG 0x11
+#define SSD2119_RAM_DATA_REG 0x22
+#define SSD2119_V_RAM_POS_REG 0x44
+#define SSD2119_H_RAM_START_REG 0x45
+#define SSD2119_H_RAM_END_REG 0x46
+#define SSD2119_X_RAM_ADDR_REG 0x4e
+#define SSD2119_Y_RAM_ADDR_REG 0x4f
+#define SSD2119_ENTRY_ID0 0x10 // Increment X
+#define SSD2119_ENTRY_ID1 0x20 // Increment Y
+#define SSD2119_ENTRY_AM 0x08  // Move along Y first
+
+/* Global variables */
+uint16_t g_pui16SSD2119Ram[SSD2119_HEIGHT][SSD2119_WIDTH];
+tSSD2119Stats g_sSSD2119Stats;
+uint32_t g_ui32SSD2119ByteCycles = 64; // 8 bits at 15 MHz
+bool g_bSSD2119Select = false;
+bool g_bSSD2119Data = false;
+bool g_bSSD2119HighByte = true;
+uint16_t g_ui16SSD2119Word = 0;
+uint8_t g_ui8SSD2119Register = 0;
+uint16_t g_ui16SSD2119Entry = 0;
+uint16_t g_ui16SSD2119X = 0;
+uint16_t g_ui16SSD2119Y = 0;
+uint16_t g_ui16SSD2119XStart = 0;
+uint16_t g_ui16SSD2119XEnd = SSD2119_WIDTH - 1;
+uint16_t g_ui16SSD2119YStart = 0;
+uint16_t g_ui16SSD2119YEnd = SSD2119_HEIGHT - 1;
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Moves a cursor coordinate one step within its window
+ *
+ * @param pui16Position The coordinate to move
+ * @param bIncrement True to move up, false to move down
+ * @param ui16Start The start of the window
+ * @param ui16End The end of the window
+ * @return True if the coordinate wrapped around the window
+ */
+bool SSD2119_Step(uint16_t *pui16Position, bool bIncrement, uint16_t ui16Start, uint16_t ui16End) {
+	if (bIncrement && *pui16Position >= ui16End) {
+		*pui16Position = ui16Start;
+		return true;
+	}
+	if (!bIncrement && *pui16Position <= ui16Start) {
+		*pui16Position = ui16End;
+		return true;
+	}
+
+	*pui16Position += bIncrement ? 1 : -1;
+	return false;
+}
+
+/**
+ * @brief Writes a pixel at the cursor and moves the cursor as set by the entry mode
+ *
+ * @param ui16Color The pixel in 5-6-5 RGB
+ */
+void SSD2119_RamWrite(uint16_t ui16Color) {
+	if (g_ui16SSD2119X < SSD2119_WIDTH && g_ui16SSD2119Y < SSD2119_HEIGHT)
+		g_pui16SSD2119Ram[g_ui16SSD2119Y][g_ui16SSD2119X] = ui16Color;
+	g_sSSD2119Stats.ui32Pixels++;
+
+	bool bXUp = g_ui16SSD2119Entry & SSD2119_ENTRY_ID0;
+	bool bYUp = g_ui16SSD2119Entry & SSD2119_ENTRY_ID1;
+	if (g_ui16SSD2119Entry & SSD2119_ENTRY_AM) {
+		if (SSD2119_Step(&g_ui16SSD2119Y, bYUp, g_ui16SSD2119YStart, g_ui16SSD2119YEnd))
+			SSD2119_Step(&g_ui16SSD2119X, bXUp, g_ui16SSD2119XStart, g_ui16SSD2119XEnd);
+	} else {
+		if (SSD2119_Step(&g_ui16SSD2119X, bXUp, g_ui16SSD2119XStart, g_ui16SSD2119XEnd))
+			SSD2119_Step(&g_ui16SSD2119Y, bYUp, g_ui16SSD2119YStart, g_ui16SSD2119YEnd);
+	}
+}
+
+/**
+ * @brief Decodes a 16 bit word received by the controller
+ *
+ * @param ui16Word The word
+ */
+void SSD2119_Word(uint16_t ui16Word) {
+	if (!g_bSSD2119Data) {
+		g_ui8SSD2119Register = ui16Word;
+		return;
+	}
+
+	switch (g_ui8SSD2119Register) {
+	case SSD2119_RAM_DATA_REG:
+		SSD2119_RamWrite(ui16Word);
+		break;
+	case SSD2119_ENTRY_MODE_REG:
+		g_ui16SSD2119Entry = ui16Word;
+		break;
+	case SSD2119_V_RAM_POS_REG:
+		g_ui16SSD2119YStart = ui16Word & 0xff;
+		g_ui16SSD2119YEnd = ui16Word >> 8;
+		break;
+	case SSD2119_H_RAM_START_REG:
+		g_ui16SSD2119XStart = ui16Word;
+		break;
+	case SSD2119_H_RAM_END_REG:
+		g_ui16SSD2119XEnd = ui16Word;
+		break;
+	case SSD2119_X_RAM_ADDR_REG:
+		g_ui16SSD2119X = ui16Word;
+		break;
+	case SSD2119_Y_RAM_ADDR_REG:
+		g_ui16SSD2119Y = ui16Word;
+		break;
+	default:
+		/* Power, gamma and timing setup do not change what is shown */
+		break;
+	}
+}
+#pragma endregion
+
+#pragma region Emulator API functions
+uint32_t SSD2119_PixelGet(int32_t i32X, int32_t i32Y) {
+	/* The driver is built for LANDSCAPE, where both axes are mirrored */
+	uint16_t ui16Color = g_pui16SSD2119Ram[SSD2119_HEIGHT - 1 - i32Y][SSD2119_WIDTH - 1 - i32X];
+
+	uint32_t ui32Red = (ui16Color >> 11) & 0x1f;
+	uint32_t ui32Green = (ui16Color >> 5) & 0x3f;
+	uint32_t ui32Blue = ui16Color & 0x1f;
+	return (((ui32Red << 3) | (ui32Red >> 2)) << 16) | (((ui32Green << 2) | (ui32Green >> 4)) << 8) |
+		   ((ui32Blue << 3) | (ui32Blue >> 2));
+}
+
+bool SSD2119_WritePPM(const char *pcPath) {
+	FILE *psFile = fopen(pcPath, "wb");
+	if (psFile == NULL)
+		return false;
+
+	fprintf(psFile, "P6\n%d %d\n255\n", SSD2119_WIDTH, SSD2119_HEIGHT);
+	for (int32_t y = 0; y < SSD2119_HEIGHT; y++) {
+		for (int32_t x = 0; x < SSD2119_WIDTH; x++) {
+			uint32_t ui32Color = SSD2119_PixelGet(x, y);
+			fputc(ui32Color >> 16, psFile);
+			fputc((ui32Color >> 8) & 0xff, psFile);
+			fputc(ui32Color & 0xff, psFile);
+		}
+	}
+
+	return fclose(psFile) == 0;
+}
+#pragma endregion
+
+#pragma region Driverlib functions
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val) {
+	Sim_Advance(SSD2119_GPIO_CYCLES);
+
+	if (ui32Port == SSD2119_DC_BASE && (ui8Pins & SSD2119_DC_PIN))
+		g_bSSD2119Data = ui8Val & SSD2119_DC_PIN;
+
+	/* Deselecting the controller drops a half received word */
+	if (ui32Port == SSD2119_CS_BASE && (ui8Pins & SSD2119_CS_PIN)) {
+		g_bSSD2119Select = !(ui8Val & SSD2119_CS_PIN);
+		g_bSSD2119HighByte = true;
+	}
+}
+
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol, uint32_t ui32Mode,
+						uint32_t ui32BitRate, uint32_t ui32DataWidth) {
+	if (ui32Base == SSD2119_SSI_BASE && ui32BitRate != 0)
+		g_ui32SSD2119ByteCycles = (uint64_t)SIM_CPU_FREQ * ui32DataWidth / ui32BitRate;
+}
+
+void SSIEnable(uint32_t ui32Base) {
+}
+
+void SSIDataPut(uint32_t ui32Base, uint32_t ui32Data) {
+	if (ui32Base != SSD2119_SSI_BASE)
+		return;
+
+	/* The bus is the bottleneck, the FIFO never lets the CPU run ahead by more than a few bytes */
+	g_sSSD2119Stats.ui64BusCycles += g_ui32SSD2119ByteCycles;
+	Sim_Advance(g_ui32SSD2119ByteCycles);
+	if (!g_bSSD2119Select)
+		return;
+
+	if (g_bSSD2119HighByte) {
+		g_ui16SSD2119Word = (ui32Data & 0xff) << 8;
+		g_bSSD2119HighByte = false;
+		return;
+	}
+
+	g_ui16SSD2119Word |= ui32Data & 0xff;
+	g_bSSD2119HighByte = true;
+	SSD2119_Word(g_ui16SSD2119Word);
+}
+
+int32_t SSIDataGetNonBlocking(uint32_t ui32Base, uint32_t *pui32Data) {
+	return 0;
+}
+
+bool SSIBusy(uint32_t ui32Base) {
+	return false;
+}
+
+void SysCtlDelay(uint32_t ui32Count) {
+}
+#pragma endregion
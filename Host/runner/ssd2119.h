@@ -0,0 +1,50 @@
+/**
+ * @file ssd2119.h
+ * @brief Host emulation of the SSD2119 display controller behind the SSI and GPIO driverlib calls
+ *
+ * The target display driver runs unchanged. Every byte it puts on the SSI bus spends the
+ * simulated time it takes at the configured bit rate, and the command stream is decoded
+ * into the controller RAM, so drawings cost and look the same as on the target.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Global defines */
+#define SSD2119_WIDTH 320
+#define SSD2119_HEIGHT 240
+
+/**
+ * @brief Bus statistics of the emulated controller
+ *
+ */
+typedef struct tSSD2119Stats {
+	/**
+	 * @brief The number of pixels written to the controller RAM
+	 */
+	uint32_t ui32Pixels;
+	/**
+	 * @brief The simulated time the SSI bus was busy (CPU cycles)
+	 */
+	uint64_t ui64BusCycles;
+} tSSD2119Stats;
+
+/* The statistics since the simulation started */
+extern tSSD2119Stats g_sSSD2119Stats;
+
+/**
+ * @brief Gets a pixel as seen on the screen
+ *
+ * @param i32X The x position in application coordinates
+ * @param i32Y The y position in application coordinates
+ * @return The color as a 24 bit RGB value
+ */
+uint32_t SSD2119_PixelGet(int32_t i32X, int32_t i32Y);
+
+/**
+ * @brief Writes the screen to a binary PPM image
+ *
+ * @param pcPath The file to write
+ * @return True if the file was written
+ */
+bool SSD2119_WritePPM(const char *pcPath);
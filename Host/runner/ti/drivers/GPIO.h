@@ -0,0 +1,48 @@
+/**
+ * @file GPIO.h
+ * @brief Host stand-in for the TI-RTOS GPIO driver, pin levels are only recorded
+ *
+ * Pin interrupts are raised by the emulated devices with Devices_RaisePin (see devices.h).
+ */
+#pragma once
+#include <stdint.h>
+
+typedef void (*GPIO_CallbackFxn)(unsigned int uiIndex);
+
+/**
+ * @brief Sets the level of a board pin
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ * @param uiValue The new level
+ */
+void GPIO_write(unsigned int uiIndex, unsigned int uiValue);
+
+/**
+ * @brief Gets the last level written to a board pin
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ * @return The level
+ */
+unsigned int GPIO_read(unsigned int uiIndex);
+
+/**
+ * @brief Sets the function called when the interrupt of a board pin is raised
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ * @param pfnCallback The function
+ */
+void GPIO_setCallback(unsigned int uiIndex, GPIO_CallbackFxn pfnCallback);
+
+/**
+ * @brief Enables the interrupt of a board pin
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ */
+void GPIO_enableInt(unsigned int uiIndex);
+
+/**
+ * @brief Disables the interrupt of a board pin
+ *
+ * @param uiIndex The index of the pin in the board pin table
+ */
+void GPIO_disableInt(unsigned int uiIndex);
@@ -0,0 +1,96 @@
+/**
+ * @file I2C.h
+ * @brief Host stand-in for the TI-RTOS I2C driver, transfers go to the devices attached to the emulated bus (see i2cbus.h)
+ *
+ * Only the callback mode is emulated, a transfer is queued and completes from interrupt context once
+ * the emulated bus has clocked it out.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct I2C_Config *I2C_Handle;
+
+/**
+ * @brief Transfer modes, only callback mode is emulated
+ *
+ */
+typedef enum I2C_TransferMode {
+	I2C_MODE_BLOCKING,
+	I2C_MODE_CALLBACK,
+} I2C_TransferMode;
+
+/**
+ * @brief Bus speeds
+ *
+ */
+typedef enum I2C_BitRate {
+	I2C_100kHz = 0,
+	I2C_400kHz = 1,
+} I2C_BitRate;
+
+/**
+ * @brief A transfer, a write then a read with a repeated start
+ *
+ */
+typedef struct I2C_Transaction {
+	void *writeBuf;
+	size_t writeCount;
+	void *readBuf;
+	size_t readCount;
+	unsigned char slaveAddress;
+	void *arg;
+	void *nextPtr;
+} I2C_Transaction;
+
+typedef void (*I2C_CallbackFxn)(I2C_Handle hHandle, I2C_Transaction *psTransaction, bool bSuccess);
+
+/**
+ * @brief Bus parameters
+ *
+ */
+typedef struct I2C_Params {
+	I2C_TransferMode transferMode;
+	I2C_CallbackFxn transferCallbackFxn;
+	I2C_BitRate bitRate;
+	uintptr_t custom;
+} I2C_Params;
+
+/**
+ * @brief Initializes the driver
+ *
+ */
+void I2C_init();
+
+/**
+ * @brief Initializes bus parameters to blocking mode at 100 kHz
+ *
+ * @param psParams The parameters to initialize
+ */
+void I2C_Params_init(I2C_Params *psParams);
+
+/**
+ * @brief Opens a bus
+ *
+ * @param uiIndex The index of the bus in the board table
+ * @param psParams The parameters, or NULL for the defaults
+ * @return The bus, or NULL if it is open already or the mode is not emulated
+ */
+I2C_Handle I2C_open(unsigned int uiIndex, I2C_Params *psParams);
+
+/**
+ * @brief Closes a bus
+ *
+ * @param hHandle The bus
+ */
+void I2C_close(I2C_Handle hHandle);
+
+/**
+ * @brief Queues a transfer
+ *
+ * @param hHandle The bus
+ * @param psTransaction The transfer, it must stay valid until its callback
+ * @return True if the transfer was queued
+ */
+bool I2C_transfer(I2C_Handle hHandle, I2C_Transaction *psTransaction);
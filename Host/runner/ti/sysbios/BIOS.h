@@ -0,0 +1,24 @@
+/**
+ * @file BIOS.h
+ * @brief Host stand-in for the SYS/BIOS kernel entry points
+ */
+#pragma once
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+
+#define BIOS_WAIT_FOREVER (~(UInt32)0)
+#define BIOS_NO_WAIT ((UInt32)0)
+
+/**
+ * @brief Runs the simulation, returns once it is stopped
+ *
+ * @note Unlike the target this function returns, see Sim_Stop
+ */
+void BIOS_start();
+
+/**
+ * @brief Gets the frequency of the simulated CPU
+ *
+ * @param psFreq The frequency to fill in
+ */
+void BIOS_getCpuFreq(Types_FreqHz *psFreq);
@@ -0,0 +1,50 @@
+/**
+ * @file GateMutexPri.h
+ * @brief Host stand-in for the SYS/BIOS priority inheriting mutex gate
+ */
+#pragma once
+#include <xdc/std.h>
+
+/**
+ * @brief A gate object
+ *
+ */
+typedef struct GateMutexPri_Struct {
+	struct tSimTask *psOwner;
+} GateMutexPri_Struct;
+typedef GateMutexPri_Struct *GateMutexPri_Handle;
+typedef struct GateMutexPri_Params {
+	int iUnused;
+} GateMutexPri_Params;
+
+/**
+ * @brief Constructs a gate
+ *
+ * @param psGate The gate to construct
+ * @param psParams Unused
+ */
+void GateMutexPri_construct(GateMutexPri_Struct *psGate, const GateMutexPri_Params *psParams);
+
+/**
+ * @brief Gets the handle of a constructed gate
+ *
+ * @param psGate The gate
+ * @return The handle
+ */
+GateMutexPri_Handle GateMutexPri_handle(GateMutexPri_Struct *psGate);
+
+/**
+ * @brief Enters the gate, blocking while another task holds it
+ *
+ * @param hGate The gate
+ * @return The key to leave with
+ */
+IArg GateMutexPri_enter(GateMutexPri_Handle hGate);
+
+/**
+ * @brief Leaves the gate, handing it to the highest priority task waiting for it
+ *
+ * @param hGate The gate
+ * @param iKey The key returned by GateMutexPri_enter
+ */
+void GateMutexPri_leave(GateMutexPri_Handle hGate, IArg iKey);
@@ -0,0 +1,60 @@
+/**
+ * @file Hwi.h
+ * @brief Host stand-in for the SYS/BIOS hardware interrupt module, interrupts are raised by the simulated peripherals
+ */
+#pragma once
+#include <xdc/std.h>
+
+typedef void (*Hwi_FuncPtr)(UArg arg);
+
+/**
+ * @brief A hardware interrupt object
+ *
+ */
+typedef struct Hwi_Struct {
+	Int iIntNum;
+	Hwi_FuncPtr pfnFxn;
+	UArg arg;
+} Hwi_Struct;
+typedef Hwi_Struct *Hwi_Handle;
+
+/**
+ * @brief Hardware interrupt creation parameters, the priority is ignored
+ *
+ */
+typedef struct Hwi_Params {
+	UArg arg;
+	Int priority;
+} Hwi_Params;
+
+/**
+ * @brief Initializes hardware interrupt parameters
+ *
+ * @param psParams The parameters to initialize
+ */
+void Hwi_Params_init(Hwi_Params *psParams);
+
+/**
+ * @brief Constructs a hardware interrupt and plugs its function into the vector
+ *
+ * @param psStruct The interrupt object
+ * @param iIntNum The interrupt number
+ * @param pfnFxn The function to call
+ * @param psParams The parameters, or NULL for the defaults
+ * @param pvEb Unused error block
+ */
+void Hwi_construct(Hwi_Struct *psStruct, Int iIntNum, Hwi_FuncPtr pfnFxn, const Hwi_Params *psParams, void *pvEb);
+
+/**
+ * @brief Disables interrupts, a no-op since interrupts only fire while time passes
+ *
+ * @return The key to restore
+ */
+UInt Hwi_disable();
+
+/**
+ * @brief Restores interrupts
+ *
+ * @param uiKey The key returned by Hwi_disable
+ */
+void Hwi_restore(UInt uiKey);
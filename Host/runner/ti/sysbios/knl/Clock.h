@@ -0,0 +1,44 @@
+/**
+ * @file Clock.h
+ * @brief Host stand-in for the SYS/BIOS clock module, one tick is one simulated millisecond
+ */
+#pragma once
+#include <xdc/std.h>
+
+typedef void (*Clock_FuncPtr)(UArg arg);
+typedef struct Clock_Object *Clock_Handle;
+
+/**
+ * @brief Clock creation parameters
+ *
+ */
+typedef struct Clock_Params {
+	UInt32 period;
+	Bool startFlag;
+	UArg arg;
+} Clock_Params;
+
+/**
+ * @brief Initializes clock parameters to a stopped one-shot clock
+ *
+ * @param psParams The parameters to initialize
+ */
+void Clock_Params_init(Clock_Params *psParams);
+
+/**
+ * @brief Creates a clock that calls a function from interrupt context
+ *
+ * @param pfnFxn The function to call
+ * @param ui32Timeout The ticks until the first call
+ * @param psParams The parameters, or NULL for the defaults
+ * @param pvEb Unused error block
+ * @return The clock
+ */
+Clock_Handle Clock_create(Clock_FuncPtr pfnFxn, UInt32 ui32Timeout, const Clock_Params *psParams, void *pvEb);
+
+/**
+ * @brief Gets the number of ticks since the simulation started
+ *
+ * @return The tick count
+ */
+UInt32 Clock_getTicks();
@@ -0,0 +1,64 @@
+/**
+ * @file Event.h
+ * @brief Host stand-in for the SYS/BIOS event module, only OR masks are supported
+ */
+#pragma once
+#include <xdc/std.h>
+
+#define Event_Id_NONE 0
+#define Event_Id_00 (1 << 0)
+#define Event_Id_01 (1 << 1)
+#define Event_Id_02 (1 << 2)
+#define Event_Id_03 (1 << 3)
+#define Event_Id_04 (1 << 4)
+#define Event_Id_05 (1 << 5)
+#define Event_Id_06 (1 << 6)
+#define Event_Id_07 (1 << 7)
+
+/**
+ * @brief An event object, at most one task may pend on it
+ *
+ */
+typedef struct Event_Struct {
+	UInt uiPosted;
+	struct tSimTask *psPending;
+} Event_Struct;
+typedef Event_Struct *Event_Handle;
+typedef struct Event_Params {
+	int iUnused;
+} Event_Params;
+
+/**
+ * @brief Constructs an event object
+ *
+ * @param psEvent The event to construct
+ * @param psParams Unused
+ */
+void Event_construct(Event_Struct *psEvent, const Event_Params *psParams);
+
+/**
+ * @brief Gets the handle of a constructed event
+ *
+ * @param psEvent The event
+ * @return The handle
+ */
+Event_Handle Event_handle(Event_Struct *psEvent);
+
+/**
+ * @brief Posts events, readying the task pending on any of them
+ *
+ * @param hEvent The event object
+ * @param uiIds The events to post
+ */
+void Event_post(Event_Handle hEvent, UInt uiIds);
+
+/**
+ * @brief Waits for any of a set of events
+ *
+ * @param hEvent The event object
+ * @param uiAndMask Must be Event_Id_NONE
+ * @param uiOrMask The events to wait for
+ * @param ui32Timeout The ticks to wait, BIOS_NO_WAIT or BIOS_WAIT_FOREVER
+ * @return The events consumed, or 0 on a timeout
+ */
+UInt Event_pend(Event_Handle hEvent, UInt uiAndMask, UInt uiOrMask, UInt32 ui32Timeout);
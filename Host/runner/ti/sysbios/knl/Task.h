@@ -0,0 +1,61 @@
+/**
+ * @file Task.h
+ * @brief Host stand-in for the SYS/BIOS task module, tasks run as coroutines on a simulated CPU
+ */
+#pragma once
+#include <xdc/std.h>
+
+typedef void (*Task_FuncPtr)(UArg arg0, UArg arg1);
+
+/**
+ * @brief A task object
+ *
+ */
+typedef struct Task_Struct {
+	struct tSimTask *psTask;
+} Task_Struct;
+typedef Task_Struct *Task_Handle;
+
+/**
+ * @brief Task creation parameters, the stack is ignored and allocated on the host
+ *
+ */
+typedef struct Task_Params {
+	size_t stackSize;
+	void *stack;
+	Int priority;
+	UArg arg0;
+	UArg arg1;
+	String instance;
+} Task_Params;
+
+/**
+ * @brief Initializes task parameters to priority 1
+ *
+ * @param psParams The parameters to initialize
+ */
+void Task_Params_init(Task_Params *psParams);
+
+/**
+ * @brief Constructs a task, it first runs once BIOS_start is called
+ *
+ * @param psTask The task to construct
+ * @param pfnFxn The task function
+ * @param psParams The parameters, or NULL for the defaults
+ * @param pvEb Unused error block
+ */
+void Task_construct(Task_Struct *psTask, Task_FuncPtr pfnFxn, const Task_Params *psParams, void *pvEb);
+
+/**
+ * @brief Gets the handle of a constructed task
+ *
+ * @param psTask The task
+ * @return The handle
+ */
+Task_Handle Task_handle(Task_Struct *psTask);
+
+/**
+ * @brief Lets other ready tasks of the same priority run
+ *
+ */
+void Task_yield();
@@ -0,0 +1,42 @@
+/**
+ * @file Load.h
+ * @brief Host stand-in for the SYS/BIOS load module, measures the simulated time each task spends
+ *
+ * Loads are measured over windows of SIM_LOAD_WINDOW, like Load.windowInMs in main.cfg.
+ */
+#pragma once
+#include <xdc/std.h>
+#include <ti/sysbios/knl/Task.h>
+
+/**
+ * @brief The time a thread ran during the last window
+ *
+ */
+typedef struct Load_Stat {
+	UInt32 threadTime;
+	UInt32 totalTime;
+} Load_Stat;
+
+/**
+ * @brief Gets the time a task ran during the last window
+ *
+ * @param hTask The task
+ * @param psStat The times to fill in (CPU cycles)
+ * @return False if a full window has not passed yet
+ */
+Bool Load_getTaskLoad(Task_Handle hTask, Load_Stat *psStat);
+
+/**
+ * @brief Converts the times of a thread to a load
+ *
+ * @param psStat The times
+ * @return The load (%)
+ */
+UInt32 Load_calculateLoad(Load_Stat *psStat);
+
+/**
+ * @brief Gets the load of all tasks during the last window
+ *
+ * @return The load (%)
+ */
+UInt32 Load_getCPULoad();
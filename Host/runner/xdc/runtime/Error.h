@@ -0,0 +1,14 @@
+/**
+ * @file Error.h
+ * @brief Host stand-in for the XDCtools error module, the project passes NULL error blocks
+ */
+#pragma once
+#include <xdc/std.h>
+
+/**
+ * @brief An error block
+ *
+ */
+typedef struct Error_Block {
+	Int iId;
+} Error_Block;
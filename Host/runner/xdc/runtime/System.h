@@ -0,0 +1,12 @@
+/**
+ * @file System.h
+ * @brief Host stand-in for the XDCtools system module
+ */
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <xdc/std.h>
+
+#define System_printf printf
+#define System_flush() fflush(stdout)
+#define System_abort(msg) (fprintf(stderr, "%s\n", (msg)), abort())
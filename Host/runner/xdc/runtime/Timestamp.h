@@ -0,0 +1,21 @@
+/**
+ * @file Timestamp.h
+ * @brief Host stand-in for the XDCtools timestamp, counts simulated CPU cycles
+ */
+#pragma once
+#include <xdc/std.h>
+#include <xdc/runtime/Types.h>
+
+/**
+ * @brief Gets the lower 32 bits of the simulated cycle counter
+ *
+ * @return The cycle count
+ */
+UInt32 Timestamp_get32();
+
+/**
+ * @brief Gets the frequency of the timestamp
+ *
+ * @param psFreq The frequency to fill in
+ */
+void Timestamp_getFreq(Types_FreqHz *psFreq);
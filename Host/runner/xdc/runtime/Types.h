@@ -0,0 +1,15 @@
+/**
+ * @file Types.h
+ * @brief Host stand-in for the XDCtools runtime types
+ */
+#pragma once
+#include <xdc/std.h>
+
+/**
+ * @brief A 64 bit frequency in Hz
+ *
+ */
+typedef struct Types_FreqHz {
+	UInt32 hi;
+	UInt32 lo;
+} Types_FreqHz;
@@ -0,0 +1,24 @@
+/**
+ * @file std.h
+ * @brief Host stand-in for the XDCtools base types
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef char Char;
+typedef int Int;
+typedef unsigned int UInt;
+typedef int32_t Int32;
+typedef uint32_t UInt32;
+typedef uint64_t UInt64;
+typedef bool Bool;
+typedef void *Ptr;
+typedef intptr_t IArg;
+typedef uintptr_t UArg;
+typedef const char *String;
+typedef void Void;
+
+#define TRUE true
+#define FALSE false
@@ -0,0 +1,35 @@
+/**
+ * @file adc.h
+ * @brief Host stand-in for the subset of the TivaWare ADC API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Triggers */
+#define ADC_TRIGGER_PROCESSOR 0x00000000
+#define ADC_TRIGGER_TIMER 0x00000005
+#define ADC_TRIGGER_PWM0 0x00000006
+#define ADC_TRIGGER_PWM1 0x00000007
+#define ADC_TRIGGER_PWM2 0x00000008
+#define ADC_TRIGGER_PWM_MOD0 0x00000000
+
+/* Step configuration */
+#define ADC_CTL_CH0 0x00000000
+#define ADC_CTL_CH1 0x00000001
+#define ADC_CTL_CH2 0x00000002
+#define ADC_CTL_CH3 0x00000003
+#define ADC_CTL_END 0x00000020
+#define ADC_CTL_IE 0x00000040
+
+/* Interrupt sources */
+#define ADC_INT_DMA_SS0 0x00000100
+
+void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Trigger, uint32_t ui32Priority);
+void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t ui32Step, uint32_t ui32Config);
+void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCSequenceDMAEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCIntEnableEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+void ADCIntClearEx(uint32_t ui32Base, uint32_t ui32IntFlags);
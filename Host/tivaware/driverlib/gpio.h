@@ -0,0 +1,26 @@
+/**
+ * @file gpio.h
+ * @brief Host stand-in for the subset of the TivaWare GPIO API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Pins */
+#define GPIO_PIN_0 0x00000001
+#define GPIO_PIN_1 0x00000002
+#define GPIO_PIN_2 0x00000004
+#define GPIO_PIN_3 0x00000008
+#define GPIO_PIN_4 0x00000010
+#define GPIO_PIN_5 0x00000020
+#define GPIO_PIN_6 0x00000040
+#define GPIO_PIN_7 0x00000080
+
+int32_t GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val);
+void GPIOPinConfigure(uint32_t ui32PinConfig);
+void GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins);
+void GPIOPinTypeTimer(uint32_t ui32Port, uint8_t ui8Pins);
@@ -0,0 +1,14 @@
+/**
+ * @file interrupt.h
+ * @brief Host stand-in for the subset of the TivaWare interrupt controller API used by the project
+ *
+ * The host builds raise interrupts through the simulator (see sim.h), none of these are called.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+bool IntMasterEnable(void);
+bool IntMasterDisable(void);
+void IntEnable(uint32_t ui32Interrupt);
+void IntDisable(uint32_t ui32Interrupt);
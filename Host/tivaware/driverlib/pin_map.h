@@ -0,0 +1,21 @@
+/**
+ * @file pin_map.h
+ * @brief Host stand-in for the subset of the TM4C1294NCPDT pin functions used by the project
+ *
+ * Each value packs the port, the pin and the alternate function, as GPIOPinConfigure takes them.
+ */
+#pragma once
+
+#define GPIO_PD4_T3CCP0 0x00031003
+#define GPIO_PD5_T3CCP1 0x00031403
+#define GPIO_PD6_T4CCP0 0x00031803
+#define GPIO_PF0_M0PWM0 0x00050006
+#define GPIO_PF1_M0PWM1 0x00050406
+#define GPIO_PF2_M0PWM2 0x00050806
+#define GPIO_PF3_M0PWM3 0x00050C06
+#define GPIO_PG0_M0PWM4 0x00060006
+#define GPIO_PG1_M0PWM5 0x00060406
+#define GPIO_PK4_M0PWM6 0x00091006
+#define GPIO_PK5_M0PWM7 0x00091406
+#define GPIO_PQ0_SSI3CLK 0x000E000E
+#define GPIO_PQ2_SSI3XDAT0 0x000E080E
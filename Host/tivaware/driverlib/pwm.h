@@ -0,0 +1,58 @@
+/**
+ * @file pwm.h
+ * @brief Host stand-in for the subset of the TivaWare PWM API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Generators, as offsets from the module base */
+#define PWM_GEN_0 0x00000040
+#define PWM_GEN_1 0x00000080
+#define PWM_GEN_2 0x000000C0
+#define PWM_GEN_3 0x00000100
+#define PWM_GEN_0_BIT 0x00000001
+#define PWM_GEN_1_BIT 0x00000002
+#define PWM_GEN_2_BIT 0x00000004
+#define PWM_GEN_3_BIT 0x00000008
+
+/* Outputs, the generator offset with the output number */
+#define PWM_OUT_0 0x00000040
+#define PWM_OUT_1 0x00000041
+#define PWM_OUT_2 0x00000082
+#define PWM_OUT_3 0x00000083
+#define PWM_OUT_4 0x000000C4
+#define PWM_OUT_5 0x000000C5
+#define PWM_OUT_6 0x00000106
+#define PWM_OUT_7 0x00000107
+#define PWM_OUT_0_BIT 0x00000001
+#define PWM_OUT_1_BIT 0x00000002
+#define PWM_OUT_2_BIT 0x00000004
+#define PWM_OUT_3_BIT 0x00000008
+#define PWM_OUT_4_BIT 0x00000010
+#define PWM_OUT_5_BIT 0x00000020
+#define PWM_OUT_6_BIT 0x00000040
+#define PWM_OUT_7_BIT 0x00000080
+
+/* Generator modes */
+#define PWM_GEN_MODE_DOWN 0x00000000
+#define PWM_GEN_MODE_UP_DOWN 0x00000002
+#define PWM_GEN_MODE_NO_SYNC 0x00000000
+#define PWM_GEN_MODE_DBG_STOP 0x00000000
+
+/* Clock dividers */
+#define PWM_SYSCLK_DIV_1 0x00000000
+
+/* Triggers */
+#define PWM_TR_CNT_ZERO 0x00000100
+#define PWM_TR_CNT_LOAD 0x00000200
+
+void PWMClockSet(uint32_t ui32Base, uint32_t ui32Config);
+void PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config);
+void PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period);
+uint32_t PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen);
+void PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen);
+void PWMGenIntTrigEnable(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32IntTrig);
+void PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width);
+void PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable);
+void PWMSyncTimeBase(uint32_t ui32Base, uint32_t ui32GenBits);
@@ -0,0 +1,5 @@
+/**
+ * @file rom.h
+ * @brief Host stand-in for the TivaWare ROM API, the project calls the driverlib functions directly
+ */
+#pragma once
@@ -0,0 +1,5 @@
+/**
+ * @file rom_map.h
+ * @brief Host stand-in for the TivaWare ROM mapping, the project calls the driverlib functions directly
+ */
+#pragma once
@@ -0,0 +1,20 @@
+/**
+ * @file ssi.h
+ * @brief Host stand-in for the subset of the TivaWare SSI API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Frame formats */
+#define SSI_FRF_MOTO_MODE_0 0x00000000
+
+/* Modes */
+#define SSI_MODE_MASTER 0x00000000
+
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol, uint32_t ui32Mode,
+						uint32_t ui32BitRate, uint32_t ui32DataWidth);
+void SSIEnable(uint32_t ui32Base);
+void SSIDataPut(uint32_t ui32Base, uint32_t ui32Data);
+int32_t SSIDataGetNonBlocking(uint32_t ui32Base, uint32_t *pui32Data);
+bool SSIBusy(uint32_t ui32Base);
@@ -0,0 +1,44 @@
+/**
+ * @file sysctl.h
+ * @brief Host stand-in for the subset of the TivaWare system control API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Peripherals */
+#define SYSCTL_PERIPH_TIMER0 0xF0000400
+#define SYSCTL_PERIPH_TIMER1 0xF0000401
+#define SYSCTL_PERIPH_TIMER2 0xF0000402
+#define SYSCTL_PERIPH_TIMER3 0xF0000403
+#define SYSCTL_PERIPH_TIMER4 0xF0000404
+#define SYSCTL_PERIPH_TIMER5 0xF0000405
+#define SYSCTL_PERIPH_TIMER6 0xF0000406
+#define SYSCTL_PERIPH_TIMER7 0xF0000407
+#define SYSCTL_PERIPH_GPIOA 0xF0000800
+#define SYSCTL_PERIPH_GPIOB 0xF0000801
+#define SYSCTL_PERIPH_GPIOC 0xF0000802
+#define SYSCTL_PERIPH_GPIOD 0xF0000803
+#define SYSCTL_PERIPH_GPIOE 0xF0000804
+#define SYSCTL_PERIPH_GPIOF 0xF0000805
+#define SYSCTL_PERIPH_GPIOG 0xF0000806
+#define SYSCTL_PERIPH_GPIOH 0xF0000807
+#define SYSCTL_PERIPH_GPIOJ 0xF0000808
+#define SYSCTL_PERIPH_GPIOK 0xF0000809
+#define SYSCTL_PERIPH_GPIOL 0xF000080A
+#define SYSCTL_PERIPH_GPIOM 0xF000080B
+#define SYSCTL_PERIPH_GPION 0xF000080C
+#define SYSCTL_PERIPH_GPIOP 0xF000080D
+#define SYSCTL_PERIPH_GPIOQ 0xF000080E
+#define SYSCTL_PERIPH_UDMA 0xF0000C00
+#define SYSCTL_PERIPH_SSI0 0xF0001C00
+#define SYSCTL_PERIPH_SSI1 0xF0001C01
+#define SYSCTL_PERIPH_SSI2 0xF0001C02
+#define SYSCTL_PERIPH_SSI3 0xF0001C03
+#define SYSCTL_PERIPH_ADC0 0xF0003800
+#define SYSCTL_PERIPH_ADC1 0xF0003801
+#define SYSCTL_PERIPH_PWM0 0xF0004000
+
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral);
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral);
+void SysCtlDelay(uint32_t ui32Count);
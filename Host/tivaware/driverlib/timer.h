@@ -0,0 +1,60 @@
+/**
+ * @file timer.h
+ * @brief Host stand-in for the subset of the TivaWare timer API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Timer halves */
+#define TIMER_A 0x000000FF
+#define TIMER_B 0x0000FF00
+#define TIMER_BOTH 0x0000FFFF
+
+/* Configurations */
+#define TIMER_CFG_PERIODIC 0x00000022
+#define TIMER_CFG_SPLIT_PAIR 0x04000000
+#define TIMER_CFG_A_CAP_TIME_UP 0x00000017
+#define TIMER_CFG_B_CAP_TIME_UP 0x00001700
+
+/* Interrupt flags */
+#define TIMER_TIMA_TIMEOUT 0x00000001
+#define TIMER_CAPA_EVENT 0x00000004
+#define TIMER_TIMB_TIMEOUT 0x00000100
+#define TIMER_CAPB_EVENT 0x00000400
+
+/* Capture events */
+#define TIMER_EVENT_POS_EDGE 0x00000000
+#define TIMER_EVENT_NEG_EDGE 0x00000404
+#define TIMER_EVENT_BOTH_EDGES 0x00000C0C
+
+/* Clock sources */
+#define TIMER_CLOCK_SYSTEM 0x00000000
+#define TIMER_CLOCK_PIOSC 0x00000001
+
+/* Halves started together by TimerSynchronize */
+#define TIMER_0A_SYNC 0x00000001
+#define TIMER_0B_SYNC 0x00000002
+#define TIMER_1A_SYNC 0x00000004
+#define TIMER_1B_SYNC 0x00000008
+#define TIMER_2A_SYNC 0x00000010
+#define TIMER_2B_SYNC 0x00000020
+#define TIMER_3A_SYNC 0x00000040
+#define TIMER_3B_SYNC 0x00000080
+#define TIMER_4A_SYNC 0x00000100
+#define TIMER_4B_SYNC 0x00000200
+#define TIMER_5A_SYNC 0x00000400
+#define TIMER_5B_SYNC 0x00000800
+
+void TimerClockSourceSet(uint32_t ui32Base, uint32_t ui32Source);
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config);
+void TimerControlEvent(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Event);
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer);
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+void TimerPrescaleSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+uint32_t TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer);
+void TimerSynchronize(uint32_t ui32Base, uint32_t ui32Timers);
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked);
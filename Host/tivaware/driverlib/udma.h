@@ -0,0 +1,43 @@
+/**
+ * @file udma.h
+ * @brief Host stand-in for the subset of the TivaWare uDMA API used by the project
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Channel assignments */
+#define UDMA_CH14_ADC0_0 0x0000000E
+#define UDMA_CH15_ADC0_1 0x0000000F
+#define UDMA_CH16_ADC0_2 0x00000010
+#define UDMA_CH17_ADC0_3 0x00000011
+
+/* Control structures */
+#define UDMA_PRI_SELECT 0x00000000
+#define UDMA_ALT_SELECT 0x00000020
+
+/* Transfer modes */
+#define UDMA_MODE_STOP 0x00000000
+#define UDMA_MODE_BASIC 0x00000001
+#define UDMA_MODE_PINGPONG 0x00000003
+
+/* Channel attributes */
+#define UDMA_ATTR_USEBURST 0x00000001
+#define UDMA_ATTR_ALTSELECT 0x00000002
+#define UDMA_ATTR_HIGH_PRIORITY 0x00000004
+#define UDMA_ATTR_REQMASK 0x00000008
+
+/* Transfer control */
+#define UDMA_SIZE_16 0x11000000
+#define UDMA_SRC_INC_NONE 0x0C000000
+#define UDMA_DST_INC_16 0x40000000
+#define UDMA_ARB_1 0x00000000
+
+void uDMAChannelAssign(uint32_t ui32Mapping);
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr);
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control);
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode, void *pvSrcAddr, void *pvDstAddr,
+							uint32_t ui32TransferSize);
+void uDMAChannelEnable(uint32_t ui32ChannelNum);
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum);
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex);
@@ -0,0 +1,14 @@
+/**
+ * @file Kentec320x240x16_ssd2119_spi.h
+ * @brief Host stand-in for the interface of the Kentec display driver of the EK-TM4C1294XL board examples
+ *
+ * The driver itself is built from the project sources, talking to the emulated controller (see ssd2119.h).
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+extern const tDisplay g_sKentec320x240x16_SSD2119;
+
+void Kentec320x240x16_SSD2119Init(uint32_t ui32SysClock);
@@ -0,0 +1,13 @@
+/**
+ * @file touch.h
+ * @brief Host stand-in for the touch screen driver interface of the EK-TM4C1294XL board examples
+ *
+ * The host builds replace the driver itself with a simulated touch screen (see devices.h).
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+void TouchScreenInit(uint32_t ui32SysClock);
+void TouchScreenIntHandler(void);
+void TouchScreenCallbackSet(int32_t (*pfnCallback)(uint32_t ui32Message, int32_t i32X, int32_t i32Y));
@@ -0,0 +1,80 @@
+/**
+ * @file canvas.c
+ * @brief Host stand-in for the canvas widget of the TivaWare graphics library
+ */
+#pragma region Includes
+#include "grlib/canvas.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Paints a canvas: the fill, the outline, the text, then what the application draws
+ *
+ * @param psWidget The canvas
+ */
+void Canvas_Paint(tWidget *psWidget) {
+	tCanvasWidget *psCanvas = (tCanvasWidget *)psWidget;
+	const tRectangle *psPosition = &psWidget->sPosition;
+	tContext sContext;
+	GrContextInit(&sContext, psWidget->psDisplay);
+	GrContextClipRegionSet(&sContext, &psWidget->sPosition);
+
+	if (psCanvas->ui32Style & CANVAS_STYLE_FILL) {
+		GrContextForegroundSet(&sContext, psCanvas->ui32FillColor);
+		GrRectFill(&sContext, psPosition);
+	}
+
+	if (psCanvas->ui32Style & CANVAS_STYLE_OUTLINE) {
+		GrContextForegroundSet(&sContext, psCanvas->ui32OutlineColor);
+		GrRectDraw(&sContext, psPosition);
+	}
+
+	if ((psCanvas->ui32Style & CANVAS_STYLE_TEXT) && psCanvas->pcText != NULL && psCanvas->psFont != NULL) {
+		GrContextFontSet(&sContext, psCanvas->psFont);
+		GrContextForegroundSet(&sContext, psCanvas->ui32TextColor);
+		GrContextBackgroundSet(&sContext, psCanvas->ui32FillColor);
+
+		/* Centered unless aligned to a side */
+		int32_t i32X = psPosition->i16XMin + (psPosition->i16XMax - psPosition->i16XMin + 1) / 2;
+		if (psCanvas->ui32Style & CANVAS_STYLE_TEXT_LEFT)
+			i32X = psPosition->i16XMin + GrStringWidthGet(&sContext, psCanvas->pcText, -1) / 2;
+		else if (psCanvas->ui32Style & CANVAS_STYLE_TEXT_RIGHT)
+			i32X = psPosition->i16XMax - GrStringWidthGet(&sContext, psCanvas->pcText, -1) / 2;
+
+		int32_t i32Y = psPosition->i16YMin + (psPosition->i16YMax - psPosition->i16YMin + 1) / 2;
+		if (psCanvas->ui32Style & CANVAS_STYLE_TEXT_TOP)
+			i32Y = psPosition->i16YMin + GrFontHeightGet(psCanvas->psFont) / 2;
+		else if (psCanvas->ui32Style & CANVAS_STYLE_TEXT_BOTTOM)
+			i32Y = psPosition->i16YMax - GrFontHeightGet(psCanvas->psFont) / 2;
+
+		GrStringDrawCentered(&sContext, psCanvas->pcText, -1, i32X, i32Y, psCanvas->ui32Style & CANVAS_STYLE_TEXT_OPAQUE);
+	}
+
+	if ((psCanvas->ui32Style & CANVAS_STYLE_APP_DRAWN) && psCanvas->pfnOnPaint != NULL)
+		psCanvas->pfnOnPaint(psWidget, &sContext);
+}
+#pragma endregion
+
+#pragma region Canvas functions
+int32_t CanvasMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2) {
+	if (ui32Message != WIDGET_MSG_PAINT)
+		return WidgetDefaultMsgProc(psWidget, ui32Message, ui32Param1, ui32Param2);
+
+	Canvas_Paint(psWidget);
+	return 1;
+}
+
+void CanvasInit(tCanvasWidget *psCanvas, const tDisplay *psDisplay, int32_t i32X, int32_t i32Y, int32_t i32Width,
+				int32_t i32Height) {
+	memset(psCanvas, 0, sizeof(tCanvasWidget));
+	psCanvas->sBase.i32Size = sizeof(tCanvasWidget);
+	psCanvas->sBase.psDisplay = psDisplay;
+	psCanvas->sBase.sPosition = (tRectangle){i32X, i32Y, i32X + i32Width - 1, i32Y + i32Height - 1};
+	psCanvas->sBase.pfnMsgProc = CanvasMsgProc;
+}
+#pragma endregion
@@ -0,0 +1,64 @@
+/**
+ * @file canvas.h
+ * @brief Host stand-in for the canvas widget of the TivaWare graphics library
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+
+/* Styles */
+#define CANVAS_STYLE_OUTLINE 0x00000001
+#define CANVAS_STYLE_FILL 0x00000002
+#define CANVAS_STYLE_TEXT 0x00000004
+#define CANVAS_STYLE_IMG 0x00000008
+#define CANVAS_STYLE_APP_DRAWN 0x00000010
+#define CANVAS_STYLE_TEXT_OPAQUE 0x00000020
+#define CANVAS_STYLE_TEXT_LEFT 0x00000040
+#define CANVAS_STYLE_TEXT_RIGHT 0x00000080
+#define CANVAS_STYLE_TEXT_TOP 0x00000100
+#define CANVAS_STYLE_TEXT_BOTTOM 0x00000200
+#define CANVAS_STYLE_TEXT_HCENTER 0x00000000
+#define CANVAS_STYLE_TEXT_VCENTER 0x00000000
+
+/**
+ * @brief A canvas, a rectangle that is filled, outlined, labelled or drawn by the application
+ *
+ */
+typedef struct tCanvasWidget {
+	tWidget sBase;
+	uint32_t ui32Style;
+	uint32_t ui32FillColor;
+	uint32_t ui32OutlineColor;
+	uint32_t ui32TextColor;
+	const tFont *psFont;
+	const char *pcText;
+	const uint8_t *pui8Image;
+	void (*pfnOnPaint)(tWidget *psWidget, tContext *psContext);
+} tCanvasWidget;
+
+/* Declares and initializes a canvas */
+#define Canvas(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style, ui32FillColor, \
+			   ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pfnOnPaint)                               \
+	tCanvasWidget sName = {{sizeof(tCanvasWidget), (tWidget *)(psParent), (tWidget *)(psNext), (tWidget *)(psChild),    \
+							(psDisplay), {(i32X), (i32Y), (i32X) + (i32Width) - 1, (i32Y) + (i32Height) - 1},           \
+							CanvasMsgProc},                                                                             \
+						   (uint32_t)(uintptr_t)(ui32Style), (uint32_t)(uintptr_t)(ui32FillColor), (uint32_t)(uintptr_t)(ui32OutlineColor), \
+						   (uint32_t)(uintptr_t)(ui32TextColor), (psFont), (pcText), (pui8Image), (pfnOnPaint)}
+
+/* Canvas access */
+#define CanvasFillColorSet(psCanvas, ui32Color) ((psCanvas)->ui32FillColor = (ui32Color))
+#define CanvasFillOn(psCanvas) ((psCanvas)->ui32Style |= CANVAS_STYLE_FILL)
+#define CanvasFillOff(psCanvas) ((psCanvas)->ui32Style &= ~CANVAS_STYLE_FILL)
+#define CanvasOutlineColorSet(psCanvas, ui32Color) ((psCanvas)->ui32OutlineColor = (ui32Color))
+#define CanvasOutlineOn(psCanvas) ((psCanvas)->ui32Style |= CANVAS_STYLE_OUTLINE)
+#define CanvasOutlineOff(psCanvas) ((psCanvas)->ui32Style &= ~CANVAS_STYLE_OUTLINE)
+#define CanvasTextColorSet(psCanvas, ui32Color) ((psCanvas)->ui32TextColor = (ui32Color))
+#define CanvasTextSet(psCanvas, pcNewText) ((psCanvas)->pcText = (pcNewText))
+#define CanvasTextOn(psCanvas) ((psCanvas)->ui32Style |= CANVAS_STYLE_TEXT)
+#define CanvasTextOff(psCanvas) ((psCanvas)->ui32Style &= ~CANVAS_STYLE_TEXT)
+
+int32_t CanvasMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2);
+void CanvasInit(tCanvasWidget *psCanvas, const tDisplay *psDisplay, int32_t i32X, int32_t i32Y, int32_t i32Width,
+				int32_t i32Height);
@@ -0,0 +1,103 @@
+/**
+ * @file checkbox.c
+ * @brief Host stand-in for the check box widget of the TivaWare graphics library
+ */
+#pragma region Includes
+#include "grlib/checkbox.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define CHECKBOX_BOX_MARGIN 2  // Left of the box
+#define CHECKBOX_TEXT_MARGIN 4 // Between the box and the text
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Paints a check box: the fill, the outline, the box with its cross when selected, then the text
+ *
+ * @param psWidget The check box
+ * @param bBoxOnly True to only paint the box, when the selection changes
+ */
+void CheckBox_Paint(tWidget *psWidget, bool bBoxOnly) {
+	tCheckBoxWidget *psCheckBox = (tCheckBoxWidget *)psWidget;
+	const tRectangle *psPosition = &psWidget->sPosition;
+	tContext sContext;
+	GrContextInit(&sContext, psWidget->psDisplay);
+	GrContextClipRegionSet(&sContext, &psWidget->sPosition);
+
+	if (!bBoxOnly && (psCheckBox->ui16Style & CB_STYLE_FILL)) {
+		GrContextForegroundSet(&sContext, psCheckBox->ui32FillColor);
+		GrRectFill(&sContext, psPosition);
+	}
+
+	if (!bBoxOnly && (psCheckBox->ui16Style & CB_STYLE_OUTLINE)) {
+		GrContextForegroundSet(&sContext, psCheckBox->ui32OutlineColor);
+		GrRectDraw(&sContext, psPosition);
+	}
+
+	/* The box is centered vertically, the cross is drawn in the fill color to clear it */
+	tRectangle sBox;
+	sBox.i16XMin = psPosition->i16XMin + CHECKBOX_BOX_MARGIN;
+	sBox.i16YMin = psPosition->i16YMin + (psPosition->i16YMax - psPosition->i16YMin - psCheckBox->ui16BoxSize + 1) / 2;
+	sBox.i16XMax = sBox.i16XMin + psCheckBox->ui16BoxSize - 1;
+	sBox.i16YMax = sBox.i16YMin + psCheckBox->ui16BoxSize - 1;
+	GrContextForegroundSet(&sContext, psCheckBox->ui32OutlineColor);
+	GrRectDraw(&sContext, &sBox);
+
+	GrContextForegroundSet(&sContext, psCheckBox->ui16Style & CB_STYLE_SELECTED ? psCheckBox->ui32OutlineColor : psCheckBox->ui32FillColor);
+	GrLineDraw(&sContext, sBox.i16XMin + 1, sBox.i16YMin + 1, sBox.i16XMax - 1, sBox.i16YMax - 1);
+	GrLineDraw(&sContext, sBox.i16XMin + 1, sBox.i16YMax - 1, sBox.i16XMax - 1, sBox.i16YMin + 1);
+
+	if (!bBoxOnly && (psCheckBox->ui16Style & CB_STYLE_TEXT) && psCheckBox->pcText != NULL && psCheckBox->psFont != NULL) {
+		GrContextFontSet(&sContext, psCheckBox->psFont);
+		GrContextForegroundSet(&sContext, psCheckBox->ui32TextColor);
+		GrContextBackgroundSet(&sContext, psCheckBox->ui32FillColor);
+		GrStringDraw(&sContext, psCheckBox->pcText, -1, sBox.i16XMax + 1 + CHECKBOX_TEXT_MARGIN,
+					 psPosition->i16YMin + (psPosition->i16YMax - psPosition->i16YMin + 1) / 2 - GrFontBaselineGet(psCheckBox->psFont) / 2,
+					 psCheckBox->ui16Style & CB_STYLE_TEXT_OPAQUE);
+	}
+}
+#pragma endregion
+
+#pragma region Check box functions
+int32_t CheckBoxMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2) {
+	tCheckBoxWidget *psCheckBox = (tCheckBoxWidget *)psWidget;
+
+	switch (ui32Message) {
+	case WIDGET_MSG_PAINT:
+		CheckBox_Paint(psWidget, false);
+		return 1;
+	case WIDGET_MSG_PTR_DOWN:
+	case WIDGET_MSG_PTR_MOVE:
+	case WIDGET_MSG_PTR_UP:
+		if (!GrRectContainsPoint(&psWidget->sPosition, (int32_t)ui32Param1, (int32_t)ui32Param2))
+			return 0;
+
+		/* Toggles when released over */
+		if (ui32Message == WIDGET_MSG_PTR_UP) {
+			psCheckBox->ui16Style ^= CB_STYLE_SELECTED;
+			CheckBox_Paint(psWidget, true);
+			if (psCheckBox->pfnOnChange != NULL)
+				psCheckBox->pfnOnChange(psWidget, (psCheckBox->ui16Style & CB_STYLE_SELECTED) != 0);
+		}
+		return 1;
+	default:
+		return WidgetDefaultMsgProc(psWidget, ui32Message, ui32Param1, ui32Param2);
+	}
+}
+
+void CheckBoxInit(tCheckBoxWidget *psCheckBox, const tDisplay *psDisplay, int32_t i32X, int32_t i32Y, int32_t i32Width,
+				  int32_t i32Height) {
+	memset(psCheckBox, 0, sizeof(tCheckBoxWidget));
+	psCheckBox->sBase.i32Size = sizeof(tCheckBoxWidget);
+	psCheckBox->sBase.psDisplay = psDisplay;
+	psCheckBox->sBase.sPosition = (tRectangle){i32X, i32Y, i32X + i32Width - 1, i32Y + i32Height - 1};
+	psCheckBox->sBase.pfnMsgProc = CheckBoxMsgProc;
+}
+#pragma endregion
@@ -0,0 +1,50 @@
+/**
+ * @file checkbox.h
+ * @brief Host stand-in for the check box widget of the TivaWare graphics library
+ *
+ * A check box toggles when released over, then calls back with its new state.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+
+/* Styles */
+#define CB_STYLE_OUTLINE 0x0001
+#define CB_STYLE_FILL 0x0002
+#define CB_STYLE_TEXT 0x0004
+#define CB_STYLE_IMG 0x0008
+#define CB_STYLE_TEXT_OPAQUE 0x0010
+#define CB_STYLE_SELECTED 0x0020
+
+/**
+ * @brief A check box, a box with a label to its right
+ *
+ */
+typedef struct tCheckBoxWidget {
+	tWidget sBase;
+	uint16_t ui16Style;
+	uint16_t ui16BoxSize;
+	uint32_t ui32FillColor;
+	uint32_t ui32OutlineColor;
+	uint32_t ui32TextColor;
+	const tFont *psFont;
+	const char *pcText;
+	const uint8_t *pui8Image;
+	void (*pfnOnChange)(tWidget *psWidget, uint32_t bSelected);
+} tCheckBoxWidget;
+
+/* Declares and initializes a check box */
+#define CheckBox(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui16Style, ui16BoxSize, \
+				 ui32FillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, pfnOnChange)              \
+	tCheckBoxWidget sName = {{sizeof(tCheckBoxWidget), (tWidget *)(psParent), (tWidget *)(psNext), (tWidget *)(psChild), \
+							  (psDisplay), {(i32X), (i32Y), (i32X) + (i32Width) - 1, (i32Y) + (i32Height) - 1},          \
+							  CheckBoxMsgProc},                                                                          \
+							 (uint16_t)(uintptr_t)(ui16Style), (ui16BoxSize), (uint32_t)(uintptr_t)(ui32FillColor),                         \
+							 (uint32_t)(uintptr_t)(ui32OutlineColor), (uint32_t)(uintptr_t)(ui32TextColor), (psFont),  \
+							 (pcText), (pui8Image), (pfnOnChange)}
+
+int32_t CheckBoxMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2);
+void CheckBoxInit(tCheckBoxWidget *psCheckBox, const tDisplay *psDisplay, int32_t i32X, int32_t i32Y, int32_t i32Width,
+				  int32_t i32Height);
@@ -0,0 +1,11 @@
+/**
+ * @file container.h
+ * @brief Host stand-in for the container widget of the TivaWare graphics library
+ *
+ * The project groups widgets with canvases, containers are not implemented on the host.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
@@ -0,0 +1,277 @@
+/**
+ * @file grlib.c
+ * @brief Host stand-in for the drawing functions of the TivaWare graphics library
+ */
+#pragma region Includes
+#include "grlib/grlib.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define GRLIB_FIRST_CHAR ' '
+#define GRLIB_LAST_CHAR '~'
+#define GRLIB_RLE_ESCAPE 0x00 // Followed by a count of eight pixel runs of the background
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Gets the glyph of a character
+ *
+ * @param psFont The font
+ * @param cChar The character
+ * @return The glyph, its size and width then its pixel runs, or NULL if the font does not have the character
+ */
+const uint8_t *Gr_Glyph(const tFont *psFont, char cChar) {
+	if (cChar < GRLIB_FIRST_CHAR || cChar > GRLIB_LAST_CHAR)
+		return NULL;
+
+	return &psFont->pui8Data[psFont->pui16Offset[cChar - GRLIB_FIRST_CHAR]];
+}
+
+/**
+ * @brief Draws a run of pixels of a glyph, one line per glyph row it covers
+ *
+ * @param psContext The graphics context
+ * @param ui32Color The translated color
+ * @param i32X The left of the glyph
+ * @param i32Y The top of the glyph
+ * @param i32Width The width of the glyph
+ * @param i32Pixel The index of the first pixel of the run, in rows of the glyph width
+ * @param i32Count The number of pixels
+ */
+void Gr_GlyphRun(const tContext *psContext, uint32_t ui32Color, int32_t i32X, int32_t i32Y, int32_t i32Width, int32_t i32Pixel,
+				 int32_t i32Count) {
+	const tRectangle *psClip = &psContext->sClipRegion;
+	while (i32Count > 0) {
+		int32_t i32Column = i32Pixel % i32Width;
+		int32_t i32Length = i32Width - i32Column < i32Count ? i32Width - i32Column : i32Count;
+		int32_t i32Row = i32Y + i32Pixel / i32Width;
+		int32_t i32X1 = i32X + i32Column;
+		int32_t i32X2 = i32X1 + i32Length - 1;
+		i32Pixel += i32Length;
+		i32Count -= i32Length;
+
+		if (i32Row < psClip->i16YMin || i32Row > psClip->i16YMax)
+			continue;
+		if (i32X1 < psClip->i16XMin)
+			i32X1 = psClip->i16XMin;
+		if (i32X2 > psClip->i16XMax)
+			i32X2 = psClip->i16XMax;
+		if (i32X1 > i32X2)
+			continue;
+
+		if (i32X1 == i32X2)
+			DpyPixelDraw(psContext->psDisplay, i32X1, i32Row, ui32Color);
+		else
+			DpyLineDrawH(psContext->psDisplay, i32X1, i32X2, i32Row, ui32Color);
+	}
+}
+
+/**
+ * @brief Draws a glyph
+ *
+ * @param psContext The graphics context, with the font
+ * @param pui8Glyph The glyph
+ * @param i32X The left of the glyph
+ * @param i32Y The top of the glyph
+ * @param bOpaque True to draw the background pixels in the background color
+ */
+void Gr_GlyphDraw(const tContext *psContext, const uint8_t *pui8Glyph, int32_t i32X, int32_t i32Y, bool bOpaque) {
+	int32_t i32Width = pui8Glyph[1];
+	int32_t i32Pixels = i32Width * psContext->psFont->ui8Height;
+	int32_t i32Pixel = 0;
+
+	for (int32_t i = 2; i < pui8Glyph[0] && i32Pixel < i32Pixels; i++) {
+		int32_t i32Off, i32On;
+		if (pui8Glyph[i] == GRLIB_RLE_ESCAPE) {
+			i32Off = pui8Glyph[++i] * 8;
+			i32On = 0;
+		} else {
+			i32Off = pui8Glyph[i] >> 4;
+			i32On = pui8Glyph[i] & 0x0F;
+		}
+
+		if (i32Off > i32Pixels - i32Pixel)
+			i32Off = i32Pixels - i32Pixel;
+		if (bOpaque && i32Off > 0)
+			Gr_GlyphRun(psContext, psContext->ui32Background, i32X, i32Y, i32Width, i32Pixel, i32Off);
+		i32Pixel += i32Off;
+
+		if (i32On > i32Pixels - i32Pixel)
+			i32On = i32Pixels - i32Pixel;
+		if (i32On > 0)
+			Gr_GlyphRun(psContext, psContext->ui32Foreground, i32X, i32Y, i32Width, i32Pixel, i32On);
+		i32Pixel += i32On;
+	}
+
+	/* Trailing background pixels are left out of the encoding */
+	if (bOpaque && i32Pixel < i32Pixels)
+		Gr_GlyphRun(psContext, psContext->ui32Background, i32X, i32Y, i32Width, i32Pixel, i32Pixels - i32Pixel);
+}
+#pragma endregion
+
+#pragma region Graphics library functions
+void GrContextInit(tContext *psContext, const tDisplay *psDisplay) {
+	*psContext = (tContext){sizeof(tContext), psDisplay, {0, 0, psDisplay->ui16Width - 1, psDisplay->ui16Height - 1}, 0, 0, NULL};
+}
+
+void GrContextClipRegionSet(tContext *psContext, tRectangle *psRect) {
+	/* The clip region never extends past the display */
+	psContext->sClipRegion.i16XMin = psRect->i16XMin < 0 ? 0 : psRect->i16XMin;
+	psContext->sClipRegion.i16YMin = psRect->i16YMin < 0 ? 0 : psRect->i16YMin;
+	psContext->sClipRegion.i16XMax =
+		psRect->i16XMax >= psContext->psDisplay->ui16Width ? psContext->psDisplay->ui16Width - 1 : psRect->i16XMax;
+	psContext->sClipRegion.i16YMax =
+		psRect->i16YMax >= psContext->psDisplay->ui16Height ? psContext->psDisplay->ui16Height - 1 : psRect->i16YMax;
+}
+
+void GrPixelDraw(const tContext *psContext, int32_t i32X, int32_t i32Y) {
+	if (GrRectContainsPoint(&psContext->sClipRegion, i32X, i32Y))
+		DpyPixelDraw(psContext->psDisplay, i32X, i32Y, psContext->ui32Foreground);
+}
+
+void GrLineDraw(const tContext *psContext, int32_t i32X1, int32_t i32Y1, int32_t i32X2, int32_t i32Y2) {
+	if (i32Y1 == i32Y2) {
+		GrLineDrawH(psContext, i32X1, i32X2, i32Y1);
+		return;
+	}
+	if (i32X1 == i32X2) {
+		GrLineDrawV(psContext, i32X1, i32Y1, i32Y2);
+		return;
+	}
+
+	/* Bresenham's algorithm, clipped pixel by pixel */
+	int32_t i32DeltaX = abs(i32X2 - i32X1);
+	int32_t i32DeltaY = -abs(i32Y2 - i32Y1);
+	int32_t i32StepX = i32X1 < i32X2 ? 1 : -1;
+	int32_t i32StepY = i32Y1 < i32Y2 ? 1 : -1;
+	int32_t i32Error = i32DeltaX + i32DeltaY;
+	while (1) {
+		GrPixelDraw(psContext, i32X1, i32Y1);
+		if (i32X1 == i32X2 && i32Y1 == i32Y2)
+			break;
+
+		if (2 * i32Error >= i32DeltaY) {
+			i32Error += i32DeltaY;
+			i32X1 += i32StepX;
+		}
+		if (2 * i32Error <= i32DeltaX) {
+			i32Error += i32DeltaX;
+			i32Y1 += i32StepY;
+		}
+	}
+}
+
+void GrLineDrawH(const tContext *psContext, int32_t i32X1, int32_t i32X2, int32_t i32Y) {
+	const tRectangle *psClip = &psContext->sClipRegion;
+	if (i32X1 > i32X2) {
+		int32_t i32Swap = i32X1;
+		i32X1 = i32X2;
+		i32X2 = i32Swap;
+	}
+
+	if (i32Y < psClip->i16YMin || i32Y > psClip->i16YMax)
+		return;
+	if (i32X1 < psClip->i16XMin)
+		i32X1 = psClip->i16XMin;
+	if (i32X2 > psClip->i16XMax)
+		i32X2 = psClip->i16XMax;
+	if (i32X1 > i32X2)
+		return;
+
+	DpyLineDrawH(psContext->psDisplay, i32X1, i32X2, i32Y, psContext->ui32Foreground);
+}
+
+void GrLineDrawV(const tContext *psContext, int32_t i32X, int32_t i32Y1, int32_t i32Y2) {
+	const tRectangle *psClip = &psContext->sClipRegion;
+	if (i32Y1 > i32Y2) {
+		int32_t i32Swap = i32Y1;
+		i32Y1 = i32Y2;
+		i32Y2 = i32Swap;
+	}
+
+	if (i32X < psClip->i16XMin || i32X > psClip->i16XMax)
+		return;
+	if (i32Y1 < psClip->i16YMin)
+		i32Y1 = psClip->i16YMin;
+	if (i32Y2 > psClip->i16YMax)
+		i32Y2 = psClip->i16YMax;
+	if (i32Y1 > i32Y2)
+		return;
+
+	DpyLineDrawV(psContext->psDisplay, i32X, i32Y1, i32Y2, psContext->ui32Foreground);
+}
+
+void GrRectDraw(const tContext *psContext, const tRectangle *psRect) {
+	/* Each side is drawn once, without drawing the corners twice */
+	GrLineDrawH(psContext, psRect->i16XMin, psRect->i16XMax, psRect->i16YMin);
+	if (psRect->i16YMin == psRect->i16YMax)
+		return;
+
+	GrLineDrawV(psContext, psRect->i16XMax, psRect->i16YMin + 1, psRect->i16YMax);
+	if (psRect->i16XMin == psRect->i16XMax)
+		return;
+
+	GrLineDrawH(psContext, psRect->i16XMax - 1, psRect->i16XMin, psRect->i16YMax);
+	if (psRect->i16YMin + 1 == psRect->i16YMax)
+		return;
+
+	GrLineDrawV(psContext, psRect->i16XMin, psRect->i16YMax - 1, psRect->i16YMin + 1);
+}
+
+void GrRectFill(const tContext *psContext, const tRectangle *psRect) {
+	const tRectangle *psClip = &psContext->sClipRegion;
+	tRectangle sRect = *psRect;
+	if (sRect.i16XMin > sRect.i16XMax) {
+		sRect.i16XMin = psRect->i16XMax;
+		sRect.i16XMax = psRect->i16XMin;
+	}
+	if (sRect.i16YMin > sRect.i16YMax) {
+		sRect.i16YMin = psRect->i16YMax;
+		sRect.i16YMax = psRect->i16YMin;
+	}
+
+	if (sRect.i16XMin < psClip->i16XMin)
+		sRect.i16XMin = psClip->i16XMin;
+	if (sRect.i16YMin < psClip->i16YMin)
+		sRect.i16YMin = psClip->i16YMin;
+	if (sRect.i16XMax > psClip->i16XMax)
+		sRect.i16XMax = psClip->i16XMax;
+	if (sRect.i16YMax > psClip->i16YMax)
+		sRect.i16YMax = psClip->i16YMax;
+	if (sRect.i16XMin > sRect.i16XMax || sRect.i16YMin > sRect.i16YMax)
+		return;
+
+	DpyRectFill(psContext->psDisplay, &sRect, psContext->ui32Foreground);
+}
+
+void GrStringDraw(const tContext *psContext, const char *pcString, int32_t i32Length, int32_t i32X, int32_t i32Y,
+				  uint32_t bOpaque) {
+	for (int32_t i = 0; (i32Length < 0 || i < i32Length) && pcString[i] != '\0'; i++) {
+		const uint8_t *pui8Glyph = Gr_Glyph(psContext->psFont, pcString[i]);
+		if (pui8Glyph == NULL)
+			continue;
+
+		/* Glyphs entirely outside of the clip region are skipped */
+		if (i32X <= psContext->sClipRegion.i16XMax && i32X + pui8Glyph[1] > psContext->sClipRegion.i16XMin)
+			Gr_GlyphDraw(psContext, pui8Glyph, i32X, i32Y, bOpaque);
+		i32X += pui8Glyph[1];
+	}
+}
+
+int32_t GrStringWidthGet(const tContext *psContext, const char *pcString, int32_t i32Length) {
+	int32_t i32Width = 0;
+	for (int32_t i = 0; (i32Length < 0 || i < i32Length) && pcString[i] != '\0'; i++) {
+		const uint8_t *pui8Glyph = Gr_Glyph(psContext->psFont, pcString[i]);
+		if (pui8Glyph != NULL)
+			i32Width += pui8Glyph[1];
+	}
+
+	return i32Width;
+}
+#pragma endregion
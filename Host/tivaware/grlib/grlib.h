@@ -0,0 +1,132 @@
+/**
+ * @file grlib.h
+ * @brief Host stand-in for the subset of the TivaWare graphics library used by the project
+ *
+ * The types and the drawing calls follow the library, and drawing goes through the callbacks of
+ * the display, so the target display driver can be used unchanged. Only pixel run-length encoded
+ * fonts with the characters 32 to 126 are supported, and images are not.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Colors, in the 24-bit RGB format used by grlib */
+#define ClrBlack 0x00000000
+#define ClrDarkBlue 0x0000008B
+#define ClrBlue 0x000000FF
+#define ClrGreen 0x00008000
+#define ClrDarkGreen 0x00006400
+#define ClrLime 0x0000FF00
+#define ClrCyan 0x0000FFFF
+#define ClrDimGray 0x00696969
+#define ClrGray 0x00808080
+#define ClrDarkGray 0x00A9A9A9
+#define ClrSilver 0x00C0C0C0
+#define ClrDarkRed 0x008B0000
+#define ClrRed 0x00FF0000
+#define ClrMagenta 0x00FF00FF
+#define ClrOrange 0x00FFA500
+#define ClrYellow 0x00FFFF00
+#define ClrWhite 0x00FFFFFF
+
+/* Flags passed to the display driver with the bits per pixel of an image */
+#define GRLIB_DRIVER_FLAG_NEW_IMAGE 0x40000000
+
+/* Font formats */
+#define FONT_FMT_UNCOMPRESSED 0x00
+#define FONT_FMT_PIXEL_RLE 0x01
+
+/**
+ * @brief A rectangle, both corners are inclusive
+ *
+ */
+typedef struct tRectangle {
+	int16_t i16XMin;
+	int16_t i16YMin;
+	int16_t i16XMax;
+	int16_t i16YMax;
+} tRectangle;
+
+/**
+ * @brief A display and the driver functions that draw on it
+ *
+ */
+typedef struct tDisplay {
+	int32_t i32Size;
+	void *pvDisplayData;
+	uint16_t ui16Width;
+	uint16_t ui16Height;
+	void (*pfnPixelDraw)(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value);
+	void (*pfnPixelDrawMultiple)(void *pvDisplayData, int32_t i32X, int32_t i32Y, int32_t i32X0, int32_t i32Count,
+								 int32_t i32BPP, const uint8_t *pui8Data, const uint8_t *pui8Palette);
+	void (*pfnLineDrawH)(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value);
+	void (*pfnLineDrawV)(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2, uint32_t ui32Value);
+	void (*pfnRectFill)(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value);
+	uint32_t (*pfnColorTranslate)(void *pvDisplayData, uint32_t ui32Value);
+	void (*pfnFlush)(void *pvDisplayData);
+} tDisplay;
+
+/**
+ * @brief A font, with the characters 32 to 126
+ *
+ */
+typedef struct tFont {
+	uint8_t ui8Format;
+	uint8_t ui8MaxWidth;
+	uint8_t ui8Height;
+	uint8_t ui8Baseline;
+	uint16_t pui16Offset[96];
+	const uint8_t *pui8Data;
+} tFont;
+
+/**
+ * @brief A drawing context, the colors are stored translated for the display
+ *
+ */
+typedef struct tContext {
+	int32_t i32Size;
+	const tDisplay *psDisplay;
+	tRectangle sClipRegion;
+	uint32_t ui32Foreground;
+	uint32_t ui32Background;
+	const tFont *psFont;
+} tContext;
+
+/* Display access */
+#define DpyWidthGet(psDisplay) ((psDisplay)->ui16Width)
+#define DpyHeightGet(psDisplay) ((psDisplay)->ui16Height)
+#define DpyColorTranslate(psDisplay, ui32Value) ((psDisplay)->pfnColorTranslate((psDisplay)->pvDisplayData, (ui32Value)))
+#define DpyPixelDraw(psDisplay, i32X, i32Y, ui32Value) \
+	((psDisplay)->pfnPixelDraw((psDisplay)->pvDisplayData, (i32X), (i32Y), (ui32Value)))
+#define DpyLineDrawH(psDisplay, i32X1, i32X2, i32Y, ui32Value) \
+	((psDisplay)->pfnLineDrawH((psDisplay)->pvDisplayData, (i32X1), (i32X2), (i32Y), (ui32Value)))
+#define DpyLineDrawV(psDisplay, i32X, i32Y1, i32Y2, ui32Value) \
+	((psDisplay)->pfnLineDrawV((psDisplay)->pvDisplayData, (i32X), (i32Y1), (i32Y2), (ui32Value)))
+#define DpyRectFill(psDisplay, psRect, ui32Value) ((psDisplay)->pfnRectFill((psDisplay)->pvDisplayData, (psRect), (ui32Value)))
+#define DpyFlush(psDisplay) ((psDisplay)->pfnFlush((psDisplay)->pvDisplayData))
+
+/* Context access */
+#define GrContextForegroundSet(psContext, ui32Value) \
+	((psContext)->ui32Foreground = DpyColorTranslate((psContext)->psDisplay, (ui32Value)))
+#define GrContextBackgroundSet(psContext, ui32Value) \
+	((psContext)->ui32Background = DpyColorTranslate((psContext)->psDisplay, (ui32Value)))
+#define GrContextFontSet(psContext, psNewFont) ((psContext)->psFont = (psNewFont))
+#define GrFontHeightGet(psFont) ((psFont)->ui8Height)
+#define GrFontBaselineGet(psFont) ((psFont)->ui8Baseline)
+#define GrRectContainsPoint(psRect, i32X, i32Y) \
+	((((i32X) >= (psRect)->i16XMin) && ((i32X) <= (psRect)->i16XMax) && ((i32Y) >= (psRect)->i16YMin) && ((i32Y) <= (psRect)->i16YMax)) ? 1 : 0)
+#define GrStringDrawCentered(psContext, pcString, i32Length, i32X, i32Y, bOpaque)                                    \
+	GrStringDraw((psContext), (pcString), (i32Length), (i32X) - (GrStringWidthGet((psContext), (pcString), (i32Length)) / 2), \
+				 (i32Y) - ((psContext)->psFont->ui8Baseline / 2), (bOpaque))
+
+void GrContextInit(tContext *psContext, const tDisplay *psDisplay);
+void GrContextClipRegionSet(tContext *psContext, tRectangle *psRect);
+void GrPixelDraw(const tContext *psContext, int32_t i32X, int32_t i32Y);
+void GrLineDraw(const tContext *psContext, int32_t i32X1, int32_t i32Y1, int32_t i32X2, int32_t i32Y2);
+void GrLineDrawH(const tContext *psContext, int32_t i32X1, int32_t i32X2, int32_t i32Y);
+void GrLineDrawV(const tContext *psContext, int32_t i32X, int32_t i32Y1, int32_t i32Y2);
+void GrRectDraw(const tContext *psContext, const tRectangle *psRect);
+void GrRectFill(const tContext *psContext, const tRectangle *psRect);
+void GrStringDraw(const tContext *psContext, const char *pcString, int32_t i32Length, int32_t i32X, int32_t i32Y,
+				  uint32_t bOpaque);
+int32_t GrStringWidthGet(const tContext *psContext, const char *pcString, int32_t i32Length);
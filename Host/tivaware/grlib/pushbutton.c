@@ -0,0 +1,131 @@
+/**
+ * @file pushbutton.c
+ * @brief Host stand-in for the rectangular push button of the TivaWare graphics library
+ */
+#pragma region Includes
+#include "grlib/pushbutton.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Paints a button: the fill, in the pressed color while pressed, the outline then the text
+ *
+ * @param psWidget The button
+ */
+void PushButton_Paint(tWidget *psWidget) {
+	tPushButtonWidget *psButton = (tPushButtonWidget *)psWidget;
+	const tRectangle *psPosition = &psWidget->sPosition;
+	uint32_t ui32Fill = psButton->ui32Style & PB_STYLE_PRESSED ? psButton->ui32PressFillColor : psButton->ui32FillColor;
+	tContext sContext;
+	GrContextInit(&sContext, psWidget->psDisplay);
+	GrContextClipRegionSet(&sContext, &psWidget->sPosition);
+
+	if (psButton->ui32Style & PB_STYLE_FILL) {
+		GrContextForegroundSet(&sContext, ui32Fill);
+		GrRectFill(&sContext, psPosition);
+	}
+
+	if (psButton->ui32Style & PB_STYLE_OUTLINE) {
+		GrContextForegroundSet(&sContext, psButton->ui32OutlineColor);
+		GrRectDraw(&sContext, psPosition);
+	}
+
+	if ((psButton->ui32Style & PB_STYLE_TEXT) && psButton->pcText != NULL && psButton->psFont != NULL) {
+		GrContextFontSet(&sContext, psButton->psFont);
+		GrContextForegroundSet(&sContext, psButton->ui32TextColor);
+		GrContextBackgroundSet(&sContext, ui32Fill);
+		GrStringDrawCentered(&sContext, psButton->pcText, -1,
+							 psPosition->i16XMin + (psPosition->i16XMax - psPosition->i16XMin + 1) / 2,
+							 psPosition->i16YMin + (psPosition->i16YMax - psPosition->i16YMin + 1) / 2,
+							 psButton->ui32Style & PB_STYLE_TEXT_OPAQUE);
+	}
+}
+
+/**
+ * @brief Handles a pointer message
+ *
+ * @param psWidget The button
+ * @param ui32Message The pointer message
+ * @param i32X The x position of the pointer
+ * @param i32Y The y position of the pointer
+ * @return 1 if the pointer is over the button
+ */
+int32_t PushButton_Click(tWidget *psWidget, uint32_t ui32Message, int32_t i32X, int32_t i32Y) {
+	tPushButtonWidget *psButton = (tPushButtonWidget *)psWidget;
+	bool bRepaint = psButton->ui32Style & PB_STYLE_FILL;
+
+	if (!GrRectContainsPoint(&psWidget->sPosition, i32X, i32Y)) {
+		/* Released away from the button */
+		if (ui32Message == WIDGET_MSG_PTR_UP && (psButton->ui32Style & PB_STYLE_PRESSED)) {
+			psButton->ui32Style &= ~PB_STYLE_PRESSED;
+			if (bRepaint)
+				PushButton_Paint(psWidget);
+		}
+		return 0;
+	}
+
+	switch (ui32Message) {
+	case WIDGET_MSG_PTR_DOWN:
+		psButton->ui32Style |= PB_STYLE_PRESSED;
+		psButton->ui32AutoRepeatCount = 0;
+		if (bRepaint)
+			PushButton_Paint(psWidget);
+		if (psButton->pfnOnClick != NULL && !(psButton->ui32Style & PB_STYLE_RELEASE_NOTIFY))
+			psButton->pfnOnClick(psWidget);
+		break;
+	case WIDGET_MSG_PTR_MOVE:
+		/* Repeats are counted in pointer moves, as the touch screen sends them while held */
+		if ((psButton->ui32Style & (PB_STYLE_AUTO_REPEAT | PB_STYLE_PRESSED)) != (PB_STYLE_AUTO_REPEAT | PB_STYLE_PRESSED) ||
+			psButton->pfnOnClick == NULL)
+			break;
+		psButton->ui32AutoRepeatCount++;
+		if (psButton->ui32AutoRepeatCount >= psButton->ui16AutoRepeatDelay &&
+			(psButton->ui32AutoRepeatCount - psButton->ui16AutoRepeatDelay) % (psButton->ui16AutoRepeatRate ? psButton->ui16AutoRepeatRate : 1) == 0)
+			psButton->pfnOnClick(psWidget);
+		break;
+	case WIDGET_MSG_PTR_UP:
+		if (!(psButton->ui32Style & PB_STYLE_PRESSED))
+			break;
+		psButton->ui32Style &= ~PB_STYLE_PRESSED;
+		if (bRepaint)
+			PushButton_Paint(psWidget);
+		if (psButton->pfnOnClick != NULL && (psButton->ui32Style & PB_STYLE_RELEASE_NOTIFY))
+			psButton->pfnOnClick(psWidget);
+		break;
+	default:
+		break;
+	}
+
+	return 1;
+}
+#pragma endregion
+
+#pragma region Push button functions
+int32_t RectangularButtonMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2) {
+	switch (ui32Message) {
+	case WIDGET_MSG_PAINT:
+		PushButton_Paint(psWidget);
+		return 1;
+	case WIDGET_MSG_PTR_DOWN:
+	case WIDGET_MSG_PTR_MOVE:
+	case WIDGET_MSG_PTR_UP:
+		return PushButton_Click(psWidget, ui32Message, (int32_t)ui32Param1, (int32_t)ui32Param2);
+	default:
+		return WidgetDefaultMsgProc(psWidget, ui32Message, ui32Param1, ui32Param2);
+	}
+}
+
+void RectangularButtonInit(tPushButtonWidget *psButton, const tDisplay *psDisplay, int32_t i32X, int32_t i32Y,
+						   int32_t i32Width, int32_t i32Height) {
+	memset(psButton, 0, sizeof(tPushButtonWidget));
+	psButton->sBase.i32Size = sizeof(tPushButtonWidget);
+	psButton->sBase.psDisplay = psDisplay;
+	psButton->sBase.sPosition = (tRectangle){i32X, i32Y, i32X + i32Width - 1, i32Y + i32Height - 1};
+	psButton->sBase.pfnMsgProc = RectangularButtonMsgProc;
+}
+#pragma endregion
@@ -0,0 +1,67 @@
+/**
+ * @file pushbutton.h
+ * @brief Host stand-in for the rectangular push button of the TivaWare graphics library
+ *
+ * A button calls back when pressed, or when released with PB_STYLE_RELEASE_NOTIFY. With
+ * PB_STYLE_AUTO_REPEAT the callback repeats while the button is held, counted in pointer moves.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+#include "grlib/widget.h"
+
+/* Styles */
+#define PB_STYLE_OUTLINE 0x00000001
+#define PB_STYLE_FILL 0x00000002
+#define PB_STYLE_TEXT 0x00000004
+#define PB_STYLE_IMG 0x00000008
+#define PB_STYLE_TEXT_OPAQUE 0x00000010
+#define PB_STYLE_AUTO_REPEAT 0x00000020
+#define PB_STYLE_PRESSED 0x00000040
+#define PB_STYLE_RELEASE_NOTIFY 0x00000080
+
+/**
+ * @brief A push button
+ *
+ */
+typedef struct tPushButtonWidget {
+	tWidget sBase;
+	uint32_t ui32Style;
+	uint32_t ui32FillColor;
+	uint32_t ui32PressFillColor;
+	uint32_t ui32OutlineColor;
+	uint32_t ui32TextColor;
+	const tFont *psFont;
+	const char *pcText;
+	const uint8_t *pui8Image;
+	const uint8_t *pui8PressImage;
+	uint16_t ui16AutoRepeatDelay;
+	uint16_t ui16AutoRepeatRate;
+	uint32_t ui32AutoRepeatCount;
+	void (*pfnOnClick)(tWidget *psWidget);
+} tPushButtonWidget;
+
+/* Declares and initializes a rectangular push button */
+#define RectangularButton(sName, psParent, psNext, psChild, psDisplay, i32X, i32Y, i32Width, i32Height, ui32Style,      \
+						  ui32FillColor, ui32PressFillColor, ui32OutlineColor, ui32TextColor, psFont, pcText, pui8Image, \
+						  pui8PressImage, ui16AutoRepeatDelay, ui16AutoRepeatRate, pfnOnClick)                           \
+	tPushButtonWidget sName = {{sizeof(tPushButtonWidget), (tWidget *)(psParent), (tWidget *)(psNext),                    \
+								(tWidget *)(psChild), (psDisplay),                                                       \
+								{(i32X), (i32Y), (i32X) + (i32Width) - 1, (i32Y) + (i32Height) - 1},                     \
+								RectangularButtonMsgProc},                                                               \
+							   (uint32_t)(uintptr_t)(ui32Style), (uint32_t)(uintptr_t)(ui32FillColor), (uint32_t)(uintptr_t)(ui32PressFillColor), \
+							   (uint32_t)(uintptr_t)(ui32OutlineColor), (uint32_t)(uintptr_t)(ui32TextColor), (psFont),    \
+							   (pcText), (pui8Image), (pui8PressImage), (ui16AutoRepeatDelay), (ui16AutoRepeatRate), 0,      \
+							   (pfnOnClick)}
+
+/* Push button access */
+#define PushButtonCallbackSet(psButton, pfnCallback) ((psButton)->pfnOnClick = (pfnCallback))
+#define PushButtonFillColorSet(psButton, ui32Color) ((psButton)->ui32FillColor = (ui32Color))
+#define PushButtonFillColorPressedSet(psButton, ui32Color) ((psButton)->ui32PressFillColor = (ui32Color))
+#define PushButtonTextColorSet(psButton, ui32Color) ((psButton)->ui32TextColor = (ui32Color))
+#define PushButtonTextSet(psButton, pcNewText) ((psButton)->pcText = (pcNewText))
+
+int32_t RectangularButtonMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2);
+void RectangularButtonInit(tPushButtonWidget *psButton, const tDisplay *psDisplay, int32_t i32X, int32_t i32Y,
+						   int32_t i32Width, int32_t i32Height);
@@ -0,0 +1,199 @@
+/**
+ * @file widget.c
+ * @brief Host stand-in for the widget tree and message queue of the TivaWare graphics library
+ */
+#pragma region Includes
+#include "grlib/widget.h"
+
+/* Standard header files */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#pragma endregion
+
+#pragma region Variables and Defines
+/* Global defines */
+#define WIDGET_QUEUE_LENGTH 16
+
+/**
+ * @brief A queued message
+ *
+ */
+typedef struct tWidgetMessage {
+	tWidget *psWidget;
+	uint32_t ui32Message;
+	uint32_t ui32Param1;
+	uint32_t ui32Param2;
+	bool bPostOrder;
+	bool bStopOnSuccess;
+} tWidgetMessage;
+
+/* Global variables */
+tWidget g_sRoot = {sizeof(tWidget), NULL, NULL, NULL, NULL, {0, 0, 319, 239}, WidgetDefaultMsgProc};
+tWidgetMessage g_psWidgetQueue[WIDGET_QUEUE_LENGTH];
+volatile uint32_t g_ui32WidgetQueueRead = 0;
+volatile uint32_t g_ui32WidgetQueueWrite = 0;
+tWidget *g_psWidgetPointer = NULL; // The widget that accepted the last press, it gets the moves and the release
+#pragma endregion
+
+#pragma region Internal functions
+/**
+ * @brief Checks if a widget is in a tree
+ *
+ * @param psWidget The widget
+ * @param psTree The root of the tree
+ * @return True if the widget is the root or one of its descendants
+ */
+bool Widget_InTree(tWidget *psWidget, tWidget *psTree) {
+	for (; psWidget != NULL; psWidget = psWidget->psParent) {
+		if (psWidget == psTree)
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * @brief Sends a message to a tree, children before their parent
+ *
+ * @param psWidget The root of the tree
+ * @param ui32Message The message
+ * @param ui32Param1 The first parameter
+ * @param ui32Param2 The second parameter
+ * @param bStopOnSuccess True to stop at the first widget that handles the message
+ * @param ppsHandler Set to the first widget that handled the message, may be NULL
+ * @return The result of the last widget the message was sent to
+ */
+int32_t Widget_SendPostOrder(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+							 bool bStopOnSuccess, tWidget **ppsHandler) {
+	for (tWidget *psChild = psWidget->psChild; psChild != NULL; psChild = psChild->psNext) {
+		int32_t i32Result = Widget_SendPostOrder(psChild, ui32Message, ui32Param1, ui32Param2, bStopOnSuccess, ppsHandler);
+		if (i32Result && bStopOnSuccess)
+			return i32Result;
+	}
+
+	int32_t i32Result = psWidget->pfnMsgProc(psWidget, ui32Message, ui32Param1, ui32Param2);
+	if (i32Result && ppsHandler != NULL && *ppsHandler == NULL)
+		*ppsHandler = psWidget;
+	return i32Result;
+}
+#pragma endregion
+
+#pragma region Widget functions
+int32_t WidgetDefaultMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2) {
+	return 0;
+}
+
+void WidgetAdd(tWidget *psParent, tWidget *psWidget) {
+	/* Widgets are added after their last sibling */
+	psWidget->psParent = psParent;
+	psWidget->psNext = NULL;
+	if (psParent->psChild == NULL) {
+		psParent->psChild = psWidget;
+		return;
+	}
+
+	tWidget *psLast = psParent->psChild;
+	while (psLast->psNext != NULL) {
+		psLast = psLast->psNext;
+	}
+	psLast->psNext = psWidget;
+}
+
+void WidgetRemove(tWidget *psWidget) {
+	tWidget *psParent = psWidget->psParent;
+	if (psParent == NULL)
+		return;
+
+	if (psParent->psChild == psWidget) {
+		psParent->psChild = psWidget->psNext;
+	} else {
+		tWidget *psPrevious = psParent->psChild;
+		while (psPrevious != NULL && psPrevious->psNext != psWidget) {
+			psPrevious = psPrevious->psNext;
+		}
+		if (psPrevious != NULL)
+			psPrevious->psNext = psWidget->psNext;
+	}
+
+	/* A widget that left the screen no longer gets the moves and the release of the press it accepted */
+	if (g_psWidgetPointer != NULL && Widget_InTree(g_psWidgetPointer, psWidget))
+		g_psWidgetPointer = NULL;
+
+	psWidget->psParent = NULL;
+	psWidget->psNext = NULL;
+}
+
+int32_t WidgetMessageSendPreOrder(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+								  bool bStopOnSuccess) {
+	int32_t i32Result = psWidget->pfnMsgProc(psWidget, ui32Message, ui32Param1, ui32Param2);
+	if (i32Result && bStopOnSuccess)
+		return i32Result;
+
+	for (tWidget *psChild = psWidget->psChild; psChild != NULL; psChild = psChild->psNext) {
+		i32Result = WidgetMessageSendPreOrder(psChild, ui32Message, ui32Param1, ui32Param2, bStopOnSuccess);
+		if (i32Result && bStopOnSuccess)
+			return i32Result;
+	}
+
+	return i32Result;
+}
+
+int32_t WidgetMessageSendPostOrder(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+								   bool bStopOnSuccess) {
+	return Widget_SendPostOrder(psWidget, ui32Message, ui32Param1, ui32Param2, bStopOnSuccess, NULL);
+}
+
+int32_t WidgetMessageQueueAdd(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+							  bool bPostOrder, bool bStopOnSuccess) {
+	/* A move replaces a move queued just before it, so a held pointer cannot fill the queue */
+	uint32_t ui32Last = (g_ui32WidgetQueueWrite + WIDGET_QUEUE_LENGTH - 1) % WIDGET_QUEUE_LENGTH;
+	if (ui32Message == WIDGET_MSG_PTR_MOVE && g_ui32WidgetQueueRead != g_ui32WidgetQueueWrite &&
+		g_psWidgetQueue[ui32Last].ui32Message == WIDGET_MSG_PTR_MOVE) {
+		g_psWidgetQueue[ui32Last].ui32Param1 = ui32Param1;
+		g_psWidgetQueue[ui32Last].ui32Param2 = ui32Param2;
+		return 1;
+	}
+
+	uint32_t ui32Next = (g_ui32WidgetQueueWrite + 1) % WIDGET_QUEUE_LENGTH;
+	if (ui32Next == g_ui32WidgetQueueRead)
+		return 0;
+
+	g_psWidgetQueue[g_ui32WidgetQueueWrite] = (tWidgetMessage){psWidget, ui32Message, ui32Param1, ui32Param2, bPostOrder, bStopOnSuccess};
+	g_ui32WidgetQueueWrite = ui32Next;
+	return 1;
+}
+
+void WidgetMessageQueueProcess(void) {
+	while (g_ui32WidgetQueueRead != g_ui32WidgetQueueWrite) {
+		tWidgetMessage sMessage = g_psWidgetQueue[g_ui32WidgetQueueRead];
+		g_ui32WidgetQueueRead = (g_ui32WidgetQueueRead + 1) % WIDGET_QUEUE_LENGTH;
+
+		if (!sMessage.bPostOrder) {
+			WidgetMessageSendPreOrder(sMessage.psWidget, sMessage.ui32Message, sMessage.ui32Param1, sMessage.ui32Param2,
+									  sMessage.bStopOnSuccess);
+			continue;
+		}
+
+		/* A press goes to the tree, the moves and the release to the widget that accepted it */
+		if (sMessage.ui32Message == WIDGET_MSG_PTR_MOVE || sMessage.ui32Message == WIDGET_MSG_PTR_UP) {
+			tWidget *psPointer = g_psWidgetPointer;
+			if (sMessage.ui32Message == WIDGET_MSG_PTR_UP)
+				g_psWidgetPointer = NULL;
+			if (psPointer != NULL)
+				psPointer->pfnMsgProc(psPointer, sMessage.ui32Message, sMessage.ui32Param1, sMessage.ui32Param2);
+			continue;
+		}
+
+		tWidget *psHandler = NULL;
+		Widget_SendPostOrder(sMessage.psWidget, sMessage.ui32Message, sMessage.ui32Param1, sMessage.ui32Param2,
+							 sMessage.bStopOnSuccess, &psHandler);
+		if (sMessage.ui32Message == WIDGET_MSG_PTR_DOWN)
+			g_psWidgetPointer = psHandler != NULL && Widget_InTree(psHandler, WIDGET_ROOT) ? psHandler : NULL;
+	}
+}
+
+int32_t WidgetPointerMessage(uint32_t ui32Message, int32_t i32X, int32_t i32Y) {
+	return WidgetMessageQueueAdd(WIDGET_ROOT, ui32Message, (uint32_t)i32X, (uint32_t)i32Y, true, true);
+}
+#pragma endregion
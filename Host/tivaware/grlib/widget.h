@@ -0,0 +1,52 @@
+/**
+ * @file widget.h
+ * @brief Host stand-in for the subset of the TivaWare widget framework used by the project
+ *
+ * Widgets form a tree under WIDGET_ROOT. Pointer messages are queued by WidgetPointerMessage and
+ * delivered by WidgetMessageQueueProcess: a press goes to the widgets children first until one
+ * accepts it, and that widget then gets the moves and the release, as in the library.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+/* Messages */
+#define WIDGET_MSG_PAINT 0x00000001
+#define WIDGET_MSG_PTR_DOWN 0x00000002
+#define WIDGET_MSG_PTR_MOVE 0x00000003
+#define WIDGET_MSG_PTR_UP 0x00000004
+
+/* The root of the widget tree */
+#define WIDGET_ROOT (&g_sRoot)
+
+/**
+ * @brief A widget, the first member of every widget type
+ *
+ */
+typedef struct tWidget {
+	int32_t i32Size;
+	struct tWidget *psParent;
+	struct tWidget *psNext;
+	struct tWidget *psChild;
+	const tDisplay *psDisplay;
+	tRectangle sPosition;
+	int32_t (*pfnMsgProc)(struct tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2);
+} tWidget;
+
+extern tWidget g_sRoot;
+
+/* Repaints a widget tree from the message queue */
+#define WidgetPaint(psWidget) WidgetMessageQueueAdd((psWidget), WIDGET_MSG_PAINT, 0, 0, false, false)
+
+int32_t WidgetDefaultMsgProc(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2);
+void WidgetAdd(tWidget *psParent, tWidget *psWidget);
+void WidgetRemove(tWidget *psWidget);
+int32_t WidgetMessageSendPreOrder(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+								  bool bStopOnSuccess);
+int32_t WidgetMessageSendPostOrder(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+								   bool bStopOnSuccess);
+int32_t WidgetMessageQueueAdd(tWidget *psWidget, uint32_t ui32Message, uint32_t ui32Param1, uint32_t ui32Param2,
+							  bool bPostOrder, bool bStopOnSuccess);
+void WidgetMessageQueueProcess(void);
+int32_t WidgetPointerMessage(uint32_t ui32Message, int32_t i32X, int32_t i32Y);
@@ -0,0 +1,12 @@
+/**
+ * @file hw_adc.h
+ * @brief Host stand-in for the subset of the ADC register offsets used by the project
+ */
+#pragma once
+
+#define ADC_O_ISC 0x0000000C
+#define ADC_O_SSPRI 0x00000020
+#define ADC_O_SSFIFO0 0x00000048
+#define ADC_O_SSFIFO1 0x00000068
+#define ADC_O_SSFIFO2 0x00000088
+#define ADC_O_SSFIFO3 0x000000A8
@@ -0,0 +1,7 @@
+/**
+ * @file hw_gpio.h
+ * @brief Host stand-in for the subset of the GPIO register offsets used by the project
+ */
+#pragma once
+
+#define GPIO_O_DATA 0x00000000 // Address bits 9:2 select the pins of an access
@@ -0,0 +1,29 @@
+/**
+ * @file hw_ints.h
+ * @brief Host stand-in for the subset of the TM4C1294 interrupt assignments used by the project
+ */
+#pragma once
+
+#define INT_ADC0SS0 30
+#define INT_ADC0SS1 31
+#define INT_ADC0SS2 32
+#define INT_ADC0SS3 33
+#define INT_TIMER0A 35
+#define INT_TIMER0B 36
+#define INT_TIMER1A 37
+#define INT_TIMER1B 38
+#define INT_TIMER2A 39
+#define INT_TIMER2B 40
+#define INT_TIMER3A 51
+#define INT_TIMER3B 52
+#define INT_SSI3 70
+#define INT_GPIOL 69
+#define INT_TIMER4A 86
+#define INT_TIMER4B 87
+#define INT_GPIOM 88
+#define INT_TIMER5A 108
+#define INT_TIMER5B 109
+#define INT_TIMER6A 114
+#define INT_TIMER6B 115
+#define INT_TIMER7A 118
+#define INT_TIMER7B 119
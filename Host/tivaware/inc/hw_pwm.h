@@ -0,0 +1,13 @@
+/**
+ * @file hw_pwm.h
+ * @brief Host stand-in for the subset of the PWM register offsets and fields used by the project
+ */
+#pragma once
+
+#define PWM_O_ENABLE 0x00000008
+#define PWM_O_X_GENA 0x00000020 // From the generator base
+#define PWM_O_X_GENB 0x00000024 // From the generator base
+#define PWM_X_GENA_ACTCMPAD_ONE 0x000000C0
+#define PWM_X_GENA_ACTLOAD_ZERO 0x00000008
+#define PWM_X_GENB_ACTLOAD_ONE 0x0000000C
+#define PWM_X_GENB_ACTZERO_ONE 0x00000003
@@ -0,0 +1,14 @@
+/**
+ * @file hw_types.h
+ * @brief Host stand-in for the subset of the TivaWare register access macros used by the project
+ *
+ * The host builds redirect the registers the application touches (see bridge.h), any other
+ * address is not backed by memory.
+ */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HWREG(x) (*((volatile uint32_t *)(x)))
+#define HWREGH(x) (*((volatile uint16_t *)(x)))
+#define HWREGB(x) (*((volatile uint8_t *)(x)))